@@ -0,0 +1,489 @@
+//
+// Copyright (c) Microsoft Corporation.    All rights reserved.
+//
+
+namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
+{
+    using System;
+    using System.Collections.Generic;
+    using System.Diagnostics;
+    using System.Globalization;
+    using System.IO;
+    using System.Reflection;
+    using System.Text;
+    using System.Threading;
+
+    using Microsoft.Zelig.Runtime.TypeSystem;
+
+
+    //
+    // Structured profile of a compilation, saved in the Chrome trace event format so that chrome://tracing,
+    // Perfetto or speedscope can show it as a flame chart per thread.
+    //
+    // Nothing is recorded until Enable() is called, a disabled scope is just a null check.
+    // Once enabled, each scope appends one event to a buffer owned by the current thread, no locks involved.
+    // Handler invocations are far too many to keep them all, so the ones shorter than the detail threshold are
+    // dropped, unless something nested inside them was recorded. The enclosing event keeps a count and the total
+    // time of the ones it dropped, per handler, saved in its args.
+    //
+    public static class CompilationTrace
+    {
+        public struct Scope : IDisposable
+        {
+            //
+            // State
+            //
+
+            private readonly Buffer m_buffer;
+            private readonly int    m_index;
+
+            //
+            // Constructor Methods
+            //
+
+            internal Scope( Buffer buffer ,
+                            int    index  )
+            {
+                m_buffer = buffer;
+                m_index  = index;
+            }
+
+            //
+            // Helper Methods
+            //
+
+            public void Dispose()
+            {
+                if(m_buffer != null)
+                {
+                    m_buffer.End( m_index );
+                }
+            }
+        }
+
+        internal class DroppedInvocations
+        {
+            internal int  Count;
+            internal long Duration;
+        }
+
+        internal struct Event
+        {
+            internal string     Category;
+            internal string     Name;
+            internal MethodInfo Handler;        // Set instead of Name for handlers, the name is only built by Save.
+            internal bool       IsDetail;
+            internal bool       IsPhase;
+            internal long       Start;
+            internal long       Duration;
+
+            //
+            // Handler invocations dropped while this event was open.
+            //
+            internal Dictionary< MethodInfo, DroppedInvocations > Dropped;
+
+            //
+            // Only tracked for phases, as a delta over the whole process.
+            //
+            internal long   AllocatedBytes;
+            internal long   HeapBytes;
+            internal int    Gen0Collections;
+            internal int    Gen1Collections;
+            internal int    Gen2Collections;
+        }
+
+        internal class Buffer
+        {
+            //
+            // State
+            //
+
+            internal readonly int           ThreadId;
+            internal readonly string        ThreadName;
+            internal readonly List< Event > Events;
+            internal readonly List< int >   Open;       // Events not ended yet, innermost last.
+
+            //
+            // Constructor Methods
+            //
+
+            internal Buffer()
+            {
+                Thread thread = Thread.CurrentThread;
+
+                ThreadId   = thread.ManagedThreadId;
+                ThreadName = thread.Name ?? string.Format( "{0} {1}", thread.IsThreadPoolThread ? "Worker" : "Thread", ThreadId );
+                Events     = new List< Event >();
+                Open       = new List< int >();
+            }
+
+            //
+            // Helper Methods
+            //
+
+            internal int Begin( string     category ,
+                                string     name     ,
+                                MethodInfo handler  ,
+                                bool       isDetail ,
+                                bool       isPhase  )
+            {
+                Event evt = new Event();
+
+                evt.Category = category;
+                evt.Name     = name;
+                evt.Handler  = handler;
+                evt.IsDetail = isDetail;
+                evt.IsPhase  = isPhase;
+                evt.Duration = -1;
+
+                if(isPhase)
+                {
+                    evt.AllocatedBytes  = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize;
+                    evt.Gen0Collections = GC.CollectionCount( 0 );
+                    evt.Gen1Collections = GC.CollectionCount( 1 );
+                    evt.Gen2Collections = GC.CollectionCount( 2 );
+                }
+
+                evt.Start = Stopwatch.GetTimestamp();
+
+                Events.Add( evt );
+                Open  .Add( Events.Count - 1 );
+
+                return Events.Count - 1;
+            }
+
+            internal void End( int index )
+            {
+                long  now = Stopwatch.GetTimestamp();
+                Event evt = Events[index];
+
+                evt.Duration = now - evt.Start;
+
+                int open = Open.LastIndexOf( index );
+
+                if(open >= 0)
+                {
+                    Open.RemoveAt( open );
+                }
+
+                if(evt.IsDetail && evt.Duration < s_minimumDetailTicks && index == Events.Count - 1)
+                {
+                    Events.RemoveAt( index );
+
+                    if(Open.Count > 0)
+                    {
+                        AddDropped( Open[Open.Count - 1], evt );
+                    }
+                    return;
+                }
+
+                if(evt.IsPhase)
+                {
+                    evt.AllocatedBytes  = AppDomain.CurrentDomain.MonitoringTotalAllocatedMemorySize - evt.AllocatedBytes;
+                    evt.HeapBytes       = GC.GetTotalMemory( false );
+                    evt.Gen0Collections = GC.CollectionCount( 0 ) - evt.Gen0Collections;
+                    evt.Gen1Collections = GC.CollectionCount( 1 ) - evt.Gen1Collections;
+                    evt.Gen2Collections = GC.CollectionCount( 2 ) - evt.Gen2Collections;
+                }
+
+                Events[index] = evt;
+            }
+
+            //
+            // Charges a dropped invocation, and whatever was dropped inside it, to the enclosing event.
+            //
+            private void AddDropped( int   index   ,
+                                     Event dropped )
+            {
+                Event evt = Events[index];
+
+                if(evt.Dropped == null)
+                {
+                    evt.Dropped   = new Dictionary< MethodInfo, DroppedInvocations >();
+                    Events[index] = evt;
+                }
+
+                AddDropped( evt.Dropped, dropped.Handler, 1, dropped.Duration );
+
+                if(dropped.Dropped != null)
+                {
+                    foreach(var pair in dropped.Dropped)
+                    {
+                        AddDropped( evt.Dropped, pair.Key, pair.Value.Count, pair.Value.Duration );
+                    }
+                }
+            }
+
+            private static void AddDropped( Dictionary< MethodInfo, DroppedInvocations > dropped  ,
+                                            MethodInfo                                    handler  ,
+                                            int                                           count    ,
+                                            long                                          duration )
+            {
+                DroppedInvocations invocations;
+
+                if(dropped.TryGetValue( handler, out invocations ) == false)
+                {
+                    invocations = new DroppedInvocations();
+
+                    dropped.Add( handler, invocations );
+                }
+
+                invocations.Count    += count;
+                invocations.Duration += duration;
+            }
+        }
+
+        //
+        // State
+        //
+
+        public const int c_DefaultMinimumDetailMicroSeconds = 10;
+
+        private static          bool           s_enabled;
+        private static          long           s_origin;
+        private static          long           s_minimumDetailTicks;
+        private static readonly List< Buffer > s_buffers = new List< Buffer >();
+
+        [ThreadStatic] private static Buffer   s_buffer;
+
+        //
+        // Helper Methods
+        //
+
+        public static void Enable( int minimumDetailMicroSeconds )
+        {
+            AppDomain.MonitoringIsEnabled = true;
+
+            s_origin             = Stopwatch.GetTimestamp();
+            s_minimumDetailTicks = (long)minimumDetailMicroSeconds * Stopwatch.Frequency / (1000 * 1000);
+            s_enabled            = true;
+        }
+
+        public static Scope Begin( string category ,
+                                   string name     )
+        {
+            return s_enabled ? Open( category, name, null, false, false ) : new Scope();
+        }
+
+        public static Scope BeginPhase( PhaseDriver phase )
+        {
+            return s_enabled ? Open( "Phase", phase.ToString(), null, false, true ) : new Scope();
+        }
+
+        public static Scope BeginMethod( MethodRepresentation md )
+        {
+            return s_enabled ? Open( "Method", md.ToShortString(), null, false, false ) : new Scope();
+        }
+
+        public static Scope BeginHandler( string   category ,
+                                          Delegate dlg      )
+        {
+            if(s_enabled == false)
+            {
+                return new Scope();
+            }
+
+            return Open( category, null, dlg.Method, true, false );
+        }
+
+        public static void Save( string file )
+        {
+            int                              pid   = Process.GetCurrentProcess().Id;
+            Dictionary< MethodInfo, string > names = new Dictionary< MethodInfo, string >();
+
+            using(StreamWriter output = new StreamWriter( file, false, new UTF8Encoding( false ) ))
+            {
+                string separator = "";
+
+                output.WriteLine( "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" );
+
+                lock(s_buffers)
+                {
+                    foreach(Buffer buffer in s_buffers)
+                    {
+                        output.Write( "{0}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{1},\"tid\":{2},\"args\":{{\"name\":{3}}}}}", separator, pid, buffer.ThreadId, Quote( buffer.ThreadName ) );
+                        separator = ",\n";
+
+                        foreach(Event evt in buffer.Events)
+                        {
+                            if(evt.Duration < 0)
+                            {
+                                continue;
+                            }
+
+                            string name = evt.Name ?? GetHandlerName( names, evt.Handler );
+
+                            output.Write( "{0}{{\"name\":{1},\"cat\":{2},\"ph\":\"X\",\"ts\":{3},\"dur\":{4},\"pid\":{5},\"tid\":{6}", separator, Quote( name ), Quote( evt.Category ), ToMicroSeconds( evt.Start - s_origin ), ToMicroSeconds( evt.Duration ), pid, buffer.ThreadId );
+
+                            if(evt.IsPhase || evt.Dropped != null)
+                            {
+                                output.Write( ",\"args\":{" );
+
+                                if(evt.IsPhase)
+                                {
+                                    output.Write( "\"allocatedBytes\":{0},\"heapBytes\":{1},\"gen0\":{2},\"gen1\":{3},\"gen2\":{4}", evt.AllocatedBytes, evt.HeapBytes, evt.Gen0Collections, evt.Gen1Collections, evt.Gen2Collections );
+
+                                    if(evt.Dropped != null)
+                                    {
+                                        output.Write( "," );
+                                    }
+                                }
+
+                                if(evt.Dropped != null)
+                                {
+                                    WriteDropped( output, names, evt.Dropped );
+                                }
+
+                                output.Write( "}" );
+                            }
+
+                            output.Write( "}" );
+
+                            if(evt.IsPhase)
+                            {
+                                //
+                                // Also plot the heap size at the end of each phase as a counter track.
+                                //
+                                output.Write( "{0}{{\"name\":\"Managed heap\",\"ph\":\"C\",\"ts\":{1},\"pid\":{2},\"args\":{{\"bytes\":{3}}}}}", separator, ToMicroSeconds( evt.Start + evt.Duration - s_origin ), pid, evt.HeapBytes );
+                            }
+                        }
+                    }
+                }
+
+                output.WriteLine();
+                output.WriteLine( "]}" );
+            }
+        }
+
+        //--//
+
+        private static Scope Open( string     category ,
+                                   string     name     ,
+                                   MethodInfo handler  ,
+                                   bool       isDetail ,
+                                   bool       isPhase  )
+        {
+            Buffer buffer = s_buffer;
+
+            if(buffer == null)
+            {
+                buffer = new Buffer();
+
+                lock(s_buffers)
+                {
+                    s_buffers.Add( buffer );
+                }
+
+                s_buffer = buffer;
+            }
+
+            return new Scope( buffer, buffer.Begin( category, name, handler, isDetail, isPhase ) );
+        }
+
+        //
+        // "dropped":{"<handler>":{"count":<invocations>,"dur":<total microseconds>},...}, longest total first.
+        // Overloads share a name, so they are merged.
+        //
+        private static void WriteDropped( StreamWriter                                  output  ,
+                                          Dictionary< MethodInfo, string >              names   ,
+                                          Dictionary< MethodInfo, DroppedInvocations > dropped )
+        {
+            Dictionary< string, DroppedInvocations > byName = new Dictionary< string, DroppedInvocations >();
+
+            foreach(var pair in dropped)
+            {
+                string             name = GetHandlerName( names, pair.Key );
+                DroppedInvocations invocations;
+
+                if(byName.TryGetValue( name, out invocations ) == false)
+                {
+                    invocations = new DroppedInvocations();
+
+                    byName.Add( name, invocations );
+                }
+
+                invocations.Count    += pair.Value.Count;
+                invocations.Duration += pair.Value.Duration;
+            }
+
+            List< KeyValuePair< string, DroppedInvocations > > sorted = new List< KeyValuePair< string, DroppedInvocations > >( byName );
+
+            sorted.Sort( (x, y) => y.Value.Duration.CompareTo( x.Value.Duration ) );
+
+            string separator = "";
+
+            output.Write( "\"dropped\":{" );
+
+            foreach(var pair in sorted)
+            {
+                output.Write( "{0}{1}:{{\"count\":{2},\"dur\":{3}}}", separator, Quote( pair.Key ), pair.Value.Count, ToMicroSeconds( pair.Value.Duration ) );
+                separator = ",";
+            }
+
+            output.Write( "}" );
+        }
+
+        private static string GetHandlerName( Dictionary< MethodInfo, string > names ,
+                                              MethodInfo                       mi    )
+        {
+            string name;
+
+            if(names.TryGetValue( mi, out name ) == false)
+            {
+                name = mi.DeclaringType.Name + "." + mi.Name;
+
+                names.Add( mi, name );
+            }
+
+            return name;
+        }
+
+        private static string ToMicroSeconds( long ticks )
+        {
+            return ((double)ticks * 1000 * 1000 / Stopwatch.Frequency).ToString( "F3", CultureInfo.InvariantCulture );
+        }
+
+        private static string Quote( string text )
+        {
+            StringBuilder sb = new StringBuilder( text.Length + 2 );
+
+            sb.Append( '"' );
+
+            foreach(char c in text)
+            {
+                switch(c)
+                {
+                    case '"' : sb.Append( "\\\"" ); break;
+                    case '\\': sb.Append( "\\\\" ); break;
+
+                    default:
+                        if(c < ' ')
+                        {
+                            sb.AppendFormat( "\\u{0:X4}", (int)c );
+                        }
+                        else
+                        {
+                            sb.Append( c );
+                        }
+                        break;
+                }
+            }
+
+            sb.Append( '"' );
+
+            return sb.ToString();
+        }
+
+        //
+        // Access Methods
+        //
+
+        public static bool IsEnabled
+        {
+            get
+            {
+                return s_enabled;
+            }
+        }
+    }
+}
@@ -290,7 +290,12 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
                     timing.Start( this, string.Format( "Phase__{0}", m_currentPhase ) );
 #endif
 
-                    var nextPhase = m_currentPhase.Execute();
+                    PhaseDriver nextPhase;
+
+                    using(CompilationTrace.BeginPhase( m_currentPhase ))
+                    {
+                        nextPhase = m_currentPhase.Execute();
+                    }
 
 #if COLLECT_PERFORMANCE_DATA_FOR_CONTROLLER
                     timing.Stop();
@@ -154,7 +154,10 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
 
                             cfg.TraceToFile( "Optimization-Pre - " + dlg.Method );
 
-                            dlg( nc );
+                            using(CompilationTrace.BeginHandler( "OptimizationHandler", dlg ))
+                            {
+                                dlg( nc );
+                            }
 
                             cfg.TraceToFile( "Optimization-Post" );
 
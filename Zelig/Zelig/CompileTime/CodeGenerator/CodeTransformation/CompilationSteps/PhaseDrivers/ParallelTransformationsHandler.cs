@@ -12,6 +12,11 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
     using System.Threading;
 
 
+    //
+    // Methods are queued in chunks of roughly the same amount of IR, handed out round robin to the workers.
+    // Each worker owns a deque of chunks: it takes its own work from the tail and, once it runs dry, steals
+    // from the head of the other workers' deques, so a few large methods don't leave the rest of the workers idle.
+    //
     public class ParallelTransformationsHandler : IDisposable
     {
         public delegate void NotificationCallback( Operation phase, MethodRepresentation md, ref object state );
@@ -29,35 +34,46 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
             // State
             //
 
-            private          ParallelTransformationsHandler  m_owner;
-            private volatile MethodRepresentation            m_md;
+            private          ParallelTransformationsHandler     m_owner;
+            private          int                                m_index;
+            private          LinkedList< MethodRepresentation[] > m_chunks;
 
-            private          List< Exception >               m_errors;
+            private          List< Exception >                  m_errors;
 
-            private          object                          m_state;
+            private          object                             m_state;
 #if !USE_THREAD_POOL
-            private          System.Threading.Thread         m_thread;
+            private          System.Threading.Thread            m_thread;
+#else
+            private          System.Threading.ManualResetEvent  m_stopped;
 #endif
-            private          System.Threading.AutoResetEvent m_waitForRequest;
 
             //
             // Constructor Methods
             //
 
-            internal Worker( ParallelTransformationsHandler owner )
+            internal Worker( ParallelTransformationsHandler owner ,
+                             int                            index )
             {
                 m_owner          = owner;
+                m_index          = index;
+                m_chunks         = new LinkedList< MethodRepresentation[] >();
 
                 m_errors         = new List< Exception >();
 
                 m_state          = null;
 #if !USE_THREAD_POOL
                 m_thread         = new System.Threading.Thread( Execute );
+#else
+                m_stopped        = new System.Threading.ManualResetEvent( false );
 #endif
-                m_waitForRequest = new System.Threading.AutoResetEvent( false );
+            }
 
-                //--//
+            //
+            // Helper Methods
+            //
 
+            internal void Start()
+            {
 #if USE_THREAD_POOL
                 ThreadPool.QueueUserWorkItem( Execute );
 #else
@@ -67,23 +83,38 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
 #endif
             }
 
-            //
-            // Helper Methods
-            // 
+            internal void Push( MethodRepresentation[] chunk )
+            {
+                lock(m_chunks)
+                {
+                    m_chunks.AddLast( chunk );
+                }
+            }
 
-            internal void Post( MethodRepresentation md )
+            internal MethodRepresentation[] Steal()
             {
-                m_md = md;
-                m_waitForRequest.Set();
+                lock(m_chunks)
+                {
+                    if(m_chunks.Count == 0)
+                    {
+                        return null;
+                    }
+
+                    MethodRepresentation[] chunk = m_chunks.First.Value;
+
+                    m_chunks.RemoveFirst();
+
+                    return chunk;
+                }
             }
 
             internal void Stop()
             {
-                m_md = null;
-                m_waitForRequest.Set();
-
 #if !USE_THREAD_POOL
                 m_thread.Join();
+#else
+                m_stopped.WaitOne();
+                m_stopped.Close();
 #endif
 
                 if(m_errors.Count > 0)
@@ -94,61 +125,91 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
 
             //--//
 
+            private MethodRepresentation[] Pop()
+            {
+                lock(m_chunks)
+                {
+                    if(m_chunks.Count == 0)
+                    {
+                        return null;
+                    }
+
+                    MethodRepresentation[] chunk = m_chunks.Last.Value;
+
+                    m_chunks.RemoveLast();
+
+                    return chunk;
+                }
+            }
+
             private void Execute(object state)
             {
-                lock(m_owner.m_availableWorkers)
+                lock(m_owner.m_notificationLock)
                 {
                     Notify( Operation.Initialize, null );
                 }
 
                 while(true)
                 {
-                    lock(m_owner.m_availableWorkers)
-                    {
-                        m_owner.m_availableWorkers.Enqueue( this );
-                    }
+                    MethodRepresentation[] chunk = Pop() ?? m_owner.StealFor( m_index );
 
-                    m_owner.m_availableSemaphore.Release();
+                    if(chunk == null)
+                    {
+                        if(m_owner.WaitForWork() == false)
+                        {
+                            break;
+                        }
 
-                    m_waitForRequest.WaitOne();
+                        continue;
+                    }
 
-                    MethodRepresentation md = m_md;
+                    m_owner.Taken();
 
-                    if(md == null)
+                    foreach(MethodRepresentation md in chunk)
                     {
-                        break;
+                        Execute( md );
                     }
 
-                    try
+                    m_owner.Completed();
+                }
+
+                lock(m_owner.m_notificationLock)
+                {
+                    Notify( Operation.Shutdown, null );
+                }
+
+#if USE_THREAD_POOL
+                m_stopped.Set();
+#endif
+            }
+
+            private void Execute( MethodRepresentation md )
+            {
+                try
+                {
+                    using(ControlFlowGraphState.LockThreadToMethod( md ))
+                    using(CompilationTrace.BeginMethod( md ))
                     {
-                        using(ControlFlowGraphState.LockThreadToMethod( md ))
-                        {
-                            Notify( Operation.Execute, md );
+                        Notify( Operation.Execute, md );
 
-                            if(m_owner.m_mdCallback != null)
-                            {
-                                m_owner.m_mdCallback( md );
-                            }
+                        if(m_owner.m_mdCallback != null)
+                        {
+                            m_owner.m_mdCallback( md );
+                        }
 
-                            if(m_owner.m_cfgCallback != null)
+                        if(m_owner.m_cfgCallback != null)
+                        {
+                            ControlFlowGraphStateForCodeTransformation cfg = TypeSystemForCodeTransformation.GetCodeForMethod( md );
+                            if(cfg != null)
                             {
-                                ControlFlowGraphStateForCodeTransformation cfg = TypeSystemForCodeTransformation.GetCodeForMethod( md );
-                                if(cfg != null)
-                                {
-                                    m_owner.m_cfgCallback( cfg );
-                                }
+                                m_owner.m_cfgCallback( cfg );
                             }
                         }
                     }
-                    catch(Exception ex)
-                    {
-                        m_errors.Add( ex );
-                    }
                 }
-
-                lock(m_owner.m_availableWorkers)
+                catch(Exception ex)
                 {
-                    Notify( Operation.Shutdown, null );
+                    m_errors.Add( ex );
                 }
             }
 
@@ -168,6 +229,13 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
 
         static int s_maximumNumberOfProcessorsToUse = int.MaxValue;
 
+        //
+        // A chunk is closed once the operators of its methods add up to this. Each method also counts for a
+        // fixed overhead, so that chunks of trivial methods (or of methods without code) stay bounded too.
+        //
+        const int c_TargetChunkCost   = 1024;
+        const int c_PerMethodOverhead = 16;
+
         //--//
 
         MethodEnumerationCallback           m_mdCallback;
@@ -176,8 +244,16 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
 
         int                                 m_procs;
         Worker[]                            m_workers;
-        System.Threading.Semaphore          m_availableSemaphore;
-        Queue< Worker >                     m_availableWorkers;
+        object                              m_notificationLock;
+
+        List< MethodRepresentation >        m_batch;
+        int                                 m_batchCost;
+        int                                 m_nextWorker;
+
+        object                              m_sync;
+        int                                 m_queuedChunks;      // Pushed to a deque, not yet taken by a worker.
+        int                                 m_outstandingChunks; // Pushed to a deque, not yet completed.
+        bool                                m_shutdown;
 
         //
         // Constructor Methods
@@ -206,14 +282,24 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
             m_cfgCallback          = cfgCallback;
             m_notificationCallback = notificationCallback;
 
-            m_procs              = procs;
-            m_workers            = new Worker[procs];
-            m_availableSemaphore = new System.Threading.Semaphore( 0, (int)procs );
-            m_availableWorkers   = new Queue< Worker >();
+            m_procs                = procs;
+            m_workers              = new Worker[procs];
+            m_notificationLock     = new object();
+
+            m_batch                = new List< MethodRepresentation >();
+            m_sync                 = new object();
 
             for(int idx = 0; idx < procs; idx++)
             {
-                m_workers[idx] = new Worker( this );
+                m_workers[idx] = new Worker( this, idx );
+            }
+
+            //
+            // Only start once all the deques exist, idle workers go looking through all of them.
+            //
+            foreach(Worker worker in m_workers)
+            {
+                worker.Start();
             }
         }
 
@@ -225,42 +311,129 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
         {
             CHECKS.ASSERT( md != null, "Expecting method argument" );
 
-            m_availableSemaphore.WaitOne();
+            m_batch.Add( md );
 
-            Worker worker;
+            m_batchCost += EstimateCost( md );
 
-            lock(m_availableWorkers)
+            if(m_batchCost >= c_TargetChunkCost)
             {
-                worker = m_availableWorkers.Dequeue();
+                FlushBatch();
             }
-
-            worker.Post( md );
         }
 
         public void Synchronize()
         {
-            for(int idx = 0; idx < m_procs; idx++)
+            FlushBatch();
+
+            lock(m_sync)
             {
-                m_availableSemaphore.WaitOne();
+                while(m_outstandingChunks > 0)
+                {
+                    Monitor.Wait( m_sync );
+                }
             }
-
-            m_availableSemaphore.Release( m_procs );
         }
 
         public void Shutdown()
         {
-            for(int idx = 0; idx < m_procs; idx++)
+            FlushBatch();
+
+            lock(m_sync)
+            {
+                m_shutdown = true;
+
+                Monitor.PulseAll( m_sync );
+            }
+
+            foreach(Worker worker in m_workers)
+            {
+                worker.Stop();
+            }
+        }
+
+        //--//
+
+        private static int EstimateCost( MethodRepresentation md )
+        {
+            ControlFlowGraphStateForCodeTransformation cfg = TypeSystemForCodeTransformation.GetCodeForMethod( md );
+
+            return c_PerMethodOverhead + (cfg != null ? cfg.CountOperators() : 0);
+        }
+
+        private void FlushBatch()
+        {
+            if(m_batch.Count == 0)
+            {
+                return;
+            }
+
+            MethodRepresentation[] chunk = m_batch.ToArray();
+
+            m_batch.Clear();
+            m_batchCost = 0;
+
+            Interlocked.Increment( ref m_outstandingChunks );
+            Interlocked.Increment( ref m_queuedChunks      );
+
+            m_workers[m_nextWorker].Push( chunk );
+
+            m_nextWorker = (m_nextWorker + 1) % m_procs;
+
+            lock(m_sync)
+            {
+                Monitor.PulseAll( m_sync );
+            }
+        }
+
+        private MethodRepresentation[] StealFor( int thief )
+        {
+            for(int offset = 1; offset < m_procs; offset++)
             {
-                m_availableSemaphore.WaitOne();
+                MethodRepresentation[] chunk = m_workers[(thief + offset) % m_procs].Steal();
 
-                Worker worker;
+                if(chunk != null)
+                {
+                    return chunk;
+                }
+            }
+
+            return null;
+        }
 
-                lock(m_availableWorkers)
+        private void Taken()
+        {
+            Interlocked.Decrement( ref m_queuedChunks );
+        }
+
+        private void Completed()
+        {
+            if(Interlocked.Decrement( ref m_outstandingChunks ) == 0)
+            {
+                lock(m_sync)
                 {
-                    worker = m_availableWorkers.Dequeue();
+                    Monitor.PulseAll( m_sync );
                 }
+            }
+        }
 
-                worker.Stop();
+        //
+        // Returns false once the handler is shut down and there is no work left anywhere.
+        //
+        private bool WaitForWork()
+        {
+            lock(m_sync)
+            {
+                while(Volatile.Read( ref m_queuedChunks ) == 0)
+                {
+                    if(m_shutdown)
+                    {
+                        return false;
+                    }
+
+                    Monitor.Wait( m_sync );
+                }
+
+                return true;
             }
         }
 
@@ -282,6 +455,18 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
             }
         }
 
+        public static void EnumerateMethods( IEnumerable< MethodRepresentation > methods  ,
+                                             NotificationCallback                callback )
+        {
+            using(ParallelTransformationsHandler handler = new ParallelTransformationsHandler( null, null, callback ))
+            {
+                foreach(MethodRepresentation md in methods)
+                {
+                    handler.Queue( md );
+                }
+            }
+        }
+
         public static void EnumerateMethods( TypeSystemForCodeTransformation typeSystem ,
                                              MethodEnumerationCallback       callback   )
         {
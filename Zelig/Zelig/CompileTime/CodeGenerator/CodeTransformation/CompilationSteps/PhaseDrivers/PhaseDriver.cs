@@ -308,7 +308,17 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
                         break;
                     }
 
-                    ParallelTransformationsHandler.EnumerateMethods( this.TypeSystem, delegate( ParallelTransformationsHandler.Operation phase, MethodRepresentation md, ref object state )
+                    //
+                    // Only the methods that got something inlined into them need another pass.
+                    //
+                    var touchedMethods = new List< MethodRepresentation >( touched.Count );
+
+                    foreach(ControlFlowGraphStateForCodeTransformation cfg in touched)
+                    {
+                        touchedMethods.Add( cfg.Method );
+                    }
+
+                    ParallelTransformationsHandler.EnumerateMethods( touchedMethods, delegate( ParallelTransformationsHandler.Operation phase, MethodRepresentation md, ref object state )
                     {
                         var rpe = (SingleMethodPhaseExecution)state;
 
@@ -319,11 +329,7 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
                                 break;
 
                             case ParallelTransformationsHandler.Operation.Execute:
-                                var cfg = TypeSystemForCodeTransformation.GetCodeForMethod( md );
-                                if(cfg != null && touched.Contains( cfg ))
-                                {
-                                    rpe.Analyze( md );
-                                }
+                                rpe.Analyze( md );
                                 break;
 
                             case ParallelTransformationsHandler.Operation.Shutdown:
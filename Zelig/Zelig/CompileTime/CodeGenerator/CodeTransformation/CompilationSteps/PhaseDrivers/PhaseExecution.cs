@@ -266,7 +266,10 @@ namespace Microsoft.Zelig.CodeGeneration.IR.CompilationSteps
                         nc.CurrentCFG.TraceToFile( dlg );
                     }
 
-                    dlg( nc );
+                    using(CompilationTrace.BeginHandler( "OperatorHandler", dlg ))
+                    {
+                        dlg( nc );
+                    }
 
                     if(nc.ShouldSkip) return false;
                     if(nc.ShouldStop) return false;
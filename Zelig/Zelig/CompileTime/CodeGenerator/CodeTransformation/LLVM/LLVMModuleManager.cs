@@ -105,6 +105,26 @@ namespace Microsoft.Zelig.LLVM
             m_module.DumpToFile( filename, format );
         }
 
+        public void SetCodeGenerationTarget( string triple, string cpu, bool functionSections, uint dwarfVersion )
+        {
+            m_module.SetCodeGenerationTarget( triple, cpu, functionSections, dwarfVersion );
+        }
+
+        public void Optimize( )
+        {
+            m_module.Optimize( );
+        }
+
+        public byte[] EmitObject( )
+        {
+            return m_module.EmitObject( );
+        }
+
+        public byte[][] EmitObjects( uint partitionCount, int threadCount, bool optimize, ObjectCache cache )
+        {
+            return m_module.EmitObjects( partitionCount, threadCount, optimize, cache );
+        }
+
         public void TurnOffCompilationAndValidation( )
         {
             m_turnOffCompilationAndValidation = true;
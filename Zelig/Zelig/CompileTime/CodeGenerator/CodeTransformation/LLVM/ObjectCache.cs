@@ -0,0 +1,210 @@
+//
+// Copyright (c) Microsoft Corporation.    All rights reserved.
+//
+
+namespace Microsoft.Zelig.LLVM
+{
+    using System;
+    using System.IO;
+    using System.Linq;
+    using System.Security.Cryptography;
+    using System.Text;
+    using System.Threading;
+
+    using Llvm.NET;
+
+    //
+    // Persistent, on disk, cache of generated objects. Entries are keyed by a fingerprint of the bitcode an
+    // object was generated from, together with the code generation settings and the identity of the compiler
+    // assemblies. The bitcode holds the final IR of every method in it along with the layout of every type
+    // they use, so an unchanged fingerprint means the object would come out identical and can be reused.
+    // The cache is safe to share between threads and between concurrent builds.
+    //
+    // Nothing is invalidated in place: entries of a previous compiler or LLVM simply stop being hit. Trim keeps
+    // the directory under a size bound by deleting the least recently used entries, so those go first.
+    //
+    public class ObjectCache
+    {
+        // Bump whenever the passes or target machine settings used to generate the cached objects change
+        private const int c_FormatVersion = 1;
+
+        public const long DefaultMaximumSize = 256L * 1024 * 1024;
+
+        // A temporary file this old belongs to a build that died before renaming it
+        private static readonly TimeSpan c_StaleTemporaryAge = TimeSpan.FromHours( 1 );
+
+        private readonly string m_directory;
+        private readonly string m_compilerIdentity;
+        private readonly long   m_maximumSize;
+        private int             m_hits;
+        private int             m_misses;
+
+        public ObjectCache( string directory ) : this( directory, DefaultMaximumSize )
+        {
+        }
+
+        public ObjectCache( string directory, long maximumSize )
+        {
+            m_directory   = directory;
+            m_maximumSize = maximumSize;
+
+            // Any rebuild of the code generator or of the LLVM bindings, or another LLVM in LibLLVM, invalidates every entry
+            m_compilerIdentity = string.Format( "{0}|{1}|{2}|{3}",
+                                                c_FormatVersion,
+                                                typeof( ObjectCache  ).Assembly.ManifestModule.ModuleVersionId,
+                                                typeof( NativeModule ).Assembly.ManifestModule.ModuleVersionId,
+                                                StaticState.LlvmVersion );
+
+            Directory.CreateDirectory( directory );
+        }
+
+        public int Hits
+        {
+            get
+            {
+                return m_hits;
+            }
+        }
+
+        public int Misses
+        {
+            get
+            {
+                return m_misses;
+            }
+        }
+
+        public string GetKey( byte[] bitcode, string configuration )
+        {
+            using( var sha = SHA256.Create( ) )
+            {
+                var header = Encoding.UTF8.GetBytes( m_compilerIdentity + "|" + configuration );
+
+                sha.TransformBlock     ( header , 0, header.Length , null, 0 );
+                sha.TransformFinalBlock( bitcode, 0, bitcode.Length          );
+
+                var sb = new StringBuilder( sha.Hash.Length * 2 );
+                foreach( byte b in sha.Hash )
+                {
+                    sb.Append( b.ToString( "x2" ) );
+                }
+
+                return sb.ToString( );
+            }
+        }
+
+        public bool TryGet( string key, out byte[] obj )
+        {
+            var path = GetPath( key );
+
+            try
+            {
+                obj = File.ReadAllBytes( path );
+            }
+            catch( IOException )
+            {
+                obj = null;
+
+                Interlocked.Increment( ref m_misses );
+                return false;
+            }
+
+            Interlocked.Increment( ref m_hits );
+
+            // The write time of an entry doubles as its last use, for Trim
+            try
+            {
+                File.SetLastWriteTimeUtc( path, DateTime.UtcNow );
+            }
+            catch( IOException )
+            {
+            }
+            catch( UnauthorizedAccessException )
+            {
+            }
+
+            return true;
+        }
+
+        //
+        // Deletes the least recently used entries until the cache fits in its maximum size, along with the
+        // temporary files of builds that did not finish. A concurrent build losing an entry just sees a miss.
+        //
+        public void Trim( )
+        {
+            var files = new DirectoryInfo( m_directory ).GetFiles( );
+            var now   = DateTime.UtcNow;
+
+            foreach( var file in files )
+            {
+                if( file.Extension == ".tmp" && now - file.LastWriteTimeUtc > c_StaleTemporaryAge )
+                {
+                    TryDelete( file );
+                }
+            }
+
+            var  entries = files.Where( f => f.Extension == ".o" ).OrderBy( f => f.LastWriteTimeUtc ).ToList( );
+            long size    = entries.Sum( f => f.Length );
+
+            foreach( var entry in entries )
+            {
+                if( size <= m_maximumSize )
+                {
+                    break;
+                }
+
+                long length = entry.Length;
+
+                if( TryDelete( entry ) )
+                {
+                    size -= length;
+                }
+            }
+        }
+
+        public void Add( string key, byte[] obj )
+        {
+            var path = GetPath( key );
+
+            //
+            // Written under a unique name and then renamed, so that a build sharing the cache never reads a partial entry
+            //
+            var tempPath = string.Format( "{0}.{1:N}.tmp", path, Guid.NewGuid( ) );
+
+            File.WriteAllBytes( tempPath, obj );
+
+            try
+            {
+                File.Move( tempPath, path );
+            }
+            catch( IOException )
+            {
+                // Another build added the same entry first
+                File.Delete( tempPath );
+            }
+        }
+
+        private static bool TryDelete( FileInfo file )
+        {
+            try
+            {
+                file.Delete( );
+                return true;
+            }
+            catch( IOException )
+            {
+                return false;
+            }
+            catch( UnauthorizedAccessException )
+            {
+                // Still open in a concurrent build
+                return false;
+            }
+        }
+
+        private string GetPath( string key )
+        {
+            return Path.Combine( m_directory, key + ".o" );
+        }
+    }
+}
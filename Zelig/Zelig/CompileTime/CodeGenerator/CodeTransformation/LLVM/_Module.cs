@@ -2,6 +2,7 @@
 using System.Linq;
 using System.Collections.Generic;
 using System.Diagnostics;
+using System.Threading;
 using Llvm.NET.Values;
 using Llvm.NET;
 using Llvm.NET.Types;
@@ -429,6 +430,240 @@ namespace Microsoft.Zelig.LLVM
             }
         }
 
+        // Replaces the placeholder target machine created with the module by one set up for code
+        // generation the same way the front end used to invoke llc.exe:
+        //     -O2 -code-model=small -relocation-model=pic -data-sections [-function-sections -dwarf-version=N]
+        // The module data layout is left alone, as the IR has already been laid out against it.
+        public void SetCodeGenerationTarget( string triple, string cpu, bool functionSections, uint dwarfVersion )
+        {
+            m_codeGenTriple           = triple;
+            m_codeGenCpu              = cpu;
+            m_codeGenFunctionSections = functionSections;
+
+            var machine = CreateCodeGenerationMachine( LlvmModule.Context );
+
+            // The previous machine still owns the module's DataLayout, so it is not disposed here
+            TargetMachine = machine;
+            LlvmModule.TargetTriple = machine.Triple;
+
+            if( dwarfVersion != 0 )
+            {
+                LlvmModule.AddModuleFlag( ModuleFlagBehavior.Warning, NativeModule.DwarfVersionValue, dwarfVersion );
+            }
+        }
+
+        // The optimization pipeline, as opt.exe switches. The front end passes the same string to opt.exe
+        // (after its -verify-* and -aa-eval switches), and the in process pipeline adds the passes by
+        // name, so the two cannot drift apart.
+        public const string OptimizationPasses = "-indvars -gvn -globaldce -adce -dce -tailcallopt -scalarrepl -mem2reg -ipconstprop -deadargelim -sccp -dce -ipsccp -dce -constmerge -scev-aa -targetlibinfo -irce -dse -dce -argpromotion -mem2reg -adce -mem2reg -globaldce -die -dce -dse";
+
+        // Switches in OptimizationPasses that set an option instead of adding a pass. -tailcallopt only
+        // sets GuaranteedTailCallOpt on opt.exe's own target machine, and llc.exe is not given it, so it
+        // has never changed the generated code.
+        private static readonly string[ ] s_optionSwitches = { "tailcallopt" };
+
+        // Passes that need the whole program, run before the module is split for parallel code generation
+        private static readonly string[ ] s_interproceduralPasses = { "globaldce", "ipconstprop", "deadargelim", "ipsccp", "constmerge", "argpromotion" };
+
+        private static void AddOptimizationPasses( PassManager passManager, Func< string, bool > filter )
+        {
+            foreach( var option in OptimizationPasses.Split( new[ ] { ' ' }, StringSplitOptions.RemoveEmptyEntries ) )
+            {
+                var name = option.TrimStart( '-' );
+
+                if( s_optionSwitches.Contains( name ) || !filter( name ) )
+                {
+                    continue;
+                }
+
+                if( !passManager.AddPass( name ) )
+                {
+                    throw new InvalidOperationException( $"LLVM has no pass for the {option} optimization switch" );
+                }
+            }
+        }
+
+        private static bool IsInterproceduralPass( string name )
+        {
+            return s_interproceduralPasses.Contains( name );
+        }
+
+        // In process equivalent of opt.exe with OptimizationPasses
+        public void Optimize( )
+        {
+            DIBuilder.Finish( );
+
+            using( var passManager = new PassManager( ) )
+            {
+                TargetMachine.AddAnalysisPasses( passManager );
+                AddOptimizationPasses( passManager, name => true );
+                passManager.AddVerifierPass( );
+
+                passManager.Run( LlvmModule );
+            }
+        }
+
+        public byte[ ] EmitObject( )
+        {
+            DIBuilder.Finish( );
+
+            using( var buffer = TargetMachine.EmitToBuffer( LlvmModule, CodeGenFileType.ObjectFile ) )
+            {
+                return buffer.ToArray( );
+            }
+        }
+
+        // Parallel counterpart of Optimize and EmitObject. The interprocedural passes run once on the whole
+        // module, which is then split into partitionCount modules that are optimized and compiled on up to
+        // threadCount threads, each with its own LLVM context as contexts are not thread safe. Objects are
+        // returned in partition order, so the output depends on partitionCount but never on threadCount.
+        // With a cache, partitions whose bitcode and settings are unchanged since a previous build reuse the
+        // object generated then instead of going through optimization and code generation again.
+        public byte[ ][ ] EmitObjects( uint partitionCount, int threadCount, bool optimize, ObjectCache cache )
+        {
+            if( m_codeGenTriple == null )
+            {
+                throw new InvalidOperationException( "SetCodeGenerationTarget must be called before generating code" );
+            }
+
+            DIBuilder.Finish( );
+
+            if( optimize )
+            {
+                using( CodeGeneration.IR.CompilationSteps.CompilationTrace.Begin( "LLVM", "Interprocedural optimization" ) )
+                {
+                    OptimizeInterprocedural( );
+                }
+            }
+
+            var parts   = LlvmModule.SplitToBitcode( partitionCount );
+            var objects = new byte[ parts.Length ][ ];
+            var errors  = new Exception[ parts.Length ];
+            int next    = -1;
+
+            string configuration = $"{m_codeGenTriple}|{m_codeGenCpu}|{m_codeGenFunctionSections}|{optimize}|{OptimizationPasses}";
+
+            try
+            {
+                ThreadStart worker = ( ) =>
+                {
+                    int index;
+                    while( ( index = Interlocked.Increment( ref next ) ) < parts.Length )
+                    {
+                        try
+                        {
+                            string key = null;
+
+                            if( cache != null )
+                            {
+                                key = cache.GetKey( parts[ index ].ToArray( ), configuration );
+
+                                if( cache.TryGet( key, out objects[ index ] ) )
+                                {
+                                    continue;
+                                }
+                            }
+
+                            // A context per partition releases each module as soon as its object is done
+                            using( CodeGeneration.IR.CompilationSteps.CompilationTrace.Begin( "LLVM", $"Partition {index}" ) )
+                            using( var context = new Context( ) )
+                            using( var machine = CreateCodeGenerationMachine( context ) )
+                            {
+                                var module = NativeModule.LoadFrom( parts[ index ], context );
+
+                                if( optimize )
+                                {
+                                    OptimizePartition( module, machine );
+                                }
+
+                                using( var buffer = machine.EmitToBuffer( module, CodeGenFileType.ObjectFile ) )
+                                {
+                                    objects[ index ] = buffer.ToArray( );
+                                }
+                            }
+
+                            cache?.Add( key, objects[ index ] );
+                        }
+                        catch( Exception ex )
+                        {
+                            errors[ index ] = ex;
+                        }
+                    }
+                };
+
+                var threads = new Thread[ Math.Max( 1, Math.Min( threadCount, parts.Length ) ) ];
+                for( int i = 0; i < threads.Length; ++i )
+                {
+                    threads[ i ] = new Thread( worker, c_CodeGenerationStackSize ) { Name = $"LLVM code generation {i}" };
+                    threads[ i ].Start( );
+                }
+
+                foreach( var thread in threads )
+                {
+                    thread.Join( );
+                }
+            }
+            finally
+            {
+                foreach( var part in parts )
+                {
+                    part.Dispose( );
+                }
+            }
+
+            var failures = errors.Where( e => e != null ).ToList( );
+            if( failures.Count != 0 )
+            {
+                throw new AggregateException( "LLVM code generation failed", failures );
+            }
+
+            return objects;
+        }
+
+        // Whole program half of the Optimize pipeline, these passes have to see every function at once.
+        // mem2reg goes first so that they work on SSA values, as they do after the function passes
+        // ahead of them in the single module pipeline.
+        private void OptimizeInterprocedural( )
+        {
+            using( var passManager = new PassManager( ) )
+            {
+                TargetMachine.AddAnalysisPasses( passManager );
+                passManager.AddPromoteMemoryToRegisterPass( );
+                AddOptimizationPasses( passManager, IsInterproceduralPass );
+
+                passManager.Run( LlvmModule );
+            }
+        }
+
+        // Function local half of the Optimize pipeline, run on each partition on its own thread
+        private static void OptimizePartition( NativeModule module, TargetMachine machine )
+        {
+            using( var passManager = new PassManager( ) )
+            {
+                machine.AddAnalysisPasses( passManager );
+                AddOptimizationPasses( passManager, name => !IsInterproceduralPass( name ) );
+                passManager.AddVerifierPass( );
+
+                passManager.Run( module );
+            }
+        }
+
+        private TargetMachine CreateCodeGenerationMachine( Context context )
+        {
+            var target = Target.FromTriple( m_codeGenTriple );
+            var machine = target.CreateTargetMachine( context
+                                                    , m_codeGenTriple
+                                                    , m_codeGenCpu
+                                                    , string.Empty   // features
+                                                    , CodeGenOpt.Default
+                                                    , Reloc.PositionIndependent
+                                                    , CodeModel.Small
+                                                    );
+            machine.SetDataSections( true );
+            machine.SetFunctionSections( m_codeGenFunctionSections );
+            return machine;
+        }
+
         // REVIEW: This can be generalized to creating any function by prototype.
         public Function GetPersonalityFunction(string functionName)
         {
@@ -454,7 +689,7 @@ namespace Microsoft.Zelig.LLVM
 
         internal NativeModule LlvmModule { get; }
         
-        internal TargetMachine TargetMachine { get; }
+        internal TargetMachine TargetMachine { get; private set; }
 
         internal DIFile GetOrCreateDIFile( string fn )
         {
@@ -499,6 +734,13 @@ namespace Microsoft.Zelig.LLVM
         private readonly Dictionary<string, DINamespace> m_DiNamespaces = new Dictionary<string, DINamespace>( );
         private readonly List<GlobalValue> m_usedGlobals = new List<GlobalValue>();
 
+        private string m_codeGenTriple;
+        private string m_codeGenCpu;
+        private bool   m_codeGenFunctionSections;
+
+        // LLVM code generation recurses deeply on large functions, give the workers more than the default 1MB
+        private const int c_CodeGenerationStackSize = 16 * 1024 * 1024;
+
         static int GetMonotonicUniqueId( )
         {
             return ( int )System.Threading.Interlocked.Increment( ref globalsCounter );
@@ -115,7 +115,7 @@ namespace Microsoft.Zelig.FrontEnd
         const string DefaultLlcArgs_target_df  = DefaultLlcArgs_target_m3;
         const string DefaultLlcArgs_reloc      = "-relocation-model=pic";
         //--//
-        const string DefaultOptExeArgs_common  = "-verify-debug-info -verify-dom-info -verify-each -verify-loop-info -verify-regalloc -verify-region-info -aa-eval -indvars -gvn -globaldce -adce -dce -tailcallopt -scalarrepl -mem2reg -ipconstprop -deadargelim -sccp -dce -ipsccp -dce -constmerge -scev-aa -targetlibinfo -irce -dse -dce -argpromotion -mem2reg -adce -mem2reg -globaldce -die -dce -dse";
+        const string DefaultOptExeArgs_common  = "-verify-debug-info -verify-dom-info -verify-each -verify-loop-info -verify-regalloc -verify-region-info -aa-eval " + _Module.OptimizationPasses;
         const string DefaultOptArgs_target_m0  = "-march=thumb -mcpu=cortex-m0";
         const string DefaultOptArgs_target_m3  = "-march=thumb -mcpu=cortex-m3";
         //const string DefaultOptArgs_target_m4 = "-march=thumb -mcpu=cortex-m4"; https://github.com/NETMF/llilum/issues/136
@@ -123,6 +123,11 @@ namespace Microsoft.Zelig.FrontEnd
         const string DefaultOptArgs_target_m7  = "-march=thumb -mcpu=cortex-m7";
         const string DefaultOptArgs_target_x86 = "-march=x86 -mcpu=x86-64";
         const string DefaultOptArgs_target_df  = DefaultOptArgs_target_m3;
+        const string DefaultTriple_target_m0   = "thumbv6m-none-eabi";
+        const string DefaultTriple_target_m3   = "thumbv7m-none-eabi";
+        const string DefaultTriple_target_x86  = "x86_64-pc-windows-msvc";
+        // Relocatable link of the partitions of a split code generation back into a single object
+        const string DefaultPartitionLinker    = "arm-none-eabi-ld";
 
         const string LlvmRegSoftwareBinPath    = @"SOFTWARE\LLVM\3.8.0";
 
@@ -151,6 +156,7 @@ namespace Microsoft.Zelig.FrontEnd
         private bool                                m_fDumpCFG;
         private bool                                m_fDumpLLVMIR;
         private bool                                m_fSkipLlvmOptExe;
+        private bool                                m_fUseLlvmTools;
         private bool                                m_fGenerateObj;
         private bool                                m_fDumpLLVMIR_TextRepresentation;
         private bool                                m_fDumpASM;
@@ -168,6 +174,12 @@ namespace Microsoft.Zelig.FrontEnd
         private string                              m_LlvmBinPath;
         private string                              m_LlvmOptArgs;
         private string                              m_LlvmLlcArgs;
+        private uint                                m_LlvmCodeGenPartitions;
+        private string                              m_partitionLinker;
+        private string                              m_LlvmObjectCacheDir;
+        private uint                                m_LlvmObjectCacheSize;
+        private string                              m_compilationTraceFile;
+        private uint                                m_compilationTraceThreshold;
 
         private HashSet< string >                   m_phasesForDiagnosticDumps;
         private List< string >                      m_references;
@@ -226,6 +238,7 @@ namespace Microsoft.Zelig.FrontEnd
 
             m_nativeIntSize             = 32;
             m_phaseExecutionCounter     = 0;
+            m_compilationTraceThreshold = IR.CompilationSteps.CompilationTrace.c_DefaultMinimumDetailMicroSeconds;
 
             m_dumpRawImage              = new List<RawImage>( );
             
@@ -953,6 +966,10 @@ namespace Microsoft.Zelig.FrontEnd
                     {
                         m_fSkipLlvmOptExe = true;
                     }
+                    else if( IsMatch( option, "UseLlvmTools" ) )
+                    {
+                        m_fUseLlvmTools = true;
+                    }
                     else if( IsMatch( option, "GenerateObj" ) )
                     {
                         m_fDumpLLVMIR = true;
@@ -1153,6 +1170,60 @@ namespace Microsoft.Zelig.FrontEnd
 
                         m_LlvmLlcArgs = llcArgs.Trim( '"' );
                     }
+                    else if( IsMatch( option, "LlvmCodeGenPartitions" ) )
+                    {
+                        if( !GetArgument( arg, args, ref i, out m_LlvmCodeGenPartitions, false ) )
+                        {
+                            return false;
+                        }
+                    }
+                    else if( IsMatch( option, "PartitionLinker" ) )
+                    {
+                        string linker;
+
+                        if( !GetArgument( arg, args, ref i, out linker, true ) )
+                        {
+                            return false;
+                        }
+
+                        m_partitionLinker = linker;
+                    }
+                    else if( IsMatch( option, "LlvmObjectCache" ) )
+                    {
+                        string dir;
+
+                        if( !GetArgument( arg, args, ref i, out dir, true ) )
+                        {
+                            return false;
+                        }
+
+                        m_LlvmObjectCacheDir = dir;
+                    }
+                    else if( IsMatch( option, "LlvmObjectCacheSize" ) )
+                    {
+                        if( !GetArgument( arg, args, ref i, out m_LlvmObjectCacheSize, false ) )
+                        {
+                            return false;
+                        }
+                    }
+                    else if( IsMatch( option, "CompilationTrace" ) )
+                    {
+                        string file;
+
+                        if( !GetArgument( arg, args, ref i, out file, true ) )
+                        {
+                            return false;
+                        }
+
+                        m_compilationTraceFile = file;
+                    }
+                    else if( IsMatch( option, "CompilationTraceThreshold" ) )
+                    {
+                        if( !GetArgument( arg, args, ref i, out m_compilationTraceThreshold, false ) )
+                        {
+                            return false;
+                        }
+                    }
                     else if( IsMatch( option, "CompilationSetup" ) )
                     {
                         string compilationSetup;
@@ -1490,7 +1561,7 @@ namespace Microsoft.Zelig.FrontEnd
         private bool ValidateLlvmToolsPath( )
         {
             // if the tools aren't needed, based on options, no point verifying anything else
-            if(m_fSkipLlvmOptExe && !m_fGenerateObj)
+            if(!UseLlvmTools || (m_fSkipLlvmOptExe && !m_fGenerateObj))
                 return true;
 
             // cover the expected production scenario first
@@ -1657,6 +1728,11 @@ namespace Microsoft.Zelig.FrontEnd
 
             string filePrefix = Path.Combine( m_outputDir, m_outputName );
 
+            if( m_compilationTraceFile != null )
+            {
+                IR.CompilationSteps.CompilationTrace.Enable( ( int )m_compilationTraceThreshold );
+            }
+
             /*FileStream fs = new FileStream( filePrefix + "_cout.txt", FileMode.Create );
             StreamWriter sw = new StreamWriter( fs );
             Console.SetOut( sw );*/
@@ -1748,9 +1824,12 @@ namespace Microsoft.Zelig.FrontEnd
 
                 Console.WriteLine( "{0}: ConvertToIR", GetTime( ) );
 
-                foreach( Normalized.MetaDataAssembly asml in m_resolver.NormalizedAssemblies )
+                using( IR.CompilationSteps.CompilationTrace.Begin( "FrontEnd", "ConvertToIR" ) )
                 {
-                    m_typeSystem.ImportAssembly( asml );
+                    foreach( Normalized.MetaDataAssembly asml in m_resolver.NormalizedAssemblies )
+                    {
+                        m_typeSystem.ImportAssembly( asml );
+                    }
                 }
 
                 Console.WriteLine( "{0}: Done", GetTime( ) );
@@ -1758,7 +1837,10 @@ namespace Microsoft.Zelig.FrontEnd
                 //--//
 
                 Console.WriteLine( "{0}: ResolveAll", GetTime( ) );
-                m_typeSystem.ResolveAll( );
+                using( IR.CompilationSteps.CompilationTrace.Begin( "FrontEnd", "ResolveAll" ) )
+                {
+                    m_typeSystem.ResolveAll( );
+                }
                 Console.WriteLine( "{0}: Done", GetTime( ) );
                 
                 //--//
@@ -2058,7 +2140,62 @@ namespace Microsoft.Zelig.FrontEnd
                 m_typeSystem.Module.DumpToFile( filePrefix + ".bc", LLVM.OutputFormat.BitCodeBinary );
             }
 
-            if( m_fDumpLLVMIR && !m_fSkipLlvmOptExe )
+            if( m_fDumpLLVMIR && !UseLlvmTools )
+            {
+                //
+                // Optimize and generate the object file in process through LibLLVM, on the module
+                // already in memory, rather than writing and re-parsing it for opt.exe and llc.exe
+                //
+                string triple;
+                string cpu;
+
+                GetTargetForArchitecture( out triple, out cpu );
+
+                if(m_architecture == c_x86_64)
+                {
+                    m_typeSystem.Module.SetCodeGenerationTarget( triple, cpu, true, 3 );
+                }
+                else
+                {
+                    m_typeSystem.Module.SetCodeGenerationTarget( triple, cpu, false, 0 );
+                }
+
+                if( !m_fSkipLlvmOptExe && !IsPartitionedCodeGen )
+                {
+                    Console.WriteLine( "Optimizing LLVM Bitcode representation" );
+                    m_typeSystem.Module.Optimize( );
+
+                    if( m_fDumpLLVMIR_TextRepresentation )
+                    {
+                        m_typeSystem.Module.DumpToFile( filePrefix + "_opt.ll", LLVM.OutputFormat.BitCodeSource );
+                    }
+                }
+
+                if( IsPartitionedCodeGen )
+                {
+                    var objFile = filePrefix + "_opt.o";
+
+                    GeneratePartitionedObject( objFile, filePrefix );
+
+                    if(m_architecture != c_x86_64)
+                    {
+                        DumpElfInformation(objFile, filePrefix);
+                    }
+                }
+                else if( m_fGenerateObj )
+                {
+                    var objFile = filePrefix + "_opt.o";
+
+                    Console.WriteLine( "Compiling LLVM Bitcode" );
+                    File.WriteAllBytes( objFile, m_typeSystem.Module.EmitObject( ) );
+
+                    if(m_architecture != c_x86_64)
+                    {
+                        DumpElfInformation(objFile, filePrefix);
+                    }
+                }
+            }
+            else if( m_fDumpLLVMIR && !m_fSkipLlvmOptExe )
             {
                 var optSwitches = BuildOptArchitectureArgs( ); 
 
@@ -2084,7 +2221,7 @@ namespace Microsoft.Zelig.FrontEnd
                 }
             }
 
-            if( m_fGenerateObj )
+            if( m_fGenerateObj && UseLlvmTools )
             {
                 var objFile     = filePrefix + "_opt.o";
                 var llcSwitches = BuildLlcArchitectureArgs(); 
@@ -2141,6 +2278,13 @@ namespace Microsoft.Zelig.FrontEnd
                 }
             }
 
+            if( IR.CompilationSteps.CompilationTrace.IsEnabled )
+            {
+                Console.WriteLine( "{0}: Saving compilation trace to {1}", GetTime( ), m_compilationTraceFile );
+
+                IR.CompilationSteps.CompilationTrace.Save( m_compilationTraceFile );
+            }
+
             Console.WriteLine( "{0}: Done", GetTime( ) );
         }
 
@@ -2161,6 +2305,106 @@ namespace Microsoft.Zelig.FrontEnd
             return ConcatArgs( DefaultOptExeArgs_common, GetOptSwitchesForTargetArchitecture() ); 
         }
 
+        private void GetTargetForArchitecture( out string triple, out string cpu )
+        {
+            // Same targets as the llc.exe switches above
+            switch(m_architecture)
+            {
+                case c_CortexM0:
+                    triple = DefaultTriple_target_m0;
+                    cpu    = c_CortexM0;
+                    break;
+                case c_CortexM7:
+                    triple = DefaultTriple_target_m3;
+                    cpu    = c_CortexM7;
+                    break;
+                case c_x86_64:
+                    triple = DefaultTriple_target_x86;
+                    cpu    = c_x86_64;
+                    break;
+                default:
+                    // Cortex-M4 is compiled as Cortex-M3, see https://github.com/NETMF/llilum/issues/136
+                    triple = DefaultTriple_target_m3;
+                    cpu    = c_CortexM3;
+                    break;
+            }
+        }
+
+        //
+        // opt.exe and llc.exe are only used when asked for, or when switches for them are given explicitly
+        //
+        private bool UseLlvmTools => m_fUseLlvmTools || m_LlvmOptArgs != null || m_LlvmLlcArgs != null;
+
+        //
+        // The COFF output for x86 has no relocatable link step to put partitions back together, so it always
+        // uses a single partition. The object cache goes through the partitioned path even for a single one.
+        //
+        private uint CodeGenPartitionCount => m_architecture == c_x86_64 ? 1 : Math.Max( 1, m_LlvmCodeGenPartitions );
+
+        private bool IsPartitionedCodeGen => m_fGenerateObj && ( CodeGenPartitionCount > 1 || m_LlvmObjectCacheDir != null );
+
+        //
+        // Optimizes and compiles the image split into m_LlvmCodeGenPartitions modules, on as many threads as
+        // -MaxProcs allows, then links the partition objects back into the single object the board makefiles
+        // expect. The partitioning only depends on the partition count, so the result is the same whatever
+        // the number of threads.
+        //
+        // -LlvmObjectCacheSize is in megabytes, 0 keeps the default bound
+        private LLVM.ObjectCache CreateObjectCache( )
+        {
+            if( m_LlvmObjectCacheSize == 0 )
+            {
+                return new LLVM.ObjectCache( m_LlvmObjectCacheDir );
+            }
+
+            return new LLVM.ObjectCache( m_LlvmObjectCacheDir, (long)m_LlvmObjectCacheSize * 1024 * 1024 );
+        }
+
+        private void GeneratePartitionedObject( string objFile, string filePrefix )
+        {
+            int              threads = Math.Min( Environment.ProcessorCount, IR.CompilationSteps.ParallelTransformationsHandler.MaximumNumberOfProcessorsToUse );
+            LLVM.ObjectCache cache   = m_LlvmObjectCacheDir != null ? CreateObjectCache( ) : null;
+
+            Console.WriteLine( "Compiling LLVM Bitcode in {0} partitions on {1} threads", CodeGenPartitionCount, threads );
+
+            var objects = m_typeSystem.Module.EmitObjects( CodeGenPartitionCount, threads, !m_fSkipLlvmOptExe, cache );
+
+            if( cache != null )
+            {
+                Console.WriteLine( "LLVM object cache: {0} reused, {1} generated", cache.Hits, cache.Misses );
+
+                cache.Trim( );
+            }
+
+            if( objects.Length == 1 )
+            {
+                File.WriteAllBytes( objFile, objects[ 0 ] );
+                return;
+            }
+
+            var partFiles = new List< string >( );
+
+            for(int i = 0; i < objects.Length; ++i)
+            {
+                var partFile = string.Format( "{0}_opt.{1}.o", filePrefix, i );
+
+                File.WriteAllBytes( partFile, objects[ i ] );
+                partFiles.Add( "\"" + partFile + "\"" );
+            }
+
+            var args = string.Format( "-r -o \"{0}\" {1}", objFile, ConcatArgs( partFiles.ToArray( ) ) );
+
+            if( ShellExec( m_partitionLinker ?? DefaultPartitionLinker, args ) != 0 )
+            {
+                throw new InvalidOperationException( "Failed to link the code generation partitions into " + objFile );
+            }
+
+            foreach(var partFile in partFiles)
+            {
+                File.Delete( partFile.Trim( '"' ) );
+            }
+        }
+
         private string GetOptSwitchesForTargetArchitecture( )
         {
             switch(m_architecture)
@@ -520,6 +520,21 @@ namespace Microsoft.Zelig.CodeGeneration.IR
             }
         }
 
+        //
+        // Size estimate for scheduling, does not update any of the cached flow information.
+        //
+        public int CountOperators()
+        {
+            int count = 0;
+
+            foreach(BasicBlock bb in m_basicBlocks)
+            {
+                count += bb.Operators.Length;
+            }
+
+            return count;
+        }
+
         //--//
 
         public BasicBlock FirstBasicBlock
@@ -1,4 +1,11 @@
 #include <llvm/IR/Module.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Bitcode/ReaderWriter.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/Utils/Cloning.h>
 #include "ModuleBindings.h"
 #include "IRBindings.h"
 
@@ -6,6 +13,62 @@ using namespace llvm;
 
 DEFINE_SIMPLE_CONVERSION_FUNCTIONS( NamedMDNode, LLVMNamedMDNodeRef )
 
+// Anything a partition may reference in another partition has to be visible to the linker,
+// this mirrors what llvm::SplitModule does. Hidden visibility keeps the symbols out of the
+// final image's dynamic symbol table.
+static void ExternalizeForSplit( GlobalValue& global )
+{
+    if( global.hasLocalLinkage( ) )
+    {
+        global.setLinkage( GlobalValue::ExternalLinkage );
+        global.setVisibility( GlobalValue::HiddenVisibility );
+    }
+
+    // unnamed values can't be referenced across modules, LLVM uniques the name as needed
+    if( !global.hasName( ) )
+        global.setName( "__llilum_split" );
+}
+
+// Partition of a function: the low 32 bits of an MD5 of its name, as llvm::SplitModule does.
+static unsigned PartitionOfName( StringRef name, unsigned partitionCount )
+{
+    MD5 hash;
+    MD5::MD5Result result;
+
+    hash.update( name );
+    hash.final( result );
+
+    uint32_t value = result[ 0 ] | ( result[ 1 ] << 8 ) | ( result[ 2 ] << 16 ) | ( (uint32_t)result[ 3 ] << 24 );
+    return value % partitionCount;
+}
+
+// Each function goes to the partition picked by an MD5 of its name, like llvm::SplitModule, so
+// a function stays in the same partition when others are added, removed or resized and only
+// the partitions that really changed miss in the object cache. Global variables stay in
+// partition 0 in their original order, so section contents are laid out as they are for a
+// single module, and aliases follow their aliasee. The result only depends on the names of
+// the functions and partitionCount.
+static DenseMap< GlobalValue const*, unsigned > AssignPartitions( Module& module, unsigned partitionCount )
+{
+    DenseMap< GlobalValue const*, unsigned > partitionOf;
+
+    for( auto& function : module )
+    {
+        if( function.isDeclaration( ) )
+            continue;
+
+        partitionOf[ &function ] = PartitionOfName( function.getName( ), partitionCount );
+    }
+
+    for( auto& alias : module.aliases( ) )
+    {
+        auto it = partitionOf.find( alias.getBaseObject( ) );
+        partitionOf[ &alias ] = it == partitionOf.end( ) ? 0 : it->second;
+    }
+
+    return partitionOf;
+}
+
 extern "C"
 {
     void LLVMAddModuleFlag( LLVMModuleRef M
@@ -62,4 +125,41 @@ extern "C"
         auto pMDNode = unwrap( namedMDNode );
         return wrap( pMDNode->getParent( ) );
     }
+
+    void LLVMSplitModuleToBitcode( LLVMModuleRef module, unsigned partitionCount, LLVMMemoryBufferRef* outParts )
+    {
+        std::unique_ptr< Module > pSource( CloneModule( unwrap( module ) ) );
+
+        // a single partition has nothing to reference in other modules, so local symbols can stay local
+        if( partitionCount > 1 )
+        {
+            for( auto& function : pSource->functions( ) )
+                ExternalizeForSplit( function );
+
+            for( auto& global : pSource->globals( ) )
+                ExternalizeForSplit( global );
+
+            for( auto& alias : pSource->aliases( ) )
+                ExternalizeForSplit( alias );
+        }
+
+        auto partitionOf = AssignPartitions( *pSource, partitionCount );
+
+        for( unsigned i = 0; i < partitionCount; ++i )
+        {
+            ValueToValueMapTy valueMap;
+            std::unique_ptr< Module > pPart( CloneModule( pSource.get( ), valueMap, [ & ]( GlobalValue const* pGlobal )
+            {
+                auto it = partitionOf.find( pGlobal );
+                return ( it == partitionOf.end( ) ? 0 : it->second ) == i;
+            } ) );
+
+            // serialized here, on the calling thread, as all partitions still share the source LLVMContext
+            SmallString< 0 > bitcode;
+            raw_svector_ostream stream( bitcode );
+            WriteBitcodeToFile( pPart.get( ), stream );
+
+            outParts[ i ] = wrap( MemoryBuffer::getMemBufferCopy( bitcode.str( ), pPart->getModuleIdentifier( ) ).release( ) );
+        }
+    }
 }
\ No newline at end of file
@@ -37,6 +37,11 @@ extern "C" {
     /*MDNode*/ LLVMMetadataRef LLVMNamedMDNodeGetOperand( LLVMNamedMDNodeRef namedMDNode, unsigned index );
     LLVMModuleRef LLVMNamedMDNodeGetParentModule( LLVMNamedMDNodeRef namedMDNode );
 
+    // Splits a copy of the module into partitionCount modules for parallel code generation and
+    // writes each one as bitcode into outParts[ 0 .. partitionCount - 1 ], so that it can be loaded
+    // into a separate LLVMContext on another thread. The source module is left untouched.
+    void LLVMSplitModuleToBitcode( LLVMModuleRef module, unsigned partitionCount, LLVMMemoryBufferRef* outParts );
+
 #ifdef __cplusplus
 }
 #endif
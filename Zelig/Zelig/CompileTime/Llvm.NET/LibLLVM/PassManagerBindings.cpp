@@ -0,0 +1,24 @@
+#include "PassManagerBindings.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/PassInfo.h"
+#include "llvm/PassRegistry.h"
+
+using namespace llvm;
+
+extern "C"
+{
+    // Adds the pass opt.exe runs for the -<name> switch, so that a pipeline can be given as the
+    // same list of switches in and out of process. Returns false if the global registry has no
+    // such pass, either because the switch is an option rather than a pass or because the library
+    // the pass lives in was not initialized.
+    LLVMBool LLVMAddPassByName( LLVMPassManagerRef PM, const char* name )
+    {
+        const PassInfo* info = PassRegistry::getPassRegistry( )->getPassInfo( name );
+
+        if( info == nullptr || info->getNormalCtor( ) == nullptr )
+            return false;
+
+        unwrap( PM )->add( info->createPass( ) );
+        return true;
+    }
+}
@@ -0,0 +1,16 @@
+#ifndef _PASS_MANAGER_BINDINGS_H_
+#define _PASS_MANAGER_BINDINGS_H_
+
+#include "llvm-c/Core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    LLVMBool LLVMAddPassByName( LLVMPassManagerRef PM, const char* name );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include "TargetMachineBindings.h"
+#include "llvm/Target/TargetMachine.h"
+
+using namespace llvm;
+
+// TargetMachineC.cpp keeps its unwrap() private, so this matches it locally
+static TargetMachine* unwrap( LLVMTargetMachineRef P )
+{
+    return reinterpret_cast< TargetMachine* >( P );
+}
+
+extern "C"
+{
+    // The LLVM-C API has no access to TargetOptions, so these cover the
+    // llc -function-sections and -data-sections switches needed to emit
+    // objects that the linker can garbage collect per function/global.
+    void LLVMSetTargetMachineFunctionSections( LLVMTargetMachineRef T, LLVMBool value )
+    {
+        unwrap( T )->Options.FunctionSections = value != 0;
+    }
+
+    void LLVMSetTargetMachineDataSections( LLVMTargetMachineRef T, LLVMBool value )
+    {
+        unwrap( T )->Options.DataSections = value != 0;
+    }
+}
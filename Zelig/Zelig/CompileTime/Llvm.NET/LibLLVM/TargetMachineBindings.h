@@ -0,0 +1,18 @@
+#ifndef _TARGET_MACHINE_BINDINGS_H_
+#define _TARGET_MACHINE_BINDINGS_H_
+
+#include "llvm-c/Core.h"
+#include "llvm-c/TargetMachine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    void LLVMSetTargetMachineFunctionSections( LLVMTargetMachineRef T, LLVMBool value );
+    void LLVMSetTargetMachineDataSections( LLVMTargetMachineRef T, LLVMBool value );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
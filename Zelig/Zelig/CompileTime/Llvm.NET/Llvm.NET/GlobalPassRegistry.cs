@@ -82,6 +82,22 @@ namespace Llvm.NET
             NativeMethods.InitializeTarget( PassRegistryHandle.Value );
         }
 
+        // Passes can only be looked up by name once their libraries have registered them
+        internal static void EnsureInitialized( )
+        {
+            lock( InitializeLock )
+            {
+                if( !IsInitialized )
+                {
+                    InitializeAll( );
+                    IsInitialized = true;
+                }
+            }
+        }
+
+        private static readonly object InitializeLock = new object( );
+        private static bool IsInitialized;
+
         private static Lazy<LLVMPassRegistryRef> PassRegistryHandle
             = new Lazy<LLVMPassRegistryRef>( ( ) => NativeMethods.GetGlobalPassRegistry( ), LazyThreadSafetyMode.ExecutionAndPublication );
     }
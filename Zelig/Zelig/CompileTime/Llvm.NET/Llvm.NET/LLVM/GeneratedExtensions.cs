@@ -758,5 +758,17 @@ namespace Llvm.NET.Native
 
         [DllImport(libraryPath, EntryPoint = "LLVMFunctionHasPersonalityFunction", CallingConvention = System.Runtime.InteropServices.CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true)]
         internal static extern LLVMBool FunctionHasPersonalityFunction( LLVMValueRef function );
+
+        [DllImport(libraryPath, EntryPoint = "LLVMSetTargetMachineFunctionSections", CallingConvention = System.Runtime.InteropServices.CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true)]
+        internal static extern void SetTargetMachineFunctionSections( LLVMTargetMachineRef T, LLVMBool value );
+
+        [DllImport(libraryPath, EntryPoint = "LLVMSetTargetMachineDataSections", CallingConvention = System.Runtime.InteropServices.CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true)]
+        internal static extern void SetTargetMachineDataSections( LLVMTargetMachineRef T, LLVMBool value );
+
+        [DllImport(libraryPath, EntryPoint = "LLVMSplitModuleToBitcode", CallingConvention = System.Runtime.InteropServices.CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true)]
+        internal static extern void SplitModuleToBitcode( LLVMModuleRef module, uint partitionCount, [Out] LLVMMemoryBufferRef[ ] outParts );
+
+        [DllImport(libraryPath, EntryPoint = "LLVMAddPassByName", CallingConvention = System.Runtime.InteropServices.CallingConvention.Cdecl, BestFitMapping = false, ThrowOnUnmappableChar = true)]
+        internal static extern LLVMBool AddPassByName( LLVMPassManagerRef PM, [MarshalAs(UnmanagedType.LPStr)] string name );
     }
 }
@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Runtime.InteropServices;
 using Llvm.NET.Native;
 
 namespace Llvm.NET
@@ -18,6 +19,11 @@ namespace Llvm.NET
             throw new InternalCodeGeneratorException( NativeMethods.MarshalMsg( msg ) );
         }
 
+        internal MemoryBuffer( LLVMMemoryBufferRef bufferHandle )
+        {
+            BufferHandle_ = bufferHandle;
+        }
+
         /// <summary>Size of the buffer</summary>
         public int Size
         {
@@ -30,6 +36,16 @@ namespace Llvm.NET
             }
         }
 
+        /// <summary>Copies the contents of the buffer into a managed array</summary>
+        public byte[ ] ToArray( )
+        {
+            var retVal = new byte[ Size ];
+            if( retVal.Length > 0 )
+                Marshal.Copy( NativeMethods.GetBufferStart( BufferHandle ), retVal, 0, retVal.Length );
+
+            return retVal;
+        }
+
         public void Dispose( )
         {
             if( BufferHandle.Pointer != IntPtr.Zero )
@@ -296,6 +296,32 @@ namespace Llvm.NET
             }
         }
 
+        /// <summary>Splits a copy of this module into modules that can be compiled independently</summary>
+        /// <param name="partitionCount">Number of partitions to create</param>
+        /// <returns>Bit-code for each partition, in partition order</returns>
+        /// <remarks>
+        /// Function definitions are balanced across the partitions by size, global variables all stay
+        /// in the first partition. Symbols with local linkage are made hidden so that partitions can
+        /// refer to each other once linked. The partitioning only depends on the module contents and
+        /// <paramref name="partitionCount"/>. Each partition is returned as bit-code, rather than as a
+        /// module, so that it can be loaded with <see cref="LoadFrom(MemoryBuffer, Context)"/> into a
+        /// separate <see cref="Context"/> on another thread.
+        /// </remarks>
+        public MemoryBuffer[ ] SplitToBitcode( uint partitionCount )
+        {
+            if( partitionCount == 0 )
+                throw new ArgumentOutOfRangeException( nameof( partitionCount ) );
+
+            var partHandles = new LLVMMemoryBufferRef[ partitionCount ];
+            NativeMethods.SplitModuleToBitcode( ModuleHandle, partitionCount, partHandles );
+
+            var retVal = new MemoryBuffer[ partitionCount ];
+            for( int i = 0; i < retVal.Length; ++i )
+                retVal[ i ] = new MemoryBuffer( partHandles[ i ] );
+
+            return retVal;
+        }
+
         /// <summary>Verifies a bit-code module</summary>
         /// <param name="errmsg">Error messages describing any issues found in the bit-code</param>
         /// <returns>true if the verification succeeded and false if not.</returns>
@@ -598,15 +624,31 @@ namespace Llvm.NET
 
             using( var buffer = new MemoryBuffer( path ) )
             {
-                LLVMModuleRef modRef;
-                IntPtr errMsgPtr;
-                if( NativeMethods.ParseBitcodeInContext( context.ContextHandle, buffer.BufferHandle, out modRef, out errMsgPtr ).Failed )
-                {
-                    var errMsg = NativeMethods.MarshalMsg( errMsgPtr );
-                    throw new InternalCodeGeneratorException( errMsg );
-                }
-                return context.GetModuleFor( modRef );
+                return LoadFrom( buffer, context );
+            }
+        }
+
+        /// <summary>Load a bit-code module from a memory buffer</summary>
+        /// <param name="buffer">Buffer holding the bit-code to load</param>
+        /// <param name="context">Context to use for creating the module</param>
+        /// <returns>Loaded <see cref="NativeModule"/></returns>
+        /// <remarks>The module does not keep a reference to <paramref name="buffer"/>, which can be disposed once this returns</remarks>
+        public static NativeModule LoadFrom( MemoryBuffer buffer, Context context )
+        {
+            if( buffer == null )
+                throw new ArgumentNullException( nameof( buffer ) );
+
+            if( context == null )
+                throw new ArgumentNullException( nameof( context ) );
+
+            LLVMModuleRef modRef;
+            IntPtr errMsgPtr;
+            if( NativeMethods.ParseBitcodeInContext( context.ContextHandle, buffer.BufferHandle, out modRef, out errMsgPtr ).Failed )
+            {
+                var errMsg = NativeMethods.MarshalMsg( errMsgPtr );
+                throw new InternalCodeGeneratorException( errMsg );
             }
+            return context.GetModuleFor( modRef );
         }
 
         internal LLVMModuleRef ModuleHandle { get; private set; }
@@ -0,0 +1,87 @@
+﻿using System;
+using Llvm.NET.Native;
+
+namespace Llvm.NET
+{
+    /// <summary>Provides a wrapper around an LLVM module level Pass Manager</summary>
+    /// <remarks>
+    /// Passes run in the order they are added, either explicitly through the Add methods or by
+    /// populating the pass manager from a <see cref="PassManagerBuilder"/>. This allows running
+    /// the optimizations in process instead of writing the module out for opt.exe.
+    /// </remarks>
+    public sealed class PassManager
+        : IDisposable
+    {
+        public PassManager( )
+        {
+            PassManagerHandle = NativeMethods.CreatePassManager( );
+        }
+
+        /// <summary>Runs all the passes in this manager on a module</summary>
+        /// <param name="module">Module to transform</param>
+        /// <returns><see langword="true"/> if any of the passes modified the module</returns>
+        public bool Run( NativeModule module )
+        {
+            if( module == null )
+                throw new ArgumentNullException( nameof( module ) );
+
+            return NativeMethods.RunPassManager( PassManagerHandle, module.ModuleHandle );
+        }
+
+        public void AddBasicAliasAnalysisPass( ) => NativeMethods.AddBasicAliasAnalysisPass( PassManagerHandle );
+
+        public void AddTypeBasedAliasAnalysisPass( ) => NativeMethods.AddTypeBasedAliasAnalysisPass( PassManagerHandle );
+
+        public void AddIndVarSimplifyPass( ) => NativeMethods.AddIndVarSimplifyPass( PassManagerHandle );
+
+        public void AddGVNPass( ) => NativeMethods.AddGVNPass( PassManagerHandle );
+
+        public void AddGlobalDCEPass( ) => NativeMethods.AddGlobalDCEPass( PassManagerHandle );
+
+        public void AddAggressiveDCEPass( ) => NativeMethods.AddAggressiveDCEPass( PassManagerHandle );
+
+        public void AddScalarReplAggregatesPass( ) => NativeMethods.AddScalarReplAggregatesPass( PassManagerHandle );
+
+        public void AddPromoteMemoryToRegisterPass( ) => NativeMethods.AddPromoteMemoryToRegisterPass( PassManagerHandle );
+
+        public void AddIPConstantPropagationPass( ) => NativeMethods.AddIPConstantPropagationPass( PassManagerHandle );
+
+        public void AddDeadArgEliminationPass( ) => NativeMethods.AddDeadArgEliminationPass( PassManagerHandle );
+
+        public void AddSCCPPass( ) => NativeMethods.AddSCCPPass( PassManagerHandle );
+
+        public void AddIPSCCPPass( ) => NativeMethods.AddIPSCCPPass( PassManagerHandle );
+
+        public void AddConstantMergePass( ) => NativeMethods.AddConstantMergePass( PassManagerHandle );
+
+        public void AddDeadStoreEliminationPass( ) => NativeMethods.AddDeadStoreEliminationPass( PassManagerHandle );
+
+        public void AddArgumentPromotionPass( ) => NativeMethods.AddArgumentPromotionPass( PassManagerHandle );
+
+        public void AddVerifierPass( ) => NativeMethods.AddVerifierPass( PassManagerHandle );
+
+        /// <summary>Adds the pass opt.exe runs for a switch, e.g. "gvn" for -gvn</summary>
+        /// <param name="name">Name of the pass, without the leading '-'</param>
+        /// <returns><see langword="false"/> if there is no such pass, e.g. because the switch sets an option instead</returns>
+        public bool AddPass( string name )
+        {
+            if( string.IsNullOrEmpty( name ) )
+                throw new ArgumentException( "Pass name cannot be empty", nameof( name ) );
+
+            GlobalPassRegistry.EnsureInitialized( );
+
+            return NativeMethods.AddPassByName( PassManagerHandle, name );
+        }
+
+        public void Dispose( )
+        {
+            if( PassManagerHandle.Pointer != IntPtr.Zero )
+            {
+                NativeMethods.DisposePassManager( PassManagerHandle );
+                PassManagerHandle = default( LLVMPassManagerRef );
+            }
+        }
+
+        internal LLVMPassManagerRef PassManagerHandle { get; private set; }
+    }
+}
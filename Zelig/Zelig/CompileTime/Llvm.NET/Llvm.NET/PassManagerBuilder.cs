@@ -38,24 +38,30 @@ namespace Llvm.NET
             NativeMethods.PassManagerBuilderSetDisableSimplifyLibCalls( PassManagerBuilderHandle, value );
         }
 
-        //public void PopulateFunctionPassManager( PassManager passManager )
-        //{
-        //    LLVMNative.PassManagerBuilderPopulateFunctionPassManager( PassManagerBuilderHandle, passManager.PassManagerHandle );
-        //}
+        public void UseInlinerWithThreshold( uint threshold )
+        {
+            NativeMethods.PassManagerBuilderUseInlinerWithThreshold( PassManagerBuilderHandle, threshold );
+        }
+
+        public void PopulateModulePassManager( PassManager passManager )
+        {
+            if( passManager == null )
+                throw new ArgumentNullException( nameof( passManager ) );
 
-        //public void PopulateModulePassManager( PassManager passManager )
-        //{
-        //    LLVMNative.PassManagerBuilderPopulateModulePassManager( PassManagerBuilderHandle, passManager.PassManagerHandle );
-        //}
+            NativeMethods.PassManagerBuilderPopulateModulePassManager( PassManagerBuilderHandle, passManager.PassManagerHandle );
+        }
+
+        public void PopulateLTOPassManager( PassManager passManager, bool internalize, bool runInliner )
+        {
+            if( passManager == null )
+                throw new ArgumentNullException( nameof( passManager ) );
 
-        //public void PopulateLTOPassManager( PassManager passManager, bool internalize, bool runInliner )
-        //{
-        //    LLVMNative.PassManagerBuilderPopulateLTOPassManager( PassManagerBuilderHandle
-        //                                                       , passManager.PassManagerHandle
-        //                                                       , internalize
-        //                                                       , runInliner
-        //                                                       );
-        //}
+            NativeMethods.PassManagerBuilderPopulateLTOPassManager( PassManagerBuilderHandle
+                                                                  , passManager.PassManagerHandle
+                                                                  , internalize
+                                                                  , runInliner
+                                                                  );
+        }
 
         public void Dispose( )
         {
@@ -30,6 +30,17 @@ namespace Llvm.NET
     /// <summary>Provides support for various LLVM static state initialization and manipulation</summary>
     public static class StaticState
     {
+        /// <summary>Version string of the LLVM libraries in the loaded LibLLVM</summary>
+        public static string LlvmVersion
+        {
+            get
+            {
+                LLVMVersionInfo versionInfo = new LLVMVersionInfo( );
+                NativeMethods.GetVersionInfo( ref versionInfo );
+                return versionInfo.ToString( ) ?? ( ( Version )versionInfo ).ToString( );
+            }
+        }
+
         public static void ParseCommandLineOptions( string[ ] args, string overview )
         {
             if( args == null )
@@ -59,6 +59,51 @@ namespace Llvm.NET
             }
         }
 
+        /// <summary>Generate code for the target machine from a module into memory</summary>
+        /// <param name="module"><see cref="NativeModule"/> to generate the code from</param>
+        /// <param name="fileType">Type of file to emit</param>
+        /// <returns><see cref="MemoryBuffer"/> holding the generated file contents</returns>
+        public MemoryBuffer EmitToBuffer( NativeModule module, CodeGenFileType fileType )
+        {
+            if( module == null )
+                throw new ArgumentNullException( nameof( module ) );
+
+            if( module.TargetTriple != null && Triple != module.TargetTriple )
+                throw new ArgumentException( "Triple specifed for the module doesn't match target machine", nameof( module ) );
+
+            IntPtr errMsg;
+            LLVMMemoryBufferRef bufferHandle;
+            if( 0 != NativeMethods.TargetMachineEmitToMemoryBuffer( TargetMachineHandle, module.ModuleHandle, (LLVMCodeGenFileType)fileType, out errMsg, out bufferHandle ).Value )
+            {
+                var errTxt = NativeMethods.MarshalMsg( errMsg );
+                throw new InternalCodeGeneratorException( errTxt );
+            }
+
+            return new MemoryBuffer( bufferHandle );
+        }
+
+        /// <summary>Adds the target specific analysis passes (e.g. cost model for the optimizers) to a pass manager</summary>
+        /// <param name="passManager">Pass manager to add the passes to</param>
+        public void AddAnalysisPasses( PassManager passManager )
+        {
+            if( passManager == null )
+                throw new ArgumentNullException( nameof( passManager ) );
+
+            NativeMethods.AddAnalysisPasses( TargetMachineHandle, passManager.PassManagerHandle );
+        }
+
+        /// <summary>Places each function in its own section in generated object files (e.g. llc -function-sections)</summary>
+        public void SetFunctionSections( bool value )
+        {
+            NativeMethods.SetTargetMachineFunctionSections( TargetMachineHandle, value );
+        }
+
+        /// <summary>Places each global in its own section in generated object files (e.g. llc -data-sections)</summary>
+        public void SetDataSections( bool value )
+        {
+            NativeMethods.SetTargetMachineDataSections( TargetMachineHandle, value );
+        }
+
         public Context Context { get; }
 
         internal TargetMachine( Context context, LLVMTargetMachineRef targetMachineHandle )
@@ -6,13 +6,21 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
 {
     using System;
     using System.Runtime.InteropServices;
+    using System.Threading;
     using Runtime = Microsoft.Zelig.Runtime;
+    using TS   = Microsoft.Zelig.Runtime.TypeSystem;
+    using LLOS = Zelig.LlilumOSAbstraction;
     using LLIO = Zelig.LlilumOSAbstraction.API.IO;
 
     public class AdcChannel : Llilum.Devices.Adc.AdcChannel
     {
         private unsafe LLIO.AdcContext* m_adc;
         private int                     m_pinNumber;
+        private ushort[]                m_samples;
+        private AutoResetEvent          m_samplesReady;
+        private int                     m_readyOffset;
+        private int                     m_pendingHalves;
+        private int                     m_overruns;
 
         internal AdcChannel(int pinNumber)
         {
@@ -33,7 +41,9 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
         {
             if (m_adc != null)
             {
+                // Uninitialize also stops sampling
                 LLIO.Adc.LLOS_ADC_Uninitialize(m_adc);
+                m_samples = null;
                 m_adc = null;
 
                 if (disposing)
@@ -78,5 +88,106 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
 
             return result;
         }
+
+        public override void StartSampling(ushort[] buffer, int sampleRateHz)
+        {
+            if (m_samplesReady == null)
+            {
+                m_samplesReady = new AutoResetEvent(false);
+            }
+
+            // The native side writes into the buffer until StopSampling, so keep it alive until then
+            m_samples       = buffer;
+            m_readyOffset   = -1;
+            m_pendingHalves = 0;
+            m_overruns      = 0;
+
+            m_samplesReady.Reset();
+
+            unsafe
+            {
+                Runtime.ArrayImpl bufferImpl = (Runtime.ArrayImpl)(object)buffer;
+
+                uint hr = LLIO.Adc.LLOS_ADC_StartSampling(m_adc, (uint)sampleRateHz, (ushort*)bufferImpl.GetDataPointer(), buffer.Length, HandleSamplesNative, ((Runtime.ObjectImpl)(object)this).ToPointer());
+
+                if (LLOS.LlilumErrors.Failed(hr))
+                {
+                    m_samples = null;
+
+                    LLOS.LlilumErrors.ThrowOnError(hr, false);
+                }
+            }
+        }
+
+        public override void StopSampling()
+        {
+            unsafe
+            {
+                LLIO.Adc.LLOS_ADC_StopSampling(m_adc);
+            }
+
+            m_samples = null;
+
+            if (m_samplesReady != null)
+            {
+                m_samplesReady.Set();
+            }
+        }
+
+        public override int WaitForSamples(int millisecondsTimeout)
+        {
+            if (m_samples == null)
+            {
+                throw new InvalidOperationException();
+            }
+
+            if (!m_samplesReady.WaitOne(millisecondsTimeout, false))
+            {
+                return -1;
+            }
+
+            using (Runtime.SmartHandles.InterruptState.Disable())
+            {
+                // Sampling was stopped while we were waiting
+                if (m_samples == null)
+                {
+                    return -1;
+                }
+
+                m_pendingHalves = 0;
+
+                return m_readyOffset;
+            }
+        }
+
+        public override int SamplingOverruns
+        {
+            get
+            {
+                return m_overruns;
+            }
+        }
+
+        [TS.GenerateUnsafeCast()]
+        private extern static AdcChannel CastAsAdcChannel(UIntPtr ptr);
+
+        private static unsafe void HandleSamplesNative(LLIO.AdcContext* channel, UIntPtr callbackCtx, ushort* pSamples, int sampleCount)
+        {
+            AdcChannel adc = CastAsAdcChannel(callbackCtx);
+
+            using (Runtime.SmartHandles.InterruptState.Disable())
+            {
+                // The other half filled before the consumer got to this one
+                if (adc.m_pendingHalves != 0)
+                {
+                    adc.m_overruns++;
+                }
+
+                adc.m_readyOffset   = (pSamples == (ushort*)((Runtime.ArrayImpl)(object)adc.m_samples).GetDataPointer()) ? 0 : sampleCount;
+                adc.m_pendingHalves = 1;
+
+                adc.m_samplesReady.Set();
+            }
+        }
     }
 }
@@ -15,6 +15,7 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
     {
         private unsafe LLIO.I2CContext* m_i2c;
         private II2cChannelInfo m_channelInfo;
+        private LLIO.I2CSegment[] m_segments = new LLIO.I2CSegment[2];
 
         public I2cChannel(II2cChannelInfo channelInfo)
         {
@@ -117,5 +118,56 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
                 }
             }
         }
+
+        public override int WriteRead(byte[] writeBuffer, int writeOffset, int writeLength, byte[] readBuffer, int readOffset, int readLength, int deviceAddress)
+        {
+            // Ensure buffers aren't null or empty
+            if (writeBuffer == null || writeBuffer.Length <= 0 || readBuffer == null || readBuffer.Length <= 0)
+            {
+                throw new ArgumentException();
+            }
+
+            // Ensure accurate bounds for the transaction
+            if (writeOffset < 0 || writeBuffer.Length < (writeOffset + writeLength) ||
+                readOffset  < 0 || readBuffer.Length  < (readOffset  + readLength))
+            {
+                throw new ArgumentException();
+            }
+
+            unsafe
+            {
+                int transferred = 0;
+
+                fixed (byte* pWrite = &writeBuffer[0])
+                fixed (byte* pRead = &readBuffer[0])
+                fixed (LLIO.I2CSegment* pSegments = &m_segments[0])
+                {
+                    pSegments[0].Buffer = pWrite;
+                    pSegments[0].Offset = writeOffset;
+                    pSegments[0].Length = writeLength;
+                    pSegments[0].Flags  = LLIO.I2CSegmentFlags.Write;
+
+                    pSegments[1].Buffer = pRead;
+                    pSegments[1].Offset = readOffset;
+                    pSegments[1].Length = readLength;
+                    pSegments[1].Flags  = LLIO.I2CSegmentFlags.Read | LLIO.I2CSegmentFlags.Stop;
+
+                    LLOS.LlilumErrors.ThrowOnError( LLIO.I2C.LLOS_I2C_Transaction( m_i2c, (uint)deviceAddress, pSegments, 2, &transferred ), true );
+
+                    // Keep reporting an unacknowledged address the way Read and Write do
+                    if (pSegments[0].Length < 0)
+                    {
+                        return pSegments[0].Length;
+                    }
+
+                    if (pSegments[1].Length < 0)
+                    {
+                        return pSegments[1].Length;
+                    }
+
+                    return transferred;
+                }
+            }
+        }
     }
 }
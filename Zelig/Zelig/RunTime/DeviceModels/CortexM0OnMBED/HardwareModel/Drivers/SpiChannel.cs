@@ -5,11 +5,13 @@
 namespace Microsoft.CortexM0OnMBED.HardwareModel
 {
     using System;
+    using System.Threading;
     using Microsoft.Zelig.Runtime;
     using Microsoft.Llilum.Devices.Spi;
     using LlilumGpio = Microsoft.Llilum.Devices.Gpio;
     using LLOS       = Zelig.LlilumOSAbstraction;
     using LLIO       = Zelig.LlilumOSAbstraction.API.IO;
+    using TS         = Zelig.Runtime.TypeSystem;
 
     public class SpiChannel : Microsoft.Llilum.Devices.Spi.SpiChannel
     {
@@ -17,6 +19,11 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
         private unsafe LLIO.SpiConfig* m_spiCfg;
         private unsafe LlilumGpio.GpioPin m_altCsPin;
         private ISpiChannelInfo m_channelInfo;
+        private AutoResetEvent m_evtTransfer;
+        private byte[] m_asyncWriteBuffer;
+        private byte[] m_asyncReadBuffer;
+        private volatile bool m_asyncPending;
+        private bool m_asyncFailed;
 
         //--//
 
@@ -47,6 +54,16 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
             // Native resources need to be freed unconditionally
             if(m_spi != null)
             {
+                if(m_asyncPending)
+                {
+                    AbortTransfer( );
+
+                    if(disposing)
+                    {
+                        CompleteTransfer( );
+                    }
+                }
+
                 LLIO.Spi.LLOS_SPI_Uninitialize(m_spi);
                 m_spi = null;
             }
@@ -120,6 +137,90 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
             DisableChipselect( );
         }
 
+        /// <summary>
+        /// Starts an asynchronous transfer over the SpiChannel. The chip select stays asserted until EndWriteRead
+        /// observes the completion.
+        /// </summary>
+        public unsafe override void BeginWriteRead( byte[] writeBuffer, int writeOffset, int writeLength, byte[] readBuffer, int readOffset, int readLength )
+        {
+            if(readBuffer == null && writeBuffer == null)
+            {
+                throw new ArgumentException( );
+            }
+
+            if(m_asyncPending)
+            {
+                throw new InvalidOperationException( );
+            }
+
+            ArrayImpl writeImpl = (ArrayImpl)(object)writeBuffer;
+            ArrayImpl readImpl  = (ArrayImpl)(object)readBuffer;
+
+            //
+            // Keep the buffers reachable for as long as the hardware may touch them.
+            //
+            m_asyncWriteBuffer = writeBuffer;
+            m_asyncReadBuffer  = readBuffer;
+            m_asyncFailed      = false;
+            m_asyncPending     = true;
+
+            m_evtTransfer.Reset( );
+
+            EnableChipSelect( );
+
+            uint hr = LLIO.Spi.LLOS_SPI_TransferAsync(
+                m_spi,
+                writeBuffer != null ? (byte*)writeImpl.GetDataPointer( ) : null,
+                writeOffset,
+                writeLength,
+                readBuffer != null ? (byte*)readImpl.GetDataPointer( ) : null,
+                readOffset,
+                readLength );
+
+            if(LLOS.LlilumErrors.Failed( hr ))
+            {
+                CompleteTransfer( );
+
+                LLOS.LlilumErrors.ThrowOnError( hr, false );
+            }
+        }
+
+        public override bool EndWriteRead( int millisecondsTimeout )
+        {
+            if(m_asyncPending && !m_evtTransfer.WaitOne( millisecondsTimeout, false ))
+            {
+                //
+                // Don't leave the hardware running into buffers the caller now considers free.
+                //
+                AbortTransfer( );
+                CompleteTransfer( );
+
+                return false;
+            }
+
+            if(m_asyncWriteBuffer != null || m_asyncReadBuffer != null)
+            {
+                CompleteTransfer( );
+            }
+
+            if(m_asyncFailed)
+            {
+                m_asyncFailed = false;
+
+                throw new InvalidOperationException( );
+            }
+
+            return true;
+        }
+
+        public override bool IsTransferInProgress
+        {
+            get
+            {
+                return m_asyncPending;
+            }
+        }
+
         public unsafe override void SetupChannel(int bits, SpiMode mode, bool isSlave)
         {
             m_spiCfg->Master          = isSlave ? 0u : 1u;
@@ -217,6 +318,37 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
             m_spiCfg->LoopbackMode = 0;
             m_spiCfg->MSBTransferMode = 0;
             m_spiCfg->ChipSelect = (uint)channelInfo.DefaultChipSelect;
+
+            m_evtTransfer = new AutoResetEvent( false );
+
+            LLIO.Spi.LLOS_SPI_SetCallback( m_spi, HandleSpiInterrupt, ((ObjectImpl)(object)this).ToPointer( ) );
+        }
+
+        private void CompleteTransfer( )
+        {
+            m_asyncPending     = false;
+            m_asyncWriteBuffer = null;
+            m_asyncReadBuffer  = null;
+
+            DisableChipselect( );
+        }
+
+        //
+        // Cancels the pending asynchronous transfer. The abort completes it with an error through
+        // HandleSpiInterrupt, unless the completion interrupt got there first; either way the
+        // outcome is dropped.
+        //
+        private unsafe void AbortTransfer( )
+        {
+            LLIO.Spi.LLOS_SPI_AbortAsync( m_spi );
+
+            using(SmartHandles.InterruptState.Disable( ))
+            {
+                m_asyncPending = false;
+                m_asyncFailed  = false;
+            }
+
+            m_evtTransfer.Reset( );
         }
 
         private uint ConvertToCoreClockTicks(int spiCycles, int spiFrequencyInHz)
@@ -264,5 +396,21 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
                 m_altCsPin.Write(m_spiCfg->ActiveLow == 1 ? 1 : 0);
             }
         }
+
+        [TS.GenerateUnsafeCast()]
+        private extern static SpiChannel CastAsSpiChannel(UIntPtr ptr);
+
+        private static unsafe void HandleSpiInterrupt( LLIO.SpiContext* channel, UIntPtr callbackCtx, LLIO.SpiAction action )
+        {
+            SpiChannel spi = CastAsSpiChannel( callbackCtx );
+
+            using(SmartHandles.InterruptState.Disable( ))
+            {
+                spi.m_asyncFailed  = action == LLIO.SpiAction.SpiError;
+                spi.m_asyncPending = false;
+
+                spi.m_evtTransfer.Set( );
+            }
+        }
     }
 }
@@ -18,7 +18,15 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
         // State
         //
 
+        //
+        // The native rings only have to cover the interrupt latency until the data is moved
+        // to/from the managed queues, they do not need to match the stream buffer sizes.
+        //
+        private const int c_NativeRxRingSize = 64;
+        private const int c_NativeTxRingSize = 64;
+
         private int m_stat_OverrunErrors;
+        private readonly byte[] m_rxChunk = new byte[c_NativeRxRingSize];
         private AutoResetEvent m_evtTx;
 
         private unsafe LLIO.SerialPortContext* m_serial;
@@ -98,6 +106,8 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
             m_serialCfg->DataBits = (uint)m_cfg.DataBits;
             m_serialCfg->Parity   = (LLIO.SerialPortParity)m_cfg.Parity;
             m_serialCfg->StopBits = (LLIO.SerialPortStopBits)m_cfg.StopBits;
+            m_serialCfg->RxBufferSize = c_NativeRxRingSize;
+            m_serialCfg->TxBufferSize = c_NativeTxRingSize;
 
             LLIO.SerialPort.LLOS_SERIAL_Configure( m_serial, m_serialCfg );
 
@@ -193,33 +203,38 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
             return m_receiveQueue.DequeueMultipleBlocking(ref array, offset, count, timeout);
         }
 
-        public override void WriteByte(byte value, int timeout)
+        public unsafe override void WriteByte(byte value, int timeout)
         {
-            WriteToTx(value, timeout);
+            WriteToTx(&value, 0, 1, timeout);
         }
 
-        public override void Write(byte[] array, int offset, int count, int timeout)
+        public unsafe override void Write(byte[] array, int offset, int count, int timeout)
         {
-            int end = offset + count;
-
             if( offset + count > array.Length )
             {
                 throw new ArgumentException();
             }
 
-            while (offset < end && !m_shutdown)
+            fixed (byte* pArray = array)
             {
-                WriteToTx(array[offset++], timeout);
+                WriteToTx(pArray, offset, count, timeout);
             }
         }
 
         public override void Flush()
         {
             //
-            // This implementation of the serial port does not use a write buffer because it would require
-            // a separate write thread.  Therefore, the transmit queue from the base class should be empty.
+            // Writes go straight to the native TX ring, the transmit queue from the base class is not used.
             //
             RT.BugCheck.Assert(m_transmitQueue.IsEmpty, RT.BugCheck.StopCode.IllegalConfiguration);
+
+            //
+            // Returns once the last byte is in the UART, it may still be shifting out on the line.
+            //
+            unsafe
+            {
+                LLIO.SerialPort.LLOS_SERIAL_Flush(m_serial);
+            }
         }
 
         //
@@ -306,31 +321,35 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
         // Helper functions
         //
 
-        private unsafe void WriteToTx(byte val, int timeout)
+        private unsafe void WriteToTx(byte* pBuffer, int offset, int count, int timeout)
         {
-            while (!m_shutdown)
+            while (count > 0 && !m_shutdown)
             {
-                uint isWritable = 1;
+                int  length = count;
+                bool isFull;
 
                 using (RT.SmartHandles.InterruptState.Disable())
                 {
-                    LLIO.SerialPort.LLOS_SERIAL_CanWrite( m_serial, &isWritable );
+                    //
+                    // The native layer queues as much as fits in its TX ring and drains it from the UART interrupt.
+                    //
+                    LLIO.SerialPort.LLOS_SERIAL_Write(m_serial, pBuffer, offset, &length);
 
-                    if (isWritable != 0)
-                    {
-                        LLIO.SerialPort.LLOS_SERIAL_Write(m_serial, &val, 0, 1);
-                        break;
-                    }
-                    else
+                    isFull = length < count;
+
+                    if (isFull)
                     {
                         //
-                        // Enable TX interrupt to wake us up from m_evtTx.WaitOne() below.
+                        // Enable TX notifications to wake us up from m_evtTx.WaitOne() below once the ring drains.
                         //
                         LLIO.SerialPort.LLOS_SERIAL_Enable(m_serial, LLIO.SerialPortIrq.IrqTx);
                     }
                 }
 
-                if (isWritable != 0)
+                offset += length;
+                count  -= length;
+
+                if (isFull)
                 {
                     if (!m_evtTx.WaitOne(timeout, false))
                     {
@@ -369,25 +388,29 @@ namespace Microsoft.CortexM0OnMBED.HardwareModel
         {
             RT.BugCheck.AssertInterruptsOff();
 
-            while (true)
+            //
+            // One call takes everything the native ring holds, up to the room left in the receive queue.
+            // Whatever does not fit stays in the native ring until the next read.
+            //
+            fixed (byte* pChunk = m_rxChunk)
             {
-                uint canRead = 1;
-                LLIO.SerialPort.LLOS_SERIAL_CanRead( m_serial, &canRead );
-
-                if ((canRead == 0) || m_receiveQueue.IsFull)
+                while (!m_receiveQueue.IsFull)
                 {
-                    break;
-                }
-                else
-                {
-                    byte c;
-                    int length = 1;
+                    int requested = Math.Min(m_rxChunk.Length, m_receiveQueue.RemainingCapacity);
+                    int length    = requested;
+
+                    LLOS.LlilumErrors.ThrowOnError( LLIO.SerialPort.LLOS_SERIAL_Read( m_serial, pChunk, 0, &length), true );
 
-                    LLOS.LlilumErrors.ThrowOnError( LLIO.SerialPort.LLOS_SERIAL_Read( m_serial, &c, 0, &length), true );
+                    for (int i = 0; i < length; i++)
+                    {
+                        if (!m_receiveQueue.EnqueueNonblocking(pChunk[i]))
+                        {
+                            m_stat_OverrunErrors++;
+                        }
+                    }
 
-                    if (!m_receiveQueue.EnqueueNonblocking(c))
+                    if (length < requested)
                     {
-                        m_stat_OverrunErrors++;
                         break;
                     }
                 }
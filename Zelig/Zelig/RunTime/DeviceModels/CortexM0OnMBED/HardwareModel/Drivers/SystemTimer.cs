@@ -9,6 +9,7 @@ namespace Microsoft.CortexM0OnMBED.Drivers
     using System.Runtime.CompilerServices;
 
     using RT            = Microsoft.Zelig.Runtime;
+    using TS            = Microsoft.Zelig.Runtime.TypeSystem;
     using LLOS          = Zelig.LlilumOSAbstraction;
     using ChipsetModel  = Microsoft.DeviceModels.Chipset.CortexM;
 
@@ -20,27 +21,34 @@ namespace Microsoft.CortexM0OnMBED.Drivers
     {
         public delegate void Callback(Timer timer, ulong currentTime);
 
-        public class Timer
+        public class Timer : IDisposable
         {
             //
             // State
             //
 
-            private readonly Callback               m_callback;
-            private readonly RT.KernelNode<Timer>   m_node;
-            private readonly SystemTimer            m_owner;
-            private ulong                           m_timeout;
+            private readonly Callback                       m_callback;
+            private readonly RT.KernelNode<Timer>           m_node;
+            private readonly SystemTimer                    m_owner;
+            private unsafe LLOS.HAL.TimerContext*           m_nativeTimer;
+            private ulong                                   m_timeout;
             
 
             //
             // Constructor Methods
             //
 
-            internal Timer(SystemTimer owner, Callback callback)
+            internal unsafe Timer(SystemTimer owner, Callback callback)
             {
-                m_owner = owner;
-                m_node = new RT.KernelNode<Timer>(this);
-                m_callback = callback;
+                m_owner       = owner;
+                m_node        = new RT.KernelNode<Timer>(this);
+                m_callback    = callback;
+                m_nativeTimer = owner.AllocateNativeTimer(this);
+            }
+
+            ~Timer()
+            {
+                Dispose(false);
             }
 
             //
@@ -52,6 +60,34 @@ namespace Microsoft.CortexM0OnMBED.Drivers
                 m_owner.Deregister(this);
             }
 
+            /// <summary>
+            /// Disarms the timer and releases its native timer, the timer cannot be armed again
+            /// </summary>
+            public void Dispose()
+            {
+                Dispose(true);
+
+                GC.SuppressFinalize(this);
+            }
+
+            private unsafe void Dispose(bool disposing)
+            {
+                //
+                // An armed timer is reachable from the armed list, so the finalizer only ever sees disarmed ones.
+                //
+                if (disposing)
+                {
+                    m_owner.Deregister(this);
+                }
+
+                if (m_nativeTimer != null)
+                {
+                    LLOS.HAL.Timer.LLOS_SYSTEM_TIMER_FreeTimer(m_nativeTimer);
+
+                    m_nativeTimer = null;
+                }
+            }
+
             /// <summary>
             /// Call to the Timer handler
             /// </summary>
@@ -73,6 +109,14 @@ namespace Microsoft.CortexM0OnMBED.Drivers
                 }
             }
 
+            internal unsafe LLOS.HAL.TimerContext* NativeTimer
+            {
+                get
+                {
+                    return m_nativeTimer;
+                }
+            }
+
             /// <summary>
             /// Set/get the timeout in absolute time
             /// </summary>
@@ -119,54 +163,33 @@ namespace Microsoft.CortexM0OnMBED.Drivers
 
         //--//
         
+        //
+        // Every Timer owns a native timer, and the native layer multiplexes them onto the hardware ticker through a
+        // timer wheel, so arming and cancelling are O(1) here. Armed timers are kept on m_timers only so that they stay
+        // reachable while native code holds their address; timers whose native timer fired move to m_expired, and
+        // only the first one of a batch posts an interrupt, so a burst of expirations cannot overflow the interrupt queue.
+        //
         private RT.KernelList<Timer>        m_timers;
+        private RT.KernelList<Timer>        m_expired;
         private InterruptController.Handler m_interrupthandler;
-        private ulong                       m_accumulator;
-        private uint                        m_lastAccumulatorUpdate;
-
-        // This is only used as a placeholder to pass into timer_insert_event
-        private unsafe LLOS.HAL.TimerContext*  m_timerEvent;
-        //--//
-        //private static Timer            s_guard;
 
         public void Initialize()
         {
             m_timers            = new RT.KernelList<Timer>();
+            m_expired           = new RT.KernelList<Timer>();
             m_interrupthandler  = InterruptController.Handler.Create( 
                                                                 Board.Instance.GetSystemTimerIRQ( )         , 
                                                                 ChipsetModel.Drivers.InterruptPriority.BelowNormal, 
                                                                 ChipsetModel.Drivers.InterruptSettings.Normal     , 
                                                                 ProcessTimerInterrupt 
                                                                 );
-
-            m_accumulator           = 0;
-            m_lastAccumulatorUpdate = this.Counter;
-
-            // Allocate our one, and only, timer event
-            unsafe
-            {
-                fixed (LLOS.HAL.TimerContext** timer_ptr = &m_timerEvent)
-                {
-                    var callbackContext = InterruptController.CastInterruptHandlerAsPtr( m_interrupthandler ); 
-                    LLOS.HAL.Timer.LLOS_SYSTEM_TIMER_AllocateTimer( HandleSystemTimerNative, callbackContext, ulong.MaxValue, timer_ptr );
-                }
-            }
             
             ChipsetModel.NVIC.SetPriority( 
                 ChipsetModel.Board.Instance.GetSystemTimerIRQ(), 
                 RT.TargetPlatform.ARMv6.ProcessorARMv6M.c_Priority__SystemTimer 
                 );
-
-            //
-            // Set up a guard to never suffer from shutting down the underlying circuitry
-            //
-            //s_guard = CreateTimer( (timer, currentTime) => { timer.RelativeTimeout = QuarterCycle;  }  );
-            //s_guard.RelativeTimeout = QuarterCycle; 
             
             InterruptController.Instance.RegisterAndEnable( m_interrupthandler );
-
-            // no need to Refresh because guard causes a refresh already
-            Refresh();
         }
         
         /// <summary>
@@ -180,29 +203,25 @@ namespace Microsoft.CortexM0OnMBED.Drivers
         }
 
         /// <summary>
-        /// Gets the current accumulator time
+        /// Gets the current time, the native layer extends the hardware counter to 64 bits
         /// </summary>
-        public ulong CurrentTime
+        public unsafe ulong CurrentTime
         {
             get
             {
-                using (RT.SmartHandles.InterruptState.Disable())
-                {
-                    // Current time is the accumulator + time since it was updated
-                    return m_accumulator + TimeSinceAccumulatorUpdate( this.Counter ); 
-                }
+                return LLOS.HAL.Timer.LLOS_SYSTEM_TIMER_GetTicks( null );
             }
         }
 
         /// <summary>
         /// Gets the current value of the timer accumulator
         /// </summary>
-        public unsafe uint Counter
+        public uint Counter
         {
             [RT.Inline]
             get
             {
-                return (uint)LLOS.HAL.Timer.LLOS_SYSTEM_TIMER_GetTicks( m_timerEvent );
+                return (uint)this.CurrentTime;
             }
         }
 
@@ -228,89 +247,44 @@ namespace Microsoft.CortexM0OnMBED.Drivers
         /// <param name="ticks">Time when the timer was fired</param>
         internal void ProcessTimeout(ulong ticks)
         {
-            // Ensure that lastAccumulatorUpdate is always updated with the accumulator!
-            uint counter = this.Counter;
-
-            //
-            // BUGBUG: this logic does not cover the case of multiple wraparounds
-            //
-            m_accumulator           += TimeSinceAccumulatorUpdate(counter);
-            m_lastAccumulatorUpdate =  counter;
-
-            // we just updated this above, so it will be precise
-            ulong now = m_accumulator;
+            ulong now = this.CurrentTime;
 
             while (true)
             {
-                RT.KernelNode<Timer> node = m_timers.StartOfForwardWalk;
+                RT.KernelNode<Timer> node = m_expired.FirstNode();
 
-                // If the next node is null, break and call Refresh
-                if (node.IsValidForForwardMove == false)
+                if (node == null)
                 {
                     break;
                 }
 
-                ulong timeout = node.Target.Timeout;
+                node.RemoveFromList();
+
+                Timer timer = node.Target;
 
-                if (timeout > now)
+                if (timer.Timeout > now)
                 {
-                    // If we get here, there are no timers that need to be cleared/invoked
-                    break;
+                    //
+                    // The timeout was moved out after the native timer fired, arm it again.
+                    //
+                    Register(timer);
+                    continue;
                 }
 
-                // The current timeout is for the current node (Timer). Remove from List
-                // so we do not try to Reload its time.
-                node.RemoveFromList();
-
                 // Invoke the handler for the expired timer
-                node.Target.Invoke(now);
+                timer.Invoke(now);
             }
-
-            Refresh();
         }
-        
-        /// <summary>
-        /// Reload the next expiring timer, if there is one. Otherwise, reload QuarterCycle
-        /// </summary>
-        private void Refresh()
-        {
-            ulong absTimeout;
-
-            Timer target = m_timers.FirstTarget();
-                
-            ulong now = this.CurrentTime;
 
-            if(target != null)
-            {
-                absTimeout = target.Timeout;
-            }
-            else
-            {
-                absTimeout = c_QuarterCycle + now;
-            }
+        private unsafe LLOS.HAL.TimerContext* AllocateNativeTimer(Timer timer)
+        {
+            LLOS.HAL.TimerContext* nativeTimer;
 
-            // 
-            // Timeout in the past? Trigger the match immediately by loading 1 
-            // Timeout too far in the future? Generate match for 
-            // a fraction of largest counter value, so we have time to handle wraparounds 
-            // 
-            Reload((now > absTimeout) ? 1 : (absTimeout - now));
-        }
+            UIntPtr callbackContext = ((RT.ObjectImpl)(object)timer).ToPointer();
 
-        /// <summary>
-        /// Place the timer closest to expiration on the mbed queue
-        /// </summary>
-        /// <param name="remainder"></param>
-        private void Reload(ulong remainder)
-        {
-            // trim to quarter cycle, so we have time to handle wraparounds
-            // This is guaranteed to fit in a uint
-            uint trimmed = (uint)Math.Min(remainder, c_QuarterCycle);
+            LLOS.LlilumErrors.ThrowOnError( LLOS.HAL.Timer.LLOS_SYSTEM_TIMER_AllocateTimer( HandleSystemTimerNative, callbackContext, ulong.MaxValue, &nativeTimer ), false );
 
-            unsafe
-            {
-                LLOS.HAL.Timer.LLOS_SYSTEM_TIMER_ScheduleTimer( m_timerEvent, trimmed );
-            }
+            return nativeTimer;
         }
         
         //
@@ -318,73 +292,89 @@ namespace Microsoft.CortexM0OnMBED.Drivers
         //
 
         /// <summary>
-        /// Add the timer to the queue in the chronologically appropriate position
+        /// Arm the native timer of this timer for its absolute timeout
         /// </summary>
         /// <param name="timer">Timer to add</param>
-        private void Register(Timer timer)
+        private unsafe void Register(Timer timer)
         {
-            RT.KernelNode<Timer> node = timer.Node;
+            if (timer.NativeTimer == null)
+            {
+                throw new ObjectDisposedException(null);
+            }
 
-            node.RemoveFromList();
+            using (RT.SmartHandles.InterruptState.Disable())
+            {
+                RT.KernelNode<Timer> node = timer.Node;
 
-            ulong timeout = timer.Timeout;
+                node.RemoveFromList();
 
-            RT.KernelNode<Timer> node2 = m_timers.StartOfForwardWalk;
+                m_timers.InsertAtTail(node);
 
-            while (node2.IsValidForForwardMove)
-            {
-                if (node2.Target.Timeout > timeout)
-                {
-                    break;
-                }
+                ulong timeout = timer.Timeout;
+                ulong now     = this.CurrentTime;
 
-                node2 = node2.Next;
+                LLOS.HAL.Timer.LLOS_SYSTEM_TIMER_ScheduleTimer( timer.NativeTimer, (timeout > now) ? (timeout - now) : 0 );
             }
-
-            node.InsertBefore(node2);
-
-            Refresh();
         }
 
         /// <summary>
-        /// Remove the timer from the queue
+        /// Disarm the native timer of this timer
         /// </summary>
         /// <param name="timer">Timer to be removed</param>
-        private void Deregister(Timer timer)
+        private unsafe void Deregister(Timer timer)
         {
-            var node = timer.Node;
-
-            if (node.IsLinked)
+            using (RT.SmartHandles.InterruptState.Disable())
             {
-                node.RemoveFromList();
+                var node = timer.Node;
 
-                Refresh();
+                if (node.IsLinked)
+                {
+                    node.RemoveFromList();
+
+                    if (timer.NativeTimer != null)
+                    {
+                        LLOS.HAL.Timer.LLOS_SYSTEM_TIMER_ScheduleTimer( timer.NativeTimer, ulong.MaxValue );
+                    }
+                }
             }
         }
 
-        /// <summary>
-        /// Gets the difference in ticks between when the accumulator, and its last recorded value
-        /// </summary>
-        /// <returns>Difference in ticks</returns>
-        private uint TimeSinceAccumulatorUpdate( uint current )
+        private void Expire(Timer timer, ulong ticks)
         {
-            // If the current timer value is greater than last accumulator update,
-            // the counter is still going up. Otherwise, the timer hit its max value
-            // and started counting from 0
-            return (current >= m_lastAccumulatorUpdate) ?
-                current           - m_lastAccumulatorUpdate          :
-                c_MaxCounterValue - m_lastAccumulatorUpdate + current;
+            RT.KernelNode<Timer> node = timer.Node;
+
+            //
+            // A timer cancelled after its native timer fired is no longer on the armed list.
+            //
+            if (node.IsLinked == false)
+            {
+                return;
+            }
+
+            bool post = (m_expired.FirstNode() == null);
+
+            node.RemoveFromList();
+
+            m_expired.InsertAtTail(node);
+
+            if (post)
+            {
+                ChipsetModel.Drivers.InterruptController.InterruptData data;
+
+                data.Context = ticks;
+                data.Handler = m_interrupthandler;
+
+                InterruptController.Instance.PostInterrupt( data );
+            }
         }
 
         //--//
 
+        [TS.GenerateUnsafeCast()]
+        private extern static Timer CastAsTimer(UIntPtr ptr);
+
         private static void HandleSystemTimerNative( UIntPtr context, ulong ticks )
         {
-            ChipsetModel.Drivers.InterruptController.InterruptData data;
-
-            data.Context = ticks;
-            data.Handler = InterruptController.CastAsInterruptHandler( context );
-
             //
             // This interrupt handler does not come from the ISR vector table, but rather from 'us_ticker_irq_handler' 
             // being lazily set through 'NVIC_SetVector( <ISR NUMBER>, (uint32_t)us_ticker_irq_handler)' during initialization. 
@@ -394,7 +384,7 @@ namespace Microsoft.CortexM0OnMBED.Drivers
             {
                 using(RT.SmartHandles.SwapCurrentThreadUnderInterrupt hnd = RT.ThreadManager.InstallInterruptThread( ))
                 {
-                    InterruptController.Instance.PostInterrupt( data );
+                    SystemTimer.Instance.Expire( CastAsTimer( context ), ticks );
                 }
             }
         }
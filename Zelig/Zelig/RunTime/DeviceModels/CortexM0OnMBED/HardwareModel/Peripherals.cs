@@ -9,6 +9,7 @@ namespace Microsoft.CortexM0OnMBED
 {
 
     using RT            = Microsoft.Zelig.Runtime;
+    using LLOS          = Microsoft.Zelig.LlilumOSAbstraction;
     using ChipsetModel  = Microsoft.CortexM0OnCMSISCore;
 
 
@@ -33,6 +34,15 @@ namespace Microsoft.CortexM0OnMBED
             //Drivers.SPI.Instance.Initialize();
         }
         
+        /// <summary>
+        /// Called by the idle thread: sleeps until the next interrupt with the quantum timer suspended. The next wait
+        /// timeout is already armed on the system timer, so no periodic tick is needed to wake up.
+        /// </summary>
+        public override void WaitForInterrupt()
+        {
+            LLOS.HAL.Clock.LLOS_CLOCK_Idle( );
+        }
+
         [RT.Inline]
         [RT.DisableNullChecks()]
         public override uint ReadPerformanceCounter()
@@ -100,6 +100,42 @@ namespace Microsoft.CortexM3OnMBED.HardwareModel
             return new string(address);
         }
 
+        public unsafe override int GetPoolStatistics(int pool, out uint available, out uint used, out uint maxUsed, out uint failures)
+        {
+            uint avail, inUse, max, err;
+
+            int result = EthernetInterface.LLOS_ethernet_get_pool_stats((uint)pool, &avail, &inUse, &max, &err);
+
+            available = avail;
+            used      = inUse;
+            maxUsed   = max;
+            failures  = err;
+
+            return result;
+        }
+
+        public unsafe override int GetTrafficStatistics(out uint framesSent, out uint framesReceived, out uint framesDropped, out uint segmentsSent, out uint segmentsReceived, out uint segmentsDropped, out uint retransmitting)
+        {
+            uint linkXmit, linkRecv, linkDrop, tcpXmit, tcpRecv, tcpDrop, rexmit;
+
+            int result = EthernetInterface.LLOS_ethernet_get_traffic_stats(&linkXmit, &linkRecv, &linkDrop, &tcpXmit, &tcpRecv, &tcpDrop, &rexmit);
+
+            framesSent       = linkXmit;
+            framesReceived   = linkRecv;
+            framesDropped    = linkDrop;
+            segmentsSent     = tcpXmit;
+            segmentsReceived = tcpRecv;
+            segmentsDropped  = tcpDrop;
+            retransmitting   = rexmit;
+
+            return result;
+        }
+
+        public override int ResetStatistics()
+        {
+            return EthernetInterface.LLOS_ethernet_reset_stats();
+        }
+
         public override string GetDefaultLocalAddress()
         {
             NetworkInterface[] interfaces = NetworkInterface.GetAllNetworkInterfaces();
@@ -5,6 +5,7 @@
 namespace Microsoft.CortexM3OnMBED.HardwareModel
 {
     using System;
+    using System.Collections.Generic;
     using Zelig.LlilumOSAbstraction.API.IO;
     using System.Text;
 
@@ -222,6 +223,34 @@ namespace Microsoft.CortexM3OnMBED.HardwareModel
                 return SocketNative.LLOS_lwip_recv(socket, buffer, count, flags, timeout_ms);
             }
         }
+
+        public unsafe override int sendv(int socket, IList<ArraySegment<byte>> buffers, int flags, int timeout_ms)
+        {
+            int[] counts;
+            uint[] addresses = GetSegmentAddresses(buffers, out counts);
+
+            fixed (uint* pAddresses = addresses)
+            {
+                fixed (int* pCounts = counts)
+                {
+                    return SocketNative.LLOS_lwip_sendv(socket, pAddresses, pCounts, counts.Length, flags, timeout_ms);
+                }
+            }
+        }
+
+        public unsafe override int recvv(int socket, IList<ArraySegment<byte>> buffers, int flags, int timeout_ms)
+        {
+            int[] counts;
+            uint[] addresses = GetSegmentAddresses(buffers, out counts);
+
+            fixed (uint* pAddresses = addresses)
+            {
+                fixed (int* pCounts = counts)
+                {
+                    return SocketNative.LLOS_lwip_recvv(socket, pAddresses, pCounts, counts.Length, flags, timeout_ms);
+                }
+            }
+        }
         
         public override int close(int socket)
         {
@@ -268,12 +297,11 @@ namespace Microsoft.CortexM3OnMBED.HardwareModel
                 }
             }
 
-            if(result < 0)
+            // lwIP reports failures as positive EAI_xxx codes
+            if(result != 0)
             {
-                // The format of address in addressArr may not be what DNS wants. Need to verify
                 canonicalName = null;
                 addresses = null;
-                addresses[0] = null;
 
                 return result;
             }
@@ -285,6 +313,14 @@ namespace Microsoft.CortexM3OnMBED.HardwareModel
 
             return result;
         }
+
+        public unsafe override int prefetchaddrinfo(string name)
+        {
+            fixed (char* pName = name.ToCharArray())
+            {
+                return SocketNative.LLOS_lwip_getaddrinfo_async(pName, (uint)name.Length);
+            }
+        }
         
         public unsafe override void shutdown(int socket, int how, out int err)
         {
@@ -507,6 +543,17 @@ namespace Microsoft.CortexM3OnMBED.HardwareModel
             return SocketNative.LLOS_lwip_poll(socket, mode, microSeconds);
         }
         
+        public unsafe override int select(int[] readSockets, ref int readCount, int[] writeSockets, ref int writeCount, int[] errorSockets, ref int errorCount, int microSeconds)
+        {
+            fixed (int* pRead = readSockets, pWrite = writeSockets, pError = errorSockets)
+            {
+                fixed (int* pReadCount = &readCount, pWriteCount = &writeCount, pErrorCount = &errorCount)
+                {
+                    return SocketNative.LLOS_lwip_select(pRead, pReadCount, pWrite, pWriteCount, pError, pErrorCount, microSeconds);
+                }
+            }
+        }
+        
         public unsafe override int ioctl(int socket, uint cmd, ref uint arg)
         {
             fixed (uint* pArg = &arg)
@@ -519,6 +566,32 @@ namespace Microsoft.CortexM3OnMBED.HardwareModel
         //--//
         //--//
 
+        //
+        // The collector does not move objects, so the segments can be handed to native code by address; they are
+        // kept alive by the list for the duration of the call.
+        //
+        static private unsafe uint[] GetSegmentAddresses( IList<ArraySegment<byte>> buffers, out int[] counts )
+        {
+            int    segments  = buffers.Count;
+            uint[] addresses = new uint[ segments ];
+
+            counts = new int[ segments ];
+
+            for(int i = 0; i < segments; i++)
+            {
+                ArraySegment<byte> segment = buffers[ i ];
+
+                if(segment.Array != null)
+                {
+                    addresses[ i ] = (uint)RT.ArrayImpl.CastAsArray( segment.Array ).GetPointerToElement( (uint)segment.Offset );
+                }
+
+                counts   [ i ] = segment.Count;
+            }
+
+            return addresses;
+        }
+
         static private int GetNativeTcpOption( int optname )
         {
             int nativeOptionName = 0;
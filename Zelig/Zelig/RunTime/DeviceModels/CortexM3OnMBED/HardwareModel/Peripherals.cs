@@ -32,11 +32,6 @@ namespace Microsoft.CortexM3OnMBED
             CMSIS.NVIC.SetPriority( (int)ARMv7.ProcessorARMv7M.IRQn_Type.PendSV_IRQn , ARMv7.ProcessorARMv7M.c_Priority__PendSV  ); 
         }
 
-        public override void WaitForInterrupt()
-        {
-            ARMv7.ProcessorARMv7M.WaitForInterrupt( );
-        }
-
         public override void CauseInterrupt()
         {
             ARMv7.ProcessorARMv7M.CompleteContextSwitch( ); 
@@ -198,5 +198,23 @@ namespace Microsoft.DeviceModels.Chipset.CortexM.Drivers
                 RT.ThreadManager.Instance.TimeQuantumExpired( );
             }
         }
+
+        //
+        // Native threads of the mbed port (os_layer/ports/mbed/mbed_threading.cpp) run inside the time slice of the
+        // managed thread that drives them. When none of them is ready, that thread gives up the rest of its slice.
+        //
+        [RT.ExportedMethod]
+        private static void LLOS_MBED_THREAD_YieldManagedThread( )
+        {
+            RT.ThreadManager.Instance.Yield( );
+        }
+
+        [RT.ExportedMethod]
+        private static System.UIntPtr LLOS_MBED_THREAD_GetManagedThread( )
+        {
+            RT.ThreadImpl thread = RT.ThreadImpl.CurrentThread;
+
+            return ( thread != null ) ? ( (RT.ObjectImpl)(object)thread ).ToPointer( ) : System.UIntPtr.Zero;
+        }
     }
 }
@@ -166,7 +166,7 @@ namespace Microsoft.DeviceModels.Runtime.Win32
 
                     thread.State |= ThreadState.WaitSleepJoin;
 
-                    InvalidateNextWaitTimer();
+                    LowerNextWaitTimer(thread.GetFirstTimeout());
                 }
             }
 
@@ -0,0 +1,130 @@
+//
+// Copyright (c) Microsoft Corporation.    All rights reserved.
+//
+
+namespace Microsoft.Llilum.Lwip
+{
+    using System;
+    using Microsoft.Zelig.Runtime;
+
+    using LLOS = Microsoft.Zelig.LlilumOSAbstraction;
+
+    //
+    // Must match the order of the pool table in os_layer/ports/mbed/mbed_ethernet.cpp
+    //
+    public enum NetworkPool
+    {
+        Heap = 0,
+        PbufPool,
+        Pbuf,
+        TcpPcb,
+        TcpPcbListen,
+        TcpSegment,
+        UdpPcb,
+        Netconn,
+        Netbuf,
+        TcpipMessage,
+        TcpipInput,
+        Timeout,
+    }
+
+    public struct NetworkPoolUsage
+    {
+        public uint Available;
+        public uint Used;
+        public uint MaxUsed;
+        public uint Failures;
+    }
+
+    public struct NetworkTrafficStatistics
+    {
+        //
+        // Counted by the native port at the driver boundary, in every build
+        //
+        public uint FramesSent;
+        public uint FramesReceived;
+        public uint FramesDropped;
+
+        //
+        // Only counted with LWIP_POOL_TUNING, zero otherwise
+        //
+        public uint SegmentsSent;
+        public uint SegmentsReceived;
+        public uint SegmentsDropped;
+
+        //
+        // Snapshot of the retransmissions pending on the active TCP connections, not a running total
+        //
+        public uint Retransmitting;
+    }
+
+    //
+    // Read-only view of the lwIP stats counters. Pool sizes are fixed when the native stack is built
+    // (see LWIP_POOL_PROFILE in lwipopts.h); these counters are what to look at when choosing a profile.
+    // Pool usage is only compiled in with LWIP_POOL_TUNING, otherwise GetPoolUsage throws NotSupportedException.
+    //
+    public static class NetworkStatistics
+    {
+        public static NetworkPoolUsage GetPoolUsage( NetworkPool pool )
+        {
+            NetworkPoolUsage usage;
+
+            int result = NetworkInterfaceProvider.Instance.GetPoolStatistics( (int)pool, out usage.Available, out usage.Used, out usage.MaxUsed, out usage.Failures );
+
+            if(result != 0)
+            {
+                ThrowIfNotSupported( result );
+
+                throw new ArgumentOutOfRangeException( nameof( pool ) );
+            }
+
+            return usage;
+        }
+
+        public static NetworkTrafficStatistics GetTraffic( )
+        {
+            NetworkTrafficStatistics traffic;
+
+            int result = NetworkInterfaceProvider.Instance.GetTrafficStatistics(
+                    out traffic.FramesSent,
+                    out traffic.FramesReceived,
+                    out traffic.FramesDropped,
+                    out traffic.SegmentsSent,
+                    out traffic.SegmentsReceived,
+                    out traffic.SegmentsDropped,
+                    out traffic.Retransmitting );
+
+            if(result != 0)
+            {
+                ThrowIfNotSupported( result );
+
+                throw new InvalidOperationException( );
+            }
+
+            return traffic;
+        }
+
+        //
+        // Clears the failure and traffic counters and restarts the high-water marks from current usage
+        //
+        public static void Reset( )
+        {
+            int result = NetworkInterfaceProvider.Instance.ResetStatistics( );
+
+            if(result != 0)
+            {
+                ThrowIfNotSupported( result );
+
+                throw new InvalidOperationException( );
+            }
+        }
+
+        private static void ThrowIfNotSupported( int result )
+        {
+            if((uint)result == LLOS.LlilumErrors.E_NOT_SUPPORTED)
+            {
+                throw new NotSupportedException( );
+            }
+        }
+    }
+}
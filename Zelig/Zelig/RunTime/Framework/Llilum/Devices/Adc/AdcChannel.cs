@@ -15,5 +15,37 @@ namespace Microsoft.Llilum.Devices.Adc
         public abstract uint ReadUnsigned();
 
         public abstract float Read();
+
+        /// <summary>
+        /// Starts sampling continuously at sampleRateHz into buffer, which is filled one half at a time.
+        /// </summary>
+        public virtual void StartSampling(ushort[] buffer, int sampleRateHz)
+        {
+            throw new NotSupportedException();
+        }
+
+        public virtual void StopSampling()
+        {
+        }
+
+        /// <summary>
+        /// Waits for the next half of the sampling buffer to fill.
+        /// </summary>
+        /// <returns>Offset of the filled half in the buffer, or -1 if the timeout elapsed</returns>
+        public virtual int WaitForSamples(int millisecondsTimeout)
+        {
+            throw new NotSupportedException();
+        }
+
+        /// <summary>
+        /// Number of buffer halves that filled before the previous one was picked up by WaitForSamples.
+        /// </summary>
+        public virtual int SamplingOverruns
+        {
+            get
+            {
+                return 0;
+            }
+        }
     }
 }
\ No newline at end of file
@@ -39,6 +39,45 @@ namespace Microsoft.Llilum.Devices.Adc
             return m_adcPin.Read();
         }
 
+        /// <summary>
+        /// Starts timer-driven sampling into buffer. Each time half of the buffer fills, WaitForSamples returns the
+        /// offset of that half while sampling continues into the other one.
+        /// </summary>
+        /// <param name="buffer">Sample buffer, with an even length</param>
+        /// <param name="sampleRateHz">Sampling rate in Hz</param>
+        public void StartSampling(ushort[] buffer, int sampleRateHz)
+        {
+            if (buffer == null || buffer.Length < 2 || (buffer.Length & 1) != 0 || sampleRateHz <= 0)
+            {
+                throw new ArgumentException();
+            }
+
+            m_adcPin.StartSampling(buffer, sampleRateHz);
+        }
+
+        public void StopSampling()
+        {
+            m_adcPin.StopSampling();
+        }
+
+        /// <summary>
+        /// Waits for the next half of the sampling buffer to fill.
+        /// </summary>
+        /// <param name="millisecondsTimeout">Time to wait, or Timeout.Infinite</param>
+        /// <returns>Offset of the filled half in the buffer, or -1 if the timeout elapsed</returns>
+        public int WaitForSamples(int millisecondsTimeout)
+        {
+            return m_adcPin.WaitForSamples(millisecondsTimeout);
+        }
+
+        public int SamplingOverruns
+        {
+            get
+            {
+                return m_adcPin.SamplingOverruns;
+            }
+        }
+
         protected virtual void Dispose(bool disposing)
         {
             if (m_adcPin != null)
@@ -18,6 +18,25 @@ namespace Microsoft.Llilum.Devices.I2c
 
         public abstract int Read(byte[] buffer, int deviceAddress, int transactionStartOffset, int transactionLength, bool sendStop);
 
+        /// <summary>
+        /// Writes and then reads with a repeated start in between. Channels that can batch both transfers in a single
+        /// bus transaction override this.
+        /// </summary>
+        /// <returns>Total number of bytes transferred, or a negative value if the address was not acknowledged</returns>
+        public virtual int WriteRead(byte[] writeBuffer, int writeOffset, int writeLength, byte[] readBuffer, int readOffset, int readLength, int deviceAddress)
+        {
+            int written = Write(writeBuffer, deviceAddress, writeOffset, writeLength, false);
+
+            if (written < writeLength)
+            {
+                return written;
+            }
+
+            int read = Read(readBuffer, deviceAddress, readOffset, readLength, true);
+
+            return (read < 0) ? read : written + read;
+        }
+
         public abstract void Dispose();
     }
 }
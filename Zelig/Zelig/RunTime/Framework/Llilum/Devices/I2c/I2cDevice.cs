@@ -98,6 +98,17 @@ namespace Microsoft.Llilum.Devices.I2c
             return m_channel.Read(buffer, deviceAddress, transactionStartOffset, transactionLength, sendStop);
         }
 
+        /// <summary>
+        /// Writes to and then reads from the device in one bus transaction, with a repeated start in between.
+        /// </summary>
+        /// <returns>Total number of bytes transferred, or a negative value if the address was not acknowledged</returns>
+        public int WriteRead(byte[] writeBuffer, int writeOffset, int writeLength, byte[] readBuffer, int readOffset, int readLength, int deviceAddress)
+        {
+            ThrowIfDisposed();
+
+            return m_channel.WriteRead(writeBuffer, writeOffset, writeLength, readBuffer, readOffset, readLength, deviceAddress);
+        }
+
         private void ThrowIfDisposed()
         {
             if (m_channel == null)
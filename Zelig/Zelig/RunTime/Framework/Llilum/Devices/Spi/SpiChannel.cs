@@ -24,6 +24,42 @@ namespace Microsoft.Llilum.Devices.Spi
 
         public abstract void Read( byte[] readBuffer, int readOffset, int readLength );
 
+        /// <summary>
+        /// Starts a transfer that completes in the background. Channels without asynchronous support
+        /// complete the transfer before returning.
+        /// </summary>
+        public virtual void BeginWriteRead( byte[] writeBuffer, int writeOffset, int writeLength, byte[] readBuffer, int readOffset, int readLength )
+        {
+            if(writeBuffer == null)
+            {
+                Read( readBuffer, readOffset, readLength );
+            }
+            else if(readBuffer == null)
+            {
+                Write( writeBuffer, writeOffset, writeLength );
+            }
+            else
+            {
+                WriteRead( writeBuffer, writeOffset, writeLength, readBuffer, readOffset, readLength, 0 );
+            }
+        }
+
+        /// <summary>
+        /// Waits for the transfer started by BeginWriteRead. Returns false if it did not complete within the timeout.
+        /// </summary>
+        public virtual bool EndWriteRead( int millisecondsTimeout )
+        {
+            return true;
+        }
+
+        public virtual bool IsTransferInProgress
+        {
+            get
+            {
+                return false;
+            }
+        }
+
         public abstract void Dispose();
     }
 
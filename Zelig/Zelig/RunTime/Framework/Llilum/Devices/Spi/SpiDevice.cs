@@ -177,6 +177,61 @@ namespace Microsoft.Llilum.Devices.Spi
             m_spiChannel.Read( readBuffer, readOffset, readLength );
         }
 
+        /// <summary>
+        /// Starts a SPI transaction without waiting for it to complete. The transfer uses DMA or interrupts where the
+        /// target supports it; the buffers must not be touched until EndWriteRead returns true.
+        /// </summary>
+        /// <param name="writeBuffer">Bytes to write. If null, writes 0x0 for read</param>
+        /// <param name="writeOffset">Offset into the writeBuffer</param>
+        /// <param name="writeLength">Length of the data in bytes to write</param>
+        /// <param name="readBuffer">Bytes to read. If null, only does write</param>
+        /// <param name="readOffset">Offset into the readBuffer</param>
+        /// <param name="readLength">Length in bytes to read</param>
+        public void BeginWriteRead(byte[] writeBuffer, int writeOffset, int writeLength, byte[] readBuffer, int readOffset, int readLength)
+        {
+            ThrowIfDisposed();
+
+            if (writeBuffer == null && readBuffer == null)
+            {
+                throw new ArgumentException();
+            }
+
+            if (m_spiChannel.IsTransferInProgress)
+            {
+                throw new InvalidOperationException();
+            }
+
+            m_spiChannel.BeginWriteRead(writeBuffer, writeOffset, writeLength, readBuffer, readOffset, readLength);
+        }
+
+        public void BeginWrite(byte[] writeBuffer, int writeOffset, int writeLength)
+        {
+            BeginWriteRead(writeBuffer, writeOffset, writeLength, null, 0, 0);
+        }
+
+        /// <summary>
+        /// Waits for the transaction started by BeginWriteRead or BeginWrite to complete.
+        /// </summary>
+        /// <param name="millisecondsTimeout">Time to wait, or Timeout.Infinite</param>
+        /// <returns>True if the transaction completed, false if the timeout elapsed first</returns>
+        public bool EndWriteRead(int millisecondsTimeout)
+        {
+            ThrowIfDisposed();
+
+            return m_spiChannel.EndWriteRead(millisecondsTimeout);
+        }
+
+        /// <summary>
+        /// Gets whether a transaction started by BeginWriteRead or BeginWrite is still running.
+        /// </summary>
+        public bool IsTransferInProgress
+        {
+            get
+            {
+                return m_spiChannel.IsTransferInProgress;
+            }
+        }
+
 
         /// <summary>
         /// Acquires the chip select pin if a new one is entered and releases the old one.
@@ -240,12 +240,8 @@ namespace Windows.Devices.I2c
         {
             ThrowIfDisposed();
 
-            // Do not send a stop bit on WriteRead for repeated start
-            int transferCount = WriteImpl(writeBuffer, false);
-            CheckAndThrowTransferException(transferCount, writeBuffer.Length);
-
-            transferCount = ReadImpl(readBuffer, true);
-            CheckAndThrowTransferException(transferCount, readBuffer.Length);
+            int transferCount = WriteReadImpl(writeBuffer, readBuffer);
+            CheckAndThrowTransferException(transferCount, writeBuffer.Length + readBuffer.Length);
         }
 
         /// <summary>Performs an atomic operation to write data to and then read data from the inter-integrated circuit (I2C) bus on which the device is connected, and sends a restart condition between the write and read operations.</summary>
@@ -256,47 +252,24 @@ namespace Windows.Devices.I2c
             ThrowIfDisposed();
 
             I2cTransferResult result = new I2cTransferResult();
-
-            // Do not send a stop bit on WriteRead for repeated start
-            int transferCountWrite = WriteImpl(writeBuffer, false);
-
-            if(transferCountWrite < writeBuffer.Length)
+            int transferCount = WriteReadImpl(writeBuffer, readBuffer);
+            if (transferCount < 0)
             {
-                if(transferCountWrite < 0)
-                {
-                    // Device not found at given address
-                    result.BytesTransferred = 0;
-                    result.Status = I2cTransferStatus.SlaveAddressNotAcknowledged;
-                }
-                else
-                {
-                    // Transfer was interrupted
-                    result.BytesTransferred = (uint)transferCountWrite;
-                    result.Status = I2cTransferStatus.PartialTransfer;
-                }
-                return result;
+                // Device not found at given address
+                result.BytesTransferred = 0;
+                result.Status = I2cTransferStatus.SlaveAddressNotAcknowledged;
             }
-
-            int transferCountRead = ReadImpl(readBuffer, true);
-            if (transferCountRead < readBuffer.Length)
+            else if (transferCount < writeBuffer.Length + readBuffer.Length)
             {
-                if (transferCountRead < 0)
-                {
-                    // Device not found at given address
-                    result.BytesTransferred = 0;
-                    result.Status = I2cTransferStatus.SlaveAddressNotAcknowledged;
-                }
-                else
-                {
-                    // Transfer was interrupted
-                    result.BytesTransferred = (uint)transferCountRead;
-                    result.Status = I2cTransferStatus.PartialTransfer;
-                }
-                return result;
+                // Transfer was interrupted
+                result.BytesTransferred = (uint)transferCount;
+                result.Status = I2cTransferStatus.PartialTransfer;
+            }
+            else
+            {
+                result.BytesTransferred = (uint)transferCount;
+                result.Status = I2cTransferStatus.FullTransfer;
             }
-
-            result.BytesTransferred = (uint)(transferCountWrite + transferCountRead);
-            result.Status = I2cTransferStatus.FullTransfer;
 
             return result;
         }
@@ -371,6 +344,21 @@ namespace Windows.Devices.I2c
             }
         }
 
+        /// <summary>
+        /// Writes and then reads over the I2C channel in one transaction, with a repeated start in between
+        /// </summary>
+        /// <param name="writeBuffer">Data to write</param>
+        /// <param name="readBuffer">Placeholder for read data</param>
+        /// <returns>Total number of bytes transferred</returns>
+        private int WriteReadImpl(byte[] writeBuffer, byte[] readBuffer)
+        {
+            lock (m_channelContainer.TransactionLock)
+            {
+                ChangeFrequencyIfneeded();
+                return m_channelContainer.Channel.WriteRead(writeBuffer, 0, writeBuffer.Length, readBuffer, 0, readBuffer.Length, m_settings.SlaveAddress);
+            }
+        }
+
         /// <summary>
         /// Since channels are shared between devices, we need this helper method to check the
         /// current channel frequency, and change it if the device being used needs a different one
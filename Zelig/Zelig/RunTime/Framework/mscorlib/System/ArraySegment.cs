@@ -0,0 +1,121 @@
+// ==++==
+//
+//   Copyright (c) Microsoft Corporation.  All rights reserved.
+//
+// ==--==
+/*============================================================
+**
+** Class:  ArraySegment<T>
+**
+**
+** Purpose: Convenient wrapper for an array, an offset, and
+**          a count.  Ideally used in streams & collections.
+**          Net Classes will consume an array of these.
+**
+**
+===========================================================*/
+namespace System
+{
+    using System;
+
+    [Serializable]
+    public struct ArraySegment<T>
+    {
+        private T[] m_array;
+        private int m_offset;
+        private int m_count;
+
+        public ArraySegment( T[] array )
+        {
+            if(array == null)
+            {
+                throw new ArgumentNullException( "array" );
+            }
+
+            m_array  = array;
+            m_offset = 0;
+            m_count  = array.Length;
+        }
+
+        public ArraySegment( T[] array, int offset, int count )
+        {
+            if(array == null)
+            {
+                throw new ArgumentNullException( "array" );
+            }
+
+            if(offset < 0)
+            {
+                throw new ArgumentOutOfRangeException( "offset", Environment.GetResourceString( "ArgumentOutOfRange_NeedNonNegNum" ) );
+            }
+
+            if(count < 0)
+            {
+                throw new ArgumentOutOfRangeException( "count", Environment.GetResourceString( "ArgumentOutOfRange_NeedNonNegNum" ) );
+            }
+
+            if(array.Length - offset < count)
+            {
+                throw new ArgumentException( Environment.GetResourceString( "Argument_InvalidOffLen" ) );
+            }
+
+            m_array  = array;
+            m_offset = offset;
+            m_count  = count;
+        }
+
+        public T[] Array
+        {
+            get
+            {
+                return m_array;
+            }
+        }
+
+        public int Offset
+        {
+            get
+            {
+                return m_offset;
+            }
+        }
+
+        public int Count
+        {
+            get
+            {
+                return m_count;
+            }
+        }
+
+        public override int GetHashCode()
+        {
+            return null == m_array ? 0 : m_array.GetHashCode() ^ m_offset ^ m_count;
+        }
+
+        public override bool Equals( Object obj )
+        {
+            if(obj is ArraySegment<T>)
+            {
+                return Equals( (ArraySegment<T>)obj );
+            }
+
+            return false;
+        }
+
+        public bool Equals( ArraySegment<T> obj )
+        {
+            return obj.m_array == m_array && obj.m_offset == m_offset && obj.m_count == m_count;
+        }
+
+        public static bool operator ==( ArraySegment<T> a, ArraySegment<T> b )
+        {
+            return a.Equals( b );
+        }
+
+        public static bool operator !=( ArraySegment<T> a, ArraySegment<T> b )
+        {
+            return !(a == b);
+        }
+    }
+}
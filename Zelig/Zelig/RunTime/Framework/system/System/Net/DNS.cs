@@ -18,6 +18,11 @@ namespace System.Net
 
             NativeSocket.getaddrinfo(hostNameOrAddress, out canonicalName, out addresses);
 
+            if (addresses == null)
+            {
+                throw new SocketException(SocketError.HostNotFound);
+            }
+
             int cAddresses = addresses.Length;
             IPAddress[] ipAddresses = new IPAddress[cAddresses];
             IPHostEntry ipHostEntry = new IPHostEntry();
@@ -50,6 +55,21 @@ namespace System.Net
 
             return ipHostEntry;
         }
+
+        //
+        // Starts resolving a host name in the background and returns right away, so that the lookup can overlap
+        // other connection setup; a later GetHostEntry for the same name is then answered from the native cache.
+        // Returns false if the lookup could not be started.
+        //
+        public static bool Prefetch(string hostName)
+        {
+            if (hostName == null)
+            {
+                throw new ArgumentNullException("hostName");
+            }
+
+            return NativeSocket.prefetchaddrinfo(hostName) >= 0;
+        }
     }
 }
 
@@ -7,6 +7,8 @@
 
 namespace Microsoft.Llilum.Net
 {
+    using System;
+    using System.Collections.Generic;
     using System.Runtime.CompilerServices;
 
     internal static class SocketNative
@@ -28,6 +30,12 @@ namespace Microsoft.Llilum.Net
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         public static extern int recv(int socket, byte[] buf, int offset, int count, int flags, int timeout_ms);
 
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        public static extern int sendv(int socket, IList<ArraySegment<byte>> buffers, int flags, int timeout_ms);
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        public static extern int recvv(int socket, IList<ArraySegment<byte>> buffers, int flags, int timeout_ms);
+
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         public static extern int close(int socket);
 
@@ -41,6 +49,9 @@ namespace Microsoft.Llilum.Net
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         public static extern void getaddrinfo(string name, out string canonicalName, out byte[][] addresses);
 
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        public static extern int prefetchaddrinfo(string name);
+
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         public static extern void shutdown(int socket, int how, out int err);
 
@@ -65,6 +76,9 @@ namespace Microsoft.Llilum.Net
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         public static extern bool poll(int socket, int mode, int microSeconds);
 
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        public static extern int select(int[] readSockets, ref int readCount, int[] writeSockets, ref int writeCount, int[] errorSockets, ref int errorCount, int microSeconds);
+
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         public static extern void ioctl(int socket, uint cmd, ref uint arg);
     }
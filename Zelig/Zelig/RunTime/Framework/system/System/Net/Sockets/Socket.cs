@@ -6,6 +6,8 @@
 
 namespace System.Net.Sockets
 {
+    using System.Collections;
+    using System.Collections.Generic;
     using System.Net;
     using System.Runtime.CompilerServices;
     using System.Threading;
@@ -223,6 +225,30 @@ namespace System.Net.Sockets
             return NativeSocket.send(this.m_handle, buffer, offset, size, (int)socketFlags, m_sendTimeout);
         }
 
+        public int Send(IList<ArraySegment<byte>> buffers)
+        {
+            return Send(buffers, SocketFlags.None);
+        }
+
+        //
+        // Sends all segments in one call, e.g. protocol headers and a body, without first copying them into a single
+        // array. On stream sockets the segments are coalesced into the same TCP segments.
+        //
+        public int Send(IList<ArraySegment<byte>> buffers, SocketFlags socketFlags)
+        {
+            if (m_handle == -1)
+            {
+                throw new ObjectDisposedException( "" );
+            }
+
+            if (buffers == null || buffers.Count == 0)
+            {
+                throw new ArgumentNullException( "buffers" );
+            }
+
+            return NativeSocket.sendv(this.m_handle, buffers, (int)socketFlags, m_sendTimeout);
+        }
+
         public int SendTo(byte[] buffer, int offset, int size, SocketFlags socketFlags, EndPoint remoteEP)
         {
             if (m_handle == -1)
@@ -275,6 +301,29 @@ namespace System.Net.Sockets
             return NativeSocket.recv(this.m_handle, buffer, offset, size, (int)socketFlags, m_recvTimeout);
         }
 
+        public int Receive(IList<ArraySegment<byte>> buffers)
+        {
+            return Receive(buffers, SocketFlags.None);
+        }
+
+        //
+        // Fills the segments in order. Only waits for the first bytes, then takes whatever else is already received.
+        //
+        public int Receive(IList<ArraySegment<byte>> buffers, SocketFlags socketFlags)
+        {
+            if (m_handle == -1)
+            {
+                throw new ObjectDisposedException( "" );
+            }
+
+            if (buffers == null || buffers.Count == 0)
+            {
+                throw new ArgumentNullException( "buffers" );
+            }
+
+            return NativeSocket.recvv(this.m_handle, buffers, (int)socketFlags, m_recvTimeout);
+        }
+
         public int ReceiveFrom(byte[] buffer, int offset, int size, SocketFlags socketFlags, ref EndPoint remoteEP)
         {
             if (m_handle == -1)
@@ -390,6 +439,87 @@ namespace System.Net.Sockets
             return NativeSocket.poll(this.m_handle, (int)mode, microSeconds);
         }
 
+        public static void Select(IList checkRead, IList checkWrite, IList checkError, int microSeconds)
+        {
+            if((checkRead  == null || checkRead .Count == 0) &&
+               (checkWrite == null || checkWrite.Count == 0) &&
+               (checkError == null || checkError.Count == 0))
+            {
+                throw new ArgumentNullException( );
+            }
+
+            int   readCount;
+            int   writeCount;
+            int   errorCount;
+            int[] readHandles  = GetHandles( checkRead , out readCount  );
+            int[] writeHandles = GetHandles( checkWrite, out writeCount );
+            int[] errorHandles = GetHandles( checkError, out errorCount );
+
+            if(NativeSocket.select( readHandles, ref readCount, writeHandles, ref writeCount, errorHandles, ref errorCount, microSeconds ) < 0)
+            {
+                throw new SocketException( SocketError.SocketError );
+            }
+
+            RemoveNotReady( checkRead , readHandles , readCount  );
+            RemoveNotReady( checkWrite, writeHandles, writeCount );
+            RemoveNotReady( checkError, errorHandles, errorCount );
+        }
+
+        private static int[] GetHandles(IList sockets, out int count)
+        {
+            count = ( sockets == null ) ? 0 : sockets.Count;
+
+            if(count == 0)
+            {
+                return null;
+            }
+
+            int[] handles = new int[ count ];
+
+            for(int i = 0; i < count; i++)
+            {
+                Socket socket = sockets[ i ] as Socket;
+
+                if(socket == null)
+                {
+                    throw new ArgumentException( );
+                }
+
+                if(socket.m_handle == -1)
+                {
+                    throw new ObjectDisposedException( "" );
+                }
+
+                handles[ i ] = socket.m_handle;
+            }
+
+            return handles;
+        }
+
+        // The native side keeps the ready handles in their original order, so a single pass matches them up.
+        private static void RemoveNotReady(IList sockets, int[] readyHandles, int readyCount)
+        {
+            if(sockets == null)
+            {
+                return;
+            }
+
+            int ready = 0;
+
+            for(int i = 0; i < sockets.Count; )
+            {
+                if(ready < readyCount && ( (Socket)sockets[ i ] ).m_handle == readyHandles[ ready ])
+                {
+                    ready++;
+                    i++;
+                }
+                else
+                {
+                    sockets.RemoveAt( i );
+                }
+            }
+        }
+
         [MethodImplAttribute(MethodImplOptions.Synchronized)]
         protected virtual void Dispose(bool disposing)
         {
@@ -302,7 +302,7 @@ namespace Microsoft.Zelig.Runtime
 
                 if(fInvalidateTimer)
                 {
-                    ThreadManager.Instance.InvalidateNextWaitTimer();
+                    ThreadManager.Instance.LowerNextWaitTimer( timeout );
                 }
             }
         }
@@ -311,14 +311,10 @@ namespace Microsoft.Zelig.Runtime
         {
             BugCheck.AssertInterruptsOff();
 
+            //
+            // No need to touch the wait timer, see ThreadManager.LowerNextWaitTimer.
+            //
             node.RemoveFromList();
-
-            SchedulerTime timeout = node.Target.Timeout;
-
-            if(timeout != SchedulerTime.MaxValue)
-            {
-                ThreadManager.Instance.InvalidateNextWaitTimer();
-            }
         }
 
         public SchedulerTime GetFirstTimeout()
@@ -72,6 +72,21 @@ namespace Microsoft.Zelig.Runtime
             {
                 throw new NotImplementedException();
             }
+
+            public override int GetPoolStatistics(int pool, out uint available, out uint used, out uint maxUsed, out uint failures)
+            {
+                throw new NotImplementedException();
+            }
+
+            public override int GetTrafficStatistics(out uint framesSent, out uint framesReceived, out uint framesDropped, out uint segmentsSent, out uint segmentsReceived, out uint segmentsDropped, out uint retransmitting)
+            {
+                throw new NotImplementedException();
+            }
+
+            public override int ResetStatistics()
+            {
+                throw new NotImplementedException();
+            }
         }
 
         public abstract int InitializeEthernet();
@@ -98,6 +113,12 @@ namespace Microsoft.Zelig.Runtime
 
         public abstract void RemapInterrupts();
 
+        public abstract int GetPoolStatistics(int pool, out uint available, out uint used, out uint maxUsed, out uint failures);
+
+        public abstract int GetTrafficStatistics(out uint framesSent, out uint framesReceived, out uint framesDropped, out uint segmentsSent, out uint segmentsReceived, out uint segmentsDropped, out uint retransmitting);
+
+        public abstract int ResetStatistics();
+
         //--//
 
         public static extern NetworkInterfaceProvider Instance
@@ -4,6 +4,9 @@
 
 namespace Microsoft.Zelig.Runtime
 {
+    using System;
+    using System.Collections.Generic;
+
     [ExtendClass(typeof(Microsoft.Llilum.Net.SocketNative), NoConstructors = true)]
     public abstract class SocketNativeImpl
     {
@@ -36,6 +39,18 @@ namespace Microsoft.Zelig.Runtime
         }
 
 
+        public static int sendv(int socket, IList<ArraySegment<byte>> buffers, int flags, int timeout_ms)
+        {
+            return SocketProvider.Instance.sendv(socket, buffers, flags, timeout_ms);
+        }
+
+
+        public static int recvv(int socket, IList<ArraySegment<byte>> buffers, int flags, int timeout_ms)
+        {
+            return SocketProvider.Instance.recvv(socket, buffers, flags, timeout_ms);
+        }
+
+
         public static int close(int socket)
         {
             return SocketProvider.Instance.close(socket);
@@ -58,6 +73,11 @@ namespace Microsoft.Zelig.Runtime
             SocketProvider.Instance.getaddrinfo(name, out canonicalName, out addresses);
         }
 
+        public static int prefetchaddrinfo(string name)
+        {
+            return SocketProvider.Instance.prefetchaddrinfo(name);
+        }
+
 
         public static void shutdown(int socket, int how, out int err)
         {
@@ -107,6 +127,12 @@ namespace Microsoft.Zelig.Runtime
         }
 
 
+        public static int select(int[] readSockets, ref int readCount, int[] writeSockets, ref int writeCount, int[] errorSockets, ref int errorCount, int microSeconds)
+        {
+            return SocketProvider.Instance.select(readSockets, ref readCount, writeSockets, ref writeCount, errorSockets, ref errorCount, microSeconds);
+        }
+
+
         public static void ioctl(int socket, uint cmd, ref uint arg)
         {
             SocketProvider.Instance.ioctl(socket, cmd, ref arg);
@@ -6,6 +6,7 @@
 namespace Microsoft.Zelig.Runtime
 {
     using System;
+    using System.Collections.Generic;
     using System.Runtime.CompilerServices;
 
     [ImplicitInstance]
@@ -44,6 +45,11 @@ namespace Microsoft.Zelig.Runtime
                 throw new NotImplementedException();
             }
 
+            public override int prefetchaddrinfo(string name)
+            {
+                throw new NotImplementedException();
+            }
+
             public override int getsockname(int socket, out byte[] address)
             {
                 throw new NotImplementedException();
@@ -74,6 +80,21 @@ namespace Microsoft.Zelig.Runtime
                 throw new NotImplementedException();
             }
 
+            public override int sendv(int socket, IList<ArraySegment<byte>> buffers, int flags, int timeout_ms)
+            {
+                throw new NotImplementedException();
+            }
+
+            public override int recvv(int socket, IList<ArraySegment<byte>> buffers, int flags, int timeout_ms)
+            {
+                throw new NotImplementedException();
+            }
+
+            public override int select(int[] readSockets, ref int readCount, int[] writeSockets, ref int writeCount, int[] errorSockets, ref int errorCount, int microSeconds)
+            {
+                throw new NotImplementedException();
+            }
+
             public override int recvfrom(int socket, byte[] buf, int offset, int count, int flags, int timeout_ms, ref byte[] address)
             {
                 throw new NotImplementedException();
@@ -121,6 +142,12 @@ namespace Microsoft.Zelig.Runtime
         public abstract int recv(int socket, byte[] buf, int offset, int count, int flags, int timeout_ms);
 
         
+        public abstract int sendv(int socket, IList<ArraySegment<byte>> buffers, int flags, int timeout_ms);
+
+        
+        public abstract int recvv(int socket, IList<ArraySegment<byte>> buffers, int flags, int timeout_ms);
+
+        
         public abstract int close(int socket);
 
         
@@ -134,6 +161,9 @@ namespace Microsoft.Zelig.Runtime
         public abstract int getaddrinfo(string name, out string canonicalName, out byte[][] addresses);
 
         
+        public abstract int prefetchaddrinfo(string name);
+
+        
         public abstract void shutdown(int socket, int how, out int err);
 
         
@@ -158,6 +188,9 @@ namespace Microsoft.Zelig.Runtime
         public abstract bool poll(int socket, int mode, int microSeconds);
 
         
+        public abstract int select(int[] readSockets, ref int readCount, int[] writeSockets, ref int writeCount, int[] errorSockets, ref int errorCount, int microSeconds);
+
+        
         public abstract int ioctl(int socket, uint cmd, ref uint arg);
 
         public static extern SocketProvider Instance
@@ -100,6 +100,7 @@ namespace Microsoft.Zelig.Runtime
         protected ThreadImpl                      m_idleThread;
         protected EventWaitHandleImpl             m_neverSignaledEvent;
         protected bool                            m_noInvalidateNextWaitTimerRecursion;
+        protected SchedulerTime                   m_nextWaitTimeout;
                                           
         //--//                            
                                           
@@ -168,6 +169,7 @@ namespace Microsoft.Zelig.Runtime
             m_allThreads          = new KernelList< ThreadImpl >();
             m_readyThreads        = new KernelList< ThreadImpl >();
             m_waitingThreads      = new KernelList< ThreadImpl >();
+            m_nextWaitTimeout     = SchedulerTime.MaxValue;
 
             m_idleThread          = new ThreadImpl( IdleThread, systemStack );
             m_neverSignaledEvent  = new EventWaitHandleImpl( false, System.Threading.EventResetMode.ManualReset );
@@ -291,7 +293,7 @@ namespace Microsoft.Zelig.Runtime
 
                     thread.State |= System.Threading.ThreadState.WaitSleepJoin;
 
-                    InvalidateNextWaitTimer();
+                    LowerNextWaitTimer( thread.GetFirstTimeout() );
 
                     RescheduleAndRequestContextSwitchIfNeeded( hnd.GetCurrentExceptionMode() );
 
@@ -428,6 +430,22 @@ namespace Microsoft.Zelig.Runtime
             }
         }
 
+        //
+        // Waits only ever move the wait timer earlier, which is O(1). Waits going away leave it where it is: at worst
+        // it fires early, and WaitExpired walks the waiting threads anyway, so that is where the timer is recomputed.
+        //
+        public void LowerNextWaitTimer( SchedulerTime timeout )
+        {
+            BugCheck.AssertInterruptsOff();
+
+            if(m_noInvalidateNextWaitTimerRecursion == false && timeout < m_nextWaitTimeout)
+            {
+                m_nextWaitTimeout = timeout;
+
+                SetNextWaitTimer( timeout );
+            }
+        }
+
         protected void WaitExpired( SchedulerTime currentTime )
         {
             m_noInvalidateNextWaitTimerRecursion = true;
@@ -465,6 +483,8 @@ namespace Microsoft.Zelig.Runtime
                 node = node.Next;
             }
 
+            m_nextWaitTimeout = nextTimeout;
+
             SetNextWaitTimer( nextTimeout );
         }
 
@@ -4,6 +4,8 @@
 
 namespace Microsoft.Zelig.LlilumOSAbstraction.API.IO
 {
+    using Runtime;
+    using System;
     using System.Runtime.InteropServices;
 
     public enum AdcDirection
@@ -12,6 +14,8 @@ namespace Microsoft.Zelig.LlilumOSAbstraction.API.IO
         Output,
     };
 
+    public unsafe delegate void LLOS_ADC_SamplesCallback( AdcContext* channel, UIntPtr callbackCtx, ushort* pSamples, int sampleCount );
+
     public static class Adc
     {
         [DllImport( "C" )]
@@ -34,6 +38,26 @@ namespace Microsoft.Zelig.LlilumOSAbstraction.API.IO
 
         [DllImport( "C" )]
         public static unsafe extern uint LLOS_ADC_GetPrecisionBits(AdcContext* channel, uint* pPrecisionBits);
+
+        public static unsafe uint LLOS_ADC_StartSampling( AdcContext* channel, uint sampleRateHz, ushort* pBuffer, int bufferLength, LLOS_ADC_SamplesCallback callback, UIntPtr callbackCtx )
+        {
+            UIntPtr callback_ptr = UIntPtr.Zero;
+
+            if(callback != null)
+            {
+                DelegateImpl dlg = (DelegateImpl)(object)callback;
+
+                callback_ptr = new UIntPtr( dlg.InnerGetCodePointer( ).Target.ToPointer( ) );
+            }
+
+            return LLOS_ADC_StartSampling( channel, sampleRateHz, pBuffer, bufferLength, callback_ptr, callbackCtx );
+        }
+
+        [DllImport( "C" )]
+        private static unsafe extern uint LLOS_ADC_StartSampling( AdcContext* channel, uint sampleRateHz, ushort* pBuffer, int bufferLength, UIntPtr callback, UIntPtr callbackCtx );
+
+        [DllImport( "C" )]
+        public static unsafe extern uint LLOS_ADC_StopSampling( AdcContext* channel );
     }
 
     public unsafe struct AdcContext
@@ -34,5 +34,17 @@ namespace Microsoft.Zelig.LlilumOSAbstraction.API.IO
 
         [DllImport("C")]
         public static extern int LLOS_ethernet_get_networkIPv4Mask(char* mask, uint bufferLen);
+
+        [DllImport("C")]
+        public static extern int LLOS_ethernet_mbox_benchmark(uint messages, uint* elapsedUs);
+
+        [DllImport("C")]
+        public static extern int LLOS_ethernet_get_pool_stats(uint pool, uint* available, uint* used, uint* maxUsed, uint* failures);
+
+        [DllImport("C")]
+        public static extern int LLOS_ethernet_get_traffic_stats(uint* framesSent, uint* framesReceived, uint* framesDropped, uint* segmentsSent, uint* segmentsReceived, uint* segmentsDropped, uint* retransmitting);
+
+        [DllImport("C")]
+        public static extern int LLOS_ethernet_reset_stats();
     }
 }
@@ -8,6 +8,25 @@ namespace Microsoft.Zelig.LlilumOSAbstraction.API.IO
     using System.Runtime.InteropServices;
 
 
+    public enum I2CSegmentFlags : uint
+    {
+        Write = 0x0,
+        Read  = 0x1,
+        Stop  = 0x2,
+    }
+
+    //
+    // !!!WARNING!!! This structure MUST be identical to the C structure LLOS_I2C_Segment in llos_i2c.h
+    //
+    [StructLayout( LayoutKind.Sequential )]
+    public unsafe struct I2CSegment
+    {
+        public byte*           Buffer;
+        public int             Offset;
+        public int             Length;
+        public I2CSegmentFlags Flags;
+    }
+
     public static class I2C
     {
         [DllImport( "C" )]
@@ -33,6 +52,9 @@ namespace Microsoft.Zelig.LlilumOSAbstraction.API.IO
 
         [DllImport( "C" )]
         public static unsafe extern uint LLOS_I2C_Reset( I2CContext* channel );
+
+        [DllImport( "C" )]
+        public static unsafe extern uint LLOS_I2C_Transaction( I2CContext* channel, uint address, I2CSegment* pSegments, int segmentCount, int* pTransferred );
     }
 
     public unsafe struct I2CContext
@@ -38,6 +38,8 @@ namespace Microsoft.Zelig.LlilumOSAbstraction.API.IO
         public uint DataBits;
         public SerialPortStopBits StopBits;
         public uint SoftwareFlowControlValue;
+        public uint RxBufferSize;
+        public uint TxBufferSize;
     };
 
     public enum SerialPortEvent
@@ -79,7 +81,7 @@ namespace Microsoft.Zelig.LlilumOSAbstraction.API.IO
         public static unsafe extern uint LLOS_SERIAL_Read(SerialPortContext* channel, byte* pBuffer, int offset, int* pLength);
 
         [DllImport( "C" )]
-        public static unsafe extern uint LLOS_SERIAL_Write(SerialPortContext* channel, byte* pBuffer, int offset, int length);
+        public static unsafe extern uint LLOS_SERIAL_Write(SerialPortContext* channel, byte* pBuffer, int offset, int* pLength);
 
         [DllImport( "C" )]
         public static unsafe extern uint LLOS_SERIAL_Flush(SerialPortContext* channel);
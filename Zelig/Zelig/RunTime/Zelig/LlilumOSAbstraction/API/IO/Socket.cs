@@ -23,6 +23,13 @@ namespace Microsoft.Zelig.LlilumOSAbstraction.API.IO
         [DllImport("C")]
         public static extern int LLOS_lwip_recv(int socket, byte* buf, int count, int flags, int timeout_ms);
 
+        // Scatter/gather, 'buffers' holds the address of each segment
+        [DllImport("C")]
+        public static extern int LLOS_lwip_sendv(int socket, uint* buffers, int* counts, int segmentCount, int flags, int timeout_ms);
+
+        [DllImport("C")]
+        public static extern int LLOS_lwip_recvv(int socket, uint* buffers, int* counts, int segmentCount, int flags, int timeout_ms);
+
         [DllImport("C")]
         public static extern int LLOS_lwip_close(int socket);
 
@@ -36,6 +43,9 @@ namespace Microsoft.Zelig.LlilumOSAbstraction.API.IO
         [DllImport("C")]
         public static extern int LLOS_lwip_getaddrinfo(char* name, uint namelen, byte* canonicalName, uint canonicalNameBufferSize, byte* addresses, uint addressesBufferSize);
 
+        [DllImport("C")]
+        public static extern int LLOS_lwip_getaddrinfo_async(char* name, uint namelen);
+
         [DllImport("C")]
         public static extern int LLOS_lwip_shutdown(int socket, int how);
 
@@ -60,6 +70,9 @@ namespace Microsoft.Zelig.LlilumOSAbstraction.API.IO
         [DllImport("C")]
         public static extern bool LLOS_lwip_poll(int socket, int mode, int microSeconds);
 
+        [DllImport("C")]
+        public static extern int LLOS_lwip_select(int* readSockets, int* readCount, int* writeSockets, int* writeCount, int* errorSockets, int* errorCount, int microSeconds);
+
         [DllImport("C")]
         public static extern int LLOS_lwip_ioctl(int socket, uint cmd, uint* arg);
     }
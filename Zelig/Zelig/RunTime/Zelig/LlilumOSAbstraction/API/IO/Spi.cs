@@ -86,6 +86,12 @@ namespace Microsoft.Zelig.LlilumOSAbstraction.API.IO
         [DllImport( "C" )]
         public static unsafe extern uint LLOS_SPI_IsBusy( SpiContext* channel, uint* isBusy );
 
+        [DllImport( "C" )]
+        public static unsafe extern uint LLOS_SPI_TransferAsync( SpiContext* channel, byte* txBuffer, int txOffset, int txCount, byte* rxBuffer, int rxOffset, int rxCount );
+
+        [DllImport( "C" )]
+        public static unsafe extern uint LLOS_SPI_AbortAsync( SpiContext* channel );
+
         [DllImport( "C" )]
         public static unsafe extern uint LLOS_SPI_Suspend( SpiContext* channel );
 
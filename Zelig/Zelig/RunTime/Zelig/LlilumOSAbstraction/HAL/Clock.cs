@@ -26,5 +26,11 @@ namespace Microsoft.Zelig.LlilumOSAbstraction.HAL
 
         [DllImport( "C" )]
         public static unsafe extern uint LLOS_CLOCK_Delay(uint microSeconds);
+
+        [DllImport( "C" )]
+        public static unsafe extern void LLOS_CLOCK_Idle( );
+
+        [DllImport( "C" )]
+        public static unsafe extern uint LLOS_CLOCK_GetIdleStatistics( uint* pIdleMicroseconds, uint* pActiveMicroseconds, ulong* pTotalIdleMicroseconds );
     }
 }
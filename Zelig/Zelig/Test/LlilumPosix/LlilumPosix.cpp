@@ -0,0 +1,9 @@
+// LlilumPosix.cpp : Defines the entry point for the console application.
+//
+
+extern int LlosPosix_Main(void);
+
+int main()
+{
+    return LlosPosix_Main();
+}
@@ -41,6 +41,20 @@ namespace Microsoft.Zelig.Test.mbed.Simple
             
             TestGpioPerf();
 
+            TestRefCountPerf();
+
+            TestAdcSamplingPerf();
+
+            TestIdleStats();
+
+            TestMboxPerf();
+
+            TestChecksumPerf();
+
+            TestThreadPerf();
+
+            TestNetworkStats();
+
             TestGpioInterrupt( 5 );
             
             TestSpiLcd( );
@@ -0,0 +1,89 @@
+﻿//
+// Copyright (c) Microsoft Corporation.    All rights reserved.
+//
+
+//#define LPC1768_FOR_ADC_SAMPLING_PERF
+
+
+namespace Microsoft.Zelig.Test.mbed.Simple
+{
+    using System;
+    using System.Diagnostics;
+
+    using LPC1768 = Llilum.LPC1768;
+    using LlilumAdc = Llilum.Devices.Adc;
+
+
+    partial class Program
+    {
+        //
+        // Compares reading the ADC one sample per call against continuous sampling into a double buffer.
+        // Uses the second potentiometer of the mbed application board (p20).
+        //
+        private static void TestAdcSamplingPerf()
+        {
+#if LPC1768_FOR_ADC_SAMPLING_PERF
+            const int samples    = 0x1000;
+            const int sampleRate = 10000;
+
+            using(var adc = new LlilumAdc.AdcPin( (int)LPC1768.PinName.p20 ))
+            {
+                //
+                // Polled: one managed to native transition per sample, as fast as the CPU can go.
+                //
+                long start = Stopwatch.GetTimestamp( );
+                uint sum   = 0;
+
+                for(int i = 0; i < samples; i++)
+                {
+                    sum += adc.ReadUnsigned( );
+                }
+
+                long   elapsed = Stopwatch.GetTimestamp( ) - start;
+                double seconds = (double)elapsed / (double)Stopwatch.Frequency;
+
+                System.Diagnostics.Debug.WriteLine( "ADC polled:   " + (int)( samples / seconds ) + " samples/sec (avg " + ( sum / samples ) + ")" );
+
+                //
+                // Continuous: the native side samples from the timer interrupt and wakes us up once per half buffer.
+                //
+                var  buffer = new ushort[ 256 ];
+                int  halves = 0;
+
+                sum = 0;
+
+                adc.StartSampling( buffer, sampleRate );
+
+                start = Stopwatch.GetTimestamp( );
+
+                while(halves * ( buffer.Length / 2 ) < samples)
+                {
+                    int offset = adc.WaitForSamples( 1000 );
+
+                    if(offset < 0)
+                    {
+                        break;
+                    }
+
+                    for(int i = offset; i < offset + buffer.Length / 2; i++)
+                    {
+                        sum += buffer[ i ];
+                    }
+
+                    halves++;
+                }
+
+                elapsed = Stopwatch.GetTimestamp( ) - start;
+
+                adc.StopSampling( );
+
+                seconds = (double)elapsed / (double)Stopwatch.Frequency;
+
+                int received = halves * ( buffer.Length / 2 );
+
+                System.Diagnostics.Debug.WriteLine( "ADC sampling: " + (int)( received / seconds ) + " samples/sec at " + sampleRate + " Hz requested, " + adc.SamplingOverruns + " overruns (avg " + ( received > 0 ? sum / received : 0 ) + ")" );
+            }
+#endif // LPC1768_FOR_ADC_SAMPLING_PERF
+        }
+    }
+}
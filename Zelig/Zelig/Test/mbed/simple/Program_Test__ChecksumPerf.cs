@@ -0,0 +1,105 @@
+﻿//
+// Copyright (c) Microsoft Corporation.    All rights reserved.
+//
+
+//#define CHECKSUM_PERF
+
+
+namespace Microsoft.Zelig.Test.mbed.Simple
+{
+    using System;
+    using System.Diagnostics;
+    using System.Runtime.InteropServices;
+
+    using LLOS = Microsoft.Zelig.LlilumOSAbstraction;
+
+
+    partial class Program
+    {
+        //
+        // Compares the lwIP copy and checksum primitives in lwip-sys/arch (Thumb-2 targets only): a full-sized TCP
+        // payload copied with thumb2_memcpy and then summed with thumb2_checksum, against a single pass through
+        // lwip_arch_chksum_copy. Reported as bytes per 100 core clock cycles, for aligned and misaligned buffers.
+        //
+
+        [DllImport( "C" )]
+        private static unsafe extern void thumb2_memcpy( byte* dst, byte* src, uint length );
+
+        [DllImport( "C" )]
+        private static unsafe extern ushort thumb2_checksum( byte* data, int length );
+
+        [DllImport( "C" )]
+        private static unsafe extern ushort lwip_arch_chksum_copy( byte* dst, byte* src, ushort length );
+
+        private static unsafe void TestChecksumPerf()
+        {
+#if CHECKSUM_PERF
+            const int iterations = 0x400;
+            const int length     = 1460;
+
+            byte[] source      = new byte[ length + 4 ];
+            byte[] destination = new byte[ length + 4 ];
+
+            for(int i = 0; i < source.Length; i++)
+            {
+                source[ i ] = (byte)( i * 7 + 3 );
+            }
+
+            double cyclesPerTick = (double)LLOS.HAL.Clock.LLOS_CLOCK_GetClockFrequency( ) / (double)Stopwatch.Frequency;
+
+            fixed(byte* pSource = source)
+            {
+                fixed(byte* pDestination = destination)
+                {
+                    for(int misalign = 0; misalign < 2; misalign++)
+                    {
+                        byte* src = pSource      + misalign;
+                        byte* dst = pDestination + misalign * 2;
+
+                        long   start;
+                        long   copy;
+                        long   checksum;
+                        long   fused;
+                        ushort separate = 0;
+                        ushort combined = 0;
+
+                        start = Stopwatch.GetTimestamp( );
+                        for(int i = 0; i < iterations; i++)
+                        {
+                            thumb2_memcpy( dst, src, length );
+                        }
+                        copy = Stopwatch.GetTimestamp( ) - start;
+
+                        start = Stopwatch.GetTimestamp( );
+                        for(int i = 0; i < iterations; i++)
+                        {
+                            separate = thumb2_checksum( dst, length );
+                        }
+                        checksum = Stopwatch.GetTimestamp( ) - start;
+
+                        start = Stopwatch.GetTimestamp( );
+                        for(int i = 0; i < iterations; i++)
+                        {
+                            combined = lwip_arch_chksum_copy( dst, src, length );
+                        }
+                        fused = Stopwatch.GetTimestamp( ) - start;
+
+                        System.Diagnostics.Debug.WriteLine( ( misalign == 0 ? "aligned:    " : "misaligned: " ) +
+                            "memcpy " + BytesPer100Cycles( copy, cyclesPerTick, iterations * length ) +
+                            ", memcpy+checksum " + BytesPer100Cycles( copy + checksum, cyclesPerTick, iterations * length ) +
+                            ", fused " + BytesPer100Cycles( fused, cyclesPerTick, iterations * length ) +
+                            " bytes/100 cycles" + ( separate == combined ? "" : " (CHECKSUM MISMATCH)" ) );
+                    }
+                }
+            }
+#endif // CHECKSUM_PERF
+        }
+
+        private static int BytesPer100Cycles( long ticks, double cyclesPerTick, int bytes )
+        {
+            double cycles = ticks * cyclesPerTick;
+
+            return cycles > 0 ? (int)( bytes * 100.0 / cycles ) : 0;
+        }
+    }
+}
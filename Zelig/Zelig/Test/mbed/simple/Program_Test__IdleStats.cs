@@ -0,0 +1,58 @@
+﻿//
+// Copyright (c) Microsoft Corporation.    All rights reserved.
+//
+
+//#define IDLE_STATS
+
+
+namespace Microsoft.Zelig.Test.mbed.Simple
+{
+    using System;
+    using System.Diagnostics;
+    using System.Threading;
+
+    using LLOS = Microsoft.Zelig.LlilumOSAbstraction;
+
+
+    partial class Program
+    {
+        //
+        // Reports, once per second, how much of the previous second the core spent asleep in the idle thread.
+        // Alternates between mostly sleeping and mostly spinning, so the two phases should read close to 100%
+        // idle and close to 100% active respectively.
+        //
+        private static unsafe void TestIdleStats()
+        {
+#if IDLE_STATS
+            for(int phase = 0; phase < 6; phase++)
+            {
+                bool busy = ( phase & 1 ) != 0;
+
+                for(int second = 0; second < 3; second++)
+                {
+                    if(busy)
+                    {
+                        long end = Stopwatch.GetTimestamp( ) + Stopwatch.Frequency;
+
+                        while(Stopwatch.GetTimestamp( ) < end)
+                        {
+                        }
+                    }
+                    else
+                    {
+                        Thread.Sleep( 1000 );
+                    }
+
+                    uint  idle;
+                    uint  active;
+                    ulong total;
+
+                    LLOS.HAL.Clock.LLOS_CLOCK_GetIdleStatistics( &idle, &active, &total );
+
+                    System.Diagnostics.Debug.WriteLine( ( busy ? "busy:  " : "sleep: " ) + "idle " + ( idle / 1000 ) + " ms, active " + ( active / 1000 ) + " ms, total idle " + (int)( total / 1000000 ) + " s" );
+                }
+            }
+#endif // IDLE_STATS
+        }
+    }
+}
@@ -0,0 +1,48 @@
+﻿//
+// Copyright (c) Microsoft Corporation.    All rights reserved.
+//
+
+//#define MBOX_PERF
+
+
+namespace Microsoft.Zelig.Test.mbed.Simple
+{
+    using System;
+
+    using LLOS = Microsoft.Zelig.LlilumOSAbstraction;
+
+
+    partial class Program
+    {
+        //
+        // Measures how many messages per second go through the lwIP tcpip thread's mailbox. Only the stack is brought
+        // up, no link or address is needed. Build lwIP with SYS_ARCH_NATIVE_MBOX set to 0 (lwip-sys/arch/sys_arch.h)
+        // to get the numbers for the CMSIS-RTOS message queues.
+        //
+        private static unsafe void TestMboxPerf()
+        {
+#if MBOX_PERF
+            const uint messages = 10000;
+
+            if(LLOS.API.IO.EthernetInterface.LLOS_ethernet_dhcp_init( ) != 0)
+            {
+                System.Diagnostics.Debug.WriteLine( "Mailbox benchmark: network stack failed to initialize" );
+                return;
+            }
+
+            for(int run = 0; run < 3; run++)
+            {
+                uint elapsedUs;
+
+                if(LLOS.API.IO.EthernetInterface.LLOS_ethernet_mbox_benchmark( messages, &elapsedUs ) != 0)
+                {
+                    System.Diagnostics.Debug.WriteLine( "Mailbox benchmark failed" );
+                    return;
+                }
+
+                System.Diagnostics.Debug.WriteLine( "Mailbox: " + messages + " messages in " + ( elapsedUs / 1000 ) + " ms, " + (int)( messages * 1000000.0 / elapsedUs ) + " msgs/sec" );
+            }
+#endif // MBOX_PERF
+        }
+    }
+}
@@ -0,0 +1,54 @@
+﻿//
+// Copyright (c) Microsoft Corporation.    All rights reserved.
+//
+
+//#define NETWORK_STATS
+
+
+namespace Microsoft.Zelig.Test.mbed.Simple
+{
+    using System;
+
+    using Microsoft.Llilum.Lwip;
+
+
+    partial class Program
+    {
+        //
+        // Brings up DHCP and dumps the lwIP pool usage and link/TCP counters, to check the buffer profile
+        // selected for the board. Run after some traffic to see the high-water marks and allocation failures.
+        // The pool usage and TCP counters need the native side built with LWIP_POOL_TUNING=1 and a matching
+        // liblwIP.a; the link counters are always there.
+        //
+
+        private static void TestNetworkStats()
+        {
+#if NETWORK_STATS
+            NetworkInterface.GetAllNetworkInterfaces( )[ 0 ].EnableDhcp( );
+
+            NetworkStatistics.Reset( );
+
+            for(NetworkPool pool = NetworkPool.Heap; pool <= NetworkPool.Timeout; pool++)
+            {
+                NetworkPoolUsage usage = NetworkStatistics.GetPoolUsage( pool );
+
+                System.Diagnostics.Debug.WriteLine( pool.ToString( ) +
+                    ": avail " + usage.Available.ToString( ) +
+                    ", used " + usage.Used.ToString( ) +
+                    ", max " + usage.MaxUsed.ToString( ) +
+                    ", failed " + usage.Failures.ToString( ) );
+            }
+
+            NetworkTrafficStatistics traffic = NetworkStatistics.GetTraffic( );
+
+            System.Diagnostics.Debug.WriteLine( "link: xmit " + traffic.FramesSent.ToString( ) +
+                ", recv " + traffic.FramesReceived.ToString( ) +
+                ", drop " + traffic.FramesDropped.ToString( ) );
+            System.Diagnostics.Debug.WriteLine( "tcp:  xmit " + traffic.SegmentsSent.ToString( ) +
+                ", recv " + traffic.SegmentsReceived.ToString( ) +
+                ", drop " + traffic.SegmentsDropped.ToString( ) +
+                ", rexmit " + traffic.Retransmitting.ToString( ) );
+#endif // NETWORK_STATS
+        }
+    }
+}
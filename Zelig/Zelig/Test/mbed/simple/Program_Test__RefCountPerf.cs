@@ -0,0 +1,78 @@
+﻿//
+// Copyright (c) Microsoft Corporation.    All rights reserved.
+//
+
+//#define REFCOUNT_PERF
+
+
+namespace Microsoft.Zelig.Test.mbed.Simple
+{
+    using System;
+    using System.Diagnostics;
+    using System.Runtime.InteropServices;
+
+    using RT   = Microsoft.Zelig.Runtime;
+    using TS   = Microsoft.Zelig.Runtime.TypeSystem;
+    using LLOS = Microsoft.Zelig.LlilumOSAbstraction;
+
+
+    partial class Program
+    {
+        //
+        // Micro-benchmark for the native reference counting primitives in mbed_mem.cpp.
+        // Reports the average number of core clock cycles per AddReference/ReleaseReferenceNative
+        // pair, with the loop overhead subtracted. It only depends on the core clock and the
+        // performance counter, so it runs on QEMU's Cortex-M3/M4 machines as well as on boards.
+        //
+
+        [DllImport( "C" )]
+        private static extern void AddReference( object obj );
+
+        [DllImport( "C" )]
+        private static extern int ReleaseReferenceNative( object obj );
+
+        [TS.DisableAutomaticReferenceCounting]
+        private static void TestRefCountPerf()
+        {
+#if REFCOUNT_PERF
+            const int iterations = 0x4000;
+
+            object target = new object( );
+
+            // Give the object a non-zero count so that the native calls take the full path.
+            RT.ObjectHeader.Unpack( target ).MultiUseWord |= ( 1 << RT.ObjectHeader.ReferenceCountShift );
+
+            long overhead = 0;
+            long addRef   = 0;
+            long release  = 0;
+            long start;
+
+            start = Stopwatch.GetTimestamp( );
+            for(int i = 0; i < iterations; i++)
+            {
+                RT.ObjectHeader.Unpack( target );
+            }
+            overhead = Stopwatch.GetTimestamp( ) - start;
+
+            start = Stopwatch.GetTimestamp( );
+            for(int i = 0; i < iterations; i++)
+            {
+                AddReference( target );
+            }
+            addRef = Stopwatch.GetTimestamp( ) - start;
+
+            start = Stopwatch.GetTimestamp( );
+            for(int i = 0; i < iterations; i++)
+            {
+                ReleaseReferenceNative( target );
+            }
+            release = Stopwatch.GetTimestamp( ) - start;
+
+            double cyclesPerTick = (double)LLOS.HAL.Clock.LLOS_CLOCK_GetClockFrequency( ) / (double)Stopwatch.Frequency;
+
+            System.Diagnostics.Debug.WriteLine( "AddReference:           " + (int)( ( addRef  - overhead ) * cyclesPerTick / iterations ) + " cycles" );
+            System.Diagnostics.Debug.WriteLine( "ReleaseReferenceNative: " + (int)( ( release - overhead ) * cyclesPerTick / iterations ) + " cycles" );
+#endif // REFCOUNT_PERF
+        }
+    }
+}
@@ -0,0 +1,57 @@
+﻿//
+// Copyright (c) Microsoft Corporation.    All rights reserved.
+//
+
+//#define THREAD_PERF
+
+
+namespace Microsoft.Zelig.Test.mbed.Simple
+{
+    using System;
+    using System.Runtime.InteropServices;
+
+
+    partial class Program
+    {
+        //
+        // Runs the native scheduler benchmarks of os_layer/inc/llos_thread_benchmark.h, the same code the POSIX port
+        // runs in HostTests/ThreadBenchmark, so the two sets of numbers compare directly.
+        //
+
+        private const uint c_ThreadBenchmark_SignalWait = 0;
+        private const uint c_ThreadBenchmark_Yield      = 1;
+
+        [DllImport( "C" )]
+        private static unsafe extern uint LLOS_THREAD_RunBenchmark( uint benchmark, uint threads, uint iterations, ulong* elapsedUs );
+
+        private static unsafe void TestThreadPerf()
+        {
+#if THREAD_PERF
+            const uint roundTrips = 10000;
+            const uint threads    = 4;
+            const uint yields     = 10000;
+
+            for(int run = 0; run < 3; run++)
+            {
+                ulong elapsedUs;
+
+                if(LLOS_THREAD_RunBenchmark( c_ThreadBenchmark_SignalWait, 0, roundTrips, &elapsedUs ) != 0)
+                {
+                    System.Diagnostics.Debug.WriteLine( "Signal/wait benchmark failed" );
+                    return;
+                }
+
+                System.Diagnostics.Debug.WriteLine( "Signal/wait: " + roundTrips + " round trips in " + (uint)( elapsedUs / 1000 ) + " ms, " + (uint)( elapsedUs * 1000 / roundTrips ) + " ns per round trip" );
+
+                if(LLOS_THREAD_RunBenchmark( c_ThreadBenchmark_Yield, threads, yields, &elapsedUs ) != 0)
+                {
+                    System.Diagnostics.Debug.WriteLine( "Yield benchmark failed" );
+                    return;
+                }
+
+                System.Diagnostics.Debug.WriteLine( "Yield: " + threads + " threads x " + yields + " yields in " + (uint)( elapsedUs / 1000 ) + " ms, " + (uint)( elapsedUs * 1000 / ( threads * yields ) ) + " ns per yield" );
+            }
+#endif // THREAD_PERF
+        }
+    }
+}
@@ -26,4 +26,9 @@
 
 #define MEM_SIZE                      (ENET_RX_RING_LEN * (ENET_ETH_MAX_FLEN + RX_BUF_ALIGNMENT) + ENET_TX_RING_LEN * ENET_ETH_MAX_FLEN)
 
+/* 256KB of RAM */
+#ifndef LWIP_POOL_PROFILE
+#define LWIP_POOL_PROFILE             LWIP_POOL_PROFILE_LARGE
+#endif
+
 #endif
@@ -0,0 +1,295 @@
+#include "lwip/opt.h"
+#include "lwip/tcpip.h"
+#include "lwip/pbuf.h"
+#include "lwip/stats.h"
+#include "netif/etharp.h"
+#include "cmsis_os.h"
+#include "host_emac_config.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <linux/if_tun.h>
+
+/** @defgroup lwiphost_emac Host (Linux) EMAC driver for LWIP
+ * @ingroup lwip_emac
+ *
+ * Stands in for the EMAC drivers of the boards, so that the stack and the
+ * LLOS_lwip_* interop layer can be exercised and measured on a Linux host.
+ * See host_emac_config.h for the supported devices.
+ *
+ * @{
+ */
+
+/* memory */
+static char               host_device[256];
+static int                host_fd = -1;
+static struct sockaddr_un host_peer;        /* pair: only */
+static volatile int       host_rx_enabled;
+
+/* function */
+static void host_rx_task(void *arg);
+static err_t host_etharp_output(struct netif *netif, struct pbuf *q, ip_addr_t *ipaddr);
+static err_t host_low_level_output(struct netif *netif, struct pbuf *p);
+
+int host_emac_set_device(const char *device) {
+    if (device == NULL || strlen(device) >= sizeof(host_device))
+        return -1;
+
+    if (strncmp(device, "tap:", 4) != 0 && (strncmp(device, "pair:", 5) != 0 || strchr(device, ',') == NULL))
+        return -1;
+
+    strcpy(host_device, device);
+    return 0;
+}
+
+/** \brief  Opens a TAP device, frames are read and written without the packet information header
+ *
+ *  \param[in] name  Interface name
+ *  \returns File descriptor or -1
+ */
+static int host_open_tap(const char *name) {
+    struct ifreq ifr;
+    int          fd = open("/dev/net/tun", O_RDWR);
+
+    if (fd < 0)
+        return -1;
+
+    memset(&ifr, 0, sizeof(ifr));
+    ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+    strncpy(ifr.ifr_name, name, IFNAMSIZ - 1);
+
+    if (ioctl(fd, TUNSETIFF, (void*)&ifr) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/** \brief  Binds an AF_UNIX datagram socket to the local path and connects it to the peer path
+ *
+ *  The peer need not exist yet: until it binds its end, frames sent to it are dropped,
+ *  which the stack sees as loss, just like a cable that is not plugged in yet.
+ *
+ *  \param[in] paths  "<local>,<peer>"
+ *  \returns File descriptor or -1
+ */
+static int host_open_pair(const char *paths) {
+    struct sockaddr_un local;
+    const char         *peer = strchr(paths, ',');
+    size_t             local_len;
+    int                fd;
+
+    if (peer == NULL)
+        return -1;
+
+    local_len = (size_t)(peer - paths);
+    peer++;
+
+    if (local_len >= sizeof(local.sun_path) || strlen(peer) >= sizeof(local.sun_path))
+        return -1;
+
+    fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (fd < 0)
+        return -1;
+
+    memset(&local, 0, sizeof(local));
+    local.sun_family = AF_UNIX;
+    memcpy(local.sun_path, paths, local_len);
+    unlink(local.sun_path);
+
+    if (bind(fd, (struct sockaddr*)&local, sizeof(local)) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    memset(&host_peer, 0, sizeof(host_peer));
+    host_peer.sun_family = AF_UNIX;
+    strcpy(host_peer.sun_path, peer);
+
+    return fd;
+}
+
+static int host_send_frame(const void *frame, size_t length) {
+    if (host_peer.sun_family == AF_UNIX) {
+        if (sendto(host_fd, frame, length, 0, (struct sockaddr*)&host_peer, sizeof(host_peer)) < 0) {
+            /* Peer not there (yet) or its queue is full: the frame is lost on the wire */
+            return (errno == ECONNREFUSED || errno == ENOENT || errno == EAGAIN || errno == ENOBUFS) ? 0 : -1;
+        }
+
+        return 0;
+    }
+
+    return (write(host_fd, frame, length) == (ssize_t)length) ? 0 : -1;
+}
+
+static void host_set_link_up(void *arg) {
+    netif_set_link_up((struct netif*)arg);
+}
+
+static void host_rx_task(void *arg) {
+    struct netif   *netif = (struct netif*)arg;
+    struct eth_hdr *ethhdr;
+    u8_t           frame[HOST_EMAC_MAX_FRAME];
+    ssize_t        length;
+    struct pbuf    *p;
+
+    /* There is no PHY, the link is up as soon as the device is open */
+    tcpip_callback_with_block(host_set_link_up, netif, 1);
+
+    while (1) {
+        length = read(host_fd, frame, sizeof(frame));
+        if (length <= 0) {
+            if (length < 0 && errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (!host_rx_enabled || length < (ssize_t)sizeof(struct eth_hdr))
+            continue;
+
+        p = pbuf_alloc(PBUF_RAW, (u16_t)(length + ETH_PAD_SIZE), PBUF_POOL);
+        if (p == NULL) {
+            LINK_STATS_INC(link.memerr);
+            LINK_STATS_INC(link.drop);
+            continue;
+        }
+
+#if ETH_PAD_SIZE
+        pbuf_header(p, -ETH_PAD_SIZE);
+#endif
+        pbuf_take(p, frame, (u16_t)length);
+#if ETH_PAD_SIZE
+        pbuf_header(p, ETH_PAD_SIZE);
+#endif
+        LINK_STATS_INC(link.recv);
+
+        ethhdr = (struct eth_hdr*)p->payload;
+        switch (htons(ethhdr->type)) {
+            case ETHTYPE_IP:
+            case ETHTYPE_ARP:
+                /* full packet send to tcpip_thread to process */
+                if (netif->input(p, netif) != ERR_OK) {
+                    /* Free buffer */
+                    pbuf_free(p);
+                }
+                break;
+            default:
+                /* Return buffer */
+                pbuf_free(p);
+                break;
+        }
+    }
+
+    fprintf(stderr, "host_emac: receive failed on %s (%s)\n", host_device, strerror(errno));
+}
+
+static err_t host_etharp_output(struct netif *netif, struct pbuf *q, ip_addr_t *ipaddr) {
+    /* Only send packet is link is up */
+    if (netif->flags & NETIF_FLAG_LINK_UP) {
+        return etharp_output(netif, q, ipaddr);
+    }
+
+    return ERR_CONN;
+}
+
+static err_t host_low_level_output(struct netif *netif, struct pbuf *p) {
+    u8_t  frame[HOST_EMAC_MAX_FRAME + ETH_PAD_SIZE];
+    u16_t length;
+
+    LWIP_UNUSED_ARG(netif);
+
+    if (p->tot_len > sizeof(frame))
+        return ERR_BUF;
+
+    /* One write per frame, the chain is gathered here like the DMA would */
+    length = pbuf_copy_partial(p, frame, p->tot_len, 0);
+
+    if (host_send_frame(frame + ETH_PAD_SIZE, length - ETH_PAD_SIZE) != 0) {
+        LINK_STATS_INC(link.err);
+        return ERR_IF;
+    }
+
+    LINK_STATS_INC(link.xmit);
+    return ERR_OK;
+}
+
+err_t eth_arch_enetif_init(struct netif *netif)
+{
+    const char *device;
+    u32_t      hash = 2166136261u;
+    const char *c;
+    int        i;
+
+    if (host_device[0] == '\0') {
+        device = getenv(HOST_EMAC_DEVICE_ENV);
+        if (device == NULL || host_emac_set_device(device) != 0)
+            host_emac_set_device(HOST_EMAC_DEFAULT_DEVICE);
+    }
+
+    if (strncmp(host_device, "tap:", 4) == 0)
+        host_fd = host_open_tap(host_device + 4);
+    else
+        host_fd = host_open_pair(host_device + 5);
+
+    if (host_fd < 0) {
+        fprintf(stderr, "host_emac: cannot open %s (%s)\n", host_device, strerror(errno));
+        return ERR_IF;
+    }
+
+    /* Locally administered MAC address derived from the device, so that both ends of a pair differ */
+    for (c = host_device; *c != '\0' && *c != ','; c++)
+        hash = (hash ^ (u8_t)*c) * 16777619u;
+
+    netif->hwaddr[0] = 0x02;
+    netif->hwaddr[1] = 0x00;
+    for (i = 2; i < ETHARP_HWADDR_LEN; i++) {
+        netif->hwaddr[i] = (u8_t)hash;
+        hash >>= 8;
+    }
+    netif->hwaddr_len = ETHARP_HWADDR_LEN;
+
+    /* maximum transfer unit */
+    netif->mtu = HOST_EMAC_MTU;
+
+    /* device capabilities */
+    netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_ETHERNET | NETIF_FLAG_IGMP;
+
+#if LWIP_NETIF_HOSTNAME
+    /* Initialize interface hostname */
+    netif->hostname = "lwiphost";
+#endif /* LWIP_NETIF_HOSTNAME */
+
+    netif->name[0] = 'e';
+    netif->name[1] = 'n';
+
+    netif->output     = host_etharp_output;
+    netif->linkoutput = host_low_level_output;
+
+    /* task */
+    sys_thread_new("host_rx_task", host_rx_task, netif, DEFAULT_THREAD_STACKSIZE, HOST_EMAC_RX_TASK_PRI);
+
+    return ERR_OK;
+}
+
+void eth_arch_enable_interrupts(void) {
+    host_rx_enabled = 1;
+}
+
+void eth_arch_disable_interrupts(void) {
+    host_rx_enabled = 0;
+}
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
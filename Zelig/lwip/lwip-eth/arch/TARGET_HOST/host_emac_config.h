@@ -0,0 +1,55 @@
+/* Copyright (C) 2015 mbed.org, MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef HOST_EMAC_CONFIG_H
+#define HOST_EMAC_CONFIG_H
+
+/*
+ * The host netif sends and receives Ethernet frames through one of:
+ *
+ *   tap:<name>            a Linux TAP device (needs CAP_NET_ADMIN, or a
+ *                         persistent device owned by the user)
+ *   pair:<local>,<peer>   a pair of AF_UNIX datagram sockets, one frame per
+ *                         datagram. Two processes started with the paths
+ *                         swapped form a point to point link, no privileges
+ *                         needed, which is what CI uses.
+ *
+ * The device is taken from host_emac_set_device() if it was called before
+ * the netif is added, else from the HOST_EMAC_DEVICE_ENV variable, else
+ * HOST_EMAC_DEFAULT_DEVICE.
+ */
+#define HOST_EMAC_DEVICE_ENV          "LLOS_HOST_NETIF"
+#define HOST_EMAC_DEFAULT_DEVICE      "tap:tap0"
+
+#define HOST_EMAC_MTU                 1500
+#define HOST_EMAC_MAX_FRAME           (HOST_EMAC_MTU + 14)
+
+#define HOST_EMAC_RX_TASK_PRI         (osPriorityHigh)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Selects the device for the next eth_arch_enetif_init, see above. Returns 0, or -1 if the string is malformed */
+int host_emac_set_device(const char *device);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
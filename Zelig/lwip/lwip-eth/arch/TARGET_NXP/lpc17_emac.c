@@ -88,10 +88,6 @@
  */
 #define TXINTGROUP (EMAC_INT_TX_UNDERRUN | EMAC_INT_TX_ERR | EMAC_INT_TX_DONE)
 
-/** \brief  Signal used for ethernet ISR to signal packet_rx() thread.
- */
-#define RX_SIGNAL  1
-
 #else
 #define RXINTGROUP 0
 #define TXINTGROUP 0
@@ -126,8 +122,10 @@ struct lpc_enetdata {
 	volatile u32_t rx_free_descs; /**< Count of free RX descriptors */
 	struct pbuf *txb[LPC_NUM_BUFF_TXDESCS]; /**< TX pbuf pointer list, zero-copy mode */
 	u32_t lpc_last_tx_idx; /**< TX last descriptor index, zero-copy mode */
+	u32_t rx_overruns; /**< Count of RX overruns (ring reset) */
 #if NO_SYS == 0
 	sys_thread_t RxThread; /**< RX receive thread data object pointer */
+	sys_sem_t RxSem; /**< RX receive thread wakeup semaphore */
 	sys_sem_t TxCleanSem; /**< TX cleanup thread wakeup semaphore */
 	sys_mutex_t TXLockMutex; /**< TX critical section mutex */
 	sys_sem_t xTXDCountSem; /**< TX free buffer counting semaphore */
@@ -281,6 +279,11 @@ static struct pbuf *lpc_low_level_input(struct netif *netif)
 	if (LPC_EMAC->IntStatus & EMAC_INT_RX_OVERRUN) {
 		LINK_STATS_INC(link.err);
 		LINK_STATS_INC(link.drop);
+		lpc_enetif->rx_overruns++;
+
+		LWIP_DEBUGF(UDP_LPC_EMAC | LWIP_DBG_TRACE,
+			("lpc_low_level_input: RX overrun, ring reset (count=%d)\n",
+			lpc_enetif->rx_overruns));
 
 		/* Temporarily disable RX */
 		LPC_EMAC->MAC1 &= ~EMAC_MAC1_REC_EN;
@@ -358,6 +361,7 @@ static struct pbuf *lpc_low_level_input(struct netif *netif)
 			if (lpc_rx_queue(lpc_enetif->netif) == 0) {
     			/* Drop the frame due to OOM. */
     			LINK_STATS_INC(link.drop);
+    			LINK_STATS_INC(link.memerr);
 
     			/* Re-queue the pbuf for receive */
     			p->len = origLength;
@@ -701,8 +705,10 @@ void ENET_IRQHandler(void)
 	ints = LPC_EMAC->IntStatus;
 
 	if (ints & RXINTGROUP) {
-        /* RX group interrupt(s): Give signal to wakeup RX receive task.*/
-        osSignalSet(lpc_enetdata.RxThread->id, RX_SIGNAL);
+        /* RX group interrupt(s): Mask them until the RX receive task has
+           drained the ring and give semaphore to wake it up. */
+        LPC_EMAC->IntEnable &= ~RXINTGROUP;
+        sys_sem_signal(&lpc_enetdata.RxSem);
     }
 
     if (ints & TXINTGROUP) {
@@ -710,29 +716,58 @@ void ENET_IRQHandler(void)
         sys_sem_signal(&lpc_enetdata.TxCleanSem);
     }
 
-	/* Clear pending interrupts */
-	LPC_EMAC->IntClear = ints;
+	/* Clear pending interrupts. RX overrun is left set for the RX
+	   receive task, which resets the ring when it sees it. */
+	LPC_EMAC->IntClear = ints & ~EMAC_INT_RX_OVERRUN;
 #endif
 }
 
 #if NO_SYS == 0
 /** \brief  Packet reception task
  *
- * This task is called when a packet is received. It will
- * pass the packet to the LWIP core.
+ * This task is woken by the first RX interrupt of a burst. RX
+ * interrupts stay masked while it polls the ring, passing at most
+ * LPC_RX_POLL_BUDGET packets to the LWIP core per pass, and are
+ * re-armed only once the ring is empty.
  *
  *  \param[in] pvParameters Not used yet
  */
 static void packet_rx(void* pvParameters) {
     struct lpc_enetdata *lpc_enetif = pvParameters;
+    u32_t budget;
 
     while (1) {
         /* Wait for receive task to wakeup */
-        osSignalWait(RX_SIGNAL, osWaitForever);
+        sys_arch_sem_wait(&lpc_enetif->RxSem, 0);
+
+        /* Process packets until empty or out of budget. A pending overrun
+           is handled by lpc_low_level_input() even if the ring looks empty */
+        for (budget = LPC_RX_POLL_BUDGET; budget > 0; budget--) {
+            if ((LPC_EMAC->RxConsumeIndex == LPC_EMAC->RxProduceIndex) &&
+                !(LPC_EMAC->IntStatus & EMAC_INT_RX_OVERRUN))
+                break;
 
-        /* Process packets until all empty */
-        while (LPC_EMAC->RxConsumeIndex != LPC_EMAC->RxProduceIndex)
             lpc_enetif_input(lpc_enetif->netif);
+        }
+
+        if (budget == 0) {
+            /* More packets may be waiting: stay in polled mode, but go back
+               through the semaphore so other threads get a turn */
+            sys_sem_signal(&lpc_enetif->RxSem);
+            continue;
+        }
+
+        /* Ring is empty: discard the status of the packets already handled
+           and re-arm the RX interrupts */
+        LPC_EMAC->IntClear = EMAC_INT_RX_DONE | EMAC_INT_RX_ERR;
+        LPC_EMAC->IntEnable |= RXINTGROUP;
+
+        /* A packet that completed just before the IntClear above has lost
+           its interrupt, so check once more and keep polling if needed */
+        if (LPC_EMAC->RxConsumeIndex != LPC_EMAC->RxProduceIndex) {
+            LPC_EMAC->IntEnable &= ~RXINTGROUP;
+            sys_sem_signal(&lpc_enetif->RxSem);
+        }
     }
 }
 
@@ -964,6 +999,7 @@ err_t eth_arch_enetif_init(struct netif *netif)
 	LWIP_ASSERT("netif != NULL", (netif != NULL));
 
 	lpc_enetdata.netif = netif;
+	lpc_enetdata.rx_overruns = 0;
 
 	/* set MAC hardware address */
 #if (MBED_MAC_ADDRESS_SUM != MBED_MAC_ADDR_INTERFACE)
@@ -1014,6 +1050,8 @@ err_t eth_arch_enetif_init(struct netif *netif)
 	LWIP_ASSERT("TXLockMutex creation error", (err == ERR_OK));
 
 	/* Packet receive task */
+	err = sys_sem_new(&lpc_enetdata.RxSem, 0);
+	LWIP_ASSERT("RxSem creation error", (err == ERR_OK));
 	lpc_enetdata.RxThread = sys_thread_new("receive_thread", packet_rx, netif->state, DEFAULT_THREAD_STACKSIZE, RX_PRIORITY);
 	LWIP_ASSERT("RxThread creation error", (lpc_enetdata.RxThread));
 
@@ -79,9 +79,26 @@ extern "C"
 #define LPC_EMAC_RMII 1         /**< Use the RMII or MII driver variant .*/
 
 /** \brief  Defines the number of descriptors used for RX. This
- *          must be a minimum value of 2.
+ *          must be a minimum value of 3. Each descriptor holds a full
+ *          sized frame allocated from the lwIP heap (MEM_SIZE), so the
+ *          LPC1768 keeps a shorter ring than the LPC4088.
  */
-#define LPC_NUM_BUFF_RXDESCS 3
+#ifndef LPC_NUM_BUFF_RXDESCS
+#if defined(TARGET_LPC1768)
+#define LPC_NUM_BUFF_RXDESCS 4
+#else
+#define LPC_NUM_BUFF_RXDESCS 8
+#endif
+#endif
+
+/** \brief  Maximum number of frames the receive thread passes to lwIP
+ *          before giving other threads a turn. RX interrupts stay masked
+ *          while the thread is polling and are re-armed once the ring
+ *          is empty.
+ */
+#ifndef LPC_RX_POLL_BUDGET
+#define LPC_RX_POLL_BUDGET LPC_NUM_BUFF_RXDESCS
+#endif
 
 /** \brief  Defines the number of descriptors used for TX. Must
  *          be a minimum value of 2.
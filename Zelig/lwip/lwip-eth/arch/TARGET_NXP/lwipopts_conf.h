@@ -27,4 +27,13 @@
 #define MEM_SIZE                      16362
 #endif
 
+/* The LPC1768 only has the 32KB AHB banks for the stack and its buffers */
+#ifndef LWIP_POOL_PROFILE
+#if defined(TARGET_LPC1768)
+#define LWIP_POOL_PROFILE             LWIP_POOL_PROFILE_DEFAULT
+#else
+#define LWIP_POOL_PROFILE             LWIP_POOL_PROFILE_LARGE
+#endif
+#endif
+
 #endif
@@ -23,4 +23,9 @@
 
 #define MEM_SIZE                      (1600 * 16)
 
+/* Plenty of on-chip RAM */
+#ifndef LWIP_POOL_PROFILE
+#define LWIP_POOL_PROFILE             LWIP_POOL_PROFILE_LARGE
+#endif
+
 #endif
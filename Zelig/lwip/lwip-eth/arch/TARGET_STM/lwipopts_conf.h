@@ -23,4 +23,8 @@
 
 #define MEM_SIZE                      (1600 * 16)
 
+#ifndef LWIP_POOL_PROFILE
+#define LWIP_POOL_PROFILE             LWIP_POOL_PROFILE_DEFAULT
+#endif
+
 #endif
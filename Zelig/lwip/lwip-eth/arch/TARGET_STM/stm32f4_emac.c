@@ -8,6 +8,15 @@
 #include <string.h>
 #include "cmsis_os.h"
 #include "mbed_interface.h"
+#include "stm32f4_emac_config.h"
+
+#if STM32F4_EMAC_ZERO_COPY
+#include "stm32f4_emac_ring.h"
+#endif
+
+#if defined(SYS_ARCH_PROTECT_BASEPRI) && (STM32F4_ETH_IRQ_PRIORITY < SYS_ARCH_PROTECT_BASEPRI)
+#error "The Ethernet interrupt must be masked by SYS_ARCH_PROTECT, see STM32F4_ETH_IRQ_PRIORITY"
+#endif
 
 /** @defgroup lwipstm32f4xx_emac_DRIVER	stm32f4 EMAC driver for LWIP
  * @ingroup lwip_emac
@@ -20,6 +29,24 @@
 #define PHY_TASK_WAIT           (200)
 
 
+#if STM32F4_EMAC_ZERO_COPY
+
+/* Descriptors only, the frames live in rx_bufs and in the caller's pbufs (see stm32f4_emac_ring.h) */
+#if defined (__ICCARM__)   /*!< IAR Compiler */
+  #pragma data_alignment=4
+#endif
+__ALIGN_BEGIN ETH_DMADescTypeDef DMARxDscrTab[STM32F4_NUM_RX_DESCS] __ALIGN_END; /* Ethernet Rx DMA Descriptor */
+
+#if defined (__ICCARM__)   /*!< IAR Compiler */
+  #pragma data_alignment=4
+#endif
+__ALIGN_BEGIN ETH_DMADescTypeDef DMATxDscrTab[STM32F4_NUM_TX_DESCS] __ALIGN_END; /* Ethernet Tx DMA Descriptor */
+
+static struct stm32f4_rx_buf rx_bufs[STM32F4_NUM_RX_BUFS];
+static struct stm32f4_emac_ring emac_ring;
+
+#else
+
 #if defined (__ICCARM__)   /*!< IAR Compiler */
   #pragma data_alignment=4
 #endif
@@ -40,6 +67,7 @@ __ALIGN_BEGIN uint8_t Rx_Buff[ETH_RXBUFNB][ETH_RX_BUF_SIZE] __ALIGN_END; /* Ethe
 #endif
 __ALIGN_BEGIN uint8_t Tx_Buff[ETH_TXBUFNB][ETH_TX_BUF_SIZE] __ALIGN_END; /* Ethernet Transmit Buffer */
 
+#endif
 
 ETH_HandleTypeDef heth;
 
@@ -51,6 +79,9 @@ static void stm32f4_rx_task(void *arg);
 static void stm32f4_phy_task(void *arg);
 static err_t stm32f4_etharp_output(struct netif *netif, struct pbuf *q, ip_addr_t *ipaddr);
 static err_t stm32f4_low_level_output(struct netif *netif, struct pbuf *p);
+#if STM32F4_EMAC_ZERO_COPY
+static void stm32f4_rx_buf_freed(void);
+#endif
 
 /**
  * Override HAL Eth Init function
@@ -101,7 +132,7 @@ void HAL_ETH_MspInit(ETH_HandleTypeDef* heth)
         /* Peripheral interrupt init*/
         /* Sets the priority grouping field */
         HAL_NVIC_SetPriorityGrouping(NVIC_PRIORITYGROUP_4);
-        HAL_NVIC_SetPriority(ETH_IRQn, 0, 0);
+        HAL_NVIC_SetPriority(ETH_IRQn, STM32F4_ETH_IRQ_PRIORITY, 0);
         HAL_NVIC_EnableIRQ(ETH_IRQn);
     }
 }
@@ -203,11 +234,24 @@ static void stm32f4_low_level_init(struct netif *netif)
        netif->flags |= NETIF_FLAG_LINK_UP;
    }
 
+#if STM32F4_EMAC_ZERO_COPY
+    /* Build both rings ourselves, the HAL helpers attach fixed buffers to the descriptors */
+    stm32f4_ring_init(&emac_ring, DMARxDscrTab, DMATxDscrTab, rx_bufs, STM32F4_NUM_RX_BUFS);
+    emac_ring.rx_buf_freed = stm32f4_rx_buf_freed;
+
+    heth.TxDesc = DMATxDscrTab;
+    heth.RxDesc = DMARxDscrTab;
+    heth.Instance->DMATDLAR = (uint32_t)DMATxDscrTab;
+    heth.Instance->DMARDLAR = (uint32_t)DMARxDscrTab;
+
+    stm32f4_ring_rx_fill(&emac_ring);
+#else
     /* Initialize Tx Descriptors list: Chain Mode */
     HAL_ETH_DMATxDescListInit(&heth, DMATxDscrTab, &Tx_Buff[0][0], ETH_TXBUFNB);
 
     /* Initialize Rx Descriptors list: Chain Mode  */
     HAL_ETH_DMARxDescListInit(&heth, DMARxDscrTab, &Rx_Buff[0][0], ETH_RXBUFNB);
+#endif
 
  #if LWIP_ARP || LWIP_ETHERNET
     /* set MAC hardware address length */
@@ -250,6 +294,150 @@ static void stm32f4_low_level_init(struct netif *netif)
 #endif
 }
 
+#if STM32F4_EMAC_ZERO_COPY
+
+/**
+ * Called by lwIP (from any thread) when it frees a received frame, so that the RX task
+ * re-attaches the buffer to the ring.
+ */
+static void stm32f4_rx_buf_freed(void)
+{
+    sys_sem_signal(&rx_ready_sem);
+}
+
+/**
+ * This function should do the actual transmission of the packet. The packet is
+ * contained in the pbuf that is passed to the function. This pbuf
+ * might be chained.
+ *
+ * The payloads are handed to the DMA in place, one descriptor per pbuf, and the
+ * chain is referenced until the DMA is done with it. The headers of TCP segments,
+ * which the stack rewrites on retransmit, go out from a copy in a header pbuf.
+ * Chains the DMA cannot read directly and chains the stack may still modify are
+ * copied into a single bounce pbuf first.
+ *
+ * @param netif the lwip network interface structure for this ethernetif
+ * @param p the MAC packet to send (e.g. IP packet including MAC addresses and type)
+ * @return ERR_OK if the packet could be sent
+ *         an err_t value if the packet couldn't be sent
+ */
+static err_t stm32f4_low_level_output(struct netif *netif, struct pbuf *p)
+{
+    err_t errval = ERR_OK;
+    struct pbuf *bounce = NULL;
+    struct pbuf *header = NULL;
+    uint32_t flags = 0;
+    u32_t skip;
+    u32_t segments;
+    u32_t waited = 0;
+
+    skip = stm32f4_ring_tx_copy_len(p);
+    segments = (skip < p->tot_len) ? stm32f4_ring_tx_segments(p, skip) : 0;
+
+    if (segments > 0 && skip > 0) {
+        header = pbuf_alloc(PBUF_RAW, (u16_t)skip, PBUF_RAM);
+        if (header == NULL) {
+            return ERR_MEM;
+        }
+
+        memcpy(header->payload, p->payload, skip);
+
+        if (!stm32f4_ring_tx_dma_safe(header->payload)) {
+            pbuf_free(header);
+            header = NULL;
+            segments = 0;
+        }
+    }
+
+    if (segments == 0) {
+        bounce = pbuf_alloc(PBUF_RAW, p->tot_len, PBUF_RAM);
+        if (bounce == NULL) {
+            return ERR_MEM;
+        }
+
+        pbuf_copy(bounce, p);
+
+        p = bounce;
+        skip = 0;
+        segments = stm32f4_ring_tx_segments(p, 0);
+
+        if (segments == 0) {
+            pbuf_free(bounce);
+            return ERR_BUF;
+        }
+    }
+
+    if (heth.Init.ChecksumMode == ETH_CHECKSUM_BY_HARDWARE) {
+        flags = ETH_DMATXDESC_CHECKSUMTCPUDPICMPFULL;
+    }
+
+    sys_mutex_lock(&tx_lock_mutex);
+
+    /* Release what the DMA already sent, and wait a little if the ring is still too full */
+    while (stm32f4_ring_tx_reclaim(&emac_ring) < segments) {
+        if (waited++ >= STM32F4_TX_WAIT_MS) {
+            errval = ERR_MEM;
+            break;
+        }
+
+        sys_mutex_unlock(&tx_lock_mutex);
+        osDelay(1);
+        sys_mutex_lock(&tx_lock_mutex);
+    }
+
+    if (errval == ERR_OK) {
+        stm32f4_ring_tx_queue(&emac_ring, header, p, skip, segments, flags);
+    }
+
+    /* When Transmit Underflow or Buffer Unavailable is set, clear it; the poll demand below resumes transmission */
+    if ((heth.Instance->DMASR & (ETH_DMASR_TUS | ETH_DMASR_TBUS)) != (uint32_t)RESET) {
+        heth.Instance->DMASR = ETH_DMASR_TUS | ETH_DMASR_TBUS;
+    }
+
+    /* Transmit Poll Demand */
+    heth.Instance->DMATPDR = 0;
+
+    sys_mutex_unlock(&tx_lock_mutex);
+
+    /* The ring holds its own references on the frame and its header */
+    if (bounce != NULL) {
+        pbuf_free(bounce);
+    }
+
+    if (header != NULL) {
+        pbuf_free(header);
+    }
+
+    return errval;
+}
+
+/**
+ * Returns the next received frame as a pbuf referring to the DMA buffer, and
+ * re-arms the RX descriptors with free buffers.
+ *
+ * @param netif the lwip network interface structure for this ethernetif
+ * @return a pbuf with the received packet (including MAC header)
+ *         NULL if no frame is pending
+ */
+static struct pbuf * stm32f4_low_level_input(struct netif *netif)
+{
+    struct pbuf *p = stm32f4_ring_rx_take(&emac_ring);
+
+    stm32f4_ring_rx_fill(&emac_ring);
+
+    /* When Rx Buffer unavailable flag is set: clear it and resume reception */
+    if ((heth.Instance->DMASR & ETH_DMASR_RBUS) != (uint32_t)RESET) {
+        /* Clear RBUS ETHERNET DMA flag */
+        heth.Instance->DMASR = ETH_DMASR_RBUS;
+        /* Resume DMA reception */
+        heth.Instance->DMARPDR = 0;
+    }
+
+    return p;
+}
+
+#else
+
 /**
  * This function should do the actual transmission of the packet. The packet is
  * contained in the pbuf that is passed to the function. This pbuf
@@ -426,6 +614,8 @@ static struct pbuf * stm32f4_low_level_input(struct netif *netif)
     return p;
 }
 
+#endif
+
 /**
  * This task receives input data
  *
@@ -438,6 +628,14 @@ static void stm32f4_rx_task(void *arg)
 
     while (1) {
         sys_arch_sem_wait(&rx_ready_sem, 0);
+#if STM32F4_EMAC_ZERO_COPY
+        /* One signal may stand for several frames, drain the ring */
+        while ((p = stm32f4_low_level_input(netif)) != NULL) {
+            if (netif->input(p, netif) != ERR_OK) {
+                pbuf_free(p);
+            }
+        }
+#else
         p = stm32f4_low_level_input(netif);
         if (p != NULL) {
             if (netif->input(p, netif) != ERR_OK) {
@@ -445,6 +643,7 @@ static void stm32f4_rx_task(void *arg)
                 p = NULL;
             } 
         }
+#endif
     }
 }
 
@@ -544,7 +743,7 @@ err_t eth_arch_enetif_init(struct netif *netif)
 void eth_arch_enable_interrupts(void)
 {
     HAL_NVIC_SetPriorityGrouping(NVIC_PRIORITYGROUP_4);
-    HAL_NVIC_SetPriority(ETH_IRQn, 0, 0);
+    HAL_NVIC_SetPriority(ETH_IRQn, STM32F4_ETH_IRQ_PRIORITY, 0);
     HAL_NVIC_EnableIRQ(ETH_IRQn);
 }
 
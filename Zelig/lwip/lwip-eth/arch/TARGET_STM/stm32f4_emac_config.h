@@ -0,0 +1,54 @@
+/* Copyright (C) 2015 mbed.org, MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STM32F4_EMAC_CONFIG_H
+#define STM32F4_EMAC_CONFIG_H
+
+#include "lwip/opt.h"
+
+/** Set to 0 to go back to copying every frame through the HAL's fixed DMA buffers. */
+#ifndef STM32F4_EMAC_ZERO_COPY
+#define STM32F4_EMAC_ZERO_COPY          1
+#endif
+
+/** Number of RX DMA descriptors. */
+#define STM32F4_NUM_RX_DESCS            ETH_RXBUFNB
+
+/** RX buffers: one per descriptor, plus frames on loan to the stack until it frees them. */
+#define STM32F4_NUM_RX_BUFS             (2 * STM32F4_NUM_RX_DESCS)
+
+/** Size of a RX buffer, large enough for a full (VLAN tagged) frame and its CRC. */
+#define STM32F4_RX_BUF_SIZE             ETH_MAX_PACKET_SIZE
+
+/** Number of TX DMA descriptors, each one maps a single pbuf of a frame. */
+#define STM32F4_NUM_TX_DESCS            (TCP_SND_QUEUELEN + 1)
+
+/** Alignment required of TX payloads handed directly to the DMA. */
+#define STM32F4_TX_BUF_ALIGNMENT        4
+
+/**
+ * NVIC priority of the Ethernet interrupt. The handler signals the receive task, so it must be
+ * masked by lwIP's critical regions: at or below SYS_ARCH_PROTECT_BASEPRI (numerically greater
+ * or equal). The default is the kernel's priority for generic peripherals.
+ */
+#define STM32F4_ETH_IRQ_PRIORITY        8
+
+/** How long (in ms) a transmit waits for the DMA to release descriptors before giving up. */
+#define STM32F4_TX_WAIT_MS              10
+
+#endif
@@ -0,0 +1,411 @@
+/* Copyright (C) 2015 mbed.org, MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STM32F4_EMAC_RING_H
+#define STM32F4_EMAC_RING_H
+
+/*
+ * Zero-copy descriptor rings for the STM32F4 Ethernet DMA (chain mode).
+ *
+ * RX descriptors point straight into driver owned buffers that are handed to the stack as custom
+ * PBUF_REF pbufs; a buffer goes back to the free list when lwIP frees its pbuf and is re-attached
+ * to a descriptor by stm32f4_ring_rx_fill. TX descriptors point at the payloads of the caller's
+ * pbuf chain, which is referenced until the DMA releases the last descriptor of the frame. The
+ * headers of TCP segments are the exception: they are copied to a small header pbuf of their own,
+ * see stm32f4_ring_tx_copy_len.
+ *
+ * Only the descriptor layout, the ETH_DMA*DESC_* bits and the lwIP headers are used here, so the
+ * ring can be driven on the host by a simulated DMA engine (os_layer/ports/posix/HostTests/EmacRingTest).
+ * The includer provides the STM32F4_* configuration (stm32f4_emac_config.h).
+ */
+
+#include "lwip/pbuf.h"
+#include "lwip/sys.h"
+#include "lwip/ip.h"
+#include "lwip/tcp_impl.h"
+#include "netif/etharp.h"
+
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error "The zero-copy STM32F4 EMAC needs LWIP_SUPPORT_CUSTOM_PBUF"
+#endif
+
+/** Start and end of the core coupled memory, which is not reachable by the Ethernet DMA. */
+#define STM32F4_CCM_START               0x10000000UL
+#define STM32F4_CCM_END                 0x10010000UL
+
+struct stm32f4_emac_ring;
+
+struct stm32f4_rx_buf {
+    struct pbuf_custom        pc;           /**< Must be first, lwIP hands it back on free */
+    struct stm32f4_emac_ring *ring;
+    struct stm32f4_rx_buf    *next;         /**< Free list link */
+    uint32_t                  data[(STM32F4_RX_BUF_SIZE + 3) / 4];
+};
+
+struct stm32f4_emac_ring {
+    ETH_DMADescTypeDef       *rx_desc;
+    struct stm32f4_rx_buf    *rxb[STM32F4_NUM_RX_DESCS];   /**< Buffer attached to each RX descriptor */
+    struct stm32f4_rx_buf    *rx_free;                     /**< Buffers neither attached nor on loan */
+    u32_t                     rx_fill_idx;                 /**< Next descriptor to attach a buffer to */
+    u32_t                     rx_next_idx;                 /**< Next descriptor the DMA completes */
+    u32_t                     rx_free_descs;               /**< Descriptors without a buffer */
+
+    ETH_DMADescTypeDef       *tx_desc;
+    struct pbuf              *txb[STM32F4_NUM_TX_DESCS];   /**< Pbuf to release with each TX descriptor, if any */
+    u32_t                     tx_fill_idx;                 /**< Next descriptor to produce */
+    u32_t                     tx_reclaim_idx;              /**< Oldest descriptor still owned by the DMA */
+    u32_t                     tx_free_descs;
+
+    void                    (*rx_buf_freed)(void);         /**< Called when the stack returns a RX buffer */
+};
+
+/** Returns a RX buffer to the free list, called by lwIP from pbuf_free on any thread. */
+static void stm32f4_ring_rx_buf_free(struct pbuf *p)
+{
+    struct stm32f4_rx_buf *buf = (struct stm32f4_rx_buf *)p;
+    struct stm32f4_emac_ring *ring = buf->ring;
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    SYS_ARCH_PROTECT(lev);
+    buf->next = ring->rx_free;
+    ring->rx_free = buf;
+    SYS_ARCH_UNPROTECT(lev);
+
+    if (ring->rx_buf_freed != NULL) {
+        ring->rx_buf_freed();
+    }
+}
+
+/**
+ * Links both descriptor tables into rings and puts all RX buffers on the free list. The caller
+ * loads the table addresses into DMARDLAR/DMATDLAR and then calls stm32f4_ring_rx_fill.
+ */
+static void stm32f4_ring_init(struct stm32f4_emac_ring *ring, ETH_DMADescTypeDef *rx_desc, ETH_DMADescTypeDef *tx_desc,
+                              struct stm32f4_rx_buf *bufs, u32_t nbufs)
+{
+    u32_t i;
+
+    memset(ring, 0, sizeof(*ring));
+
+    ring->rx_desc = rx_desc;
+    ring->tx_desc = tx_desc;
+
+    for (i = 0; i < STM32F4_NUM_RX_DESCS; i++) {
+        rx_desc[i].Status = 0;
+        rx_desc[i].ControlBufferSize = ETH_DMARXDESC_RCH;
+        rx_desc[i].Buffer1Addr = 0;
+        rx_desc[i].Buffer2NextDescAddr = (uint32_t)&rx_desc[(i + 1) % STM32F4_NUM_RX_DESCS];
+    }
+
+    for (i = 0; i < STM32F4_NUM_TX_DESCS; i++) {
+        tx_desc[i].Status = ETH_DMATXDESC_TCH;
+        tx_desc[i].ControlBufferSize = 0;
+        tx_desc[i].Buffer1Addr = 0;
+        tx_desc[i].Buffer2NextDescAddr = (uint32_t)&tx_desc[(i + 1) % STM32F4_NUM_TX_DESCS];
+    }
+
+    for (i = 0; i < nbufs; i++) {
+        bufs[i].ring = ring;
+        bufs[i].pc.custom_free_function = stm32f4_ring_rx_buf_free;
+        bufs[i].next = ring->rx_free;
+        ring->rx_free = &bufs[i];
+    }
+
+    ring->rx_free_descs = STM32F4_NUM_RX_DESCS;
+    ring->tx_free_descs = STM32F4_NUM_TX_DESCS;
+}
+
+/** Attaches free buffers to empty RX descriptors and gives them to the DMA. Returns how many were attached. */
+static u32_t stm32f4_ring_rx_fill(struct stm32f4_emac_ring *ring)
+{
+    u32_t queued = 0;
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    while (ring->rx_free_descs > 0) {
+        struct stm32f4_rx_buf *buf;
+        u32_t idx = ring->rx_fill_idx;
+
+        SYS_ARCH_PROTECT(lev);
+        buf = ring->rx_free;
+        if (buf != NULL) {
+            ring->rx_free = buf->next;
+        }
+        SYS_ARCH_UNPROTECT(lev);
+
+        if (buf == NULL) {
+            break;
+        }
+
+        ring->rxb[idx] = buf;
+        ring->rx_desc[idx].Buffer1Addr = (uint32_t)buf->data;
+        ring->rx_desc[idx].ControlBufferSize = ETH_DMARXDESC_RCH | (STM32F4_RX_BUF_SIZE & ETH_DMARXDESC_RBS1);
+        ring->rx_desc[idx].Status = ETH_DMARXDESC_OWN;
+
+        ring->rx_fill_idx = (idx + 1) % STM32F4_NUM_RX_DESCS;
+        ring->rx_free_descs--;
+        queued++;
+    }
+
+    return queued;
+}
+
+/**
+ * Takes the next completed frame off the RX ring as a pbuf that refers to the DMA buffer, or returns
+ * NULL if the DMA has not completed one. Errored frames and frames that did not fit one buffer are
+ * dropped and their buffer recycled. Either way the descriptor is left empty; call
+ * stm32f4_ring_rx_fill to re-arm it.
+ */
+static struct pbuf *stm32f4_ring_rx_take(struct stm32f4_emac_ring *ring)
+{
+    while (ring->rx_free_descs < STM32F4_NUM_RX_DESCS) {
+        u32_t idx = ring->rx_next_idx;
+        uint32_t status = ring->rx_desc[idx].Status;
+        struct stm32f4_rx_buf *buf = ring->rxb[idx];
+        u32_t len;
+
+        if ((status & ETH_DMARXDESC_OWN) != 0) {
+            return NULL;
+        }
+
+        ring->rx_next_idx = (idx + 1) % STM32F4_NUM_RX_DESCS;
+        ring->rxb[idx] = NULL;
+        ring->rx_free_descs++;
+
+        len = (status & ETH_DMARXDESC_FL) >> ETH_DMARXDESC_FRAMELENGTHSHIFT;
+
+        if ((status & (ETH_DMARXDESC_ES | ETH_DMARXDESC_FS | ETH_DMARXDESC_LS)) != (ETH_DMARXDESC_FS | ETH_DMARXDESC_LS) ||
+            len <= 4 || len > STM32F4_RX_BUF_SIZE) {
+            SYS_ARCH_DECL_PROTECT(lev);
+
+            /* Drop: the buffer goes straight back to the free list, to be re-attached in ring order. */
+            SYS_ARCH_PROTECT(lev);
+            buf->next = ring->rx_free;
+            ring->rx_free = buf;
+            SYS_ARCH_UNPROTECT(lev);
+            continue;
+        }
+
+        /* The frame length includes the CRC. */
+        return pbuf_alloced_custom(PBUF_RAW, (u16_t)(len - 4), PBUF_REF, &buf->pc, buf->data, STM32F4_RX_BUF_SIZE);
+    }
+
+    return NULL;
+}
+
+/** Releases the frames of all TX descriptors the DMA is done with. Returns the number of free descriptors. */
+static u32_t stm32f4_ring_tx_reclaim(struct stm32f4_emac_ring *ring)
+{
+    while (ring->tx_free_descs < STM32F4_NUM_TX_DESCS) {
+        u32_t idx = ring->tx_reclaim_idx;
+
+        if ((ring->tx_desc[idx].Status & ETH_DMATXDESC_OWN) != 0) {
+            break;
+        }
+
+        if (ring->txb[idx] != NULL) {
+            pbuf_free(ring->txb[idx]);
+            ring->txb[idx] = NULL;
+        }
+
+        ring->tx_reclaim_idx = (idx + 1) % STM32F4_NUM_TX_DESCS;
+        ring->tx_free_descs++;
+    }
+
+    return ring->tx_free_descs;
+}
+
+/** Returns non-zero if the DMA can read this payload in place. */
+static int stm32f4_ring_tx_dma_safe(const void *payload)
+{
+    uint32_t addr = (uint32_t)payload;
+
+    if ((addr & (STM32F4_TX_BUF_ALIGNMENT - 1)) != 0) {
+        return 0;
+    }
+
+    return (addr < STM32F4_CCM_START || addr >= STM32F4_CCM_END);
+}
+
+/**
+ * Number of descriptors needed to send this chain with its first 'skip' bytes copied to a header
+ * pbuf (see stm32f4_ring_tx_copy_len), counting the header, or 0 if it has to be bounced whole.
+ */
+static u32_t stm32f4_ring_tx_segments(struct pbuf *p, u32_t skip)
+{
+    struct pbuf *q;
+    u32_t segments = (skip > 0) ? 1 : 0;
+
+    if (skip > p->len) {
+        return 0;
+    }
+
+    for (q = p; q != NULL; q = q->next) {
+        u32_t offset = (q == p) ? skip : 0;
+
+        if (q->len == offset) {
+            continue;
+        }
+
+        if (!stm32f4_ring_tx_dma_safe((u8_t *)q->payload + offset)) {
+            return 0;
+        }
+
+        segments++;
+    }
+
+    return (segments < STM32F4_NUM_TX_DESCS) ? segments : 0;
+}
+
+/**
+ * Returns how many leading bytes of the frame must be copied before the DMA can read the rest in
+ * place. lwIP 1.4 keeps sent TCP segments on the unacked queue and rewrites their Ethernet, IP and
+ * TCP headers in place on retransmit, without checking whether the driver still holds them; the
+ * data behind the headers is never modified. For TCP this is the length of the headers, rounded up
+ * so that the rest of the first pbuf starts DMA aligned, and 0 for any other frame. The whole frame
+ * (p->tot_len) must be copied when the headers are not all in the first pbuf, so they cannot be
+ * checked, and when the chain is referenced anywhere else (a pbuf with ref > 1, e.g. a netbuf
+ * chained behind a UDP header), as it may then change under the DMA.
+ */
+static u32_t stm32f4_ring_tx_copy_len(struct pbuf *p)
+{
+    struct pbuf *q;
+    struct ip_hdr *iph;
+    u16_t type;
+    u32_t offset = SIZEOF_ETH_HDR;
+    u32_t hlen;
+
+    for (q = p; q != NULL; q = q->next) {
+        if (q->ref > 1) {
+            return p->tot_len;
+        }
+    }
+
+    if (p->len < SIZEOF_ETH_HDR) {
+        return p->tot_len;
+    }
+
+    type = ((struct eth_hdr *)p->payload)->type;
+
+#if ETHARP_SUPPORT_VLAN
+    if (type == PP_HTONS(ETHTYPE_VLAN)) {
+        if (p->len < SIZEOF_ETH_HDR + SIZEOF_VLAN_HDR) {
+            return p->tot_len;
+        }
+
+        type = ((struct eth_vlan_hdr *)((u8_t *)p->payload + SIZEOF_ETH_HDR))->tpid;
+        offset += SIZEOF_VLAN_HDR;
+    }
+#endif
+
+    if (type != PP_HTONS(ETHTYPE_IP)) {
+        return 0;
+    }
+
+    if (p->len < offset + IP_HLEN) {
+        return p->tot_len;
+    }
+
+    iph = (struct ip_hdr *)((u8_t *)p->payload + offset);
+
+    if (IPH_PROTO(iph) != IP_PROTO_TCP) {
+        return 0;
+    }
+
+    hlen = IPH_HL(iph) * 4;
+    if (hlen < IP_HLEN || p->len < offset + hlen + TCP_HLEN) {
+        return p->tot_len;
+    }
+
+    offset += hlen;
+
+    hlen = TCPH_HDRLEN((struct tcp_hdr *)((u8_t *)p->payload + offset)) * 4;
+    if (hlen < TCP_HLEN || p->len < offset + hlen) {
+        return p->tot_len;
+    }
+
+    offset += hlen;
+    offset += (STM32F4_TX_BUF_ALIGNMENT - (((uint32_t)p->payload + offset) & (STM32F4_TX_BUF_ALIGNMENT - 1))) &
+              (STM32F4_TX_BUF_ALIGNMENT - 1);
+
+    return (offset < p->len) ? offset : p->len;
+}
+
+/**
+ * Queues a frame for transmission without copying it: one descriptor per non-empty pbuf, with the
+ * chain referenced until the DMA completes the last segment. If 'header' is not NULL it holds a
+ * copy of the first 'skip' bytes of the frame and goes out first, and is referenced until the DMA
+ * is done with its own descriptor. The first descriptor is handed to the DMA last, so it never sees
+ * a partially built frame. The caller must have checked that there are enough free descriptors for
+ * 'segments' (from stm32f4_ring_tx_segments with the same 'skip', which is 0 without a header), and
+ * then issues a transmit poll demand.
+ */
+static void stm32f4_ring_tx_queue(struct stm32f4_emac_ring *ring, struct pbuf *header, struct pbuf *p, u32_t skip,
+                                  u32_t segments, uint32_t flags)
+{
+    struct pbuf *q;
+    u32_t first = ring->tx_fill_idx;
+    u32_t idx = first;
+    u32_t n = 0;
+
+    pbuf_ref(p);
+
+    if (header != NULL) {
+        pbuf_ref(header);
+
+        ring->txb[idx] = header;
+        ring->tx_desc[idx].Buffer1Addr = (uint32_t)header->payload;
+        ring->tx_desc[idx].ControlBufferSize = header->len & ETH_DMATXDESC_TBS1;
+        ring->tx_desc[idx].Status = ETH_DMATXDESC_TCH | ETH_DMATXDESC_FS | flags;
+
+        idx = (idx + 1) % STM32F4_NUM_TX_DESCS;
+        n++;
+    }
+
+    for (q = p; q != NULL; q = q->next) {
+        uint32_t status = ETH_DMATXDESC_TCH | flags;
+        u32_t offset = (q == p) ? skip : 0;
+
+        if (q->len == offset) {
+            continue;
+        }
+
+        n++;
+
+        if (n == 1) {
+            status |= ETH_DMATXDESC_FS;
+        }
+
+        if (n == segments) {
+            status |= ETH_DMATXDESC_LS | ETH_DMATXDESC_IC;
+            ring->txb[idx] = p;
+        }
+
+        ring->tx_desc[idx].Buffer1Addr = (uint32_t)((u8_t *)q->payload + offset);
+        ring->tx_desc[idx].ControlBufferSize = (q->len - offset) & ETH_DMATXDESC_TBS1;
+        ring->tx_desc[idx].Status = (idx == first) ? status : (status | ETH_DMATXDESC_OWN);
+
+        idx = (idx + 1) % STM32F4_NUM_TX_DESCS;
+    }
+
+    ring->tx_fill_idx = idx;
+    ring->tx_free_descs -= segments;
+
+    ring->tx_desc[first].Status |= ETH_DMATXDESC_OWN;
+}
+
+#endif
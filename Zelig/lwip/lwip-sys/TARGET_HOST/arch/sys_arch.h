@@ -0,0 +1,105 @@
+/* Copyright (C) 2012 mbed.org, MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Host (Linux) operating system abstraction, used to run the stack and the
+ * LLOS_lwip_* interop layer as a normal process on top of the host netif in
+ * lwip-eth/arch/TARGET_HOST. Put this directory ahead of lwip-sys on the
+ * include path so that it shadows arch/sys_arch.h; cc.h and perf.h are shared.
+ */
+#ifndef __ARCH_SYS_ARCH_H__
+#define __ARCH_SYS_ARCH_H__
+
+#include "lwip/opt.h"
+
+#include <pthread.h>
+
+#if NO_SYS == 0
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+// === SEMAPHORE ===
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t  signaled;
+    u32_t           count;
+    u8_t            valid;
+} sys_sem_t;
+
+#define sys_sem_valid(x)            ((*x).valid)
+#define sys_sem_set_invalid(x)      ( (*x).valid = 0 )
+
+// === MUTEX ===
+typedef struct {
+    pthread_mutex_t lock;
+    u8_t            valid;
+} sys_mutex_t;
+
+#define sys_mutex_valid(x)          ((*x).valid)
+#define sys_mutex_set_invalid(x)    ( (*x).valid = 0 )
+
+// === MAIL BOX ===
+#define MB_SIZE      8
+
+typedef struct {
+    void*           queue[MB_SIZE];
+    u32_t           head;                   /* Free running, written by posters */
+    u32_t           tail;                   /* Free running, written by fetchers */
+    u32_t           size;
+    pthread_mutex_t lock;
+    pthread_cond_t  not_empty;
+    pthread_cond_t  not_full;
+    u8_t            valid;
+} sys_mbox_t;
+
+#define SYS_MBOX_NULL               ((uint32_t) NULL)
+#define sys_mbox_valid(x)           ((*x).valid)
+#define sys_mbox_set_invalid(x)     ( (*x).valid = 0 )
+
+#if ((DEFAULT_RAW_RECVMBOX_SIZE) > (MB_SIZE)) || \
+    ((DEFAULT_UDP_RECVMBOX_SIZE) > (MB_SIZE)) || \
+    ((DEFAULT_TCP_RECVMBOX_SIZE) > (MB_SIZE)) || \
+    ((DEFAULT_ACCEPTMBOX_SIZE)   > (MB_SIZE)) || \
+    ((TCPIP_MBOX_SIZE)           > (MB_SIZE))
+#   error Mailbox size not supported
+#endif
+
+// === THREAD ===
+typedef pthread_t sys_thread_t;
+
+// === PROTECTION ===
+typedef int sys_prot_t;
+
+/* Same statistics as the target port: lwIP's pool lock is a recursive mutex here */
+#ifndef SYS_ARCH_PROTECT_STATS
+#define SYS_ARCH_PROTECT_STATS              0
+#endif
+
+void sys_arch_protect_get_stats(u32_t *count, u32_t *max_hold_us);
+void sys_arch_protect_reset_stats(void);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif
+
+#endif /* __ARCH_SYS_ARCH_H__ */
@@ -0,0 +1,20 @@
+/*
+ * Stand-in for the CMSIS-RTOS header on the host port (see arch/sys_arch.h in
+ * this directory). lwipopts.h and the EMAC drivers only need the thread
+ * priorities; sys_thread_new ignores them on the host.
+ */
+#ifndef CMSIS_OS_H_
+#define CMSIS_OS_H_
+
+typedef enum {
+    osPriorityIdle          = -3,
+    osPriorityLow           = -2,
+    osPriorityBelowNormal   = -1,
+    osPriorityNormal        =  0,
+    osPriorityAboveNormal   = +1,
+    osPriorityHigh          = +2,
+    osPriorityRealtime      = +3,
+    osPriorityError         = 0x84
+} osPriority;
+
+#endif /* CMSIS_OS_H_ */
@@ -0,0 +1,528 @@
+/* Copyright (C) 2012 mbed.org, MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <errno.h>
+
+#include "lwip/opt.h"
+#include "lwip/debug.h"
+#include "lwip/def.h"
+#include "lwip/sys.h"
+#include "lwip/mem.h"
+
+/* pthread implementation of the lwip operating system abstraction, see arch/sys_arch.h */
+#include "arch/sys_arch.h"
+
+static uint64_t sys_monotonic_us(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+
+static void sys_cond_init(pthread_cond_t *cond) {
+    pthread_condattr_t attr;
+
+    /* Timeouts are relative, keep them immune to wall clock changes */
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/* Waits on cond for at most timeout ms (0 waits forever), with lock held.
+ * Returns 0 when signaled, or ETIMEDOUT. */
+static int sys_cond_wait(pthread_cond_t *cond, pthread_mutex_t *lock, u32_t timeout) {
+    struct timespec deadline;
+
+    if (timeout == 0)
+        return pthread_cond_wait(cond, lock);
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec  += timeout / 1000;
+    deadline.tv_nsec += (long)(timeout % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    return pthread_cond_timedwait(cond, lock, &deadline);
+}
+
+static void sys_fatal(const char *msg) {
+    fprintf(stderr, "lwIP sys_arch: %s\n", msg);
+    abort();
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_new
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Creates a new mailbox
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      int queue_sz            -- Size of elements in the mailbox
+ * Outputs:
+ *      err_t                   -- ERR_OK if message posted, else ERR_MEM
+ *---------------------------------------------------------------------------*/
+err_t sys_mbox_new(sys_mbox_t *mbox, int queue_sz) {
+    if (queue_sz > MB_SIZE)
+        sys_fatal("sys_mbox_new size error");
+
+    mbox->head = 0;
+    mbox->tail = 0;
+    mbox->size = (queue_sz > 0) ? (u32_t)queue_sz : MB_SIZE;
+    pthread_mutex_init(&mbox->lock, NULL);
+    sys_cond_init(&mbox->not_empty);
+    sys_cond_init(&mbox->not_full);
+    mbox->valid = 1;
+
+    return ERR_OK;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_free
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Deallocates a mailbox. If there are messages still present in the
+ *      mailbox when the mailbox is deallocated, it is an indication of a
+ *      programming error in lwIP and the developer should be notified.
+ * Inputs:
+ *      sys_mbox_t *mbox         -- Handle of mailbox
+ *---------------------------------------------------------------------------*/
+void sys_mbox_free(sys_mbox_t *mbox) {
+    if (mbox->head != mbox->tail)
+        sys_fatal("sys_mbox_free error");
+
+    pthread_cond_destroy(&mbox->not_full);
+    pthread_cond_destroy(&mbox->not_empty);
+    pthread_mutex_destroy(&mbox->lock);
+    mbox->valid = 0;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_post
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Post the "msg" to the mailbox, blocking while it is full.
+ * Inputs:
+ *      sys_mbox_t mbox        -- Handle of mailbox
+ *      void *msg              -- Pointer to data to post
+ *---------------------------------------------------------------------------*/
+void sys_mbox_post(sys_mbox_t *mbox, void *msg) {
+    pthread_mutex_lock(&mbox->lock);
+    while (mbox->head - mbox->tail >= mbox->size)
+        pthread_cond_wait(&mbox->not_full, &mbox->lock);
+
+    mbox->queue[mbox->head % MB_SIZE] = msg;
+    mbox->head++;
+    pthread_cond_signal(&mbox->not_empty);
+    pthread_mutex_unlock(&mbox->lock);
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_trypost
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Try to post the "msg" to the mailbox.  Returns immediately with
+ *      error if cannot.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void *msg               -- Pointer to data to post
+ * Outputs:
+ *      err_t                   -- ERR_OK if message posted, else ERR_MEM
+ *                                  if not.
+ *---------------------------------------------------------------------------*/
+err_t sys_mbox_trypost(sys_mbox_t *mbox, void *msg) {
+    pthread_mutex_lock(&mbox->lock);
+    if (mbox->head - mbox->tail >= mbox->size) {
+        pthread_mutex_unlock(&mbox->lock);
+        return ERR_MEM;
+    }
+
+    mbox->queue[mbox->head % MB_SIZE] = msg;
+    mbox->head++;
+    pthread_cond_signal(&mbox->not_empty);
+    pthread_mutex_unlock(&mbox->lock);
+
+    return ERR_OK;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_mbox_fetch
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Blocks the thread until a message arrives in the mailbox, but does
+ *      not block the thread longer than "timeout" milliseconds (similar to
+ *      the sys_arch_sem_wait() function). The "msg" argument is a result
+ *      parameter that is set by the function (i.e., by doing "*msg =
+ *      ptr"). The "msg" parameter maybe NULL to indicate that the message
+ *      should be dropped.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void **msg              -- Pointer to pointer to msg received
+ *      u32_t timeout           -- Number of milliseconds until timeout
+ * Outputs:
+ *      u32_t                   -- SYS_ARCH_TIMEOUT if timeout, else number
+ *                                  of milliseconds until received.
+ *---------------------------------------------------------------------------*/
+u32_t sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout) {
+    uint64_t start = sys_monotonic_us();
+
+    pthread_mutex_lock(&mbox->lock);
+    while (mbox->head == mbox->tail) {
+        if (sys_cond_wait(&mbox->not_empty, &mbox->lock, timeout) == ETIMEDOUT && mbox->head == mbox->tail) {
+            pthread_mutex_unlock(&mbox->lock);
+            return SYS_ARCH_TIMEOUT;
+        }
+    }
+
+    if (msg != NULL)
+        *msg = mbox->queue[mbox->tail % MB_SIZE];
+    mbox->tail++;
+    pthread_cond_signal(&mbox->not_full);
+    pthread_mutex_unlock(&mbox->lock);
+
+    return (u32_t)((sys_monotonic_us() - start) / 1000);
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_mbox_tryfetch
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Similar to sys_arch_mbox_fetch, but if message is not ready
+ *      immediately, we'll return with SYS_MBOX_EMPTY.  On success, 0 is
+ *      returned.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void **msg              -- Pointer to pointer to msg received
+ * Outputs:
+ *      u32_t                   -- SYS_MBOX_EMPTY if no messages.  Otherwise,
+ *                                  return ERR_OK.
+ *---------------------------------------------------------------------------*/
+u32_t sys_arch_mbox_tryfetch(sys_mbox_t *mbox, void **msg) {
+    pthread_mutex_lock(&mbox->lock);
+    if (mbox->head == mbox->tail) {
+        pthread_mutex_unlock(&mbox->lock);
+        return SYS_MBOX_EMPTY;
+    }
+
+    if (msg != NULL)
+        *msg = mbox->queue[mbox->tail % MB_SIZE];
+    mbox->tail++;
+    pthread_cond_signal(&mbox->not_full);
+    pthread_mutex_unlock(&mbox->lock);
+
+    return ERR_OK;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_sem_new
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Creates and returns a new semaphore. The "ucCount" argument specifies
+ *      the initial state of the semaphore.
+ * Inputs:
+ *      sys_sem_t sem         -- Handle of semaphore
+ *      u8_t count            -- Initial count of semaphore
+ * Outputs:
+ *      err_t                 -- ERR_OK if semaphore created
+ *---------------------------------------------------------------------------*/
+err_t sys_sem_new(sys_sem_t *sem, u8_t count) {
+    pthread_mutex_init(&sem->lock, NULL);
+    sys_cond_init(&sem->signaled);
+    sem->count = count;
+    sem->valid = 1;
+
+    return ERR_OK;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_sem_wait
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Blocks the thread while waiting for the semaphore to be
+ *      signaled. If the "timeout" argument is non-zero, the thread should
+ *      only be blocked for the specified time (measured in
+ *      milliseconds).
+ * Inputs:
+ *      sys_sem_t sem           -- Semaphore to wait on
+ *      u32_t timeout           -- Number of milliseconds until timeout
+ * Outputs:
+ *      u32_t                   -- Time elapsed or SYS_ARCH_TIMEOUT.
+ *---------------------------------------------------------------------------*/
+u32_t sys_arch_sem_wait(sys_sem_t *sem, u32_t timeout) {
+    uint64_t start = sys_monotonic_us();
+
+    pthread_mutex_lock(&sem->lock);
+    while (sem->count == 0) {
+        if (sys_cond_wait(&sem->signaled, &sem->lock, timeout) == ETIMEDOUT && sem->count == 0) {
+            pthread_mutex_unlock(&sem->lock);
+            return SYS_ARCH_TIMEOUT;
+        }
+    }
+    sem->count--;
+    pthread_mutex_unlock(&sem->lock);
+
+    return (u32_t)((sys_monotonic_us() - start) / 1000);
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_sem_signal
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Signals (releases) a semaphore
+ * Inputs:
+ *      sys_sem_t sem           -- Semaphore to signal
+ *---------------------------------------------------------------------------*/
+void sys_sem_signal(sys_sem_t *data) {
+    pthread_mutex_lock(&data->lock);
+    data->count++;
+    pthread_cond_signal(&data->signaled);
+    pthread_mutex_unlock(&data->lock);
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_sem_free
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Deallocates a semaphore
+ * Inputs:
+ *      sys_sem_t sem           -- Semaphore to free
+ *---------------------------------------------------------------------------*/
+void sys_sem_free(sys_sem_t *sem) {
+    pthread_cond_destroy(&sem->signaled);
+    pthread_mutex_destroy(&sem->lock);
+    sem->valid = 0;
+}
+
+/** Create a new mutex
+ * @param mutex pointer to the mutex to create
+ * @return a new mutex */
+err_t sys_mutex_new(sys_mutex_t *mutex) {
+    if (pthread_mutex_init(&mutex->lock, NULL) != 0)
+        return ERR_MEM;
+
+    mutex->valid = 1;
+    return ERR_OK;
+}
+
+/** Lock a mutex
+ * @param mutex the mutex to lock */
+void sys_mutex_lock(sys_mutex_t *mutex) {
+    if (pthread_mutex_lock(&mutex->lock) != 0)
+        sys_fatal("sys_mutex_lock error");
+}
+
+/** Unlock a mutex
+ * @param mutex the mutex to unlock */
+void sys_mutex_unlock(sys_mutex_t *mutex) {
+    if (pthread_mutex_unlock(&mutex->lock) != 0)
+        sys_fatal("sys_mutex_unlock error");
+}
+
+/** Delete a mutex
+ * @param mutex the mutex to delete */
+void sys_mutex_free(sys_mutex_t *mutex) {
+    pthread_mutex_destroy(&mutex->lock);
+    mutex->valid = 0;
+}
+
+/*---------------------------------------------------------------------------*
+ * Critical regions
+ *---------------------------------------------------------------------------*
+ * There are no interrupts to mask on the host; the receive threads of the
+ * host netif are ordinary threads, so a recursive mutex is enough. The same
+ * statistics as the target port are kept, so the numbers can be compared.
+ *---------------------------------------------------------------------------*/
+static pthread_mutex_t protect_lock;
+static u32_t protect_depth;
+
+#if SYS_ARCH_PROTECT_STATS
+static uint64_t protect_start_us;
+static u32_t protect_count;
+static u32_t protect_max_hold_us;
+#endif
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_init
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Initialize sys arch
+ *---------------------------------------------------------------------------*/
+void sys_init(void) {
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&protect_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    sys_arch_protect_reset_stats();
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_protect
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Enters a (possibly nested) critical region.
+ * Outputs:
+ *      sys_prot_t              -- Nesting level before this call
+ *---------------------------------------------------------------------------*/
+sys_prot_t sys_arch_protect(void) {
+    sys_prot_t prev;
+
+    pthread_mutex_lock(&protect_lock);
+    prev = (sys_prot_t)protect_depth++;
+#if SYS_ARCH_PROTECT_STATS
+    if (prev == 0) {
+        protect_start_us = sys_monotonic_us();
+        protect_count++;
+    }
+#endif
+    return prev;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_unprotect
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Leaves the critical region entered by the matching sys_arch_protect.
+ * Inputs:
+ *      sys_prot_t              -- Value returned by sys_arch_protect
+ *---------------------------------------------------------------------------*/
+void sys_arch_unprotect(sys_prot_t p) {
+    protect_depth = (u32_t)p;
+#if SYS_ARCH_PROTECT_STATS
+    if (p == 0) {
+        u32_t held = (u32_t)(sys_monotonic_us() - protect_start_us);
+
+        if (held > protect_max_hold_us)
+            protect_max_hold_us = held;
+    }
+#endif
+    pthread_mutex_unlock(&protect_lock);
+}
+
+void sys_arch_protect_get_stats(u32_t *count, u32_t *max_hold_us) {
+#if SYS_ARCH_PROTECT_STATS
+    *count       = protect_count;
+    *max_hold_us = protect_max_hold_us;
+#else
+    *count       = 0;
+    *max_hold_us = 0;
+#endif
+}
+
+void sys_arch_protect_reset_stats(void) {
+#if SYS_ARCH_PROTECT_STATS
+    protect_count       = 0;
+    protect_max_hold_us = 0;
+#endif
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_jiffies
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Used by PPP as a timestamp-ish value
+ *---------------------------------------------------------------------------*/
+u32_t sys_jiffies(void) {
+    return (u32_t)(sys_monotonic_us() / 10000);
+}
+
+u32_t sys_now(void) {
+    return (u32_t)(sys_monotonic_us() / 1000);
+}
+
+typedef struct {
+    void (*thread)(void *arg);
+    void  *arg;
+} sys_thread_start_t;
+
+static void* sys_thread_entry(void *param) {
+    sys_thread_start_t start = *(sys_thread_start_t*)param;
+
+    free(param);
+    start.thread(start.arg);
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_thread_new
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Starts a new thread that will begin its execution in the function
+ *      "thread()". The "arg" argument will be passed as an argument to the
+ *      thread() function. Threads are detached, lwIP never joins them.
+ *      The requested stack size is a minimum and priorities are ignored:
+ *      the host scheduler is not something the benchmarks should depend on.
+ * Inputs:
+ *      char *name                -- Name of thread
+ *      void (*thread)(void *arg) -- Pointer to function to run.
+ *      void *arg                 -- Argument passed into function
+ *      int stacksize             -- Required stack amount in bytes
+ *      int priority              -- Thread priority
+ * Outputs:
+ *      sys_thread_t              -- Thread handle.
+ *---------------------------------------------------------------------------*/
+sys_thread_t sys_thread_new(const char *pcName,
+                            void (*thread)(void *arg),
+                            void *arg, int stacksize, int priority) {
+    sys_thread_start_t *start;
+    pthread_attr_t      attr;
+    pthread_t           t;
+
+    LWIP_UNUSED_ARG(pcName);
+    LWIP_UNUSED_ARG(stacksize);
+    LWIP_UNUSED_ARG(priority);
+    LWIP_DEBUGF(SYS_DEBUG, ("New Thread: %s\n", pcName));
+
+    start = (sys_thread_start_t*)malloc(sizeof(sys_thread_start_t));
+    if (start == NULL)
+        sys_fatal("sys_thread_new allocation error");
+    start->thread = thread;
+    start->arg    = arg;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&t, &attr, sys_thread_entry, start) != 0)
+        sys_fatal("sys_thread_new create error");
+    pthread_attr_destroy(&attr);
+
+    return t;
+}
+
+#ifdef LWIP_DEBUG
+
+void assert_printf(char *msg, int line, char *file) {
+    fprintf(stderr, "%s:%d in file %s\n", msg ? msg : "LWIP ASSERT", line, file);
+    abort();
+}
+
+#else
+
+void assert_printf(char *msg, int line, char *file) {
+    LWIP_UNUSED_ARG(msg);
+    LWIP_UNUSED_ARG(line);
+    LWIP_UNUSED_ARG(file);
+}
+
+#endif /* LWIP_DEBUG */
@@ -52,11 +52,17 @@ typedef uintptr_t          mem_ptr_t;
 #define X32_F "lx"
 #define SZT_F "uz"
 
-/* ARM/LPC17xx is little endian only */
+/* ARM/LPC17xx is little endian only, so is the host port (which may have it from <endian.h>) */
+#ifndef BYTE_ORDER
 #define BYTE_ORDER LITTLE_ENDIAN
+#endif
 
-/* Use LWIP error codes */
+/* Use LWIP error codes, except on the host where the C library has its own */
+#if defined(TARGET_HOST)
+#include <errno.h>
+#else
 #define LWIP_PROVIDE_ERRNO
+#endif
 
 #if defined(__arm__) && defined(__ARMCC_VERSION) 
     /* Keil uVision4 tools */
@@ -97,6 +103,21 @@ typedef uintptr_t          mem_ptr_t;
     #define LWIP_CHKSUM_ALGORITHM   1
 #endif
 
+/* Copy and checksum in one pass when LWIP_CHECKSUM_ON_COPY is enabled
+   (lwip_arch_chksum_copy in checksum.c). Only lwIP's core uses the define, so it
+   takes effect with a liblwIP.a rebuilt with LWIP_ARCH_CHKSUM_COPY set; the
+   prebuilt library keeps its own copy then checksum. Not used on ARMv6-M, where
+   the word-at-a-time path is no faster than lwIP's own */
+#ifndef LWIP_ARCH_CHKSUM_COPY
+#define LWIP_ARCH_CHKSUM_COPY   0
+#endif
+
+#if LWIP_ARCH_CHKSUM_COPY && ((defined(TOOLCHAIN_GCC) && defined(__thumb2__)) || !defined(__arm__))
+    #define LWIP_CHKSUM_COPY(dst,src,len)   lwip_arch_chksum_copy(dst,src,len)
+
+    u16_t lwip_arch_chksum_copy(void* pDest, const void* pSource, u16_t length);
+#endif
+
 
 #ifdef LWIP_DEBUG
 
@@ -112,8 +133,13 @@ void assert_printf(char *msg, int line, char *file);
 #define LWIP_PLATFORM_ASSERT(flag) { ; }
 #endif 
 
+#if defined(TARGET_HOST)
+#define LWIP_PLATFORM_HTONS(x)      __builtin_bswap16(x)
+#define LWIP_PLATFORM_HTONL(x)      __builtin_bswap32(x)
+#else
 #include "cmsis.h"
 #define LWIP_PLATFORM_HTONS(x)      __REV16(x)
 #define LWIP_PLATFORM_HTONL(x)      __REV(x)
+#endif
 
 #endif /* __CC_H__ */ 
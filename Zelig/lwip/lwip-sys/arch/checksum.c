@@ -124,3 +124,168 @@ __attribute__((naked)) void /*uint16_t*/ thumb2_checksum(const void* pData, int
 }
 
 #endif
+
+
+#include <stdint.h>
+#include <string.h>
+
+/* Copy and checksum in a single pass, for LWIP_CHKSUM_COPY (used by lwIP when
+   LWIP_CHECKSUM_ON_COPY is set, i.e. when segments are copied into pbufs).  The
+   data is summed as it is loaded for the copy, instead of being read a second
+   time by LWIP_CHKSUM after MEMCPY.
+
+   The sum has the same meaning as thumb2_checksum()'s: words are loaded in
+   native order, a source at an odd address is summed at an offset of 1 and
+   swapped at the end.  Only the source has to be aligned for the main loop,
+   the destination is written with (possibly unaligned) word stores.
+
+   Words are accumulated into 64 bits, which needs no carry handling in the
+   loop on the host and compiles to an adds/adc pair on ARM.  When both
+   pointers end up word aligned, Thumb-2 targets move 16 bytes per iteration
+   with ldm/stm and fold them in with a single adcs chain.
+
+   Returns:
+        16-bit 1's complement summation (not inversed).
+*/
+static inline uint32_t chksum_load32(const uint8_t* p)
+{
+    uint32_t value;
+
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline void chksum_store32(uint8_t* p, uint32_t value)
+{
+    memcpy(p, &value, sizeof(value));
+}
+
+uint16_t lwip_arch_chksum_copy(void* pDest, const void* pSource, uint16_t length)
+{
+    uint8_t*       pDst = (uint8_t*)pDest;
+    const uint8_t* pSrc = (const uint8_t*)pSource;
+    int            len  = length;
+    int            odd  = (int)((uintptr_t)pSrc & 1);
+    uint64_t       sum  = 0;
+    uint32_t       fold;
+
+    if (len == 0)
+    {
+        return 0;
+    }
+
+    /* 2-byte align the source, the first byte goes to the odd summation slot. */
+    if (odd)
+    {
+        *pDst = *pSrc;
+        sum   = (uint32_t)*pSrc << 8;
+        pDst++;
+        pSrc++;
+        len--;
+    }
+
+    /* 4-byte align the source. */
+    if (((uintptr_t)pSrc & 2) && len >= 2)
+    {
+        uint16_t half;
+
+        memcpy(&half, pSrc, sizeof(half));
+        memcpy(pDst, &half, sizeof(half));
+        sum  += half;
+        pDst += 2;
+        pSrc += 2;
+        len  -= 2;
+    }
+
+#if defined(TOOLCHAIN_GCC) && defined(__thumb2__)
+    if (((uintptr_t)pDst & 3) == 0)
+    {
+        uint32_t sum32 = 0;
+
+        /* Both aligned: 16 bytes per iteration with a single carry chain. */
+        while (len >= 16)
+        {
+            __asm volatile (
+                "    ldmia   %[src]!, {r4-r7}\n"
+                "    stmia   %[dst]!, {r4-r7}\n"
+                "    adds    %[sum], %[sum], r4\n"
+                "    adcs    %[sum], %[sum], r5\n"
+                "    adcs    %[sum], %[sum], r6\n"
+                "    adcs    %[sum], %[sum], r7\n"
+                "    adc     %[sum], %[sum], #0\n"
+                : [src] "+r" (pSrc), [dst] "+r" (pDst), [sum] "+r" (sum32)
+                :
+                : "r4", "r5", "r6", "r7", "cc", "memory"
+            );
+            len -= 16;
+        }
+
+        sum += sum32;
+    }
+#endif
+
+    /* Unrolled word loop. */
+    while (len >= 16)
+    {
+        uint32_t w0 = chksum_load32(pSrc + 0 );
+        uint32_t w1 = chksum_load32(pSrc + 4 );
+        uint32_t w2 = chksum_load32(pSrc + 8 );
+        uint32_t w3 = chksum_load32(pSrc + 12);
+
+        chksum_store32(pDst + 0 , w0);
+        chksum_store32(pDst + 4 , w1);
+        chksum_store32(pDst + 8 , w2);
+        chksum_store32(pDst + 12, w3);
+
+        sum += (uint64_t)w0 + w1 + w2 + w3;
+
+        pDst += 16;
+        pSrc += 16;
+        len  -= 16;
+    }
+
+    while (len >= 4)
+    {
+        uint32_t w = chksum_load32(pSrc);
+
+        chksum_store32(pDst, w);
+        sum  += w;
+        pDst += 4;
+        pSrc += 4;
+        len  -= 4;
+    }
+
+    if (len >= 2)
+    {
+        uint16_t half;
+
+        memcpy(&half, pSrc, sizeof(half));
+        memcpy(pDst, &half, sizeof(half));
+        sum  += half;
+        pDst += 2;
+        pSrc += 2;
+        len  -= 2;
+    }
+
+    /* Trailing byte, in the low (even) slot. */
+    if (len)
+    {
+        *pDst = *pSrc;
+        sum  += *pSrc;
+    }
+
+    /* Fold 64-bit sum into 16 bits. */
+    sum  = (sum >> 32) + (sum & 0xFFFFFFFFu);
+    sum  = (sum >> 32) + (sum & 0xFFFFFFFFu);
+    fold = (uint32_t)sum;
+    fold = (fold >> 16) + (fold & 0xFFFFu);
+    fold = (fold >> 16) + (fold & 0xFFFFu);
+
+    /* Swap bytes if started at odd address. */
+    if (odd)
+    {
+        fold = ((fold & 0xFFu) << 8) | (fold >> 8);
+    }
+
+    return (uint16_t)fold;
+}
@@ -89,6 +89,8 @@ uint32_t sys_uSeconds() {
     return (uint32_t)((ticks * 1000000) / frequency);
 }
 
+#if !SYS_ARCH_NATIVE_MBOX
+
 /*---------------------------------------------------------------------------*
  * Routine:  sys_mbox_new
  *---------------------------------------------------------------------------*
@@ -229,6 +231,8 @@ u32_t sys_arch_mbox_tryfetch(sys_mbox_t *mbox, void **msg) {
     return ERR_OK;
 }
 
+#endif
+
 /*---------------------------------------------------------------------------*
  * Routine:  sys_sem_new
  *---------------------------------------------------------------------------*
@@ -355,13 +359,8 @@ void sys_mutex_free(sys_mutex_t *mutex) {}
  * Description:
  *      Initialize sys arch
  *---------------------------------------------------------------------------*/
-osMutexId lwip_sys_mutex;
-osMutexDef(lwip_sys_mutex);
-
 void sys_init(void) {
-    lwip_sys_mutex = osMutexCreate(osMutex(lwip_sys_mutex));
-    if (lwip_sys_mutex == NULL)
-        error("sys_init error\n");
+    sys_arch_protect_reset_stats();
 }
 
 /*---------------------------------------------------------------------------*
@@ -378,6 +377,57 @@ u32_t sys_jiffies(void) {
     return jiffies;
 }
 
+/*---------------------------------------------------------------------------*
+ * Critical regions
+ *---------------------------------------------------------------------------*
+ * lwIP protects its pools (pbuf/memp allocations and frees) with very short
+ * critical regions, so they are implemented by masking interrupts rather than
+ * with an RTOS mutex. On ARMv7-M BASEPRI is raised to the level the kernel uses
+ * to disable interrupts, which leaves priority 0 handlers running (see
+ * SYS_ARCH_PROTECT_BASEPRI in sys_arch.h); ARMv6-M only has PRIMASK. The previous mask is returned, so nested regions unwind correctly.
+ *
+ * With SYS_ARCH_PROTECT_STATS (off by default), the number of regions and the
+ * longest time one was held (in microseconds, outermost regions only) are
+ * recorded.
+ *---------------------------------------------------------------------------*/
+#if (__CORTEX_M >= 0x03)
+#define SYS_ARCH_PROTECT_USE_BASEPRI    1
+#else
+#define SYS_ARCH_PROTECT_USE_BASEPRI    0
+#endif
+
+static volatile u32_t protect_depth;
+
+#if SYS_ARCH_PROTECT_STATS
+static u32_t protect_start_us;
+static volatile u32_t protect_count;
+static volatile u32_t protect_max_hold_us;
+#endif
+
+static __INLINE sys_prot_t sys_arch_mask_interrupts(void) {
+#if SYS_ARCH_PROTECT_USE_BASEPRI
+    uint32_t prev  = __get_BASEPRI();
+    uint32_t level = SYS_ARCH_PROTECT_BASEPRI << (8 - __NVIC_PRIO_BITS);
+
+    if (prev == 0 || prev > level)
+        __set_BASEPRI(level);
+    return (sys_prot_t)prev;
+#else
+    uint32_t prev = __get_PRIMASK();
+
+    __disable_irq();
+    return (sys_prot_t)prev;
+#endif
+}
+
+static __INLINE void sys_arch_restore_interrupts(sys_prot_t prev) {
+#if SYS_ARCH_PROTECT_USE_BASEPRI
+    __set_BASEPRI((uint32_t)prev);
+#else
+    __set_PRIMASK((uint32_t)prev);
+#endif
+}
+
 /*---------------------------------------------------------------------------*
  * Routine:  sys_arch_protect
  *---------------------------------------------------------------------------*
@@ -395,12 +445,19 @@ u32_t sys_jiffies(void) {
  *      sys_arch_protect() is only required if your port is supporting an
  *      operating system.
  * Outputs:
- *      sys_prot_t              -- Previous protection level (not used here)
+ *      sys_prot_t              -- Previous interrupt mask
  *---------------------------------------------------------------------------*/
 sys_prot_t sys_arch_protect(void) {
-    if (osMutexWait(lwip_sys_mutex, osWaitForever) != osOK)
-        error("sys_arch_protect error\n");
-    return (sys_prot_t)1;
+    sys_prot_t prev = sys_arch_mask_interrupts();
+
+    if (protect_depth++ == 0) {
+#if SYS_ARCH_PROTECT_STATS
+        protect_start_us = us_ticker_read();
+        protect_count++;
+#endif
+    }
+
+    return prev;
 }
 
 /*---------------------------------------------------------------------------*
@@ -412,11 +469,50 @@ sys_prot_t sys_arch_protect(void) {
  *      sys_arch_protect() for more information. This function is only
  *      required if your port is supporting an operating system.
  * Inputs:
- *      sys_prot_t              -- Previous protection level (not used here)
+ *      sys_prot_t              -- Interrupt mask returned by sys_arch_protect
  *---------------------------------------------------------------------------*/
 void sys_arch_unprotect(sys_prot_t p) {
-    if (osMutexRelease(lwip_sys_mutex) != osOK)
-        error("sys_arch_unprotect error\n");
+    if (--protect_depth == 0) {
+#if SYS_ARCH_PROTECT_STATS
+        u32_t held = us_ticker_read() - protect_start_us;
+
+        if (held > protect_max_hold_us)
+            protect_max_hold_us = held;
+#endif
+    }
+
+    sys_arch_restore_interrupts(p);
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_protect_get_stats
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Reports how many critical regions were entered and the longest one,
+ *      since startup or the last sys_arch_protect_reset_stats.
+ * Outputs:
+ *      u32_t *count            -- Number of outermost critical regions
+ *      u32_t *max_hold_us      -- Longest critical region in microseconds
+ *---------------------------------------------------------------------------*/
+void sys_arch_protect_get_stats(u32_t *count, u32_t *max_hold_us) {
+#if SYS_ARCH_PROTECT_STATS
+    *count       = protect_count;
+    *max_hold_us = protect_max_hold_us;
+#else
+    *count       = 0;
+    *max_hold_us = 0;
+#endif
+}
+
+void sys_arch_protect_reset_stats(void) {
+#if SYS_ARCH_PROTECT_STATS
+    sys_prot_t prev = sys_arch_mask_interrupts();
+
+    protect_count       = 0;
+    protect_max_hold_us = 0;
+
+    sys_arch_restore_interrupts(prev);
+#endif
 }
 
 u32_t sys_now(void) {
@@ -65,6 +65,38 @@ typedef struct {
 // === MAIL BOX ===
 #define MB_SIZE      8
 
+/* Native ring buffer mailboxes (sys_arch_mbox.c) instead of CMSIS-RTOS message queues. They
+   change the layout of sys_mbox_t, which the prebuilt liblwIP.a embeds in its own structures
+   (netconn, tcpip), so only turn them on together with a rebuilt lwIP library */
+#ifndef SYS_ARCH_NATIVE_MBOX
+#define SYS_ARCH_NATIVE_MBOX        0
+#endif
+
+#if SYS_ARCH_NATIVE_MBOX
+
+/*
+ * Messages go through a ring under sys_arch_protect, so posting and fetching
+ * never leave native code unless a thread actually has to block; then the
+ * semaphores below are used to sleep and to wake it up.
+ */
+typedef struct {
+    void*           queue[MB_SIZE];
+    volatile u32_t  head;                   /* Free running, written by posters */
+    volatile u32_t  tail;                   /* Free running, written by fetchers */
+    u32_t           size;
+    volatile u32_t  fetch_waiters;          /* Threads blocked on not_empty */
+    volatile u32_t  post_waiters;           /* Threads blocked on not_full */
+    sys_sem_t       not_empty;
+    sys_sem_t       not_full;
+    u8_t            valid;
+} sys_mbox_t;
+
+#define SYS_MBOX_NULL               ((uint32_t) NULL)
+#define sys_mbox_valid(x)           ((*x).valid)
+#define sys_mbox_set_invalid(x)     ( (*x).valid = 0 )
+
+#else
+
 typedef struct {
     osMessageQId    id;
     osMessageQDef_t def;
@@ -77,6 +109,8 @@ typedef struct {
 #define sys_mbox_valid(x)           (((*x).id == NULL) ? 0 : 1 )
 #define sys_mbox_set_invalid(x)     ( (*x).id = NULL )
 
+#endif
+
 #if ((DEFAULT_RAW_RECVMBOX_SIZE) > (MB_SIZE)) || \
     ((DEFAULT_UDP_RECVMBOX_SIZE) > (MB_SIZE)) || \
     ((DEFAULT_TCP_RECVMBOX_SIZE) > (MB_SIZE)) || \
@@ -98,6 +132,37 @@ typedef sys_thread_data_t* sys_thread_t;
 // === PROTECTION ===
 typedef int sys_prot_t;
 
+/*
+ * BASEPRI level for critical regions on ARMv7-M, the one the kernel uses to disable interrupts.
+ * Only handlers at this priority or below (numerically greater or equal) are masked: a handler
+ * at priority 0, the NVIC reset value, still runs inside a critical region and must not call
+ * into lwIP or the RTOS. Drivers that do, like the STM32F4 EMAC, set their IRQ priority at or
+ * below this level.
+ */
+#ifndef SYS_ARCH_PROTECT_BASEPRI
+#define SYS_ARCH_PROTECT_BASEPRI            1
+#endif
+
+/* Count critical regions and record the longest one, see sys_arch_protect_get_stats. Reads the
+   us ticker twice per outermost region, so it is off unless measuring. */
+#ifndef SYS_ARCH_PROTECT_STATS
+#define SYS_ARCH_PROTECT_STATS              0
+#endif
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+void sys_arch_protect_get_stats(u32_t *count, u32_t *max_hold_us);
+void sys_arch_protect_reset_stats(void);
+
+uint32_t sys_uSeconds(void);
+
+#ifdef  __cplusplus
+}
+#endif
+
 #else
 #ifdef  __cplusplus
 extern "C" {
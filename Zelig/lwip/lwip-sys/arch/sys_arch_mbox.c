@@ -0,0 +1,272 @@
+/* Copyright (C) 2012 mbed.org, MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "mbed_error.h"
+
+#include "lwip/opt.h"
+#include "lwip/sys.h"
+
+#if (NO_SYS == 0) && SYS_ARCH_NATIVE_MBOX
+
+/*---------------------------------------------------------------------------*
+ * Native mailboxes
+ *---------------------------------------------------------------------------*
+ * Every tcpip_callback, netconn call and received frame goes through a
+ * mailbox, so these are kept out of the CMSIS-RTOS layer: a message is
+ * copied in and out of a small ring while interrupts are masked, and the
+ * semaphores are only touched when a thread has to sleep on an empty (or
+ * full) mailbox. Waiters register themselves in fetch_waiters/post_waiters
+ * before blocking, and whoever makes progress hands out one token per
+ * registration it removes, so an uncontended post/fetch never leaves native
+ * code.
+ *---------------------------------------------------------------------------*/
+#define SYS_MBOX_SLOT(index)    ((index) % MB_SIZE)
+
+/* Waits on a mailbox semaphore after registering in *waiters (under protection).
+ * Returns 0 if woken up, or SYS_ARCH_TIMEOUT once the registration is withdrawn. */
+static u32_t sys_mbox_wait(sys_sem_t *sem, volatile u32_t *waiters, u32_t timeout) {
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    if (sys_arch_sem_wait(sem, timeout) != SYS_ARCH_TIMEOUT)
+        return 0;
+
+    SYS_ARCH_PROTECT(lev);
+    if (*waiters != 0) {
+        /* Nobody picked us, withdraw */
+        (*waiters)--;
+        SYS_ARCH_UNPROTECT(lev);
+        return SYS_ARCH_TIMEOUT;
+    }
+    SYS_ARCH_UNPROTECT(lev);
+
+    /* Lost the race with a signal that is already on its way, absorb it */
+    sys_arch_sem_wait(sem, 0);
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_new
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Creates a new mailbox
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      int queue_sz            -- Size of elements in the mailbox
+ * Outputs:
+ *      err_t                   -- ERR_OK if message posted, else ERR_MEM
+ *---------------------------------------------------------------------------*/
+err_t sys_mbox_new(sys_mbox_t *mbox, int queue_sz) {
+    if (queue_sz > MB_SIZE)
+        error("sys_mbox_new size error\n");
+
+    mbox->head          = 0;
+    mbox->tail          = 0;
+    mbox->size          = (queue_sz > 0) ? (u32_t)queue_sz : MB_SIZE;
+    mbox->fetch_waiters = 0;
+    mbox->post_waiters  = 0;
+
+    if (sys_sem_new(&mbox->not_empty, 0) != ERR_OK)
+        return ERR_MEM;
+    if (sys_sem_new(&mbox->not_full, 0) != ERR_OK) {
+        sys_sem_free(&mbox->not_empty);
+        return ERR_MEM;
+    }
+
+    mbox->valid = 1;
+    return ERR_OK;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_free
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Deallocates a mailbox. If there are messages still present in the
+ *      mailbox when the mailbox is deallocated, it is an indication of a
+ *      programming error in lwIP and the developer should be notified.
+ * Inputs:
+ *      sys_mbox_t *mbox         -- Handle of mailbox
+ *---------------------------------------------------------------------------*/
+void sys_mbox_free(sys_mbox_t *mbox) {
+    if (mbox->head != mbox->tail)
+        error("sys_mbox_free error\n");
+
+    sys_sem_free(&mbox->not_empty);
+    sys_sem_free(&mbox->not_full);
+    mbox->valid = 0;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_post
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Post the "msg" to the mailbox.
+ * Inputs:
+ *      sys_mbox_t mbox        -- Handle of mailbox
+ *      void *msg              -- Pointer to data to post
+ *---------------------------------------------------------------------------*/
+void sys_mbox_post(sys_mbox_t *mbox, void *msg) {
+    while (sys_mbox_trypost(mbox, msg) != ERR_OK) {
+        SYS_ARCH_DECL_PROTECT(lev);
+
+        SYS_ARCH_PROTECT(lev);
+        if (mbox->head - mbox->tail < mbox->size) {
+            /* A slot freed up in the meantime */
+            SYS_ARCH_UNPROTECT(lev);
+            continue;
+        }
+        mbox->post_waiters++;
+        SYS_ARCH_UNPROTECT(lev);
+
+        sys_mbox_wait(&mbox->not_full, &mbox->post_waiters, 0);
+    }
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_mbox_trypost
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Try to post the "msg" to the mailbox.  Returns immediately with
+ *      error if cannot.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void *msg               -- Pointer to data to post
+ * Outputs:
+ *      err_t                   -- ERR_OK if message posted, else ERR_MEM
+ *                                  if not.
+ *---------------------------------------------------------------------------*/
+err_t sys_mbox_trypost(sys_mbox_t *mbox, void *msg) {
+    u32_t wake = 0;
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    SYS_ARCH_PROTECT(lev);
+    if (mbox->head - mbox->tail >= mbox->size) {
+        SYS_ARCH_UNPROTECT(lev);
+        return ERR_MEM;
+    }
+
+    mbox->queue[SYS_MBOX_SLOT(mbox->head)] = msg;
+    mbox->head++;
+
+    if (mbox->fetch_waiters != 0) {
+        mbox->fetch_waiters--;
+        wake = 1;
+    }
+    SYS_ARCH_UNPROTECT(lev);
+
+    /* May run in an ISR, releasing a semaphore is safe there */
+    if (wake)
+        sys_sem_signal(&mbox->not_empty);
+
+    return ERR_OK;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_mbox_fetch
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Blocks the thread until a message arrives in the mailbox, but does
+ *      not block the thread longer than "timeout" milliseconds (similar to
+ *      the sys_arch_sem_wait() function). The "msg" argument is a result
+ *      parameter that is set by the function (i.e., by doing "*msg =
+ *      ptr"). The "msg" parameter maybe NULL to indicate that the message
+ *      should be dropped.
+ *
+ *      The return values are the same as for the sys_arch_sem_wait() function:
+ *      Number of milliseconds spent waiting or SYS_ARCH_TIMEOUT if there was a
+ *      timeout.
+ *
+ *      Note that a function with a similar name, sys_mbox_fetch(), is
+ *      implemented by lwIP.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void **msg              -- Pointer to pointer to msg received
+ *      u32_t timeout           -- Number of milliseconds until timeout
+ * Outputs:
+ *      u32_t                   -- SYS_ARCH_TIMEOUT if timeout, else number
+ *                                  of milliseconds until received.
+ *---------------------------------------------------------------------------*/
+u32_t sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout) {
+    u32_t start = (u32_t)sys_uSeconds();
+    u32_t elapsed;
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    for (;;) {
+        if (sys_arch_mbox_tryfetch(mbox, msg) == ERR_OK)
+            return ((u32_t)sys_uSeconds() - start) / 1000;
+
+        elapsed = ((u32_t)sys_uSeconds() - start) / 1000;
+        if (timeout != 0 && elapsed >= timeout)
+            return SYS_ARCH_TIMEOUT;
+
+        SYS_ARCH_PROTECT(lev);
+        if (mbox->head != mbox->tail) {
+            /* A message arrived in the meantime */
+            SYS_ARCH_UNPROTECT(lev);
+            continue;
+        }
+        mbox->fetch_waiters++;
+        SYS_ARCH_UNPROTECT(lev);
+
+        if (sys_mbox_wait(&mbox->not_empty, &mbox->fetch_waiters, (timeout != 0) ? (timeout - elapsed) : 0) == SYS_ARCH_TIMEOUT)
+            return SYS_ARCH_TIMEOUT;
+    }
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_mbox_tryfetch
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Similar to sys_arch_mbox_fetch, but if message is not ready
+ *      immediately, we'll return with SYS_MBOX_EMPTY.  On success, 0 is
+ *      returned.
+ * Inputs:
+ *      sys_mbox_t mbox         -- Handle of mailbox
+ *      void **msg              -- Pointer to pointer to msg received
+ * Outputs:
+ *      u32_t                   -- SYS_MBOX_EMPTY if no messages.  Otherwise,
+ *                                  return ERR_OK.
+ *---------------------------------------------------------------------------*/
+u32_t sys_arch_mbox_tryfetch(sys_mbox_t *mbox, void **msg) {
+    void *value;
+    u32_t wake = 0;
+    SYS_ARCH_DECL_PROTECT(lev);
+
+    SYS_ARCH_PROTECT(lev);
+    if (mbox->head == mbox->tail) {
+        SYS_ARCH_UNPROTECT(lev);
+        return SYS_MBOX_EMPTY;
+    }
+
+    value = mbox->queue[SYS_MBOX_SLOT(mbox->tail)];
+    mbox->tail++;
+
+    if (mbox->post_waiters != 0) {
+        mbox->post_waiters--;
+        wake = 1;
+    }
+    SYS_ARCH_UNPROTECT(lev);
+
+    if (wake)
+        sys_sem_signal(&mbox->not_full);
+
+    if (msg != NULL)
+        *msg = value;
+
+    return ERR_OK;
+}
+
+#endif
@@ -48,10 +48,43 @@
 // 32-bit alignment
 #define MEM_ALIGNMENT               4
 
+// Pool tuning: the pool profiles and the statistics below change the pool sizes and the layout of
+// lwip_stats, which the prebuilt liblwIP.a is not built with. They are off unless LWIP_POOL_TUNING
+// is set (LWIP_POOL_TUNING=1 in the makefiles) for a liblwIP.a rebuilt with the same options;
+// otherwise the DEFAULT sizes, the ones of the prebuilt library, are used.
+#ifndef LWIP_POOL_TUNING
+#define LWIP_POOL_TUNING            0
+#endif
+
+// Pool profiles. Each board picks one in its lwipopts_conf.h; a build can override it with
+// -DLWIP_POOL_PROFILE=LWIP_POOL_PROFILE_xxx (LWIP_PROFILE=xxx in the makefiles).
+#define LWIP_POOL_PROFILE_SMALL     0
+#define LWIP_POOL_PROFILE_DEFAULT   1
+#define LWIP_POOL_PROFILE_LARGE     2
+
+#ifndef LWIP_POOL_PROFILE
+#define LWIP_POOL_PROFILE           LWIP_POOL_PROFILE_DEFAULT
+#endif
+
+#if LWIP_POOL_TUNING && (LWIP_POOL_PROFILE == LWIP_POOL_PROFILE_SMALL)
+#define PBUF_POOL_SIZE              4
+#define MEMP_NUM_TCP_PCB_LISTEN     2
+#define MEMP_NUM_TCP_PCB            2
+#define MEMP_NUM_PBUF               6
+#define LWIP_POOL_TCP_WINDOW_MSS    2       // lwIP's sanity checks want at least two segments
+#elif LWIP_POOL_TUNING && (LWIP_POOL_PROFILE == LWIP_POOL_PROFILE_LARGE)
+#define PBUF_POOL_SIZE              16
+#define MEMP_NUM_TCP_PCB_LISTEN     4
+#define MEMP_NUM_TCP_PCB            8
+#define MEMP_NUM_PBUF               16
+#define LWIP_POOL_TCP_WINDOW_MSS    4
+#else
 #define PBUF_POOL_SIZE              5
 #define MEMP_NUM_TCP_PCB_LISTEN     4
 #define MEMP_NUM_TCP_PCB            4
 #define MEMP_NUM_PBUF               8
+#define LWIP_POOL_TCP_WINDOW_MSS    2
+#endif
 
 #define TCP_QUEUE_OOSEQ             0
 #define TCP_OVERSIZE                0
@@ -100,8 +133,29 @@
 #define MEMP_SANITY_CHECK           1
 #else
 #define LWIP_NOASSERT               1
+#if !LWIP_POOL_TUNING
 #define LWIP_STATS                  0
 #endif
+#endif
+
+#if LWIP_POOL_TUNING
+// With pool tuning, statistics are on in every build, but only the cheap ones: pool usage, high-water
+// marks and allocation failures, link and TCP counters. They are read with LLOS_ethernet_get_pool_stats
+// and friends.
+#define LWIP_STATS                  1
+#define LWIP_STATS_DISPLAY          0
+#define LINK_STATS                  1
+#define TCP_STATS                   1
+#define MEM_STATS                   1
+#define MEMP_STATS                  1
+#define ETHARP_STATS                0
+#define IPFRAG_STATS                0
+#define IP_STATS                    0
+#define ICMP_STATS                  0
+#define IGMP_STATS                  0
+#define UDP_STATS                   0
+#define SYS_STATS                   0
+#endif
 
 #define LWIP_PLATFORM_BYTESWAP      1
 
@@ -109,8 +163,8 @@
 
 /* MSS should match the hardware packet size */
 #define TCP_MSS                     1460
-#define TCP_SND_BUF                 (2 * TCP_MSS)
-#define TCP_WND                     (2 * TCP_MSS)
+#define TCP_SND_BUF                 (LWIP_POOL_TCP_WINDOW_MSS * TCP_MSS)
+#define TCP_WND                     (LWIP_POOL_TCP_WINDOW_MSS * TCP_MSS)
 #define TCP_SND_QUEUELEN            (2 * TCP_SND_BUF/TCP_MSS)
 
 // Broadcast
@@ -29,6 +29,15 @@ HRESULT LLOS_ADC_Read(LLOS_Context channel, float* value);
 HRESULT LLOS_ADC_Write(LLOS_Context channel, float value);
 HRESULT LLOS_ADC_GetPrecisionBits(LLOS_Context channel, uint32_t* precisionInBits);
 
+//
+// Continuous sampling: samples are taken at sampleRateHz into pBuffer, which is used as two halves. The callback
+// runs in interrupt context each time a half fills, while sampling continues into the other half.
+//
+typedef VOID (*LLOS_ADC_SamplesCallback)(LLOS_Context channel, LLOS_Context callbackCtx, uint16_t* pSamples, int32_t sampleCount);
+
+HRESULT LLOS_ADC_StartSampling(LLOS_Context channel, uint32_t sampleRateHz, uint16_t* pBuffer, int32_t bufferLength, LLOS_ADC_SamplesCallback callback, LLOS_Context callbackCtx);
+HRESULT LLOS_ADC_StopSampling(LLOS_Context channel);
+
 #ifdef __cplusplus
 }
 #endif
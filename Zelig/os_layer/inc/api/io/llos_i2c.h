@@ -15,6 +15,21 @@ extern "C" {
 // I2C
 //
 
+typedef enum LLOS_I2C_SegmentFlags
+{
+    LLOS_I2C_SegmentWrite = 0x0,
+    LLOS_I2C_SegmentRead  = 0x1,
+    LLOS_I2C_SegmentStop  = 0x2,   // send a stop after this segment, otherwise the next segment starts with a repeated start
+} LLOS_I2C_SegmentFlags;
+
+typedef struct LLOS_I2C_Segment
+{
+    uint8_t* Buffer;
+    int32_t  Offset;
+    int32_t  Length;               // in: bytes to transfer, out: bytes transferred (negative if the address was not acknowledged)
+    uint32_t Flags;
+} LLOS_I2C_Segment;
+
 HRESULT LLOS_I2C_Initialize  (int32_t sdaPin, int32_t sclPin, LLOS_Context* pChannel);
 VOID    LLOS_I2C_Uninitialize(LLOS_Context channel);
 HRESULT LLOS_I2C_SetFrequency(LLOS_Context channel, uint32_t frequencyHz);
@@ -24,6 +39,13 @@ HRESULT LLOS_I2C_Write       (LLOS_Context channel, uint32_t address, uint8_t* p
 HRESULT LLOS_I2C_Read        (LLOS_Context channel, uint32_t address, uint8_t* pBuffer, int32_t offset, int32_t* pLength, BOOL stop);
 HRESULT LLOS_I2C_Reset       (LLOS_Context channel);
 
+//
+// Runs all segments against one slave address in a single call. Execution stops at the first segment that
+// transfers less than requested, in which case the bus is released with a stop.
+// pTransferred receives the total number of bytes transferred.
+//
+HRESULT LLOS_I2C_Transaction (LLOS_Context channel, uint32_t address, LLOS_I2C_Segment* pSegments, int32_t segmentCount, int32_t* pTransferred);
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,6 +30,11 @@ typedef enum LLOS_SERIAL_StopBits
     LLOS_SERIAL_StopBitsOnePointFive,
 } LLOS_SERIAL_StopBits;
 
+// Size of the interrupt driven RX/TX rings used when a port is configured with a buffer size of 0.
+#ifndef LLOS_SERIAL_DEFAULT_BUFFER_SIZE
+#define LLOS_SERIAL_DEFAULT_BUFFER_SIZE 64
+#endif // LLOS_SERIAL_DEFAULT_BUFFER_SIZE
+
 typedef struct LLOS_SERIAL_Config
 {
     uint32_t BaudRate;
@@ -37,6 +42,8 @@ typedef struct LLOS_SERIAL_Config
     uint32_t DataBits;
     uint32_t StopBits;
     uint32_t SoftwareFlowControlValue;
+    uint32_t RxBufferSize;
+    uint32_t TxBufferSize;
 } LLOS_SERIAL_Config;
 
 typedef enum LLOS_SERIAL_Event
@@ -62,7 +69,7 @@ HRESULT LLOS_SERIAL_Disable       (LLOS_Context channel, LLOS_SERIAL_Irq irq);
 HRESULT LLOS_SERIAL_SetFlowControl(LLOS_Context channel, int32_t rtsPin, int32_t ctsPin);
 HRESULT LLOS_SERIAL_Configure     (LLOS_Context channel, LLOS_SERIAL_Config* pConfig);
 HRESULT LLOS_SERIAL_Read          (LLOS_Context channel, uint8_t* pBuffer, int32_t offset, int32_t* pLength);
-HRESULT LLOS_SERIAL_Write         (LLOS_Context channel, uint8_t* pBuffer, int32_t offset, int32_t length);
+HRESULT LLOS_SERIAL_Write         (LLOS_Context channel, uint8_t* pBuffer, int32_t offset, int32_t* pLength);
 HRESULT LLOS_SERIAL_Flush         (LLOS_Context channel);
 HRESULT LLOS_SERIAL_Clear         (LLOS_Context channel);
 HRESULT LLOS_SERIAL_SetCallback   (LLOS_Context channel, LLOS_SERIAL_InterruptCallback callback, LLOS_Context callbackContext);
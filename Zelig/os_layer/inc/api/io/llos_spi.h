@@ -52,6 +52,15 @@ HRESULT LLOS_SPI_Transfer    ( LLOS_Context channel, uint8_t* txBuffer, int32_t
 HRESULT LLOS_SPI_Write       ( LLOS_Context channel, uint8_t* txBuffer, int32_t txOffset, int32_t txCount ); 
 HRESULT LLOS_SPI_Read        ( LLOS_Context channel, uint8_t* rxBuffer, int32_t rxOffset, int32_t rxCount, int32_t rxStartOffset ); 
 HRESULT LLOS_SPI_IsBusy      ( LLOS_Context channel, BOOL* isBusy );
+
+//
+// Asynchronous (master only) transfers. The buffers must stay valid until the callback set through
+// LLOS_SPI_SetCallback is invoked with the completion action (LLOS_SPI_ActionWrite/Read/Transfer) or
+// LLOS_SPI_ActionError. The callback may run in interrupt context. Either buffer may be NULL.
+//
+HRESULT LLOS_SPI_TransferAsync( LLOS_Context channel, uint8_t* txBuffer, int32_t txOffset, int32_t txCount, uint8_t* rxBuffer, int32_t rxOffset, int32_t rxCount );
+HRESULT LLOS_SPI_AbortAsync   ( LLOS_Context channel );
+
 HRESULT LLOS_SPI_Suspend     ( LLOS_Context channel );
 HRESULT LLOS_SPI_Resume      ( LLOS_Context channel );
 
@@ -23,6 +23,14 @@ uint64_t LLOS_CLOCK_GetPerformanceCounterFrequency();
 uint32_t LLOS_CLOCK_DelayCycles(uint32_t cycles);
 uint32_t LLOS_CLOCK_Delay(uint32_t microSeconds);
 
+//
+// Idle support: sleeps the core until the next interrupt, with the quantum timer suspended, and accounts the time
+// spent asleep. The statistics cover the last complete one second window, plus the idle time since boot.
+// The host ports only yield the processor in LLOS_CLOCK_Idle and return LLOS_E_NOT_SUPPORTED for the statistics.
+//
+VOID     LLOS_CLOCK_Idle();
+HRESULT  LLOS_CLOCK_GetIdleStatistics(uint32_t* pIdleMicroseconds, uint32_t* pActiveMicroseconds, uint64_t* pTotalIdleMicroseconds);
+
 #ifdef __cplusplus
 }
 #endif
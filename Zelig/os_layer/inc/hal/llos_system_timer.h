@@ -17,6 +17,12 @@ extern "C" {
 
 typedef VOID(*LLOS_SYSTEM_TIMER_Callback)(LLOS_Context callbackCtx, uint64_t ticks);
 
+//
+// Ticks are microseconds on the device ports and are 64 bits wide, so they never wrap. Scheduling a timer for
+// LLOS_SYSTEM_TIMER_NEVER microseconds from now disarms it; rescheduling an armed timer replaces its deadline.
+//
+#define LLOS_SYSTEM_TIMER_NEVER 0xFFFFFFFFFFFFFFFFull
+
 HRESULT  LLOS_SYSTEM_TIMER_AllocateTimer    (LLOS_SYSTEM_TIMER_Callback callback, LLOS_Context callbackContext, uint64_t microsecondsFromNow, LLOS_Context *pTimer);
 VOID     LLOS_SYSTEM_TIMER_FreeTimer        (LLOS_Context pTimer                                                                                                   );
 HRESULT  LLOS_SYSTEM_TIMER_ScheduleTimer    (LLOS_Context pTimer, uint64_t microsecondsFromNow                                                                     );
@@ -0,0 +1,87 @@
+//
+//    LLILUM OS Abstraction Layer - Idle time accounting
+//
+
+#ifndef __LLOS_IDLE_WINDOW_H__
+#define __LLOS_IDLE_WINDOW_H__
+
+#include "llos_types.h"
+
+//
+// Splits time into fixed windows and reports how much of the last complete window was spent idle.
+// The idle loop charges each sleep as a [start, end) interval; an interval may cross any number of
+// window boundaries, and a busy system closes the windows it went through by charging an empty interval.
+//
+// No HAL dependency and no locking; the owner serializes access (on the mbed port by masking interrupts).
+//
+
+#ifndef LLOS_IDLE_WINDOW_US
+#define LLOS_IDLE_WINDOW_US  1000000
+#endif
+
+typedef struct LLOS_IdleWindow
+{
+    uint64_t WindowStart;
+    uint32_t WindowIdle;
+    uint32_t LastIdle;
+    uint32_t LastActive;
+} LLOS_IdleWindow;
+
+//--//
+
+static inline void LLOS_IdleWindow_Initialize(LLOS_IdleWindow* window, uint64_t now)
+{
+    window->WindowStart = now;
+    window->WindowIdle  = 0;
+    window->LastIdle    = 0;
+    window->LastActive  = 0;
+}
+
+// Charges [start, end) as idle time, closing the windows it crosses.
+static inline void LLOS_IdleWindow_Account(LLOS_IdleWindow* window, uint64_t start, uint64_t end)
+{
+    if (end - window->WindowStart >= LLOS_IDLE_WINDOW_US)
+    {
+        uint64_t windowEnd = window->WindowStart + LLOS_IDLE_WINDOW_US;
+
+        if (start < windowEnd)
+        {
+            window->WindowIdle += (uint32_t)(windowEnd - start);
+            start               = windowEnd;
+        }
+
+        window->LastIdle    = window->WindowIdle;
+        window->WindowIdle  = 0;
+        window->WindowStart = windowEnd + ((end - windowEnd) / LLOS_IDLE_WINDOW_US) * LLOS_IDLE_WINDOW_US;
+
+        //
+        // Whole windows went by since: the last of them is the one to report, and it was idle from
+        // wherever the interval entered it.
+        //
+        if (window->WindowStart != windowEnd)
+        {
+            uint64_t lastStart = window->WindowStart - LLOS_IDLE_WINDOW_US;
+
+            if (start < lastStart)
+            {
+                start = lastStart;
+            }
+
+            window->LastIdle = (start < window->WindowStart) ? (uint32_t)(window->WindowStart - start) : 0;
+        }
+
+        window->LastActive = LLOS_IDLE_WINDOW_US - window->LastIdle;
+
+        if (start < window->WindowStart)
+        {
+            start = window->WindowStart;
+        }
+    }
+
+    if (start < end)
+    {
+        window->WindowIdle += (uint32_t)(end - start);
+    }
+}
+
+#endif // __LLOS_IDLE_WINDOW_H__
@@ -0,0 +1,152 @@
+//
+//    LLILUM OS Abstraction Layer - Ring buffer
+// 
+
+#ifndef __LLOS_RING_BUFFER_H__
+#define __LLOS_RING_BUFFER_H__
+
+#include "llos_types.h"
+
+//
+// Single producer / single consumer byte ring used to decouple drivers from their
+// interrupt handlers (e.g. the UART IRQ fills the RX ring, managed reads drain it).
+// It has no dependency on any HAL, so it can be exercised on the host.
+//
+// Head and Tail are free running counters; the capacity must be a power of two so
+// that the unsigned wrap-around of the counters keeps Head - Tail equal to the count.
+// The producer only ever writes Head and the consumer only ever writes Tail, so on a
+// single core no lock is needed as long as each side stays on its own context.
+//
+
+typedef struct LLOS_RingBuffer
+{
+    volatile uint8_t*  Buffer;
+    uint32_t           Capacity;
+    volatile uint32_t  Head;
+    volatile uint32_t  Tail;
+} LLOS_RingBuffer;
+
+static inline uint32_t LLOS_RingBuffer_RoundCapacity(uint32_t size)
+{
+    uint32_t capacity = 1;
+
+    while (capacity < size && capacity < 0x80000000u)
+    {
+        capacity <<= 1;
+    }
+
+    return capacity;
+}
+
+// Capacity must be a power of two, see LLOS_RingBuffer_RoundCapacity.
+static inline void LLOS_RingBuffer_Initialize(LLOS_RingBuffer* ring, uint8_t* buffer, uint32_t capacity)
+{
+    ring->Buffer   = buffer;
+    ring->Capacity = buffer != NULL ? capacity : 0;
+    ring->Head     = 0;
+    ring->Tail     = 0;
+}
+
+static inline uint32_t LLOS_RingBuffer_Count(const LLOS_RingBuffer* ring)
+{
+    return ring->Head - ring->Tail;
+}
+
+static inline uint32_t LLOS_RingBuffer_Free(const LLOS_RingBuffer* ring)
+{
+    return ring->Capacity - LLOS_RingBuffer_Count(ring);
+}
+
+static inline BOOL LLOS_RingBuffer_IsEmpty(const LLOS_RingBuffer* ring)
+{
+    return ring->Head == ring->Tail;
+}
+
+static inline BOOL LLOS_RingBuffer_IsFull(const LLOS_RingBuffer* ring)
+{
+    return LLOS_RingBuffer_Count(ring) >= ring->Capacity;
+}
+
+// Producer side
+static inline BOOL LLOS_RingBuffer_Push(LLOS_RingBuffer* ring, uint8_t value)
+{
+    uint32_t head = ring->Head;
+
+    if (head - ring->Tail >= ring->Capacity)
+    {
+        return 0;
+    }
+
+    ring->Buffer[head & (ring->Capacity - 1)] = value;
+    ring->Head = head + 1;
+
+    return 1;
+}
+
+// Producer side, returns the number of bytes actually queued.
+static inline uint32_t LLOS_RingBuffer_Write(LLOS_RingBuffer* ring, const uint8_t* data, uint32_t length)
+{
+    uint32_t head  = ring->Head;
+    uint32_t avail = ring->Capacity - (head - ring->Tail);
+    uint32_t i;
+
+    if (length > avail)
+    {
+        length = avail;
+    }
+
+    for (i = 0; i < length; i++)
+    {
+        ring->Buffer[(head + i) & (ring->Capacity - 1)] = data[i];
+    }
+
+    ring->Head = head + length;
+
+    return length;
+}
+
+// Consumer side
+static inline BOOL LLOS_RingBuffer_Pop(LLOS_RingBuffer* ring, uint8_t* pValue)
+{
+    uint32_t tail = ring->Tail;
+
+    if (ring->Head == tail)
+    {
+        return 0;
+    }
+
+    *pValue = ring->Buffer[tail & (ring->Capacity - 1)];
+    ring->Tail = tail + 1;
+
+    return 1;
+}
+
+// Consumer side, returns the number of bytes actually dequeued.
+static inline uint32_t LLOS_RingBuffer_Read(LLOS_RingBuffer* ring, uint8_t* data, uint32_t length)
+{
+    uint32_t tail  = ring->Tail;
+    uint32_t count = ring->Head - tail;
+    uint32_t i;
+
+    if (length > count)
+    {
+        length = count;
+    }
+
+    for (i = 0; i < length; i++)
+    {
+        data[i] = ring->Buffer[(tail + i) & (ring->Capacity - 1)];
+    }
+
+    ring->Tail = tail + length;
+
+    return length;
+}
+
+// Consumer side, drops everything currently queued.
+static inline void LLOS_RingBuffer_Clear(LLOS_RingBuffer* ring)
+{
+    ring->Tail = ring->Head;
+}
+
+#endif // __LLOS_RING_BUFFER_H__
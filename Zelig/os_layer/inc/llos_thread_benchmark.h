@@ -0,0 +1,236 @@
+//
+//    LLILUM OS Abstraction Layer - Thread scheduler benchmarks
+//
+
+#ifndef __LLOS_THREAD_BENCHMARK_H__
+#define __LLOS_THREAD_BENCHMARK_H__
+
+#include "llos_types.h"
+#include "llos_thread.h"
+#include "llos_system_timer.h"
+
+//
+// Written only against llos_thread.h, so that every port runs the very same code: the mbed port exposes it
+// through LLOS_THREAD_RunBenchmark (Test/mbed/simple, THREAD_PERF), the POSIX port runs it from
+// HostTests/ThreadBenchmark.
+//
+// Events are thread handles that are never started, waiting on a handle consumes its signal. Each benchmark
+// checks its own bookkeeping, and gives up with LLOS_E_TIMEOUT rather than hanging if a wake up gets lost.
+//
+
+#define LLOS_THREAD_BENCHMARK_SIGNAL_WAIT  0
+#define LLOS_THREAD_BENCHMARK_YIELD        1
+
+#define LLOS_THREAD_BENCHMARK_MAX_THREADS  8
+#define LLOS_THREAD_BENCHMARK_TIMEOUT_MS   10000
+
+typedef struct LLOS_ThreadBenchmark
+{
+    LLOS_Handle       Thread;
+    LLOS_Handle       Wake;       // Signaled to wake up the thread
+    LLOS_Handle       Done;       // Signaled by the thread, once per round trip or once at the end
+    uint32_t          Iterations;
+    volatile uint32_t Completed;
+    volatile HRESULT  Result;
+} LLOS_ThreadBenchmark;
+
+static void LLOS_THREAD_Benchmark_Nothing(LLOS_Context param)
+{
+    (void)param;
+}
+
+static inline HRESULT LLOS_THREAD_Benchmark_CreateEvent(LLOS_Handle* pEvent)
+{
+    return LLOS_THREAD_CreateThread(LLOS_THREAD_Benchmark_Nothing, NULL, NULL, 0, pEvent);
+}
+
+static inline void LLOS_THREAD_Benchmark_Delete(LLOS_Handle* pHandle)
+{
+    if (*pHandle != NULL)
+    {
+        LLOS_THREAD_DeleteThread(*pHandle);
+
+        *pHandle = NULL;
+    }
+}
+
+static void LLOS_THREAD_Benchmark_Pong(LLOS_Context param)
+{
+    LLOS_ThreadBenchmark* pBench = (LLOS_ThreadBenchmark*)param;
+    uint32_t              i;
+
+    for (i = 0; i < pBench->Iterations; i++)
+    {
+        HRESULT hr = LLOS_THREAD_Wait(pBench->Wake, LLOS_THREAD_BENCHMARK_TIMEOUT_MS);
+
+        if (FAILED(hr))
+        {
+            pBench->Result = hr;
+            break;
+        }
+
+        pBench->Completed = pBench->Completed + 1;
+
+        LLOS_THREAD_Signal(pBench->Done);
+    }
+}
+
+static void LLOS_THREAD_Benchmark_Yielder(LLOS_Context param)
+{
+    LLOS_ThreadBenchmark* pBench = (LLOS_ThreadBenchmark*)param;
+    uint32_t              i;
+
+    for (i = 0; i < pBench->Iterations; i++)
+    {
+        LLOS_THREAD_Yield();
+
+        pBench->Completed = pBench->Completed + 1;
+    }
+
+    LLOS_THREAD_Signal(pBench->Done);
+}
+
+//
+// Signal/Wait round trips between the calling thread and a worker: two wake ups, and on a uniprocessor two
+// context switches, per round trip.
+//
+static inline HRESULT LLOS_THREAD_BenchmarkSignalWait(uint32_t roundTrips, uint64_t* pElapsedUs)
+{
+    LLOS_ThreadBenchmark bench;
+    uint64_t             start;
+    uint32_t             i;
+    HRESULT              hr;
+
+    if (pElapsedUs == NULL)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    bench.Thread     = NULL;
+    bench.Wake       = NULL;
+    bench.Done       = NULL;
+    bench.Iterations = roundTrips;
+    bench.Completed  = 0;
+    bench.Result     = S_OK;
+
+    hr = LLOS_THREAD_Benchmark_CreateEvent(&bench.Wake);
+
+    if (SUCCEEDED(hr))
+    {
+        hr = LLOS_THREAD_Benchmark_CreateEvent(&bench.Done);
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        hr = LLOS_THREAD_CreateThread(LLOS_THREAD_Benchmark_Pong, &bench, NULL, 0, &bench.Thread);
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        hr = LLOS_THREAD_Start(bench.Thread);
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        start = LLOS_SYSTEM_TIMER_GetTicks(NULL);
+
+        for (i = 0; i < roundTrips && SUCCEEDED(hr); i++)
+        {
+            LLOS_THREAD_Signal(bench.Wake);
+
+            hr = LLOS_THREAD_Wait(bench.Done, LLOS_THREAD_BENCHMARK_TIMEOUT_MS);
+        }
+
+        *pElapsedUs = (LLOS_SYSTEM_TIMER_GetTicks(NULL) - start) * 1000000 / LLOS_SYSTEM_TIMER_GetTimerFrequency(NULL);
+
+        if (FAILED(hr))
+        {
+            //
+            // Let the worker run out of round trips, rather than deleting it in the middle of a wait.
+            //
+            bench.Iterations = 0;
+
+            LLOS_THREAD_Signal(bench.Wake);
+        }
+    }
+
+    LLOS_THREAD_Benchmark_Delete(&bench.Thread);
+    LLOS_THREAD_Benchmark_Delete(&bench.Done);
+    LLOS_THREAD_Benchmark_Delete(&bench.Wake);
+
+    if (SUCCEEDED(hr) && (FAILED(bench.Result) || bench.Completed != roundTrips))
+    {
+        hr = FAILED(bench.Result) ? bench.Result : LLOS_E_FAIL;
+    }
+
+    return hr;
+}
+
+//
+// 'threads' workers of the same priority each yield 'yields' times while the calling thread waits for them
+// to finish: every yield hands the processor to the next worker in line.
+//
+static inline HRESULT LLOS_THREAD_BenchmarkYield(uint32_t threads, uint32_t yields, uint64_t* pElapsedUs)
+{
+    LLOS_ThreadBenchmark bench[LLOS_THREAD_BENCHMARK_MAX_THREADS];
+    uint64_t             start = 0;
+    uint32_t             i;
+    HRESULT              hr    = S_OK;
+
+    if (pElapsedUs == NULL || threads == 0 || threads > LLOS_THREAD_BENCHMARK_MAX_THREADS)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    for (i = 0; i < threads; i++)
+    {
+        bench[i].Thread     = NULL;
+        bench[i].Wake       = NULL;
+        bench[i].Done       = NULL;
+        bench[i].Iterations = yields;
+        bench[i].Completed  = 0;
+        bench[i].Result     = S_OK;
+    }
+
+    for (i = 0; i < threads && SUCCEEDED(hr); i++)
+    {
+        hr = LLOS_THREAD_Benchmark_CreateEvent(&bench[i].Done);
+
+        if (SUCCEEDED(hr))
+        {
+            hr = LLOS_THREAD_CreateThread(LLOS_THREAD_Benchmark_Yielder, &bench[i], NULL, 0, &bench[i].Thread);
+        }
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        start = LLOS_SYSTEM_TIMER_GetTicks(NULL);
+
+        for (i = 0; i < threads && SUCCEEDED(hr); i++)
+        {
+            hr = LLOS_THREAD_Start(bench[i].Thread);
+        }
+
+        for (i = 0; i < threads && SUCCEEDED(hr); i++)
+        {
+            hr = LLOS_THREAD_Wait(bench[i].Done, LLOS_THREAD_BENCHMARK_TIMEOUT_MS);
+        }
+
+        *pElapsedUs = (LLOS_SYSTEM_TIMER_GetTicks(NULL) - start) * 1000000 / LLOS_SYSTEM_TIMER_GetTimerFrequency(NULL);
+    }
+
+    for (i = 0; i < threads; i++)
+    {
+        LLOS_THREAD_Benchmark_Delete(&bench[i].Thread);
+        LLOS_THREAD_Benchmark_Delete(&bench[i].Done);
+
+        if (SUCCEEDED(hr) && bench[i].Completed != yields)
+        {
+            hr = LLOS_E_FAIL;
+        }
+    }
+
+    return hr;
+}
+
+#endif // __LLOS_THREAD_BENCHMARK_H__
@@ -0,0 +1,350 @@
+//
+//    LLILUM OS Abstraction Layer - Timer wheel
+//
+
+#ifndef __LLOS_TIMER_WHEEL_H__
+#define __LLOS_TIMER_WHEEL_H__
+
+#include <stddef.h>
+#include "llos_types.h"
+
+//
+// Hierarchical timer wheel used to multiplex any number of logical timers onto a single hardware
+// compare channel. Insert and cancel are O(1); advancing the wheel costs O(expired + cascaded) timers,
+// independent of how much time went by. Expirations are exact: an entry placed on an upper level is
+// cascaded down when the wheel reaches the start of its slot, and only fires from level 0.
+//
+// An entry is placed on the level of the most significant digit in which its expiry differs from the
+// current time, so every entry on level L > 0 sits in a slot ahead of the current level L digit and
+// every level 0 entry expires within the current level 0 rotation. Expiries beyond the top level go
+// to an overflow list that is re-examined each time the top level wraps around.
+//
+// The wheel has no HAL dependency and no locking; the owner serializes access (on the mbed port by
+// masking interrupts, since the ticker interrupt advances the wheel).
+//
+
+#define LLOS_TIMER_WHEEL_LEVEL_BITS  6
+#define LLOS_TIMER_WHEEL_SLOTS       (1 << LLOS_TIMER_WHEEL_LEVEL_BITS)
+#define LLOS_TIMER_WHEEL_LEVELS      5
+#define LLOS_TIMER_WHEEL_SPAN_BITS   (LLOS_TIMER_WHEEL_LEVEL_BITS * LLOS_TIMER_WHEEL_LEVELS)
+#define LLOS_TIMER_WHEEL_OVERFLOW    0xFF
+#define LLOS_TIMER_WHEEL_NEVER       0xFFFFFFFFFFFFFFFFull
+
+typedef struct LLOS_TimerWheelEntry
+{
+    struct LLOS_TimerWheelEntry*  Next;
+    struct LLOS_TimerWheelEntry** PPrev;     // NULL when the entry is not scheduled
+    uint64_t                      Expiry;
+    uint8_t                       Level;
+    uint8_t                       Slot;
+} LLOS_TimerWheelEntry;
+
+typedef struct LLOS_TimerWheel
+{
+    uint64_t              Now;
+    uint64_t              Occupied[LLOS_TIMER_WHEEL_LEVELS];
+    LLOS_TimerWheelEntry* Slots   [LLOS_TIMER_WHEEL_LEVELS][LLOS_TIMER_WHEEL_SLOTS];
+    LLOS_TimerWheelEntry* Overflow;
+} LLOS_TimerWheel;
+
+typedef void (*LLOS_TimerWheel_Expired)(LLOS_TimerWheelEntry* entry, uint64_t now, void* context);
+
+//--//
+
+static inline uint32_t LLOS_TimerWheel_FirstSetBit(uint64_t mask)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctzll(mask);
+#else
+    uint32_t bit = 0;
+
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        bit++;
+    }
+
+    return bit;
+#endif
+}
+
+static inline void LLOS_TimerWheel_Initialize(LLOS_TimerWheel* wheel, uint64_t now)
+{
+    uint32_t level;
+    uint32_t slot;
+
+    wheel->Now      = now;
+    wheel->Overflow = NULL;
+
+    for (level = 0; level < LLOS_TIMER_WHEEL_LEVELS; level++)
+    {
+        wheel->Occupied[level] = 0;
+
+        for (slot = 0; slot < LLOS_TIMER_WHEEL_SLOTS; slot++)
+        {
+            wheel->Slots[level][slot] = NULL;
+        }
+    }
+}
+
+static inline void LLOS_TimerWheel_InitializeEntry(LLOS_TimerWheelEntry* entry)
+{
+    entry->Next   = NULL;
+    entry->PPrev  = NULL;
+    entry->Expiry = LLOS_TIMER_WHEEL_NEVER;
+    entry->Level  = 0;
+    entry->Slot   = 0;
+}
+
+static inline bool LLOS_TimerWheel_IsScheduled(const LLOS_TimerWheelEntry* entry)
+{
+    return entry->PPrev != NULL;
+}
+
+static inline void LLOS_TimerWheel_Link(LLOS_TimerWheelEntry** head, LLOS_TimerWheelEntry* entry)
+{
+    entry->Next = *head;
+
+    if (entry->Next != NULL)
+    {
+        entry->Next->PPrev = &entry->Next;
+    }
+
+    entry->PPrev = head;
+    *head        = entry;
+}
+
+// Places an entry whose Expiry is already set, relative to the current time of the wheel.
+static inline void LLOS_TimerWheel_Place(LLOS_TimerWheel* wheel, LLOS_TimerWheelEntry* entry)
+{
+    uint64_t expiry = entry->Expiry;
+    uint64_t diff;
+    uint32_t level;
+    uint32_t slot;
+
+    //
+    // Anything already due goes in the current level 0 slot and fires on the next advance.
+    //
+    if (expiry < wheel->Now)
+    {
+        expiry = wheel->Now;
+    }
+
+    diff = expiry ^ wheel->Now;
+
+    if ((diff >> LLOS_TIMER_WHEEL_SPAN_BITS) != 0)
+    {
+        entry->Level = LLOS_TIMER_WHEEL_OVERFLOW;
+        entry->Slot  = 0;
+
+        LLOS_TimerWheel_Link(&wheel->Overflow, entry);
+        return;
+    }
+
+    for (level = 0; (diff >> ((level + 1) * LLOS_TIMER_WHEEL_LEVEL_BITS)) != 0; level++)
+    {
+    }
+
+    slot = (uint32_t)(expiry >> (level * LLOS_TIMER_WHEEL_LEVEL_BITS)) & (LLOS_TIMER_WHEEL_SLOTS - 1);
+
+    entry->Level = (uint8_t)level;
+    entry->Slot  = (uint8_t)slot;
+
+    LLOS_TimerWheel_Link(&wheel->Slots[level][slot], entry);
+
+    wheel->Occupied[level] |= 1ull << slot;
+}
+
+static inline void LLOS_TimerWheel_Cancel(LLOS_TimerWheel* wheel, LLOS_TimerWheelEntry* entry)
+{
+    if (entry->PPrev == NULL)
+    {
+        return;
+    }
+
+    *entry->PPrev = entry->Next;
+
+    if (entry->Next != NULL)
+    {
+        entry->Next->PPrev = entry->PPrev;
+    }
+
+    if (entry->Level != LLOS_TIMER_WHEEL_OVERFLOW && wheel->Slots[entry->Level][entry->Slot] == NULL)
+    {
+        wheel->Occupied[entry->Level] &= ~(1ull << entry->Slot);
+    }
+
+    entry->Next  = NULL;
+    entry->PPrev = NULL;
+}
+
+// (Re)schedules an entry for an absolute expiry time.
+static inline void LLOS_TimerWheel_Schedule(LLOS_TimerWheel* wheel, LLOS_TimerWheelEntry* entry, uint64_t expiry)
+{
+    LLOS_TimerWheel_Cancel(wheel, entry);
+
+    entry->Expiry = expiry;
+
+    LLOS_TimerWheel_Place(wheel, entry);
+}
+
+//
+// Returns the time at which LLOS_TimerWheel_Advance must next be called: either the earliest expiry, or
+// an earlier point where an upper level slot (or the overflow list) has to be cascaded. Returns
+// LLOS_TIMER_WHEEL_NEVER if the wheel is empty.
+//
+static inline uint64_t LLOS_TimerWheel_NextEvent(const LLOS_TimerWheel* wheel)
+{
+    uint64_t next = LLOS_TIMER_WHEEL_NEVER;
+    uint32_t level;
+
+    for (level = 0; level < LLOS_TIMER_WHEEL_LEVELS; level++)
+    {
+        uint32_t shift   = level * LLOS_TIMER_WHEEL_LEVEL_BITS;
+        uint32_t current = (uint32_t)(wheel->Now >> shift) & (LLOS_TIMER_WHEEL_SLOTS - 1);
+        uint64_t pending = wheel->Occupied[level] & (~0ull << current);
+
+        if (pending != 0)
+        {
+            uint64_t base = wheel->Now & ~((1ull << (shift + LLOS_TIMER_WHEEL_LEVEL_BITS)) - 1);
+            uint64_t when = base + ((uint64_t)LLOS_TimerWheel_FirstSetBit(pending) << shift);
+
+            if (when < wheel->Now)
+            {
+                when = wheel->Now;
+            }
+
+            if (when < next)
+            {
+                next = when;
+            }
+        }
+    }
+
+    if (wheel->Overflow != NULL)
+    {
+        uint64_t wrap = (wheel->Now | ((1ull << LLOS_TIMER_WHEEL_SPAN_BITS) - 1)) + 1;
+
+        if (wrap < next)
+        {
+            next = wrap;
+        }
+    }
+
+    return next;
+}
+
+static inline void LLOS_TimerWheel_Cascade(LLOS_TimerWheel* wheel, LLOS_TimerWheelEntry** head)
+{
+    LLOS_TimerWheelEntry* entry = *head;
+
+    *head = NULL;
+
+    while (entry != NULL)
+    {
+        LLOS_TimerWheelEntry* next = entry->Next;
+
+        entry->Next  = NULL;
+        entry->PPrev = NULL;
+
+        LLOS_TimerWheel_Place(wheel, entry);
+
+        entry = next;
+    }
+}
+
+//
+// Moves the wheel forward to 'now' and invokes 'expired' for every entry that became due, in expiry
+// order. Entries are unscheduled before their callback runs, so callbacks may reschedule them; an entry
+// rescheduled for a time that is already due fires on the next advance rather than recursively.
+//
+static inline void LLOS_TimerWheel_Advance(LLOS_TimerWheel* wheel, uint64_t now, LLOS_TimerWheel_Expired expired, void* context)
+{
+    while (true)
+    {
+        uint64_t              next = LLOS_TimerWheel_NextEvent(wheel);
+        uint32_t              level;
+        uint32_t              slot;
+        LLOS_TimerWheelEntry* entry;
+
+        if (next > now)
+        {
+            break;
+        }
+
+        wheel->Now = next;
+
+        //
+        // Cascade from the top down, so that entries land on the lowest level that can hold them.
+        //
+        if (wheel->Overflow != NULL && (next & ((1ull << LLOS_TIMER_WHEEL_SPAN_BITS) - 1)) == 0)
+        {
+            LLOS_TimerWheel_Cascade(wheel, &wheel->Overflow);
+        }
+
+        for (level = LLOS_TIMER_WHEEL_LEVELS - 1; level > 0; level--)
+        {
+            uint32_t shift = level * LLOS_TIMER_WHEEL_LEVEL_BITS;
+
+            if ((next & ((1ull << shift) - 1)) != 0)
+            {
+                continue;
+            }
+
+            slot = (uint32_t)(next >> shift) & (LLOS_TIMER_WHEEL_SLOTS - 1);
+
+            if ((wheel->Occupied[level] & (1ull << slot)) != 0)
+            {
+                wheel->Occupied[level] &= ~(1ull << slot);
+
+                LLOS_TimerWheel_Cascade(wheel, &wheel->Slots[level][slot]);
+            }
+        }
+
+        //
+        // Detach the due slot before calling out, so that callbacks rescheduling into it are left for the next pass.
+        //
+        slot  = (uint32_t)next & (LLOS_TIMER_WHEEL_SLOTS - 1);
+        entry = wheel->Slots[0][slot];
+
+        wheel->Slots[0][slot] = NULL;
+        wheel->Occupied[0]   &= ~(1ull << slot);
+
+        if (entry != NULL)
+        {
+            entry->PPrev = &entry;
+        }
+
+        while (entry != NULL)
+        {
+            LLOS_TimerWheelEntry* current = entry;
+
+            entry = current->Next;
+
+            if (entry != NULL)
+            {
+                entry->PPrev = &entry;
+            }
+
+            current->Next  = NULL;
+            current->PPrev = NULL;
+
+            expired(current, next, context);
+        }
+
+        //
+        // Stop here if a callback rescheduled something for the current tick, otherwise we would spin.
+        //
+        if (wheel->Occupied[0] & (1ull << slot))
+        {
+            break;
+        }
+    }
+
+    if (wheel->Now < now && (wheel->Occupied[0] & (1ull << ((uint32_t)wheel->Now & (LLOS_TIMER_WHEEL_SLOTS - 1)))) == 0)
+    {
+        wheel->Now = now;
+    }
+}
+
+#endif // __LLOS_TIMER_WHEEL_H__
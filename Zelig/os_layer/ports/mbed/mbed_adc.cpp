@@ -1,6 +1,7 @@
 #include "mbed_helpers.h"
 #include "llos_analog.h"
 #include "llos_memory.h"
+#include "llos_system_timer.h"
 
 //--//
 
@@ -16,8 +17,75 @@ extern "C"
         };
 
         LLOS_ADC_Direction Direction;
+
+        // Continuous sampling state
+        LLOS_Context             SampleTimer;
+        uint16_t* volatile       SampleBuffer;
+        int32_t                  SampleBufferLength;
+        int32_t                  SampleIndex;
+        uint32_t                 SamplePeriod;
+        uint32_t                 NextSampleTime;
+        LLOS_ADC_SamplesCallback SamplesCallback;
+        LLOS_Context             SamplesContext;
     } LLOS_MbedAdc;
 
+    //
+    // Anything shorter than this leaves no time for the rest of the system between ticker interrupts.
+    //
+#define LLOS_ADC_MIN_SAMPLE_PERIOD_US 20
+
+    static VOID SampleTimerCallback(LLOS_Context callbackCtx, uint64_t ticks)
+    {
+        LLOS_MbedAdc *pCtx      = (LLOS_MbedAdc*)callbackCtx;
+        uint16_t     *pBuffer   = pCtx->SampleBuffer;
+        int32_t       half      = pCtx->SampleBufferLength / 2;
+        int32_t       delay;
+
+        LLOS__UNREFERENCED_PARAMETER(ticks);
+
+        if (pBuffer == NULL)
+        {
+            return;
+        }
+
+        pBuffer[pCtx->SampleIndex++] = analogin_read_u16(&pCtx->InputChannel);
+
+        if (pCtx->SampleIndex == half)
+        {
+            pCtx->SamplesCallback(pCtx, pCtx->SamplesContext, &pBuffer[0], half);
+        }
+        else if (pCtx->SampleIndex == pCtx->SampleBufferLength)
+        {
+            pCtx->SampleIndex = 0;
+
+            pCtx->SamplesCallback(pCtx, pCtx->SamplesContext, &pBuffer[half], half);
+        }
+
+        //
+        // The callback may have stopped sampling.
+        //
+        if (pCtx->SampleBuffer == NULL)
+        {
+            return;
+        }
+
+        //
+        // Schedule against the ideal sample time so that interrupt latency does not accumulate as drift. If we fell
+        // more than a period behind, drop the missed samples and resynchronize.
+        //
+        pCtx->NextSampleTime += pCtx->SamplePeriod;
+
+        delay = (int32_t)(pCtx->NextSampleTime - us_ticker_read());
+
+        if (delay < -(int32_t)pCtx->SamplePeriod)
+        {
+            pCtx->NextSampleTime = us_ticker_read() + pCtx->SamplePeriod;
+            delay                = (int32_t)pCtx->SamplePeriod;
+        }
+
+        LLOS_SYSTEM_TIMER_ScheduleTimer(pCtx->SampleTimer, delay > 0 ? (uint64_t)delay : 0);
+    }
+
     HRESULT LLOS_ADC_Initialize(uint32_t pinName, LLOS_ADC_Direction direction, LLOS_Context* channel)
     {
         LLOS_MbedAdc *pCtx;
@@ -35,6 +103,8 @@ extern "C"
         }
 
         pCtx->Direction = direction;
+        pCtx->SampleTimer = NULL;
+        pCtx->SampleBuffer = NULL;
 
         if (direction == LLOS_ADC_Input)
         {
@@ -52,6 +122,11 @@ extern "C"
 
     VOID LLOS_ADC_Uninitialize(LLOS_Context channel)
     {
+        if (channel != NULL)
+        {
+            LLOS_ADC_StopSampling(channel);
+        }
+
         FreeFromManagedHeap(channel);
     }
 
@@ -131,5 +206,83 @@ extern "C"
 
         return LLOS_E_NOTIMPL;
     }
+
+    HRESULT LLOS_ADC_StartSampling(LLOS_Context channel, uint32_t sampleRateHz, uint16_t* pBuffer, int32_t bufferLength, LLOS_ADC_SamplesCallback callback, LLOS_Context callbackCtx)
+    {
+        LLOS_MbedAdc *pCtx = (LLOS_MbedAdc*)channel;
+        HRESULT       hr;
+
+        if (pCtx == NULL || pBuffer == NULL || callback == NULL || bufferLength < 2 || (bufferLength & 1) != 0 || sampleRateHz == 0)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        if (pCtx->Direction != LLOS_ADC_Input || 1000000 / sampleRateHz < LLOS_ADC_MIN_SAMPLE_PERIOD_US)
+        {
+            return LLOS_E_NOT_SUPPORTED;
+        }
+
+        if (pCtx->SampleBuffer != NULL)
+        {
+            return LLOS_E_BUSY;
+        }
+
+        if (pCtx->SampleTimer == NULL)
+        {
+            hr = LLOS_SYSTEM_TIMER_AllocateTimer(SampleTimerCallback, pCtx, 0xFFFFFFFFFFFFFFFFull, &pCtx->SampleTimer);
+
+            if (FAILED(hr))
+            {
+                return hr;
+            }
+        }
+
+        pCtx->SampleBufferLength = bufferLength;
+        pCtx->SampleIndex        = 0;
+        pCtx->SamplePeriod       = 1000000 / sampleRateHz;
+        pCtx->SamplesCallback    = callback;
+        pCtx->SamplesContext     = callbackCtx;
+        pCtx->NextSampleTime     = us_ticker_read() + pCtx->SamplePeriod;
+        pCtx->SampleBuffer       = pBuffer;
+
+        return LLOS_SYSTEM_TIMER_ScheduleTimer(pCtx->SampleTimer, pCtx->SamplePeriod);
+    }
+
+    HRESULT LLOS_ADC_StopSampling(LLOS_Context channel)
+    {
+        LLOS_MbedAdc *pCtx = (LLOS_MbedAdc*)channel;
+        LLOS_Context  sampleTimer;
+
+        if (pCtx == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        //
+        // Only disarm and detach the timer with interrupts off, freeing it goes back to the managed heap.
+        //
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        pCtx->SampleBuffer = NULL;
+
+        sampleTimer = pCtx->SampleTimer;
+
+        if (sampleTimer != NULL)
+        {
+            LLOS_SYSTEM_TIMER_ScheduleTimer(sampleTimer, LLOS_SYSTEM_TIMER_NEVER);
+
+            pCtx->SampleTimer = NULL;
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
+        if (sampleTimer != NULL)
+        {
+            LLOS_SYSTEM_TIMER_FreeTimer(sampleTimer);
+        }
+
+        return S_OK;
+    }
 #endif
 }
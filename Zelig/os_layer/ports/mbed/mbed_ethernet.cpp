@@ -11,6 +11,9 @@
 #include "netifapi.h"
 #include "Netdb.h"
 #include "tcp.h"
+#include "tcp_impl.h"
+#include "memp.h"
+#include "stats.h"
 #include "Sockets.h"
 #include "llos_error.h"
 
@@ -63,9 +66,292 @@ extern "C"
         return result;
     }
 
+    static HRESULT InstallLinkCounters(HRESULT result);
+
     HRESULT LLOS_ethernet_dhcp_init()
     {
-        return EthernetInterface::init();
+        return InstallLinkCounters(EthernetInterface::init());
+    }
+
+    //
+    // Mailbox throughput: posts 'messages' callbacks to the tcpip thread and measures how long it takes until the
+    // last one ran. Each message is a full tcpip_callback round (message allocation, post, fetch and dispatch), so
+    // this is what every socket call and received frame pays on top of the actual protocol work.
+    //
+    typedef struct MboxBenchmark
+    {
+        volatile uint32_t Remaining;
+        sys_sem_t         Done;
+    } MboxBenchmark;
+
+    static void MboxBenchmarkCallback(void* arg)
+    {
+        MboxBenchmark* pBenchmark = (MboxBenchmark*)arg;
+
+        if (--pBenchmark->Remaining == 0)
+        {
+            sys_sem_signal(&pBenchmark->Done);
+        }
+    }
+
+    HRESULT LLOS_ethernet_mbox_benchmark(uint32_t messages, uint32_t* pElapsedUs)
+    {
+        MboxBenchmark benchmark;
+        uint32_t      start;
+
+        if (messages == 0 || pElapsedUs == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        benchmark.Remaining = messages;
+
+        if (sys_sem_new(&benchmark.Done, 0) != ERR_OK)
+        {
+            return LLOS_E_OUT_OF_MEMORY;
+        }
+
+        start = us_ticker_read();
+
+        for (uint32_t i = 0; i < messages; i++)
+        {
+            // Blocks while the mailbox is full; only runs out of messages if the tcpip thread falls behind the pool.
+            while (tcpip_callback_with_block(MboxBenchmarkCallback, &benchmark, 1) != ERR_OK)
+            {
+            }
+        }
+
+        sys_arch_sem_wait(&benchmark.Done, 0);
+
+        *pElapsedUs = us_ticker_read() - start;
+
+        sys_sem_free(&benchmark.Done);
+
+        return S_OK;
+    }
+
+    //
+    // Link counters. The drivers only count frames into lwip_stats, which the prebuilt liblwIP.a does not have, so
+    // the port counts them itself at the driver boundary: the netif's linkoutput (every frame lwIP hands the driver)
+    // and input (every frame the driver hands lwIP) are wrapped once the interface is added. Frames a driver drops
+    // before passing them up, e.g. for lack of pbufs, are not seen here.
+    //
+    static volatile uint32_t   s_framesSent;
+    static volatile uint32_t   s_framesReceived;
+    static volatile uint32_t   s_framesDropped;
+    static netif_input_fn      s_driverInput;
+    static netif_linkoutput_fn s_driverLinkOutput;
+
+    static err_t CountingInput(struct pbuf* p, struct netif* inp)
+    {
+        err_t err = s_driverInput(p, inp);
+
+        if (err == ERR_OK)
+        {
+            s_framesReceived++;
+        }
+        else
+        {
+            s_framesDropped++;
+        }
+
+        return err;
+    }
+
+    static err_t CountingLinkOutput(struct netif* netif, struct pbuf* p)
+    {
+        err_t err = s_driverLinkOutput(netif, p);
+
+        if (err == ERR_OK)
+        {
+            s_framesSent++;
+        }
+        else
+        {
+            s_framesDropped++;
+        }
+
+        return err;
+    }
+
+    static HRESULT InstallLinkCounters(HRESULT result)
+    {
+        struct netif* pNetif = netif_default;
+
+        if (result == S_OK && pNetif != NULL && pNetif->input != CountingInput)
+        {
+            SYS_ARCH_DECL_PROTECT(lev);
+            SYS_ARCH_PROTECT(lev);
+
+            s_driverInput       = pNetif->input;
+            s_driverLinkOutput  = pNetif->linkoutput;
+            pNetif->input       = CountingInput;
+            pNetif->linkoutput  = CountingLinkOutput;
+
+            SYS_ARCH_UNPROTECT(lev);
+        }
+
+        return result;
+    }
+
+#if LWIP_POOL_TUNING
+    //
+    // Pool statistics. With LWIP_POOL_TUNING, lwipopts.h keeps the pool and TCP statistics on in every build, so
+    // that buffer pools can be sized against real traffic: for each pool, how many elements exist, how many are in
+    // use, the most ever in use at once, and how many allocations failed. Pools are numbered as
+    // Microsoft.Llilum.Lwip.NetworkPool.
+    //
+    static const int8_t s_networkPools[] =
+    {
+        -1,                     // Heap (mem_malloc), not a memp pool
+        MEMP_PBUF_POOL,
+        MEMP_PBUF,
+        MEMP_TCP_PCB,
+        MEMP_TCP_PCB_LISTEN,
+        MEMP_TCP_SEG,
+        MEMP_UDP_PCB,
+        MEMP_NETCONN,
+        MEMP_NETBUF,
+        MEMP_TCPIP_MSG_API,
+        MEMP_TCPIP_MSG_INPKT,
+        MEMP_SYS_TIMEOUT,
+    };
+
+    HRESULT LLOS_ethernet_get_pool_stats(uint32_t pool, uint32_t* pAvailable, uint32_t* pUsed, uint32_t* pMaxUsed, uint32_t* pFailures)
+    {
+        struct stats_mem* pStats;
+
+        if (pAvailable == NULL || pUsed == NULL || pMaxUsed == NULL || pFailures == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        if (pool >= sizeof(s_networkPools) / sizeof(s_networkPools[0]))
+        {
+            return LLOS_E_OUT_OF_RANGE;
+        }
+
+        pStats = (s_networkPools[pool] < 0) ? &lwip_stats.mem : &lwip_stats.memp[s_networkPools[pool]];
+
+        *pAvailable = pStats->avail;
+        *pUsed      = pStats->used;
+        *pMaxUsed   = pStats->max;
+        *pFailures  = pStats->err;
+
+        return S_OK;
+    }
+#else
+    //
+    // The prebuilt liblwIP.a has no lwip_stats, pool statistics need a library rebuilt with LWIP_POOL_TUNING.
+    //
+    HRESULT LLOS_ethernet_get_pool_stats(uint32_t pool, uint32_t* pAvailable, uint32_t* pUsed, uint32_t* pMaxUsed, uint32_t* pFailures)
+    {
+        LLOS__UNREFERENCED_PARAMETER(pool);
+        LLOS__UNREFERENCED_PARAMETER(pAvailable);
+        LLOS__UNREFERENCED_PARAMETER(pUsed);
+        LLOS__UNREFERENCED_PARAMETER(pMaxUsed);
+        LLOS__UNREFERENCED_PARAMETER(pFailures);
+
+        return LLOS_E_NOT_SUPPORTED;
+    }
+#endif // LWIP_POOL_TUNING
+
+    //
+    // lwIP 1.4 has no running count of TCP retransmissions, so pRetransmitting reports the retransmissions pending on
+    // open connections (the sum of their nrtx), walked on the tcpip thread. Anything above zero for long is trouble.
+    //
+    typedef struct TcpRetransmitQuery
+    {
+        uint32_t  Count;
+        sys_sem_t Done;
+    } TcpRetransmitQuery;
+
+    static void TcpRetransmitQueryCallback(void* arg)
+    {
+        TcpRetransmitQuery* pQuery = (TcpRetransmitQuery*)arg;
+
+        for (struct tcp_pcb* pcb = tcp_active_pcbs; pcb != NULL; pcb = pcb->next)
+        {
+            pQuery->Count += pcb->nrtx;
+        }
+
+        sys_sem_signal(&pQuery->Done);
+    }
+
+    HRESULT LLOS_ethernet_get_traffic_stats(uint32_t* pFramesSent, uint32_t* pFramesReceived, uint32_t* pFramesDropped, uint32_t* pSegmentsSent, uint32_t* pSegmentsReceived, uint32_t* pSegmentsDropped, uint32_t* pRetransmitting)
+    {
+        TcpRetransmitQuery query;
+
+        if (pFramesSent == NULL || pFramesReceived == NULL || pFramesDropped == NULL ||
+            pSegmentsSent == NULL || pSegmentsReceived == NULL || pSegmentsDropped == NULL || pRetransmitting == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        *pFramesSent       = s_framesSent;
+        *pFramesReceived   = s_framesReceived;
+        *pFramesDropped    = s_framesDropped;
+#if LWIP_POOL_TUNING
+        *pSegmentsSent     = lwip_stats.tcp.xmit;
+        *pSegmentsReceived = lwip_stats.tcp.recv;
+        *pSegmentsDropped  = lwip_stats.tcp.drop;
+#else
+        // TCP segments are only counted in lwip_stats
+        *pSegmentsSent     = 0;
+        *pSegmentsReceived = 0;
+        *pSegmentsDropped  = 0;
+#endif
+        *pRetransmitting   = 0;
+
+        query.Count = 0;
+
+        if (sys_sem_new(&query.Done, 0) != ERR_OK)
+        {
+            return LLOS_E_OUT_OF_MEMORY;
+        }
+
+        if (tcpip_callback_with_block(TcpRetransmitQueryCallback, &query, 1) == ERR_OK)
+        {
+            sys_arch_sem_wait(&query.Done, 0);
+
+            *pRetransmitting = query.Count;
+        }
+
+        sys_sem_free(&query.Done);
+
+        return S_OK;
+    }
+
+    //
+    // Starts a new measurement: counters go back to zero, high-water marks down to the current usage.
+    //
+    HRESULT LLOS_ethernet_reset_stats()
+    {
+        SYS_ARCH_DECL_PROTECT(lev);
+
+        SYS_ARCH_PROTECT(lev);
+
+        s_framesSent     = 0;
+        s_framesReceived = 0;
+        s_framesDropped  = 0;
+
+#if LWIP_POOL_TUNING
+        lwip_stats.mem.max = lwip_stats.mem.used;
+        lwip_stats.mem.err = 0;
+
+        for (int i = 0; i < MEMP_MAX; i++)
+        {
+            lwip_stats.memp[i].max = lwip_stats.memp[i].used;
+            lwip_stats.memp[i].err = 0;
+        }
+
+        memset(&lwip_stats.link, 0, sizeof(lwip_stats.link));
+        memset(&lwip_stats.tcp, 0, sizeof(lwip_stats.tcp));
+#endif
+
+        SYS_ARCH_UNPROTECT(lev);
+
+        return S_OK;
     }
 
     HRESULT LLOS_ethernet_staticIP_init(const uint16_t* ip, const uint32_t ipLen, const uint16_t* mask, const uint32_t maskLen, const uint16_t* gateway, const uint32_t gatewayLen)
@@ -89,7 +375,7 @@ extern "C"
             maskBuffer[maskLen] = '\0';
             gatewayBuffer[gatewayLen] = '\0';
 
-            return EthernetInterface::init(ipBuffer, maskBuffer, gatewayBuffer);
+            return InstallLinkCounters(EthernetInterface::init(ipBuffer, maskBuffer, gatewayBuffer));
         }
 
         return LLOS_E_INVALID_PARAMETER;
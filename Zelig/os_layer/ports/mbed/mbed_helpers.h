@@ -74,6 +74,8 @@
 
 int32_t WStringToCharBuffer(char* output, uint32_t outputBufferLength, const uint16_t* input, const uint32_t length);
 
+extern "C" uint64_t LLOS_MBED_TIMER_GetMicrosecondsToNextEvent();
+
 //--//
 
 extern uint32_t* __StackTop;
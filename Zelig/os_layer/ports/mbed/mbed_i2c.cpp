@@ -90,6 +90,74 @@ extern "C"
         return S_OK;
     }
 
+    HRESULT LLOS_I2C_Transaction(LLOS_Context channel, uint32_t address, LLOS_I2C_Segment* pSegments, int32_t segmentCount, int32_t* pTransferred)
+    {
+        i2c_t  *pI2C  = (i2c_t*)channel;
+        int32_t total = 0;
+
+        if (pI2C == NULL || pSegments == NULL || segmentCount <= 0 || pTransferred == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        //
+        // Reject bad segments before the START goes out, bailing out half way would leave the bus claimed.
+        //
+        for (int32_t i = 0; i < segmentCount; i++)
+        {
+            if (pSegments[i].Buffer == NULL || pSegments[i].Offset < 0 || pSegments[i].Length < 0)
+            {
+                return LLOS_E_INVALID_PARAMETER;
+            }
+        }
+
+        for (int32_t i = 0; i < segmentCount; i++)
+        {
+            LLOS_I2C_Segment* pSegment = &pSegments[i];
+            int32_t           requested = pSegment->Length;
+            int               stop;
+
+            //
+            // The last segment always ends the transaction.
+            //
+            stop = ((pSegment->Flags & LLOS_I2C_SegmentStop) != 0 || i == segmentCount - 1) ? 1 : 0;
+
+            if ((pSegment->Flags & LLOS_I2C_SegmentRead) != 0)
+            {
+                pSegment->Length = i2c_read(pI2C, address, (char *)&pSegment->Buffer[pSegment->Offset], requested, stop);
+            }
+            else
+            {
+                pSegment->Length = i2c_write(pI2C, address, (const char *)&pSegment->Buffer[pSegment->Offset], requested, stop);
+            }
+
+            if (pSegment->Length > 0)
+            {
+                total += pSegment->Length;
+            }
+
+            if (pSegment->Length < requested)
+            {
+                //
+                // Mark the segments we did not get to and make sure the bus is not left claimed. Not every
+                // HAL sends the STOP itself when a transfer fails, even if one was requested, so always send it.
+                //
+                for (int32_t j = i + 1; j < segmentCount; j++)
+                {
+                    pSegments[j].Length = 0;
+                }
+
+                i2c_stop(pI2C);
+
+                break;
+            }
+        }
+
+        *pTransferred = total;
+
+        return S_OK;
+    }
+
     HRESULT LLOS_I2C_Reset(LLOS_Context channel)
     {
         i2c_t  *pI2C = (i2c_t*)channel;
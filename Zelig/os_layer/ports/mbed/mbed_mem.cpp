@@ -43,6 +43,178 @@ extern "C"
     #define REFERENCE_COUNT_MASK  0xFF000000
     #define REFERENCE_COUNT_SHIFT 24
 
+#if (__CORTEX_M >= 0x03) || (__CORTEX_SC >= 300)
+
+    //
+    // ARMv7-M: reference counts are updated with LDREX/STREX and never mask interrupts.
+    //
+    // The architecture clears the local exclusive monitor on every exception entry and
+    // return, so on these single core parts a successful STREX also proves that nothing
+    // (interrupt or context switch) ran since the matching LDREX. LoadAndAddReference and
+    // the failure path of ReferenceCountingCompareExchange rely on this to re-check the
+    // slot after taking the reservation on the object header: if the STREX on the header
+    // succeeds, the slot still held the object when its count was bumped.
+    //
+
+    __attribute__((always_inline)) __STATIC_INLINE void AddReferenceFast(Object* target)
+    {
+        if (target != NULL)
+        {
+            volatile uint32_t* word = (volatile uint32_t*)&target->get_Header()->MultiUseWord;
+            uint32_t value;
+
+            do
+            {
+                value = __LDREXW(word);
+
+                if ((value & REFERENCE_COUNT_MASK) == 0)
+                {
+                    __CLREX();
+                    return;
+                }
+            }
+            while (__STREXW(value + (1 << REFERENCE_COUNT_SHIFT), word) != 0);
+        }
+    }
+
+    __attribute__((always_inline)) __STATIC_INLINE int ReleaseReferenceFast(Object* target)
+    {
+        volatile uint32_t* word = (volatile uint32_t*)&target->get_Header()->MultiUseWord;
+        uint32_t value;
+
+        do
+        {
+            value = __LDREXW(word);
+
+            if ((value & REFERENCE_COUNT_MASK) == 0)
+            {
+                __CLREX();
+                return 1;
+            }
+
+            value -= (1 << REFERENCE_COUNT_SHIFT);
+        }
+        while (__STREXW(value, word) != 0);
+
+        return value & REFERENCE_COUNT_MASK;
+    }
+
+    // Add a reference to the object currently stored in *target, provided *target still holds it
+    // when the count is committed. Returns false if the slot changed and the caller has to retry.
+    __attribute__((always_inline)) __STATIC_INLINE bool AddReferenceIfStillStored(Object** target, Object* value)
+    {
+        volatile uint32_t* word = (volatile uint32_t*)&value->get_Header()->MultiUseWord;
+        uint32_t header;
+
+        do
+        {
+            header = __LDREXW(word);
+
+            if (*(Object* volatile*)target != value)
+            {
+                __CLREX();
+                return false;
+            }
+
+            if ((header & REFERENCE_COUNT_MASK) == 0)
+            {
+                __CLREX();
+                return true;
+            }
+        }
+        while (__STREXW(header + (1 << REFERENCE_COUNT_SHIFT), word) != 0);
+
+        return true;
+    }
+
+    void AddReference(Object* target)
+    {
+        AddReferenceFast(target);
+    }
+
+    // Return zero when target is dead after the call
+    int ReleaseReferenceNative(Object* target)
+    {
+        if (target == NULL)
+        {
+            return 1;
+        }
+
+        return ReleaseReferenceFast(target);
+    }
+
+    Object* LoadAndAddReferenceNative(Object** target)
+    {
+        while (true)
+        {
+            Object* value = *(Object* volatile*)target;
+
+            if (value == NULL || AddReferenceIfStillStored(target, value))
+            {
+                return value;
+            }
+        }
+    }
+
+    Object* ReferenceCountingExchange(Object** target, Object* value)
+    {
+        Object* oldValue;
+
+        // The caller owns a reference to value, so it cannot die while we publish it. Take the
+        // slot's reference first so that the object is never reachable with a missing count.
+        AddReferenceFast(value);
+
+        do
+        {
+            oldValue = (Object*)__LDREXW((volatile uint32_t*)target);
+        }
+        while (__STREXW((uint32_t)value, (volatile uint32_t*)target) != 0);
+
+        return oldValue;
+    }
+
+    Object* ReferenceCountingCompareExchange(Object** target, Object* value, Object* comparand)
+    {
+        while (true)
+        {
+            Object* oldValue = *(Object* volatile*)target;
+
+            if (oldValue == comparand)
+            {
+                // Compare exchange succeeds, we need to add ref the new value
+                // The old value's ref count will be passed back to the caller on return.
+                AddReferenceFast(value);
+
+                oldValue = (Object*)__LDREXW((volatile uint32_t*)target);
+
+                if (oldValue == comparand && __STREXW((uint32_t)value, (volatile uint32_t*)target) == 0)
+                {
+                    return oldValue;
+                }
+
+                __CLREX();
+
+                // Lost the race, give back the reference taken above. The caller still owns one,
+                // so this can never be the last reference.
+                if (value != NULL)
+                {
+                    ReleaseReferenceFast(value);
+                }
+            }
+            else
+            {
+                // Target is not changed, we need to add ref the old value so it has
+                // a ref count to pass back to caller on return
+                if (oldValue == NULL || AddReferenceIfStillStored(target, oldValue))
+                {
+                    return oldValue;
+                }
+            }
+        }
+    }
+
+#else // Cortex-M0/M0+ have no exclusive access instructions, fall back to masking interrupts.
+
     // Helpers for starting / ending section of code that needs to be atomic
     __attribute__((always_inline)) __STATIC_INLINE void StartAtomicOperations(void)
     {
@@ -159,4 +331,6 @@ extern "C"
 
         return oldValue;
     }
+
+#endif // (__CORTEX_M >= 0x03) || (__CORTEX_SC >= 300)
 }
@@ -1,19 +1,115 @@
 #include "mbed_helpers.h"
 #include "llos_serial.h"
 #include "llos_memory.h"
+#include "llos_ring_buffer.h"
 
 //--//
 
 extern "C"
 {
+    //
+    // The UART interrupt is always enabled while a port is open: the RX handler moves bytes from
+    // the hardware into RxRing and the TX handler feeds the hardware from TxRing, so Read/Write
+    // never poll the UART. LLOS_SERIAL_Enable/Disable only control whether the managed callback
+    // is notified about RX data and about the TX ring draining.
+    //
     typedef struct LLOS_MbedSerial
     {
         serial_t                      Port;
         LLOS_SERIAL_InterruptCallback Callback;
         LLOS_Context                  Context;
         LLOS_SERIAL_Config            Config;
+        LLOS_RingBuffer               RxRing;
+        LLOS_RingBuffer               TxRing;
+        bool                          NotifyRx;
+        bool                          NotifyTx;
+        uint32_t                      RxOverruns;
     } LLOS_MbedSerial;
 
+    static void HandleInternalSerialPortInterrupt(uint32_t id, SerialIrq data);
+
+    //
+    // The serial HAL gives the interrupt handler back a 32-bit id, which cannot hold a pointer on
+    // a 64-bit host. Open ports are kept in this table and the id is their slot index.
+    //
+#define LLOS_SERIAL_MAX_PORTS 4
+
+    static LLOS_MbedSerial* s_serialPorts[LLOS_SERIAL_MAX_PORTS];
+
+    static int32_t ClaimPortSlot(LLOS_MbedSerial* pSerial)
+    {
+        int32_t slot = -1;
+
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+
+        for (int32_t i = 0; i < LLOS_SERIAL_MAX_PORTS; i++)
+        {
+            if (s_serialPorts[i] == NULL)
+            {
+                s_serialPorts[i] = pSerial;
+                slot             = i;
+                break;
+            }
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
+        return slot;
+    }
+
+    static void ReleasePortSlot(LLOS_MbedSerial* pSerial)
+    {
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+
+        for (int32_t i = 0; i < LLOS_SERIAL_MAX_PORTS; i++)
+        {
+            if (s_serialPorts[i] == pSerial)
+            {
+                s_serialPorts[i] = NULL;
+            }
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+    }
+
+    static uint32_t GetRingCapacity(uint32_t size)
+    {
+        return LLOS_RingBuffer_RoundCapacity(size == 0 ? LLOS_SERIAL_DEFAULT_BUFFER_SIZE : size);
+    }
+
+    // Returns the storage the ring was using, which the caller frees once interrupts are back on.
+    static uint8_t* ReplaceRingStorage(LLOS_RingBuffer* pRing, uint8_t* pStorage, uint32_t capacity)
+    {
+        uint8_t* pOldStorage = (uint8_t*)pRing->Buffer;
+
+        LLOS_RingBuffer_Initialize(pRing, pStorage, capacity);
+
+        return pOldStorage;
+    }
+
+    static void FreeRingBuffer(LLOS_RingBuffer* pRing)
+    {
+        if (pRing->Buffer != NULL)
+        {
+            FreeFromManagedHeap((LLOS_Opaque)pRing->Buffer);
+        }
+
+        LLOS_RingBuffer_Initialize(pRing, NULL, 0);
+    }
+
+    // Must be called with interrupts disabled, the TX interrupt handler is the other consumer of TxRing.
+    static void StartTransmit(LLOS_MbedSerial* pSerial)
+    {
+        uint8_t c;
+
+        while (serial_writable(&pSerial->Port) && LLOS_RingBuffer_Pop(&pSerial->TxRing, &c))
+        {
+            serial_putc(&pSerial->Port, c);
+        }
+
+        serial_irq_set(&pSerial->Port, TxIrq, !LLOS_RingBuffer_IsEmpty(&pSerial->TxRing));
+    }
+
     HRESULT LLOS_SERIAL_Open(int32_t rxPin, int32_t txPin, LLOS_SERIAL_Config** ppConfig, LLOS_Context* pChannel)
     {
         LLOS_MbedSerial *pSerial;
@@ -30,8 +126,46 @@ extern "C"
             return LLOS_E_OUT_OF_MEMORY;
         }
 
+        pSerial->Callback   = NULL;
+        pSerial->Context    = NULL;
+        pSerial->NotifyRx   = false;
+        pSerial->NotifyTx   = false;
+        pSerial->RxOverruns = 0;
+
+        pSerial->Config.RxBufferSize = LLOS_SERIAL_DEFAULT_BUFFER_SIZE;
+        pSerial->Config.TxBufferSize = LLOS_SERIAL_DEFAULT_BUFFER_SIZE;
+
+        uint32_t rxCapacity = GetRingCapacity(pSerial->Config.RxBufferSize);
+        uint32_t txCapacity = GetRingCapacity(pSerial->Config.TxBufferSize);
+
+        LLOS_RingBuffer_Initialize(&pSerial->RxRing, (uint8_t*)AllocateFromManagedHeap(rxCapacity), rxCapacity);
+        LLOS_RingBuffer_Initialize(&pSerial->TxRing, (uint8_t*)AllocateFromManagedHeap(txCapacity), txCapacity);
+
+        if (pSerial->RxRing.Buffer == NULL || pSerial->TxRing.Buffer == NULL)
+        {
+            FreeRingBuffer(&pSerial->RxRing);
+            FreeRingBuffer(&pSerial->TxRing);
+            FreeFromManagedHeap(pSerial);
+
+            return LLOS_E_OUT_OF_MEMORY;
+        }
+
+        int32_t slot = ClaimPortSlot(pSerial);
+
+        if (slot < 0)
+        {
+            FreeRingBuffer(&pSerial->RxRing);
+            FreeRingBuffer(&pSerial->TxRing);
+            FreeFromManagedHeap(pSerial);
+
+            return LLOS_E_BUSY;
+        }
+
         serial_init(&pSerial->Port, (PinName)txPin, (PinName)rxPin);
 
+        serial_irq_handler(&pSerial->Port, (uart_irq_handler)HandleInternalSerialPortInterrupt, (uint32_t)slot);
+        serial_irq_set(&pSerial->Port, RxIrq, 1);
+
         *pChannel = (LLOS_Context)pSerial;
         *ppConfig = &pSerial->Config;
 
@@ -44,7 +178,14 @@ extern "C"
 
         if (pSerial != NULL)
         {
+            serial_irq_set(&pSerial->Port, RxIrq, 0);
+            serial_irq_set(&pSerial->Port, TxIrq, 0);
             serial_free(&pSerial->Port);
+
+            ReleasePortSlot(pSerial);
+
+            FreeRingBuffer(&pSerial->RxRing);
+            FreeRingBuffer(&pSerial->TxRing);
         }
 
         FreeFromManagedHeap(pSerial);
@@ -62,14 +203,14 @@ extern "C"
         switch (irq)
         {
         case LLOS_SERIAL_IrqRx:
-            serial_irq_set(&pSerial->Port, RxIrq, fEnable);
+            pSerial->NotifyRx = (fEnable != 0);
             break;
         case LLOS_SERIAL_IrqTx:
-            serial_irq_set(&pSerial->Port, TxIrq, fEnable);
+            pSerial->NotifyTx = (fEnable != 0);
             break;
         case LLOS_SERIAL_IrqBoth:
-            serial_irq_set(&pSerial->Port, TxIrq, fEnable);
-            serial_irq_set(&pSerial->Port, RxIrq, fEnable);
+            pSerial->NotifyTx = (fEnable != 0);
+            pSerial->NotifyRx = (fEnable != 0);
             break;
         default:
             return LLOS_E_INVALID_PARAMETER;
@@ -139,56 +280,152 @@ extern "C"
         serial_format(&pSerial->Port, pConfig->DataBits, (SerialParity)pConfig->Parity, pConfig->StopBits);
         serial_baud(&pSerial->Port, pConfig->BaudRate);
 
-        return S_OK;
-    }
+        //
+        // Resizing a ring drops whatever it currently holds, so only do it when the size changes.
+        // The managed heap must not be used with interrupts disabled: the new storage is allocated
+        // up front, only swapped in under PRIMASK, and the old storage freed afterwards.
+        //
+        uint32_t rxCapacity = GetRingCapacity(pConfig->RxBufferSize);
+        uint32_t txCapacity = GetRingCapacity(pConfig->TxBufferSize);
+        uint8_t* pRxStorage = NULL;
+        uint8_t* pTxStorage = NULL;
+        bool     fResizeRx  = (rxCapacity != pSerial->RxRing.Capacity);
+        bool     fResizeTx  = (txCapacity != pSerial->TxRing.Capacity);
+
+        if (fResizeRx)
+        {
+            pRxStorage = (uint8_t*)AllocateFromManagedHeap(rxCapacity);
+        }
 
-    HRESULT LLOS_SERIAL_Read(LLOS_Context channel, uint8_t* pBuffer, int32_t offset, int32_t* pLength)
-    {
-        LLOS_MbedSerial *pSerial   = (LLOS_MbedSerial*)channel;
-        int              bytesRead = 0;
-        char            *pcNext    = NULL;
+        if (fResizeTx)
+        {
+            pTxStorage = (uint8_t*)AllocateFromManagedHeap(txCapacity);
+        }
 
-        if (pSerial == NULL || pBuffer == NULL)
+        if ((fResizeRx && pRxStorage == NULL) || (fResizeTx && pTxStorage == NULL))
         {
-            return LLOS_E_INVALID_PARAMETER;
+            FreeFromManagedHeap(pRxStorage);
+            FreeFromManagedHeap(pTxStorage);
+
+            return LLOS_E_OUT_OF_MEMORY;
         }
 
-        pcNext = (char*)&pBuffer[offset];
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
 
-        while (serial_readable(&pSerial->Port) && bytesRead < *pLength)
+        if (fResizeRx)
         {
-            *pcNext++ = serial_getc(&pSerial->Port);
-            bytesRead++;
+            pRxStorage = ReplaceRingStorage(&pSerial->RxRing, pRxStorage, rxCapacity);
         }
 
-        *pLength = bytesRead;
+        if (fResizeTx)
+        {
+            pTxStorage = ReplaceRingStorage(&pSerial->TxRing, pTxStorage, txCapacity);
+
+            serial_irq_set(&pSerial->Port, TxIrq, 0);
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
+        FreeFromManagedHeap(pRxStorage);
+        FreeFromManagedHeap(pTxStorage);
+
+        pConfig->RxBufferSize = rxCapacity;
+        pConfig->TxBufferSize = txCapacity;
 
         return S_OK;
     }
 
-    HRESULT LLOS_SERIAL_Write(LLOS_Context channel, uint8_t* pBuffer, int32_t offset, int32_t length)
+    // Copies up to *pLength bytes already received by the RX interrupt, never waits for more.
+    HRESULT LLOS_SERIAL_Read(LLOS_Context channel, uint8_t* pBuffer, int32_t offset, int32_t* pLength)
     {
-        LLOS_MbedSerial *pSerial      = (LLOS_MbedSerial*)channel;
-        char            *pcNext       = NULL;
+        LLOS_MbedSerial *pSerial = (LLOS_MbedSerial*)channel;
 
-        if (pSerial == NULL || pBuffer == NULL)
+        if (pSerial == NULL || pBuffer == NULL || pLength == NULL || *pLength < 0)
         {
             return LLOS_E_INVALID_PARAMETER;
         }
 
-        pcNext = (char*)&pBuffer[offset];
+        *pLength = (int32_t)LLOS_RingBuffer_Read(&pSerial->RxRing, &pBuffer[offset], (uint32_t)*pLength);
+
+        return S_OK;
+    }
 
-        while (length-- > 0)
+    // Queues up to *pLength bytes for the TX interrupt and returns the number queued in *pLength.
+    HRESULT LLOS_SERIAL_Write(LLOS_Context channel, uint8_t* pBuffer, int32_t offset, int32_t* pLength)
+    {
+        LLOS_MbedSerial *pSerial = (LLOS_MbedSerial*)channel;
+
+        if (pSerial == NULL || pBuffer == NULL || pLength == NULL || *pLength < 0)
         {
-            serial_putc(&pSerial->Port, *pcNext++);
+            return LLOS_E_INVALID_PARAMETER;
         }
 
+        *pLength = (int32_t)LLOS_RingBuffer_Write(&pSerial->TxRing, &pBuffer[offset], (uint32_t)*pLength);
+
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        StartTransmit(pSerial);
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
         return S_OK;
     }
 
+    //
+    // Blocks until every queued byte has been handed to the UART, i.e. until the TX ring is empty
+    // and the transmit holding register has room again. The mbed serial API has no way to query
+    // the shift register, so the last byte may still be going out on the line when this returns.
+    //
     HRESULT LLOS_SERIAL_Flush(LLOS_Context channel)
     {
-        LLOS__UNREFERENCED_PARAMETER(channel); 
+        LLOS_MbedSerial *pSerial = (LLOS_MbedSerial*)channel;
+
+        if (pSerial == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        if (__get_PRIMASK() != 0)
+        {
+            //
+            // The TX interrupt cannot run, drain the ring by polling.
+            //
+            uint8_t c;
+
+            while (LLOS_RingBuffer_Pop(&pSerial->TxRing, &c))
+            {
+                serial_putc(&pSerial->Port, c);
+            }
+
+            serial_irq_set(&pSerial->Port, TxIrq, 0);
+        }
+        else
+        {
+            //
+            // Sleep until the TX interrupt (or any other one, e.g. the scheduler tick) fires.
+            // Checking with interrupts masked closes the race with the ring draining right
+            // before WFI; a pending interrupt still wakes the core up.
+            //
+            while (true)
+            {
+                __disable_irq();
+
+                if (LLOS_RingBuffer_IsEmpty(&pSerial->TxRing))
+                {
+                    __enable_irq();
+                    break;
+                }
+
+                __WFI();
+                __enable_irq();
+            }
+        }
+
+        while (!serial_writable(&pSerial->Port))
+        {
+        }
 
         return S_OK;
     }
@@ -202,18 +439,70 @@ extern "C"
             return LLOS_E_INVALID_PARAMETER;
         }
 
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
         serial_clear(&pSerial->Port);
 
+        LLOS_RingBuffer_Clear(&pSerial->RxRing);
+        LLOS_RingBuffer_Clear(&pSerial->TxRing);
+
+        serial_irq_set(&pSerial->Port, TxIrq, 0);
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
         return S_OK;
     }
 
     static void HandleInternalSerialPortInterrupt(uint32_t id, SerialIrq data)
     {
-        LLOS_MbedSerial *pSerial = (LLOS_MbedSerial*)id;
+        LLOS_MbedSerial *pSerial = id < LLOS_SERIAL_MAX_PORTS ? s_serialPorts[id] : NULL;
+
+        if (pSerial == NULL)
+        {
+            return;
+        }
 
-        if (pSerial != NULL && pSerial->Callback != NULL)
+        if (data == RxIrq)
         {
-            pSerial->Callback(pSerial, pSerial->Context, (LLOS_SERIAL_Event)data);
+            BOOL fReceived = false;
+
+            //
+            // Always empty the hardware FIFO so the interrupt deasserts, even if the ring is full.
+            //
+            while (serial_readable(&pSerial->Port))
+            {
+                if (!LLOS_RingBuffer_Push(&pSerial->RxRing, (uint8_t)serial_getc(&pSerial->Port)))
+                {
+                    pSerial->RxOverruns++;
+                }
+
+                fReceived = true;
+            }
+
+            if (fReceived && pSerial->NotifyRx && pSerial->Callback != NULL)
+            {
+                pSerial->Callback(pSerial, pSerial->Context, LLOS_SERIAL_EventRx);
+            }
+        }
+        else
+        {
+            uint8_t c;
+
+            while (serial_writable(&pSerial->Port) && LLOS_RingBuffer_Pop(&pSerial->TxRing, &c))
+            {
+                serial_putc(&pSerial->Port, c);
+            }
+
+            if (LLOS_RingBuffer_IsEmpty(&pSerial->TxRing))
+            {
+                serial_irq_set(&pSerial->Port, TxIrq, 0);
+
+                if (pSerial->NotifyTx && pSerial->Callback != NULL)
+                {
+                    pSerial->Callback(pSerial, pSerial->Context, LLOS_SERIAL_EventTx);
+                }
+            }
         }
     }
 
@@ -226,10 +515,13 @@ extern "C"
             return LLOS_E_INVALID_PARAMETER;
         }
 
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
         pSerial->Callback = callback;
         pSerial->Context  = callbackContext;
 
-        serial_irq_handler(&pSerial->Port, (uart_irq_handler)HandleInternalSerialPortInterrupt, (uint32_t)channel);
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
 
         return S_OK;
     }
@@ -243,7 +535,7 @@ extern "C"
             return LLOS_E_INVALID_PARAMETER;
         }
 
-        *pCanRead = serial_readable(&pSerial->Port);
+        *pCanRead = !LLOS_RingBuffer_IsEmpty(&pSerial->RxRing);
 
         return S_OK;
     }
@@ -257,7 +549,7 @@ extern "C"
             return LLOS_E_INVALID_PARAMETER;
         }
 
-        *pCanWrite = serial_writable(&pSerial->Port);
+        *pCanWrite = !LLOS_RingBuffer_IsFull(&pSerial->TxRing);
 
         return S_OK;
     }
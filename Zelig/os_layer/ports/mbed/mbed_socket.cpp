@@ -2,19 +2,114 @@
 // Copyright (c) Microsoft Corporation.    All rights reserved.
 //
 
+#if !defined(TARGET_HOST)
 #include "mbed_helpers.h"
 #include "mbed.h"
 #include "EthernetInterface.h"
+#else
+// Host builds (lwip-eth/arch/TARGET_HOST) run this file on the lwIP stack alone
+#include <cstring>
+#include <stdint.h>
+
+int32_t WStringToCharBuffer(char* output, uint32_t outputBufferLength, const uint16_t* input, const uint32_t length);
+
+#define LLOS__UNREFERENCED_PARAMETER(P) ((void)P)
+#endif
 #include "init.h"
 #include "tcpip.h"
 #include "dns.h"
 #include "netifapi.h"
 #include "netdb.h"
+#include "netif.h"
 #include "tcp.h"
-#include "Sockets.h"
+#include "mem.h"
+#include "sockets.h"
 
 extern "C"
 {
+    //
+    // Poll modes, these match System.Net.Sockets.SelectMode
+    //
+#define LLOS_LWIP_SELECT_READ   0
+#define LLOS_LWIP_SELECT_WRITE  1
+#define LLOS_LWIP_SELECT_ERROR  2
+
+    // Negative timeouts mean wait forever.
+    static struct timeval* MicrosecondsToTimeval(int32_t microSeconds, struct timeval* pTimeout)
+    {
+        if (microSeconds < 0)
+        {
+            return NULL;
+        }
+
+        pTimeout->tv_sec  = microSeconds / 1000000;
+        pTimeout->tv_usec = microSeconds % 1000000;
+
+        return pTimeout;
+    }
+
+    // Returns 1 if the socket is ready, 0 on timeout and -1 on error.
+    static int32_t WaitForSocket(int32_t socket, int32_t mode, int32_t microSeconds)
+    {
+        fd_set         set;
+        struct timeval timeout;
+
+        if (socket < 0 || socket >= FD_SETSIZE)
+        {
+            return -1;
+        }
+
+        FD_ZERO(&set);
+        FD_SET(socket, &set);
+
+        return lwip_select(socket + 1,
+            (mode == LLOS_LWIP_SELECT_READ ) ? &set : NULL,
+            (mode == LLOS_LWIP_SELECT_WRITE) ? &set : NULL,
+            (mode == LLOS_LWIP_SELECT_ERROR) ? &set : NULL,
+            MicrosecondsToTimeval(microSeconds, &timeout));
+    }
+
+    //
+    // Send and receive calls take a timeout in milliseconds, where zero or negative values mean block until done.
+    // With a timeout, wait for the socket to become ready first; receives are then done without blocking, so the
+    // call cannot outlast the timeout if another thread drained the socket in between, and a receive that timed
+    // out fails in lwIP with EWOULDBLOCK in SO_ERROR. Sends still block, lwIP cannot partially write a non-blocking
+    // send. A send that times out is not handed to lwIP at all, so its EWOULDBLOCK is kept in s_SendErrors until
+    // LLOS_lwip_getsockopt reports it as SO_ERROR.
+    //
+    static volatile uint8_t s_SendErrors[FD_SETSIZE];
+
+    static int32_t WaitForTimedIo(int32_t socket, int32_t mode, int32_t flags, int32_t time_ms)
+    {
+        if (time_ms <= 0 || (flags & MSG_DONTWAIT) != 0)
+        {
+            return 1;
+        }
+
+        return WaitForSocket(socket, mode, (time_ms > 0x7FFFFFFF / 1000) ? -1 : time_ms * 1000);
+    }
+
+    // Returns true if the send can go ahead, otherwise the caller fails it with -1.
+    static bool WaitForTimedSend(int32_t socket, int32_t flags, int32_t time_ms)
+    {
+        int32_t result = WaitForTimedIo(socket, LLOS_LWIP_SELECT_WRITE, flags, time_ms);
+
+        if (result == 0)
+        {
+            s_SendErrors[socket] = EWOULDBLOCK;
+        }
+
+        return result > 0;
+    }
+
+    static void ClearSendError(int32_t socket)
+    {
+        if (socket >= 0 && socket < FD_SETSIZE)
+        {
+            s_SendErrors[socket] = 0;
+        }
+    }
+
     int32_t LLOS_lwip_socket(int32_t family, int32_t type, int32_t protocol)
     {
         switch (protocol)
@@ -34,33 +129,49 @@ extern "C"
             break;
         }
 
-        return lwip_socket(family, type, protocol);
-    }
-
+        int32_t socket = lwip_socket(family, type, protocol);
 
-    int32_t LLOS_lwip_bind(int32_t socket, void* address)
-    {
-        sockaddr_in _remoteHost;
+        ClearSendError(socket);
 
-        return lwip_bind(socket, (const struct sockaddr *) &_remoteHost, sizeof(_remoteHost));
+        return socket;
     }
 
 
-    int32_t LLOS_lwip_connect(int32_t socket, void* address, bool fThrowOnWouldBlock)
+    // Converts a managed SocketAddress buffer (family, big endian port, IPv4 address) to an lwIP sockaddr_in.
+    static void SocketAddressToSockaddrIn(void* address, sockaddr_in* pAddr)
     {
-        sockaddr_in _remoteHost;
-
         uint8_t p1 = ((uint8_t*)address)[2];
         uint8_t p2 = ((uint8_t*)address)[3];
         uint16_t port = p1 << 8 | p2;
 
-        std::memcpy((char*)&_remoteHost.sin_addr.s_addr, &((uint8_t*)address)[4], 4);
+        std::memset(pAddr, 0, sizeof(*pAddr));
+        std::memcpy((char*)&pAddr->sin_addr.s_addr, &((uint8_t*)address)[4], 4);
 
         // Address family
-        _remoteHost.sin_family = AF_INET;
+        pAddr->sin_family = AF_INET;
 
         // Set port
-        _remoteHost.sin_port = htons(port);
+        pAddr->sin_port = htons(port);
+    }
+
+
+    int32_t LLOS_lwip_bind(int32_t socket, void* address)
+    {
+        sockaddr_in _localHost;
+
+        SocketAddressToSockaddrIn(address, &_localHost);
+
+        return lwip_bind(socket, (const struct sockaddr *) &_localHost, sizeof(_localHost));
+    }
+
+
+    int32_t LLOS_lwip_connect(int32_t socket, void* address, bool fThrowOnWouldBlock)
+    {
+        sockaddr_in _remoteHost;
+
+        LLOS__UNREFERENCED_PARAMETER(fThrowOnWouldBlock);
+
+        SocketAddressToSockaddrIn(address, &_remoteHost);
 
         return lwip_connect(socket, (const struct sockaddr *) &_remoteHost, sizeof(_remoteHost));
     }
@@ -68,18 +179,280 @@ extern "C"
 
     int32_t LLOS_lwip_send(int32_t socket, char* buf, int32_t count, int32_t flags, int32_t time_ms)
     {
+        if (!WaitForTimedSend(socket, flags, time_ms))
+        {
+            return -1;
+        }
+
         return lwip_send(socket, buf, count, flags);
     }
 
 
     int32_t LLOS_lwip_recv(int32_t socket, char* buf, int32_t count, int32_t flags, int32_t time_ms)
     {
+        if (time_ms > 0)
+        {
+            if (WaitForTimedIo(socket, LLOS_LWIP_SELECT_READ, flags, time_ms) < 0)
+            {
+                return -1;
+            }
+
+            flags |= MSG_DONTWAIT;
+        }
+
         return lwip_recv(socket, buf, count, flags);
     }
 
 
+    //
+    // Scatter/gather I/O: 'buffers' and 'counts' describe 'segmentCount' segments, which are sent or filled in order.
+    //
+    // On stream sockets each segment goes straight to lwIP, with MSG_MORE on all but the last one so that they are
+    // coalesced into full TCP segments and only the last one is pushed. lwIP still copies the data into its send
+    // buffer: the segments are managed arrays that can be collected as soon as the call returns, long before the
+    // data is acknowledged, so NETCONN_NOCOPY is never safe here. Datagrams (and peeks, which would see the same
+    // bytes for every segment) must be a single lwIP call, so those go through one bounce buffer instead.
+    //
+    // The bounce buffer is allocated once and holds an unfragmented UDP datagram. Receives are cut to that size,
+    // which truncates only reassembled datagrams, as a short buffer would; raise LLOS_LWIP_BOUNCE_SIZE if the
+    // application expects those. Sends of larger datagrams, and calls made while another thread holds the
+    // buffer, fall back to the lwIP heap.
+    //
+#ifndef LLOS_LWIP_BOUNCE_SIZE
+#define LLOS_LWIP_BOUNCE_SIZE   (1500 - 20 - 8)
+#endif
+
+    static char          s_Bounce[LLOS_LWIP_BOUNCE_SIZE];
+    static volatile bool s_BounceInUse;
+
+    static char* ClaimBounce(int32_t length)
+    {
+        if (length <= LLOS_LWIP_BOUNCE_SIZE)
+        {
+            bool claimed;
+
+            SYS_ARCH_DECL_PROTECT(lev);
+            SYS_ARCH_PROTECT(lev);
+
+            claimed       = !s_BounceInUse;
+            s_BounceInUse = true;
+
+            SYS_ARCH_UNPROTECT(lev);
+
+            if (claimed)
+            {
+                return s_Bounce;
+            }
+        }
+
+        return (char*)mem_malloc(length > 0 ? length : 1);
+    }
+
+    static void ReleaseBounce(char* bounce)
+    {
+        if (bounce == s_Bounce)
+        {
+            s_BounceInUse = false;
+        }
+        else
+        {
+            mem_free(bounce);
+        }
+    }
+
+    static int32_t TotalLength(char** buffers, int32_t* counts, int32_t segmentCount)
+    {
+        int32_t total = 0;
+
+        if (buffers == NULL || counts == NULL || segmentCount <= 0)
+        {
+            return -1;
+        }
+
+        for (int32_t i = 0; i < segmentCount; i++)
+        {
+            if (counts[i] < 0 || (counts[i] > 0 && buffers[i] == NULL) || counts[i] > 0x7FFFFFFF - total)
+            {
+                return -1;
+            }
+
+            total += counts[i];
+        }
+
+        return total;
+    }
+
+    static bool IsStreamSocket(int32_t socket)
+    {
+        int       type   = 0;
+        socklen_t length = sizeof(type);
+
+        return lwip_getsockopt(socket, SOL_SOCKET, SO_TYPE, &type, &length) == 0 && type == SOCK_STREAM;
+    }
+
+    int32_t LLOS_lwip_sendv(int32_t socket, char** buffers, int32_t* counts, int32_t segmentCount, int32_t flags, int32_t time_ms)
+    {
+        int32_t total = TotalLength(buffers, counts, segmentCount);
+        int32_t sent  = 0;
+        int32_t last;
+
+        if (total < 0)
+        {
+            return -1;
+        }
+
+        if (!WaitForTimedSend(socket, flags, time_ms))
+        {
+            return -1;
+        }
+
+        if (!IsStreamSocket(socket))
+        {
+            char*   bounce = ClaimBounce(total);
+            int32_t result;
+
+            if (bounce == NULL)
+            {
+                return -1;
+            }
+
+            for (int32_t i = 0; i < segmentCount; i++)
+            {
+                std::memcpy(&bounce[sent], buffers[i], counts[i]);
+                sent += counts[i];
+            }
+
+            result = lwip_send(socket, bounce, total, flags);
+
+            ReleaseBounce(bounce);
+
+            return result;
+        }
+
+        for (last = segmentCount - 1; last > 0 && counts[last] == 0; last--)
+        {
+        }
+
+        for (int32_t i = 0; i <= last; i++)
+        {
+            int32_t result;
+
+            if (counts[i] == 0 && i != last)
+            {
+                continue;
+            }
+
+            result = lwip_send(socket, buffers[i], counts[i], (i < last) ? (flags | MSG_MORE) : flags);
+
+            if (result < 0)
+            {
+                return (sent > 0) ? sent : result;
+            }
+
+            sent += result;
+
+            if (result < counts[i])
+            {
+                break;
+            }
+        }
+
+        return sent;
+    }
+
+    int32_t LLOS_lwip_recvv(int32_t socket, char** buffers, int32_t* counts, int32_t segmentCount, int32_t flags, int32_t time_ms)
+    {
+        int32_t total    = TotalLength(buffers, counts, segmentCount);
+        int32_t received = 0;
+
+        if (total < 0)
+        {
+            return -1;
+        }
+
+        if (time_ms > 0)
+        {
+            if (WaitForTimedIo(socket, LLOS_LWIP_SELECT_READ, flags, time_ms) < 0)
+            {
+                return -1;
+            }
+
+            flags |= MSG_DONTWAIT;
+        }
+
+        if ((flags & MSG_PEEK) != 0 || !IsStreamSocket(socket))
+        {
+            char*   bounce;
+            int32_t result;
+
+            if (total > LLOS_LWIP_BOUNCE_SIZE)
+            {
+                total = LLOS_LWIP_BOUNCE_SIZE;
+            }
+
+            // Only hold the bounce buffer once there is something to receive
+            if ((flags & MSG_DONTWAIT) == 0 && WaitForSocket(socket, LLOS_LWIP_SELECT_READ, -1) < 0)
+            {
+                return -1;
+            }
+
+            bounce = ClaimBounce(total);
+
+            if (bounce == NULL)
+            {
+                return -1;
+            }
+
+            result = lwip_recv(socket, bounce, total, flags);
+
+            for (int32_t i = 0; i < segmentCount && received < result; i++)
+            {
+                int32_t chunk = (counts[i] < result - received) ? counts[i] : (result - received);
+
+                std::memcpy(buffers[i], &bounce[received], chunk);
+                received += chunk;
+            }
+
+            ReleaseBounce(bounce);
+
+            return result;
+        }
+
+        //
+        // Block (or wait out the timeout) for the first bytes only, then take whatever else is already queued.
+        //
+        for (int32_t i = 0; i < segmentCount; i++)
+        {
+            int32_t result;
+
+            if (counts[i] == 0)
+            {
+                continue;
+            }
+
+            result = lwip_recv(socket, buffers[i], counts[i], (received > 0) ? (flags | MSG_DONTWAIT) : flags);
+
+            if (result <= 0)
+            {
+                return (received > 0) ? received : result;
+            }
+
+            received += result;
+
+            if (result < counts[i])
+            {
+                break;
+            }
+        }
+
+        return received;
+    }
+
+
     int32_t LLOS_lwip_close(int32_t socket)
     {
+        ClearSendError(socket);
+
         return lwip_close(socket);
     }
 
@@ -92,45 +465,373 @@ extern "C"
 
     int32_t LLOS_lwip_accept(int32_t socket, void* address, uint32_t* addrlen)
     {
-        return lwip_accept(socket, (sockaddr*)address, addrlen);
+        int32_t accepted = lwip_accept(socket, (sockaddr*)address, addrlen);
+
+        ClearSendError(accepted);
+
+        return accepted;
     }
 
-    int32_t LLOS_lwip_getaddrinfo(uint16_t* name, uint32_t namelen, char* canonicalName, uint32_t canonicalNameBufferSize, char* addresses, uint32_t addressBufferSize)
+    //
+    // DNS cache. Devices tend to reconnect to the same few hosts over and over, so resolved IPv4 addresses are kept
+    // for LLOS_DNS_CACHE_TTL_MS in a small LRU table and handed out without a round trip through the tcpip thread.
+    // lwIP does not report the record TTL past its own table, so the lifetime is only a short cap: once it runs
+    // out, the lookup goes back to lwIP, which still answers from its table for as long as the record TTL allows.
+    // The whole cache is dropped when the default interface changes address, the device may be on another network
+    // with other DNS servers. Names longer than LLOS_DNS_CACHE_NAME_LENGTH are resolved every time.
+    //
+    // LLOS_lwip_getaddrinfo_async starts a resolution in the background, so that connection setup can overlap it
+    // with other work; the result lands in the cache for the following LLOS_lwip_getaddrinfo.
+    //
+#define LLOS_DNS_CACHE_ENTRIES          4
+#define LLOS_DNS_CACHE_NAME_LENGTH      64
+#ifndef LLOS_DNS_CACHE_TTL_MS
+#define LLOS_DNS_CACHE_TTL_MS           (60 * 1000)
+#endif
+
+#define LLOS_DNS_ENTRY_FREE             0
+#define LLOS_DNS_ENTRY_PENDING          1
+#define LLOS_DNS_ENTRY_RESOLVED         2
+
+    typedef struct DnsCacheEntry
     {
-        char nameBuffer[256];
+        char      Name[LLOS_DNS_CACHE_NAME_LENGTH];
+        ip_addr_t Address;
+        uint32_t  Expiry;
+        uint32_t  LastUsed;
+        uint8_t   State;
+    } DnsCacheEntry;
+
+    static DnsCacheEntry s_DnsCache[LLOS_DNS_CACHE_ENTRIES];
+    static uint32_t      s_DnsCacheClock;
+    static ip_addr_t     s_DnsCacheNetifAddress;
+
+    // Must be called under SYS_ARCH_PROTECT.
+    static DnsCacheEntry* DnsCacheFind(const char* name)
+    {
+        ip_addr_t netifAddress;
+
+        ip_addr_set_zero(&netifAddress);
+
+        if (netif_default != NULL)
+        {
+            ip_addr_copy(netifAddress, netif_default->ip_addr);
+        }
 
-        if (namelen >= 256)
+        // Queries still in flight are dropped as well, their answers would come from the old network
+        if (!ip_addr_cmp(&netifAddress, &s_DnsCacheNetifAddress))
+        {
+            for (int32_t i = 0; i < LLOS_DNS_CACHE_ENTRIES; i++)
+            {
+                s_DnsCache[i].State = LLOS_DNS_ENTRY_FREE;
+            }
+
+            ip_addr_copy(s_DnsCacheNetifAddress, netifAddress);
+        }
+
+        for (int32_t i = 0; i < LLOS_DNS_CACHE_ENTRIES; i++)
+        {
+            DnsCacheEntry* pEntry = &s_DnsCache[i];
+
+            if (pEntry->State == LLOS_DNS_ENTRY_RESOLVED && (int32_t)(pEntry->Expiry - sys_now()) <= 0)
+            {
+                pEntry->State = LLOS_DNS_ENTRY_FREE;
+            }
+
+            if (pEntry->State != LLOS_DNS_ENTRY_FREE && strcmp(pEntry->Name, name) == 0)
+            {
+                return pEntry;
+            }
+        }
+
+        return NULL;
+    }
+
+    // Picks a free entry, or else the least recently used resolved one. Must be called under SYS_ARCH_PROTECT.
+    static DnsCacheEntry* DnsCacheAllocate(const char* name)
+    {
+        DnsCacheEntry* pVictim = NULL;
+
+        for (int32_t i = 0; i < LLOS_DNS_CACHE_ENTRIES; i++)
+        {
+            DnsCacheEntry* pEntry = &s_DnsCache[i];
+
+            if (pEntry->State == LLOS_DNS_ENTRY_FREE)
+            {
+                pVictim = pEntry;
+                break;
+            }
+
+            if (pEntry->State == LLOS_DNS_ENTRY_RESOLVED && (pVictim == NULL || (int32_t)(pEntry->LastUsed - pVictim->LastUsed) < 0))
+            {
+                pVictim = pEntry;
+            }
+        }
+
+        if (pVictim != NULL)
+        {
+            strcpy(pVictim->Name, name);
+            pVictim->LastUsed = ++s_DnsCacheClock;
+        }
+
+        return pVictim;
+    }
+
+    static void DnsCacheStore(DnsCacheEntry* pEntry, const char* name, const ip_addr_t* pAddress)
+    {
+        SYS_ARCH_DECL_PROTECT(lev);
+        SYS_ARCH_PROTECT(lev);
+
+        // The entry may have been recycled for another name while the query was in flight
+        if (strcmp(pEntry->Name, name) == 0 && pEntry->State != LLOS_DNS_ENTRY_FREE)
+        {
+            if (pAddress != NULL)
+            {
+                ip_addr_copy(pEntry->Address, *pAddress);
+                pEntry->Expiry = sys_now() + LLOS_DNS_CACHE_TTL_MS;
+                pEntry->State  = LLOS_DNS_ENTRY_RESOLVED;
+            }
+            else
+            {
+                pEntry->State = LLOS_DNS_ENTRY_FREE;
+            }
+        }
+
+        SYS_ARCH_UNPROTECT(lev);
+    }
+
+    // Runs on the tcpip thread.
+    static void DnsFound(const char* name, ip_addr_t* ipaddr, void* callback_arg)
+    {
+        DnsCacheStore((DnsCacheEntry*)callback_arg, name, ipaddr);
+    }
+
+    // Runs on the tcpip thread, where the raw DNS API must be called.
+    static void DnsStartQuery(void* arg)
+    {
+        DnsCacheEntry* pEntry = (DnsCacheEntry*)arg;
+        char           name[LLOS_DNS_CACHE_NAME_LENGTH];
+        ip_addr_t      address;
+        err_t          err;
+
+        SYS_ARCH_DECL_PROTECT(lev);
+        SYS_ARCH_PROTECT(lev);
+
+        if (pEntry->State != LLOS_DNS_ENTRY_PENDING)
+        {
+            SYS_ARCH_UNPROTECT(lev);
+            return;
+        }
+
+        strcpy(name, pEntry->Name);
+
+        SYS_ARCH_UNPROTECT(lev);
+
+        err = dns_gethostbyname(name, &address, DnsFound, pEntry);
+
+        if (err == ERR_OK)
+        {
+            DnsCacheStore(pEntry, name, &address);
+        }
+        else if (err != ERR_INPROGRESS)
+        {
+            DnsCacheStore(pEntry, name, NULL);
+        }
+    }
+
+    static void CopyCanonicalName(char* canonicalName, uint32_t canonicalNameBufferSize, const char* name)
+    {
+        while (*name != '\0' && canonicalNameBufferSize > 1)
+        {
+            *canonicalName++ = *name++;
+            canonicalNameBufferSize--;
+        }
+
+        if (canonicalNameBufferSize > 0)
+        {
+            *canonicalName = '\0';
+        }
+    }
+
+    static int32_t ConvertHostName(char* nameBuffer, uint32_t nameBufferSize, uint16_t* name, uint32_t namelen)
+    {
+        if (name == NULL || namelen >= nameBufferSize)
         {
             return ERR_ARG;
         }
 
-        WStringToCharBuffer(nameBuffer, 256, name, namelen);
+        WStringToCharBuffer(nameBuffer, nameBufferSize, name, namelen);
         nameBuffer[namelen] = '\0';
 
-        addrinfo* addressInfo = NULL;
-        int32_t res = lwip_getaddrinfo(nameBuffer, NULL, NULL, &addressInfo);
+        return ERR_OK;
+    }
 
-        char* canonName = addressInfo->ai_canonname;
-        sockaddr* sockAddress = addressInfo->ai_addr;
+    int32_t LLOS_lwip_getaddrinfo(uint16_t* name, uint32_t namelen, char* canonicalName, uint32_t canonicalNameBufferSize, char* addresses, uint32_t addressBufferSize)
+    {
+        char           nameBuffer[256];
+        bool           cacheable;
+        DnsCacheEntry* pEntry;
+        ip_addr_t      cached;
 
-        while (*canonName != '\0' && canonicalNameBufferSize > 0)
+        if (ConvertHostName(nameBuffer, sizeof(nameBuffer), name, namelen) != ERR_OK)
         {
-            *canonicalName = *canonName;
-            canonName++;
-            canonicalName++;
-            canonicalNameBufferSize--;
+            return ERR_ARG;
+        }
+
+        if (canonicalName == NULL || addresses == NULL || addressBufferSize < sizeof(sockaddr_in))
+        {
+            return ERR_VAL;
+        }
+
+        cacheable = namelen < LLOS_DNS_CACHE_NAME_LENGTH;
+
+        if (cacheable)
+        {
+            SYS_ARCH_DECL_PROTECT(lev);
+            SYS_ARCH_PROTECT(lev);
+
+            pEntry = DnsCacheFind(nameBuffer);
+
+            if (pEntry != NULL && pEntry->State == LLOS_DNS_ENTRY_RESOLVED)
+            {
+                ip_addr_copy(cached, pEntry->Address);
+                pEntry->LastUsed = ++s_DnsCacheClock;
+            }
+            else
+            {
+                pEntry = NULL;
+            }
+
+            SYS_ARCH_UNPROTECT(lev);
+
+            if (pEntry != NULL)
+            {
+                sockaddr_in* pAddress = (sockaddr_in*)addresses;
+
+                std::memset(pAddress, 0, sizeof(sockaddr_in));
+                pAddress->sin_len         = sizeof(sockaddr_in);
+                pAddress->sin_family      = AF_INET;
+                inet_addr_from_ipaddr(&pAddress->sin_addr, &cached);
+
+                CopyCanonicalName(canonicalName, canonicalNameBufferSize, nameBuffer);
+
+                return ERR_OK;
+            }
+        }
+
+        //
+        // Miss (or still pending from an asynchronous lookup): resolve now, lwIP answers from its own table if the
+        // background query already completed there.
+        //
+        addrinfo* addressInfo = NULL;
+        int32_t   res         = lwip_getaddrinfo(nameBuffer, NULL, NULL, &addressInfo);
+
+        if (res != 0 || addressInfo == NULL || addressInfo->ai_addr == NULL)
+        {
+            if (addressInfo != NULL)
+            {
+                lwip_freeaddrinfo(addressInfo);
+            }
+
+            return (res != 0) ? res : ERR_VAL;
         }
-        
+
+        sockaddr* sockAddress = addressInfo->ai_addr;
+
         if (sockAddress->sa_len > addressBufferSize)
         {
+            lwip_freeaddrinfo(addressInfo);
             return ERR_VAL;
         }
 
+        CopyCanonicalName(canonicalName, canonicalNameBufferSize, (addressInfo->ai_canonname != NULL) ? addressInfo->ai_canonname : nameBuffer);
+
         std::memcpy(addresses, sockAddress, sockAddress->sa_len);
 
+        if (cacheable && sockAddress->sa_family == AF_INET)
+        {
+            ip_addr_t resolved;
+
+            SYS_ARCH_DECL_PROTECT(lev);
+            SYS_ARCH_PROTECT(lev);
+
+            pEntry = DnsCacheFind(nameBuffer);
+
+            if (pEntry == NULL)
+            {
+                pEntry = DnsCacheAllocate(nameBuffer);
+            }
+
+            if (pEntry != NULL)
+            {
+                inet_addr_to_ipaddr(&resolved, &((sockaddr_in*)sockAddress)->sin_addr);
+
+                ip_addr_copy(pEntry->Address, resolved);
+                pEntry->Expiry = sys_now() + LLOS_DNS_CACHE_TTL_MS;
+                pEntry->State  = LLOS_DNS_ENTRY_RESOLVED;
+            }
+
+            SYS_ARCH_UNPROTECT(lev);
+        }
+
+        lwip_freeaddrinfo(addressInfo);
+
         return res;
     }
 
+    //
+    // Returns 0 if the name is already cached, or too long to be cached at all, 1 if a background lookup is (now)
+    // in progress, or a negative lwIP error code.
+    //
+    int32_t LLOS_lwip_getaddrinfo_async(uint16_t* name, uint32_t namelen)
+    {
+        char           nameBuffer[LLOS_DNS_CACHE_NAME_LENGTH];
+        DnsCacheEntry* pEntry;
+        int32_t        result;
+
+        // Nothing to prefetch, LLOS_lwip_getaddrinfo resolves such names every time
+        if (name != NULL && namelen >= LLOS_DNS_CACHE_NAME_LENGTH)
+        {
+            return 0;
+        }
+
+        if (ConvertHostName(nameBuffer, sizeof(nameBuffer), name, namelen) != ERR_OK)
+        {
+            return ERR_ARG;
+        }
+
+        SYS_ARCH_DECL_PROTECT(lev);
+        SYS_ARCH_PROTECT(lev);
+
+        pEntry = DnsCacheFind(nameBuffer);
+
+        if (pEntry != NULL)
+        {
+            result = (pEntry->State == LLOS_DNS_ENTRY_RESOLVED) ? 0 : 1;
+            pEntry = NULL;
+        }
+        else
+        {
+            pEntry = DnsCacheAllocate(nameBuffer);
+            result = (pEntry != NULL) ? 1 : ERR_MEM;
+
+            if (pEntry != NULL)
+            {
+                pEntry->State = LLOS_DNS_ENTRY_PENDING;
+            }
+        }
+
+        SYS_ARCH_UNPROTECT(lev);
+
+        if (pEntry != NULL && tcpip_callback_with_block(DnsStartQuery, pEntry, 0) != ERR_OK)
+        {
+            DnsCacheStore(pEntry, nameBuffer, NULL);
+            result = ERR_MEM;
+        }
+
+        return result;
+    }
+
     int32_t LLOS_lwip_shutdown(int32_t socket, int32_t how)
     {
         return lwip_shutdown(socket, how);
@@ -139,12 +840,27 @@ extern "C"
 
     int32_t LLOS_lwip_sendto(int32_t socket, char* buf, int32_t count, int32_t flags, int32_t time_ms, void* address, uint32_t tolen)
     {
+        if (!WaitForTimedSend(socket, flags, time_ms))
+        {
+            return -1;
+        }
+
         return lwip_sendto(socket, buf, count, flags, (sockaddr*)address, tolen);
     }
 
 
     int32_t LLOS_lwip_recvfrom(int32_t socket, char* buf, int32_t count, int32_t flags, int32_t time_ms, void* address, uint32_t* fromlen)
     {
+        if (time_ms > 0)
+        {
+            if (WaitForTimedIo(socket, LLOS_LWIP_SELECT_READ, flags, time_ms) < 0)
+            {
+                return -1;
+            }
+
+            flags |= MSG_DONTWAIT;
+        }
+
         return lwip_recvfrom(socket, buf, count, flags, (sockaddr*)address, fromlen);
     }
 
@@ -163,7 +879,20 @@ extern "C"
 
     int32_t LLOS_lwip_getsockopt(int32_t socket, int32_t level, int32_t optname, char* buf, uint32_t* optlen)
     {
-        return lwip_getsockopt(socket, level, optname, buf, optlen);
+        int32_t result = lwip_getsockopt(socket, level, optname, buf, optlen);
+
+        // Reading SO_ERROR clears it, lwIP's error goes first
+        if (result == 0 && level == SOL_SOCKET && optname == SO_ERROR && socket < FD_SETSIZE)
+        {
+            if (*(int*)buf == 0)
+            {
+                *(int*)buf = s_SendErrors[socket];
+            }
+
+            s_SendErrors[socket] = 0;
+        }
+
+        return result;
     }
 
 
@@ -172,10 +901,107 @@ extern "C"
         return lwip_setsockopt(socket, level, optname, buf, optlen);
     }
 
-    // TODO
+    //
+    // Socket.Poll semantics: true if the socket is ready for 'mode' within 'microSeconds' (negative waits forever).
+    // A socket lwIP reports as invalid is treated as ready, so that the following call fails with the actual error
+    // instead of the caller polling forever.
+    //
     bool LLOS_lwip_poll(int32_t socket, int32_t mode, int32_t microSeconds)
     {
-        return true;
+        return WaitForSocket(socket, mode, microSeconds) != 0;
+    }
+
+    // Keeps the first *pCount sockets of the array that are set in 'set', in order, and updates the count.
+    static void CompactSockets(int32_t* sockets, int32_t* pCount, fd_set* set)
+    {
+        int32_t kept = 0;
+
+        if (sockets == NULL || pCount == NULL)
+        {
+            return;
+        }
+
+        for (int32_t i = 0; i < *pCount; i++)
+        {
+            if (FD_ISSET(sockets[i], set))
+            {
+                sockets[kept++] = sockets[i];
+            }
+        }
+
+        *pCount = kept;
+    }
+
+    static int32_t FillSocketSet(int32_t* sockets, int32_t count, fd_set* set, int32_t* pMaxSocket)
+    {
+        FD_ZERO(set);
+
+        for (int32_t i = 0; i < count; i++)
+        {
+            if (sockets[i] < 0 || sockets[i] >= FD_SETSIZE)
+            {
+                return -1;
+            }
+
+            FD_SET(sockets[i], set);
+
+            if (sockets[i] > *pMaxSocket)
+            {
+                *pMaxSocket = sockets[i];
+            }
+        }
+
+        return 0;
+    }
+
+    //
+    // Waits until any of the given sockets is ready, so that a single thread can service many connections. On return
+    // each array only holds the sockets that are ready, and its count is updated; arrays may be NULL.
+    // Returns the number of ready sockets, 0 on timeout or -1 on error.
+    //
+    int32_t LLOS_lwip_select(int32_t* readSockets, int32_t* readCount, int32_t* writeSockets, int32_t* writeCount, int32_t* errorSockets, int32_t* errorCount, int32_t microSeconds)
+    {
+        fd_set         readSet;
+        fd_set         writeSet;
+        fd_set         errorSet;
+        struct timeval timeout;
+        int32_t        maxSocket = -1;
+        int32_t        result;
+
+        int32_t nRead  = (readSockets  != NULL && readCount  != NULL) ? *readCount  : 0;
+        int32_t nWrite = (writeSockets != NULL && writeCount != NULL) ? *writeCount : 0;
+        int32_t nError = (errorSockets != NULL && errorCount != NULL) ? *errorCount : 0;
+
+        if (FillSocketSet(readSockets , nRead , &readSet , &maxSocket) < 0 ||
+            FillSocketSet(writeSockets, nWrite, &writeSet, &maxSocket) < 0 ||
+            FillSocketSet(errorSockets, nError, &errorSet, &maxSocket) < 0)
+        {
+            return -1;
+        }
+
+        result = lwip_select(maxSocket + 1,
+            (nRead  > 0) ? &readSet  : NULL,
+            (nWrite > 0) ? &writeSet : NULL,
+            (nError > 0) ? &errorSet : NULL,
+            MicrosecondsToTimeval(microSeconds, &timeout));
+
+        if (result < 0)
+        {
+            return result;
+        }
+
+        if (result == 0)
+        {
+            FD_ZERO(&readSet);
+            FD_ZERO(&writeSet);
+            FD_ZERO(&errorSet);
+        }
+
+        CompactSockets(readSockets , readCount , &readSet );
+        CompactSockets(writeSockets, writeCount, &writeSet);
+        CompactSockets(errorSockets, errorCount, &errorSet);
+
+        return result;
     }
 
 
@@ -16,8 +16,65 @@ extern "C"
         LLOS_SPI_Callback         Callback;
         LLOS_Context              Context;
         LLOS_SPI_ControllerConfig Config;
+        volatile bool             AsyncPending;
+        LLOS_SPI_Action           AsyncAction;
     } LLOS_MbedSpi;
 
+    static void CompleteAsyncTransfer(LLOS_MbedSpi* pCtx, LLOS_SPI_Action action)
+    {
+        pCtx->AsyncPending = false;
+
+        if (pCtx->Callback != NULL)
+        {
+            pCtx->Callback(pCtx, pCtx->Context, action);
+        }
+    }
+
+#if DEVICE_SPI_ASYNCH
+
+    //
+    // The HAL asynchronous transfer takes a plain ISR address (mbed itself uses CThunk to bind it to the SPI object), 
+    // so we keep one trampoline per SPI module and look the channel up from there.
+    //
+#define LLOS_SPI_MAX_ASYNC_MODULES 4
+
+    static LLOS_MbedSpi* s_asyncChannels[LLOS_SPI_MAX_ASYNC_MODULES];
+
+    static void HandleAsyncInterrupt(uint32_t module)
+    {
+        LLOS_MbedSpi* pCtx = s_asyncChannels[module];
+        uint32_t      events;
+
+        if (pCtx == NULL)
+        {
+            return;
+        }
+
+        events = spi_irq_handler_asynch(&pCtx->Spi) & SPI_EVENT_ALL;
+
+        if (events != 0)
+        {
+            s_asyncChannels[module] = NULL;
+
+            CompleteAsyncTransfer(pCtx, (events & SPI_EVENT_COMPLETE) != 0 ? pCtx->AsyncAction : LLOS_SPI_ActionError);
+        }
+    }
+
+    static void HandleAsyncInterrupt0(void) { HandleAsyncInterrupt(0); }
+    static void HandleAsyncInterrupt1(void) { HandleAsyncInterrupt(1); }
+    static void HandleAsyncInterrupt2(void) { HandleAsyncInterrupt(2); }
+    static void HandleAsyncInterrupt3(void) { HandleAsyncInterrupt(3); }
+
+    static void (* const s_asyncHandlers[LLOS_SPI_MAX_ASYNC_MODULES])(void) =
+    {
+        HandleAsyncInterrupt0,
+        HandleAsyncInterrupt1,
+        HandleAsyncInterrupt2,
+        HandleAsyncInterrupt3,
+    };
+
+#endif // DEVICE_SPI_ASYNCH
+
     HRESULT LLOS_SPI_Initialize(uint32_t mosi, uint32_t miso, uint32_t sclk, uint32_t chipSelect, LLOS_Context* ppChannel, LLOS_SPI_ControllerConfig** ppConfiguration )
     {
         LLOS_MbedSpi *pCtx;
@@ -37,6 +94,8 @@ extern "C"
         spi_init(&pCtx->Spi, (PinName)mosi, (PinName)miso, (PinName)sclk, (PinName)chipSelect);
         pCtx->Callback = NULL;
         pCtx->Context = NULL;
+        pCtx->AsyncPending = false;
+        pCtx->AsyncAction = LLOS_SPI_ActionTransfer;
 
         *ppChannel = (LLOS_Context)pCtx;
         *ppConfiguration = &pCtx->Config;
@@ -46,6 +105,15 @@ extern "C"
 
     VOID LLOS_SPI_Uninitialize(LLOS_Context channel)
     {
+        LLOS_MbedSpi *pCtx = (LLOS_MbedSpi*)channel;
+
+        if (pCtx != NULL && pCtx->AsyncPending)
+        {
+            pCtx->Callback = NULL;
+
+            LLOS_SPI_AbortAsync(channel);
+        }
+
         FreeFromManagedHeap(channel);
     }
 
@@ -88,11 +156,22 @@ extern "C"
 
     HRESULT LLOS_SPI_SetCallback(LLOS_Context channel, LLOS_SPI_Callback request, LLOS_Context context)
     {
-        LLOS__UNREFERENCED_PARAMETER(channel);
-        LLOS__UNREFERENCED_PARAMETER(request);
-        LLOS__UNREFERENCED_PARAMETER(context);
+        LLOS_MbedSpi *pCtx = (LLOS_MbedSpi*)channel;
 
-        return LLOS_E_NOTIMPL;
+        if (pCtx == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        if (pCtx->AsyncPending)
+        {
+            return LLOS_E_BUSY;
+        }
+
+        pCtx->Callback = request;
+        pCtx->Context = context;
+
+        return S_OK;
     }
 
     HRESULT LLOS_SPI_SetFrequency(LLOS_Context channel, uint32_t frequencyHz)
@@ -140,7 +219,7 @@ extern "C"
 
             if (ibNextWord >= rxStartOffset && ibRx < rxCount)
             {
-                if (wordSizeBytes == 8)
+                if (wordSizeBytes == 1)
                 {
                     rxBuffer[ibRx + rxOffset] = (uint8_t)response;
                 }
@@ -233,7 +312,138 @@ extern "C"
             return LLOS_E_INVALID_PARAMETER;
         }
 
-        *isBusy = spi_busy( &pCtx->Spi ) != 0;
+        *isBusy = pCtx->AsyncPending || spi_busy( &pCtx->Spi ) != 0;
+
+        return S_OK;
+    }
+
+    HRESULT LLOS_SPI_TransferAsync(LLOS_Context channel, uint8_t* txBuffer, int32_t txOffset, int32_t txCount, uint8_t* rxBuffer, int32_t rxOffset, int32_t rxCount)
+    {
+        LLOS_MbedSpi   *pCtx = (LLOS_MbedSpi*)channel;
+        LLOS_SPI_Action action;
+
+        if (pCtx == NULL || (txBuffer == NULL && rxBuffer == NULL))
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        if (!pCtx->Config.Master)
+        {
+            return LLOS_E_INVALID_OPERATION;
+        }
+
+        if (pCtx->AsyncPending)
+        {
+            return LLOS_E_BUSY;
+        }
+
+        if (txBuffer == NULL)
+        {
+            txCount = 0;
+            action  = LLOS_SPI_ActionRead;
+        }
+        else if (rxBuffer == NULL)
+        {
+            rxCount = 0;
+            action  = LLOS_SPI_ActionWrite;
+        }
+        else
+        {
+            action  = LLOS_SPI_ActionTransfer;
+        }
+
+        pCtx->AsyncAction  = action;
+        pCtx->AsyncPending = true;
+
+#if DEVICE_SPI_ASYNCH
+        {
+            int32_t  wordSizeBytes = (pCtx->Config.WordSize >> 3);
+            uint32_t module        = spi_get_module(&pCtx->Spi);
+
+            if (module < LLOS_SPI_MAX_ASYNC_MODULES)
+            {
+                s_asyncChannels[module] = pCtx;
+
+                //
+                // The HAL picks DMA if the target supports it and falls back to the SPI interrupt otherwise.
+                //
+                spi_master_transfer(
+                    &pCtx->Spi,
+                    txBuffer != NULL ? &txBuffer[txOffset] : NULL, txCount / wordSizeBytes,
+                    rxBuffer != NULL ? &rxBuffer[rxOffset] : NULL, rxCount / wordSizeBytes,
+                    (uint8_t)pCtx->Config.WordSize,
+                    (uint32_t)s_asyncHandlers[module],
+                    SPI_EVENT_ALL,
+                    DMA_USAGE_OPPORTUNISTIC);
+
+                return S_OK;
+            }
+        }
+#endif // DEVICE_SPI_ASYNCH
+
+        //
+        // No asynchronous support in the HAL for this target: run the transfer to completion and signal it right away,
+        // so callers see the same completion protocol on every board.
+        //
+        {
+            HRESULT hr;
+
+            if (action == LLOS_SPI_ActionWrite)
+            {
+                hr = LLOS_SPI_Write(channel, txBuffer, txOffset, txCount);
+            }
+            else if (action == LLOS_SPI_ActionRead)
+            {
+                //
+                // LLOS_SPI_Transfer clocks out zeros once the TX buffer is exhausted.
+                //
+                uint8_t fill = 0;
+
+                hr = LLOS_SPI_Transfer(channel, &fill, 0, 0, rxBuffer, rxOffset, rxCount, 0);
+            }
+            else
+            {
+                hr = LLOS_SPI_Transfer(channel, txBuffer, txOffset, txCount, rxBuffer, rxOffset, rxCount, 0);
+            }
+
+            CompleteAsyncTransfer(pCtx, SUCCEEDED(hr) ? action : LLOS_SPI_ActionError);
+        }
+
+        return S_OK;
+    }
+
+    HRESULT LLOS_SPI_AbortAsync(LLOS_Context channel)
+    {
+        LLOS_MbedSpi *pCtx = (LLOS_MbedSpi*)channel;
+
+        if (pCtx == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        //
+        // The completion interrupt may have won the race, in which case there is nothing left to abort.
+        //
+        if (pCtx->AsyncPending)
+        {
+#if DEVICE_SPI_ASYNCH
+            uint32_t module = spi_get_module(&pCtx->Spi);
+
+            spi_abort_asynch(&pCtx->Spi);
+
+            if (module < LLOS_SPI_MAX_ASYNC_MODULES)
+            {
+                s_asyncChannels[module] = NULL;
+            }
+#endif // DEVICE_SPI_ASYNCH
+
+            CompleteAsyncTransfer(pCtx, LLOS_SPI_ActionError);
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
 
         return S_OK;
     }
@@ -2,36 +2,125 @@
 // Copyright (c) Microsoft Corporation.    All rights reserved.
 //
 
-#include "mbed_helpers.h" 
+#include "mbed_helpers.h"
 #include "llos_system_timer.h"
+#include "llos_timer_wheel.h"
 #include "llos_memory.h"
 //--//
 
+//
+// All LLOS timers live in a single hierarchical timer wheel, and only the earliest wheel event is programmed into
+// the us_ticker. This keeps scheduling and cancelling O(1) no matter how many timers are armed, instead of walking
+// the sorted mbed ticker event list on every insert.
+//
+// The us_ticker is 32 bits wide, so it is extended to 64 bits here; the ticker is never programmed further out than
+// LLOS_MBED_TIMER_MAX_PROGRAM_US so that it is read at least once per wrap-around, even when no timer is armed.
+//
+#define LLOS_MBED_TIMER_MIN_PROGRAM_US  2
+#define LLOS_MBED_TIMER_MAX_PROGRAM_US  (1u << 30)
+
 extern "C"
 {
     typedef struct LLOS_MbedTimer
     {
-        LLOS_Context   Context;
-        ticker_event_t TickerEvent;
+        LLOS_TimerWheelEntry       Entry;       // Must be first, the wheel hands it back to us on expiry
+        LLOS_SYSTEM_TIMER_Callback Callback;
+        LLOS_Context               Context;
     } LLOS_MbedTimer;
 
-    static LLOS_SYSTEM_TIMER_Callback s_TimerCallback = NULL;
     static const ticker_data_t *s_pTickerData = get_us_ticker_data();
 
-    // This is used to call back into the Kernel using a WellKnownMethod
-    static void MbedInterruptHandler(uint32_t id)
+    static ticker_event_t  s_TickerEvent;
+    static LLOS_TimerWheel s_TimerWheel;
+    static bool            s_Initialized   = false;
+    static bool            s_Dispatching   = false;
+    static uint64_t        s_Ticks         = 0;
+    static uint32_t        s_LastTicker    = 0;
+    static uint64_t        s_ProgrammedFor = LLOS_TIMER_WHEEL_NEVER;
+
+    // Must be called with interrupts disabled.
+    static uint64_t ReadTicks()
     {
-        if (s_TimerCallback != NULL)
+        uint32_t now = us_ticker_read();
+
+        s_Ticks     += (uint32_t)(now - s_LastTicker);
+        s_LastTicker = now;
+
+        return s_Ticks;
+    }
+
+    // Must be called with interrupts disabled.
+    static void ProgramTicker()
+    {
+        uint64_t next = LLOS_TimerWheel_NextEvent(&s_TimerWheel);
+        uint64_t now  = ReadTicks();
+        uint32_t delay;
+
+        if (next <= now)
+        {
+            delay = LLOS_MBED_TIMER_MIN_PROGRAM_US;
+        }
+        else if (next - now > LLOS_MBED_TIMER_MAX_PROGRAM_US)
+        {
+            delay = LLOS_MBED_TIMER_MAX_PROGRAM_US;
+        }
+        else
         {
-            LLOS_MbedTimer *pCtx = (LLOS_MbedTimer*)id;
+            delay = (uint32_t)(next - now);
 
-            if (pCtx != NULL)
+            if (delay < LLOS_MBED_TIMER_MIN_PROGRAM_US)
             {
-                uint64_t ticks = us_ticker_read();
-
-                s_TimerCallback(pCtx->Context, ticks);
+                delay = LLOS_MBED_TIMER_MIN_PROGRAM_US;
             }
         }
+
+        s_ProgrammedFor = now + delay;
+
+        ticker_remove_event(s_pTickerData, &s_TickerEvent);
+        ticker_insert_event(s_pTickerData, &s_TickerEvent, s_LastTicker + delay, 0);
+    }
+
+    static void FireTimer(LLOS_TimerWheelEntry* entry, uint64_t now, void* context)
+    {
+        LLOS_MbedTimer *pCtx = (LLOS_MbedTimer*)entry;
+
+        LLOS__UNREFERENCED_PARAMETER(context);
+
+        if (pCtx->Callback != NULL)
+        {
+            pCtx->Callback(pCtx->Context, now);
+        }
+    }
+
+    // This is used to call back into the Kernel using a WellKnownMethod, or into other native timer clients (e.g. ADC sampling)
+    static void MbedInterruptHandler(uint32_t id)
+    {
+        LLOS__UNREFERENCED_PARAMETER(id);
+
+        //
+        // Callbacks run with interrupts masked; they only post to the kernel or restart a conversion, and
+        // rescheduling from within a callback must not race with another interrupt touching the wheel.
+        //
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        s_Dispatching = true;
+
+        LLOS_TimerWheel_Advance(&s_TimerWheel, ReadTicks(), FireTimer, NULL);
+
+        s_Dispatching = false;
+
+        ProgramTicker();
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+    }
+
+    // Used by the idle loop to decide how deep it may sleep. Must be called with interrupts disabled.
+    uint64_t LLOS_MBED_TIMER_GetMicrosecondsToNextEvent()
+    {
+        uint64_t now = ReadTicks();
+
+        return (s_ProgrammedFor > now) ? (s_ProgrammedFor - now) : 0;
     }
 
     HRESULT LLOS_SYSTEM_TIMER_SetTicks(uint64_t value)
@@ -43,9 +132,18 @@ extern "C"
 
     uint64_t LLOS_SYSTEM_TIMER_GetTicks(LLOS_Context timerContext)
     {
+        uint64_t ticks;
+
         LLOS__UNREFERENCED_PARAMETER(timerContext);
 
-        return us_ticker_read();
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        ticks = ReadTicks();
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
+        return ticks;
     }
 
     uint64_t LLOS_SYSTEM_TIMER_GetTimerFrequency(LLOS_Context timerContext)
@@ -65,7 +163,7 @@ extern "C"
         {
             return LLOS_E_INVALID_PARAMETER;
         }
-        
+
         pCtx = (LLOS_MbedTimer*)AllocateFromManagedHeap(sizeof(LLOS_MbedTimer));
 
         if (pCtx == NULL)
@@ -73,13 +171,30 @@ extern "C"
             return LLOS_E_OUT_OF_MEMORY;
         }
 
-        s_TimerCallback = callback;
+        LLOS_TimerWheel_InitializeEntry(&pCtx->Entry);
 
-        us_ticker_init();
+        pCtx->Callback = callback;
+        pCtx->Context = callbackContext;
 
-        ticker_set_handler(s_pTickerData, MbedInterruptHandler);
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
 
-        pCtx->Context = callbackContext;
+        if (!s_Initialized)
+        {
+            us_ticker_init();
+
+            ticker_set_handler(s_pTickerData, MbedInterruptHandler);
+
+            s_LastTicker = us_ticker_read();
+
+            LLOS_TimerWheel_Initialize(&s_TimerWheel, s_Ticks);
+
+            ProgramTicker();
+
+            s_Initialized = true;
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
 
         *pTimer = pCtx;
 
@@ -92,7 +207,14 @@ extern "C"
 
         if (pCtx != NULL)
         {
-            ticker_remove_event(s_pTickerData, &pCtx->TickerEvent);
+            LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+            __disable_irq();
+
+            LLOS_TimerWheel_Cancel(&s_TimerWheel, &pCtx->Entry);
+
+            LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
+            FreeFromManagedHeap(pCtx);
         }
     }
 
@@ -100,22 +222,41 @@ extern "C"
     {
         LLOS_MbedTimer *pCtx = (LLOS_MbedTimer*)pTimer;
 
-        if (pCtx == NULL || microsecondsFromNow > 0xFFFFFFFFuLL)
+        if (pCtx == NULL)
         {
             return LLOS_E_INVALID_PARAMETER;
         }
 
-        if (microsecondsFromNow < 2)
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        if (microsecondsFromNow == LLOS_SYSTEM_TIMER_NEVER)
         {
-            microsecondsFromNow = 2;
+            LLOS_TimerWheel_Cancel(&s_TimerWheel, &pCtx->Entry);
         }
+        else
+        {
+            uint64_t now    = ReadTicks();
+            uint64_t expiry = now + microsecondsFromNow;
+
+            if (expiry < now)
+            {
+                expiry = LLOS_TIMER_WHEEL_NEVER - 1;
+            }
 
-        LLOS__PRESERVE_PRIMASK_STATE_M0_1__SAVE();
+            LLOS_TimerWheel_Schedule(&s_TimerWheel, &pCtx->Entry, expiry);
 
-        ticker_remove_event(s_pTickerData, &pCtx->TickerEvent);
-        ticker_insert_event(s_pTickerData, &pCtx->TickerEvent, us_ticker_read() + (uint32_t)microsecondsFromNow, (uint32_t)pTimer);
+            //
+            // Only touch the ticker if this timer is now the earliest event; a cancelled or later timer at most
+            // causes one spurious interrupt. While dispatching, the handler reprograms once all callbacks ran.
+            //
+            if (!s_Dispatching && LLOS_TimerWheel_NextEvent(&s_TimerWheel) < s_ProgrammedFor)
+            {
+                ProgramTicker();
+            }
+        }
 
-        LLOS__PRESERVE_PRIMASK_STATE_M0_1__RESTORE();
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
 
         return S_OK;
     }
@@ -3,9 +3,27 @@
 //
 
 #include "mbed_helpers.h" 
+#include "sleep_api.h"
+#include "llos_clock.h"
+#include "llos_system_timer.h"
+#include "llos_idle_window.h"
 
 //--//
 
+//
+// Tickless idle. When the kernel switches to the idle thread it already cancels the quantum timer and arms the system
+// timer for the earliest wait timeout, so the idle loop only has to keep SysTick from waking the core and go to sleep.
+// Deep sleep gates the clocks of most peripherals, and on several targets that includes the timer behind us_ticker, so
+// it is opt-in per target through LLOS_MBED_IDLE_DEEPSLEEP and only used when the next timer event is far enough away.
+//
+#ifndef LLOS_MBED_IDLE_DEEPSLEEP
+#define LLOS_MBED_IDLE_DEEPSLEEP         0
+#endif
+
+#ifndef LLOS_MBED_IDLE_DEEPSLEEP_MIN_US
+#define LLOS_MBED_IDLE_DEEPSLEEP_MIN_US  10000
+#endif
+
 extern "C"
 {
 
@@ -96,4 +114,87 @@ extern "C"
         __ASM volatile ("BX        LR");
 #endif
     }
+
+    //
+    // Idle
+    //
+
+    static LLOS_IdleWindow s_IdleWindow;
+    static uint64_t        s_IdleTotal = 0;
+
+    VOID LLOS_CLOCK_Idle()
+    {
+        uint32_t ctrl;
+        uint64_t start;
+        uint64_t end;
+
+        //
+        // WFI wakes up on a pending interrupt even with PRIMASK set, so the handler only runs once the SysTick
+        // state is restored and the idle time is accounted.
+        //
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        ctrl = SysTick->CTRL;
+
+        SysTick->CTRL = ctrl & ~(SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk);
+
+        start = LLOS_SYSTEM_TIMER_GetTicks(NULL);
+
+#if LLOS_MBED_IDLE_DEEPSLEEP && DEVICE_SLEEP
+        if (LLOS_MBED_TIMER_GetMicrosecondsToNextEvent() >= LLOS_MBED_IDLE_DEEPSLEEP_MIN_US)
+        {
+            deepsleep();
+        }
+        else
+#endif
+        {
+#if DEVICE_SLEEP
+            sleep();
+#else
+            __DSB();
+            __WFI();
+#endif
+        }
+
+        end = LLOS_SYSTEM_TIMER_GetTicks(NULL);
+
+        s_IdleTotal += end - start;
+
+        LLOS_IdleWindow_Account(&s_IdleWindow, start, end);
+
+        SysTick->CTRL = ctrl;
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+    }
+
+    HRESULT LLOS_CLOCK_GetIdleStatistics(uint32_t* pIdleMicroseconds, uint32_t* pActiveMicroseconds, uint64_t* pTotalIdleMicroseconds)
+    {
+        if (pIdleMicroseconds == NULL || pActiveMicroseconds == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        //
+        // Close the current window if a busy system has not been through the idle loop for a while.
+        //
+        uint64_t now = LLOS_SYSTEM_TIMER_GetTicks(NULL);
+
+        LLOS_IdleWindow_Account(&s_IdleWindow, now, now);
+
+        *pIdleMicroseconds   = s_IdleWindow.LastIdle;
+        *pActiveMicroseconds = s_IdleWindow.LastActive;
+
+        if (pTotalIdleMicroseconds != NULL)
+        {
+            *pTotalIdleMicroseconds = s_IdleTotal;
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
+        return S_OK;
+    }
 }
@@ -2,10 +2,39 @@
 // Copyright (c) Microsoft Corporation.    All rights reserved.
 //
 
-#include "mbed_helpers.h" 
+#include "mbed_helpers.h"
+#include "llos_thread.h"
+#include "llos_system_timer.h"
+#include "llos_memory.h"
+#include "llos_thread_benchmark.h"
+#include <string.h>
 
 //--//
 
+//
+// Native threads for the llos_thread.h contract.
+//
+// PendSV and SVC belong to the managed scheduler on this port, so native threads are scheduled cooperatively
+// on top of it: they run inside the time slice of the managed thread that drives them and switch only in
+// Yield, Wait, Sleep, Signal (when waking a higher priority thread) and on exit. The switch saves the same
+// software frame as PendSV_Handler (R4-R11, plus S16-S31 with an FPU) but is entered with a plain call, so
+// a managed context switch in the middle of a native thread is transparent: PendSV simply stacks whatever
+// native stack is active on PSP.
+//
+// The first caller into this layer becomes the 'main' native thread. Scheduling is strict priority, FIFO
+// within a priority. All scheduler state is protected by masking interrupts, so LLOS_THREAD_Signal and the
+// wait timeouts are safe from interrupt handlers. Only one managed thread should drive the native threads.
+//
+#define LLOS_MBED_THREAD_PRIORITIES         (ThreadPriority_Highest + 1)
+#define LLOS_MBED_THREAD_MIN_STACK_SIZE     256
+#define LLOS_MBED_THREAD_DEFAULT_STACK_SIZE 1024
+
+#if defined(__FPU_USED) && (__FPU_USED != 0)
+#define LLOS_MBED_THREAD_FRAME_WORDS        (16 + 9)        // S16-S31, R4-R11, LR
+#else
+#define LLOS_MBED_THREAD_FRAME_WORDS        9               // R4-R11, LR
+#endif
+
 extern "C"
 {
     __attribute__((section(".managed_exception_thread")))
@@ -26,45 +55,866 @@ extern "C"
         return top - limit;
     }
 
-	//
-	// Threading 
-    // TODO TODO TODO: Eliminate this portion or convert the Win32 port over
-	//
+    //--//
+
+    typedef enum LlosThreadState
+    {
+        LlosThreadState_Created = 0,
+        LlosThreadState_Ready,
+        LlosThreadState_Running,
+        LlosThreadState_Blocked,
+        LlosThreadState_Finished,
+    } LlosThreadState;
+
+    typedef struct LlosThread
+    {
+        uint32_t*            StackPointer;      // Must be first, saved by LLOS_MBED_THREAD_SwitchContext
+        LLOS_ThreadEntry     Entry;
+        LLOS_Context         Param;
+        LLOS_Context         ManagedThread;
+        uint8_t*             Stack;             // NULL for the main thread and for caller provided stacks
+        LLOS_ThreadPriority  Priority;
+        LlosThreadState      State;
+        struct LlosThread*   Next;              // Ready queue link
+        struct LlosThread*   Waiter;            // Thread blocked in LLOS_THREAD_Wait on this thread
+        struct LlosThread*   WaitingOn;         // Thread this thread is blocked in LLOS_THREAD_Wait on
+        LLOS_Context         Timer;             // Timed wait timeout, allocated with the thread
+        volatile uint32_t    Signaled;
+    } LlosThread;
 
-	void* CreateNativeContext(void* entryPoint, void* stack, int32_t stackSize)
-	{
-        LLOS__UNREFERENCED_PARAMETER(entryPoint);
-        LLOS__UNREFERENCED_PARAMETER(stack);
-        LLOS__UNREFERENCED_PARAMETER(stackSize);
+    typedef struct LlosReadyQueue
+    {
+        LlosThread* Head;
+        LlosThread* Tail;
+    } LlosReadyQueue;
 
-		return NULL;
-	}
+    //
+    // Exported by the managed scheduler (ContextSwitchTimer in ModelForCortexM).
+    //
+    extern void         LLOS_MBED_THREAD_YieldManagedThread();
+    extern LLOS_Context LLOS_MBED_THREAD_GetManagedThread();
 
-	void Yield(void* nativeContext)
-	{
-        LLOS__UNREFERENCED_PARAMETER(nativeContext);
-	}
+    static LlosThread     s_MainThread;
+    static LlosThread*    s_pCurrent = NULL;
+    static LlosReadyQueue s_Ready[LLOS_MBED_THREAD_PRIORITIES];
 
-	void Retire(void* nativeContext)
-	{
-        LLOS__UNREFERENCED_PARAMETER(nativeContext);
-	}
+    //
+    // Saves the callee-saved registers on the current stack, stores SP in *pSaveSP, then resumes the context
+    // saved at newSP. Must be called with interrupts disabled.
+    //
+    __attribute__((naked))
+    static void LLOS_MBED_THREAD_SwitchContext(uint32_t** pSaveSP, uint32_t* newSP)
+    {
+#if __CORTEX_M0
+        __ASM volatile ("PUSH     {R4-R7, LR}");
+        __ASM volatile ("MOV      R4,       R8");
+        __ASM volatile ("MOV      R5,       R9");
+        __ASM volatile ("MOV      R6,      R10");
+        __ASM volatile ("MOV      R7,      R11");
+        __ASM volatile ("PUSH     {R4-R7}");
 
-	void SwitchToContext(void* nativeContext)
-	{
-        LLOS__UNREFERENCED_PARAMETER(nativeContext);
-	}
+        __ASM volatile ("MOV      R2,       SP");
+        __ASM volatile ("STR      R2,     [R0]");
+        __ASM volatile ("MOV      SP,       R1");
 
-	void* GetPriority(void* nativeContext)
-	{
-        LLOS__UNREFERENCED_PARAMETER(nativeContext);
+        __ASM volatile ("POP      {R4-R7}");
+        __ASM volatile ("MOV      R8,       R4");
+        __ASM volatile ("MOV      R9,       R5");
+        __ASM volatile ("MOV      R10,      R6");
+        __ASM volatile ("MOV      R11,      R7");
+        __ASM volatile ("POP      {R4-R7, PC}");
+#else
+        __ASM volatile ("PUSH     {R4-R11, LR}");
+#if defined(__FPU_USED) && (__FPU_USED != 0)
+        __ASM volatile ("VPUSH    {S16-S31}");
+#endif
+
+        __ASM volatile ("MOV      R2, SP");
+        __ASM volatile ("STR      R2, [R0]");
+        __ASM volatile ("MOV      SP, R1");
+
+#if defined(__FPU_USED) && (__FPU_USED != 0)
+        __ASM volatile ("VPOP     {S16-S31}");
+#endif
+        __ASM volatile ("POP      {R4-R11, PC}");
+#endif
+    }
+
+    //--//
+
+    static void EnsureInitialized()
+    {
+        if (s_pCurrent == NULL)
+        {
+            s_MainThread.Priority = ThreadPriority_Normal;
+            s_MainThread.State    = LlosThreadState_Running;
+            s_pCurrent            = &s_MainThread;
+        }
+    }
+
+    // Must be called with interrupts disabled.
+    static void MakeReady(LlosThread* pThread)
+    {
+        LlosReadyQueue* pQueue = &s_Ready[pThread->Priority];
+
+        pThread->State = LlosThreadState_Ready;
+        pThread->Next  = NULL;
+
+        if (pQueue->Tail != NULL)
+        {
+            pQueue->Tail->Next = pThread;
+        }
+        else
+        {
+            pQueue->Head = pThread;
+        }
+
+        pQueue->Tail = pThread;
+    }
+
+    // Must be called with interrupts disabled.
+    static void RemoveReady(LlosThread* pThread)
+    {
+        LlosReadyQueue* pQueue = &s_Ready[pThread->Priority];
+        LlosThread*     pPrev  = NULL;
+        LlosThread*     pNode  = pQueue->Head;
+
+        while (pNode != NULL && pNode != pThread)
+        {
+            pPrev = pNode;
+            pNode = pNode->Next;
+        }
+
+        if (pNode == NULL)
+        {
+            return;
+        }
+
+        if (pPrev != NULL)
+        {
+            pPrev->Next = pNode->Next;
+        }
+        else
+        {
+            pQueue->Head = pNode->Next;
+        }
+
+        if (pQueue->Tail == pNode)
+        {
+            pQueue->Tail = pPrev;
+        }
+
+        pNode->Next = NULL;
+    }
+
+    // Must be called with interrupts disabled.
+    static LlosThread* DequeueReady()
+    {
+        int32_t priority;
+
+        for (priority = LLOS_MBED_THREAD_PRIORITIES - 1; priority >= 0; priority--)
+        {
+            LlosReadyQueue* pQueue  = &s_Ready[priority];
+            LlosThread*     pThread = pQueue->Head;
+
+            if (pThread != NULL)
+            {
+                pQueue->Head = pThread->Next;
+
+                if (pQueue->Head == NULL)
+                {
+                    pQueue->Tail = NULL;
+                }
+
+                pThread->Next = NULL;
+
+                return pThread;
+            }
+        }
+
+        return NULL;
+    }
+
+    //
+    // Runs the highest priority ready thread. The current thread must already be queued, blocked or finished.
+    // When nothing is ready, the managed thread driving us gives the rest of its time slice to the other managed
+    // threads; only if that did not make anything ready either do we wait for an interrupt (a timeout or a signal
+    // from a handler). Must be called with interrupts disabled; returns when the current thread is resumed.
+    //
+    static void Reschedule()
+    {
+        LlosThread* pCurrent = s_pCurrent;
+        LlosThread* pNext;
+        bool        yielded  = false;
+
+        while ((pNext = DequeueReady()) == NULL)
+        {
+            if (yielded)
+            {
+                __WFI();
+                __enable_irq();
+                __ISB();
+            }
+            else
+            {
+                __enable_irq();
+                LLOS_MBED_THREAD_YieldManagedThread();
+            }
+
+            __disable_irq();
+
+            yielded = !yielded;
+        }
+
+        pNext->State = LlosThreadState_Running;
+
+        if (pNext != pCurrent)
+        {
+            s_pCurrent = pNext;
+
+            LLOS_MBED_THREAD_SwitchContext(&pCurrent->StackPointer, pNext->StackPointer);
+        }
+    }
+
+    static void ThreadStart()
+    {
+        LlosThread* pThread = s_pCurrent;
+
+        //
+        // We got here from LLOS_MBED_THREAD_SwitchContext, where interrupts are always masked.
+        //
+        __enable_irq();
+
+        pThread->Entry(pThread->Param);
+
+        __disable_irq();
+
+        pThread->State = LlosThreadState_Finished;
+
+        Reschedule();
+
+        // Not reached, a finished thread is never made ready again.
+        while (true)
+        {
+        }
+    }
+
+    static void TimeoutCallback(LLOS_Context context, uint64_t ticks)
+    {
+        LlosThread* pThread = (LlosThread*)context;
+
+        LLOS__UNREFERENCED_PARAMETER(ticks);
+
+        if (pThread->State == LlosThreadState_Blocked)
+        {
+            MakeReady(pThread);
+        }
+    }
+
+    //
+    // Timers come from the managed heap, so they are allocated with interrupts enabled: when the thread is created,
+    // and for the main thread, which is not created here, on its first timed wait before interrupts are disabled.
+    //
+    static HRESULT AllocateThreadTimer(LlosThread* pThread)
+    {
+        if (pThread->Timer != NULL)
+        {
+            return S_OK;
+        }
+
+        return LLOS_SYSTEM_TIMER_AllocateTimer(TimeoutCallback, pThread, 0, &pThread->Timer);
+    }
+
+    static void EnsureMainThreadTimer()
+    {
+        if (s_pCurrent == NULL || s_pCurrent == &s_MainThread)
+        {
+            AllocateThreadTimer(&s_MainThread);
+        }
+    }
+
+    // Blocks the current thread for at most timeoutMs (negative is infinite). Must be called with interrupts disabled.
+    static HRESULT Block(int32_t timeoutMs)
+    {
+        LlosThread* pCurrent = s_pCurrent;
+
+        if (timeoutMs >= 0)
+        {
+            if (pCurrent->Timer == NULL)
+            {
+                return LLOS_E_OUT_OF_MEMORY;
+            }
+
+            LLOS_SYSTEM_TIMER_ScheduleTimer(pCurrent->Timer, (uint64_t)timeoutMs * 1000);
+        }
+
+        pCurrent->State = LlosThreadState_Blocked;
+
+        Reschedule();
+
+        if (pCurrent->Timer != NULL)
+        {
+            LLOS_SYSTEM_TIMER_ScheduleTimer(pCurrent->Timer, LLOS_SYSTEM_TIMER_NEVER);
+        }
+
+        return S_OK;
+    }
+
+    //
+    // Unlinks the thread from the waits it takes part in, so that nothing points at it once it is finished.
+    // A thread waiting on it is woken up and fails its wait. Must be called with interrupts disabled.
+    //
+    static void DetachWaits(LlosThread* pThread)
+    {
+        LlosThread* pWaiter = pThread->Waiter;
+
+        if (pThread->WaitingOn != NULL)
+        {
+            pThread->WaitingOn->Waiter = NULL;
+            pThread->WaitingOn         = NULL;
+        }
+
+        if (pWaiter != NULL)
+        {
+            pThread->Waiter    = NULL;
+            pWaiter->WaitingOn = NULL;
+
+            if (pWaiter->State == LlosThreadState_Blocked)
+            {
+                MakeReady(pWaiter);
+            }
+        }
+    }
+
+    static HRESULT InitializeThread(LlosThread* pThread, LLOS_ThreadEntry threadEntry, LLOS_Context threadParameter, uint8_t* stack, uint32_t stackSize)
+    {
+        uint32_t* top;
+        uint32_t  i;
+
+        if (stackSize < LLOS_MBED_THREAD_MIN_STACK_SIZE)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        //
+        // Lay out the frame LLOS_MBED_THREAD_SwitchContext unstacks, with ThreadStart as the return address and
+        // the stack pointer 8 byte aligned once the frame is popped.
+        //
+        top = (uint32_t*)(((uint32_t)stack + stackSize) & ~7u) - LLOS_MBED_THREAD_FRAME_WORDS;
+
+        for (i = 0; i < LLOS_MBED_THREAD_FRAME_WORDS; i++)
+        {
+            top[i] = 0;
+        }
+
+        top[LLOS_MBED_THREAD_FRAME_WORDS - 1] = (uint32_t)ThreadStart;
+
+        pThread->StackPointer = top;
+        pThread->Entry        = threadEntry;
+        pThread->Param        = threadParameter;
+        pThread->Priority     = ThreadPriority_Normal;
+        pThread->State        = LlosThreadState_Created;
+
+        return S_OK;
+    }
+
+    //--//
+
+    HRESULT LLOS_THREAD_CreateThread(LLOS_ThreadEntry threadEntry, LLOS_Context threadParameter, LLOS_Context managedThread, uint32_t stackSize, LLOS_Handle* threadHandle)
+    {
+        LlosThread* pThread;
+        HRESULT     hr;
+
+        if (threadEntry == NULL || threadHandle == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        if (stackSize == 0)
+        {
+            stackSize = LLOS_MBED_THREAD_DEFAULT_STACK_SIZE;
+        }
+
+        pThread = (LlosThread*)AllocateFromManagedHeap(sizeof(LlosThread));
+
+        if (pThread == NULL)
+        {
+            return LLOS_E_OUT_OF_MEMORY;
+        }
+
+        memset(pThread, 0, sizeof(LlosThread));
+
+        pThread->Stack = (uint8_t*)AllocateFromManagedHeap(stackSize);
+
+        if (pThread->Stack == NULL)
+        {
+            FreeFromManagedHeap(pThread);
+            return LLOS_E_OUT_OF_MEMORY;
+        }
+
+        hr = InitializeThread(pThread, threadEntry, threadParameter, pThread->Stack, stackSize);
+
+        if (SUCCEEDED(hr))
+        {
+            hr = AllocateThreadTimer(pThread);
+        }
+
+        if (FAILED(hr))
+        {
+            FreeFromManagedHeap(pThread->Stack);
+            FreeFromManagedHeap(pThread);
+            return hr;
+        }
+
+        pThread->ManagedThread = managedThread;
+
+        *threadHandle = pThread;
+
+        return S_OK;
+    }
+
+    HRESULT LLOS_THREAD_DeleteThread(LLOS_Handle threadHandle)
+    {
+        LlosThread* pThread = (LlosThread*)threadHandle;
+        HRESULT     hr      = S_OK;
+
+        if (pThread == NULL || pThread == &s_MainThread)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        EnsureInitialized();
+
+        if (pThread == s_pCurrent)
+        {
+            hr = LLOS_E_INVALID_OPERATION;
+        }
+        else
+        {
+            //
+            // A thread that has not finished is simply never resumed again.
+            //
+            if (pThread->State == LlosThreadState_Ready)
+            {
+                RemoveReady(pThread);
+            }
+
+            pThread->State = LlosThreadState_Finished;
+
+            DetachWaits(pThread);
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
+        if (FAILED(hr))
+        {
+            return hr;
+        }
+
+        if (pThread->Timer != NULL)
+        {
+            LLOS_SYSTEM_TIMER_FreeTimer(pThread->Timer);
+        }
 
-		return 0;
-	}
+        if (pThread->Stack != NULL)
+        {
+            FreeFromManagedHeap(pThread->Stack);
+        }
 
-	void SetPriority(void* nativeContext, void* priority)
-	{
+        FreeFromManagedHeap(pThread);
+
+        return S_OK;
+    }
+
+    HRESULT LLOS_THREAD_Start(LLOS_Handle threadHandle)
+    {
+        LlosThread* pThread = (LlosThread*)threadHandle;
+        HRESULT     hr      = S_OK;
+
+        if (pThread == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        EnsureInitialized();
+
+        if (pThread->State != LlosThreadState_Created)
+        {
+            hr = LLOS_E_INVALID_OPERATION;
+        }
+        else
+        {
+            MakeReady(pThread);
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
+        return hr;
+    }
+
+    HRESULT LLOS_THREAD_Yield(VOID)
+    {
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        EnsureInitialized();
+
+        MakeReady(s_pCurrent);
+
+        Reschedule();
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
+        return S_OK;
+    }
+
+    HRESULT LLOS_THREAD_Signal(LLOS_Handle threadHandle)
+    {
+        LlosThread* pThread = (LlosThread*)threadHandle;
+
+        if (pThread == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        EnsureInitialized();
+
+        pThread->Signaled = 1;
+
+        if (pThread->Waiter != NULL && pThread->Waiter->State == LlosThreadState_Blocked)
+        {
+            LlosThread* pWaiter = pThread->Waiter;
+
+            MakeReady(pWaiter);
+
+            //
+            // Hand over right away if we woke up a more important thread, unless we are in a handler or the
+            // scheduler is idle (signaled from another managed thread while the native threads are all blocked).
+            //
+            if (__get_IPSR() == 0 && s_pCurrent->State == LlosThreadState_Running && pWaiter->Priority > s_pCurrent->Priority)
+            {
+                MakeReady(s_pCurrent);
+                Reschedule();
+            }
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
+        return S_OK;
+    }
+
+    HRESULT LLOS_THREAD_Wait(LLOS_Handle threadHandle, int32_t timeoutMs)
+    {
+        LlosThread* pThread = (LlosThread*)threadHandle;
+        HRESULT     hr      = S_OK;
+
+        if (pThread == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        if (timeoutMs > 0)
+        {
+            EnsureMainThreadTimer();
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        EnsureInitialized();
+
+        if (pThread->Signaled == 0)
+        {
+            if (timeoutMs == 0)
+            {
+                hr = LLOS_E_TIMEOUT;
+            }
+            else if (pThread->Waiter != NULL)
+            {
+                hr = LLOS_E_BUSY;
+            }
+            else
+            {
+                LlosThread* pCurrent = s_pCurrent;
+
+                pThread->Waiter     = pCurrent;
+                pCurrent->WaitingOn = pThread;
+
+                hr = Block(timeoutMs);
+
+                if (pCurrent->WaitingOn == NULL)
+                {
+                    //
+                    // The thread was deleted while we were waiting on it, it must not be touched anymore.
+                    //
+                    hr      = LLOS_E_OBJECT_DISPOSED;
+                    pThread = NULL;
+                }
+                else
+                {
+                    pThread->Waiter     = NULL;
+                    pCurrent->WaitingOn = NULL;
+
+                    if (SUCCEEDED(hr) && pThread->Signaled == 0)
+                    {
+                        hr = LLOS_E_TIMEOUT;
+                    }
+                }
+            }
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            pThread->Signaled = 0;
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
+        return hr;
+    }
+
+    VOID LLOS_THREAD_Sleep(int32_t timeoutMilliseconds)
+    {
+        if (timeoutMilliseconds == 0)
+        {
+            LLOS_THREAD_Yield();
+            return;
+        }
+
+        if (timeoutMilliseconds > 0)
+        {
+            EnsureMainThreadTimer();
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        EnsureInitialized();
+
+        Block(timeoutMilliseconds);
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+    }
+
+    HRESULT LLOS_THREAD_GetCurrentThread(LLOS_Context* managedThread)
+    {
+        if (managedThread == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        *managedThread = (s_pCurrent != NULL) ? s_pCurrent->ManagedThread : NULL;
+
+        //
+        // The main thread, and any thread created without one, runs on behalf of the managed thread driving us.
+        //
+        if (*managedThread == NULL)
+        {
+            *managedThread = LLOS_MBED_THREAD_GetManagedThread();
+        }
+
+        return *managedThread != NULL ? S_OK : LLOS_E_FAIL;
+    }
+
+    HRESULT LLOS_THREAD_SetPriority(LLOS_Handle threadHandle, LLOS_ThreadPriority threadPriority)
+    {
+        LlosThread* pThread = (LlosThread*)threadHandle;
+
+        if (pThread == NULL || threadPriority < ThreadPriority_Lowest || threadPriority > ThreadPriority_Highest)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        EnsureInitialized();
+
+        if (pThread->State == LlosThreadState_Ready)
+        {
+            RemoveReady(pThread);
+
+            pThread->Priority = threadPriority;
+
+            MakeReady(pThread);
+        }
+        else
+        {
+            pThread->Priority = threadPriority;
+        }
+
+        //
+        // Lowering our own priority below a ready thread gives up the processor.
+        //
+        if (pThread == s_pCurrent && __get_IPSR() == 0)
+        {
+            MakeReady(s_pCurrent);
+            Reschedule();
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+
+        return S_OK;
+    }
+
+    HRESULT LLOS_THREAD_GetPriority(LLOS_Handle threadHandle, LLOS_ThreadPriority* threadPriority)
+    {
+        LlosThread* pThread = (LlosThread*)threadHandle;
+
+        if (pThread == NULL || threadPriority == NULL)
+        {
+            return LLOS_E_INVALID_PARAMETER;
+        }
+
+        *threadPriority = pThread->Priority;
+
+        return S_OK;
+    }
+
+    //
+    // The scheduler benchmarks shared with the other ports, for Test/mbed/simple (THREAD_PERF). The 'threads'
+    // argument only applies to LLOS_THREAD_BENCHMARK_YIELD.
+    //
+    HRESULT LLOS_THREAD_RunBenchmark(uint32_t benchmark, uint32_t threads, uint32_t iterations, uint64_t* pElapsedUs)
+    {
+        switch (benchmark)
+        {
+        case LLOS_THREAD_BENCHMARK_SIGNAL_WAIT:
+            return LLOS_THREAD_BenchmarkSignalWait(iterations, pElapsedUs);
+
+        case LLOS_THREAD_BENCHMARK_YIELD:
+            return LLOS_THREAD_BenchmarkYield(threads, iterations, pElapsedUs);
+
+        default:
+            return LLOS_E_INVALID_PARAMETER;
+        }
+    }
+
+    //--//
+
+    //
+    // RTOS extensibility hooks of the CortexM3OnMBED processor context (THREADING_RTOS), on top of the
+    // native threads above. The managed side owns the stack.
+    //
+
+    void* CreateNativeContext(void* entryPoint, void* stack, int32_t stackSize)
+    {
+        LlosThread* pThread;
+
+        if (entryPoint == NULL || stack == NULL || stackSize <= 0)
+        {
+            return NULL;
+        }
+
+        pThread = (LlosThread*)AllocateFromManagedHeap(sizeof(LlosThread));
+
+        if (pThread == NULL)
+        {
+            return NULL;
+        }
+
+        memset(pThread, 0, sizeof(LlosThread));
+
+        if (FAILED(InitializeThread(pThread, (LLOS_ThreadEntry)entryPoint, NULL, (uint8_t*)stack, (uint32_t)stackSize)) ||
+            FAILED(AllocateThreadTimer(pThread)))
+        {
+            FreeFromManagedHeap(pThread);
+            return NULL;
+        }
+
+        return pThread;
+    }
+
+    void Yield(void* nativeContext)
+    {
         LLOS__UNREFERENCED_PARAMETER(nativeContext);
-        LLOS__UNREFERENCED_PARAMETER(priority);
-	}
-}
\ No newline at end of file
+
+        LLOS_THREAD_Yield();
+    }
+
+    void Retire(void* nativeContext)
+    {
+        LlosThread* pThread = (LlosThread*)nativeContext;
+
+        if (pThread == NULL)
+        {
+            return;
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        EnsureInitialized();
+
+        if (pThread->State == LlosThreadState_Ready)
+        {
+            RemoveReady(pThread);
+        }
+
+        pThread->State = LlosThreadState_Finished;
+
+        DetachWaits(pThread);
+
+        if (pThread == s_pCurrent)
+        {
+            Reschedule();
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+    }
+
+    void SwitchToContext(void* nativeContext)
+    {
+        LlosThread* pThread = (LlosThread*)nativeContext;
+
+        if (pThread == NULL)
+        {
+            return;
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__SAVE();
+        __disable_irq();
+
+        EnsureInitialized();
+
+        if (pThread != s_pCurrent && pThread->State != LlosThreadState_Finished)
+        {
+            LlosThread* pCurrent = s_pCurrent;
+
+            if (pThread->State == LlosThreadState_Ready)
+            {
+                RemoveReady(pThread);
+            }
+
+            MakeReady(pCurrent);
+
+            pThread->State = LlosThreadState_Running;
+            s_pCurrent     = pThread;
+
+            LLOS_MBED_THREAD_SwitchContext(&pCurrent->StackPointer, pThread->StackPointer);
+        }
+
+        LLOS__PRESERVE_PRIMASK_STATE__RESTORE();
+    }
+
+    void* GetPriority(void* nativeContext)
+    {
+        LlosThread* pThread = (LlosThread*)nativeContext;
+
+        return (pThread != NULL) ? (void*)pThread->Priority : (void*)ThreadPriority_Normal;
+    }
+
+    void SetPriority(void* nativeContext, void* priority)
+    {
+        LLOS_THREAD_SetPriority(nativeContext, (LLOS_ThreadPriority)(uint32_t)priority);
+    }
+}
@@ -0,0 +1,203 @@
+//
+// Host test of the fused copy and checksum (lwip/lwip-sys/arch/checksum.c, portable path) against lwIP's
+// reference checksum: every source and destination alignment, lengths around the unrolled loop sizes,
+// then random offsets and lengths. The copy must be exact and must not write past the destination.
+//
+//   ChecksumTest [iterations]
+//
+
+#include "HostTest.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include <vector>
+
+extern "C" uint16_t lwip_arch_chksum_copy(void* pDest, const void* pSource, uint16_t length);
+
+//
+// lwip_standard_chksum, LWIP_CHKSUM_ALGORITHM 1, from lwIP 1.4.0 core/ipv4/inet_chksum.c. The sum is
+// taken over big endian halfwords and returned swapped, which makes it the sum of native halfwords
+// whatever the alignment of the data.
+//
+static uint16_t lwip_standard_chksum(const void* dataptr, uint16_t len)
+{
+    uint32_t       acc      = 0;
+    uint16_t       src;
+    const uint8_t* octetptr = (const uint8_t*)dataptr;
+
+    while (len > 1)
+    {
+        src  = (uint16_t)((*octetptr) << 8);
+        octetptr++;
+        src |= (*octetptr);
+        octetptr++;
+        acc += src;
+        len -= 2;
+    }
+
+    if (len > 0)
+    {
+        src  = (uint16_t)((*octetptr) << 8);
+        acc += src;
+    }
+
+    acc = (acc >> 16) + (acc & 0x0000ffffUL);
+
+    if ((acc & 0xffff0000UL) != 0)
+    {
+        acc = (acc >> 16) + (acc & 0x0000ffffUL);
+    }
+
+    return __builtin_bswap16((uint16_t)acc);
+}
+
+static uint64_t s_seed = 0x2545F4914F6CDD1Dull;
+
+static uint32_t NextRandom()
+{
+    s_seed ^= s_seed << 13;
+    s_seed ^= s_seed >> 7;
+    s_seed ^= s_seed << 17;
+
+    return (uint32_t)(s_seed >> 16);
+}
+
+static double NowSeconds()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//--//
+
+static const uint32_t c_MaxLength = 4096;
+static const uint32_t c_Slack     = 16;
+static const uint8_t  c_Guard     = 0xA5;
+
+static uint8_t s_source[c_MaxLength + c_Slack] __attribute__((aligned(16)));
+static uint8_t s_dest  [c_MaxLength + 2 * c_Slack] __attribute__((aligned(16)));
+
+static void Check(uint32_t srcOffset, uint32_t dstOffset, uint32_t length)
+{
+    const uint8_t* src = s_source + srcOffset;
+    uint8_t*       dst = s_dest + c_Slack + dstOffset;
+
+    memset(s_dest, c_Guard, sizeof(s_dest));
+
+    uint16_t sum = lwip_arch_chksum_copy(dst, src, (uint16_t)length);
+
+    HOST_CHECK(memcmp(dst, src, length) == 0);
+
+    for (uint8_t* p = s_dest; p < dst; p++)
+    {
+        HOST_CHECK(*p == c_Guard);
+    }
+
+    for (uint8_t* p = dst + length; p < s_dest + sizeof(s_dest); p++)
+    {
+        HOST_CHECK(*p == c_Guard);
+    }
+
+    if (sum != lwip_standard_chksum(src, (uint16_t)length))
+    {
+        fprintf(stderr, "src+%u dst+%u len %u: 0x%04x, expected 0x%04x\n", srcOffset, dstOffset, length, sum, lwip_standard_chksum(src, (uint16_t)length));
+        exit(1);
+    }
+}
+
+static void TestAlignments()
+{
+    for (uint32_t srcOffset = 0; srcOffset < 8; srcOffset++)
+    {
+        for (uint32_t dstOffset = 0; dstOffset < 8; dstOffset++)
+        {
+            for (uint32_t length = 0; length <= 80; length++)
+            {
+                Check(srcOffset, dstOffset, length);
+            }
+
+            Check(srcOffset, dstOffset, 1460);
+            Check(srcOffset, dstOffset, c_MaxLength);
+        }
+    }
+}
+
+// All ones data drives the sum through every carry.
+static void TestCarries()
+{
+    memset(s_source, 0xFF, sizeof(s_source));
+
+    for (uint32_t offset = 0; offset < 4; offset++)
+    {
+        Check(offset, 0, c_MaxLength);
+        Check(offset, 1, c_MaxLength - 1);
+    }
+
+    for (uint32_t i = 0; i < sizeof(s_source); i++)
+    {
+        s_source[i] = (uint8_t)NextRandom();
+    }
+}
+
+static void TestRandomized(uint32_t iterations)
+{
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        Check(NextRandom() % c_Slack, NextRandom() % c_Slack, NextRandom() % (c_MaxLength + 1));
+    }
+}
+
+// Not a pass/fail criterion, for comparing against the board numbers (Program_Test__ChecksumPerf.cs).
+static void Measure()
+{
+    const uint32_t    rounds = 20000;
+    volatile uint32_t sink   = 0;
+    double            start;
+    double            separate;
+    double            fused;
+
+    start = NowSeconds();
+
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        memcpy(s_dest, s_source, 1460);
+        sink += lwip_standard_chksum(s_dest, 1460);
+    }
+
+    separate = NowSeconds() - start;
+    start    = NowSeconds();
+
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        sink += lwip_arch_chksum_copy(s_dest, s_source, 1460);
+    }
+
+    fused = NowSeconds() - start;
+
+    printf("1460 bytes: memcpy + reference checksum %.2f GB/s, fused %.2f GB/s\n",
+           rounds * 1460.0 / separate / 1e9, rounds * 1460.0 / fused / 1e9);
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t iterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 200000;
+
+    for (uint32_t i = 0; i < sizeof(s_source); i++)
+    {
+        s_source[i] = (uint8_t)NextRandom();
+    }
+
+    TestAlignments();
+    TestCarries();
+    TestRandomized(iterations);
+    Measure();
+
+    printf("ChecksumTest: PASS\n");
+
+    return 0;
+}
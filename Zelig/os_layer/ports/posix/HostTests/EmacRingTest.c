@@ -0,0 +1,821 @@
+//
+// Host test of the STM32F4 zero-copy descriptor rings (lwip/lwip-eth/arch/TARGET_STM/stm32f4_emac_ring.h),
+// driven by a simulated DMA engine that walks the descriptor chains like the MAC does: it only touches
+// descriptors it owns, reads and writes the buffers they point at, and hands them back by clearing OWN.
+//
+// The transmit path mirrors stm32f4_low_level_output. Frames the stack may still modify are scribbled
+// over right after they are queued, TCP headers as a retransmission would; the DMA must still send
+// the bytes that were queued.
+//
+
+#include "HostTest.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "stm32f4xx_hal_eth.h"
+#include "MockPbuf.h"
+
+#include "stm32f4_emac_config.h"
+#include "stm32f4_emac_ring.h"
+
+#define FRAME_MAX      1514
+#define SENT_MAX       64
+
+static ETH_DMADescTypeDef       s_rxDesc[STM32F4_NUM_RX_DESCS];
+static ETH_DMADescTypeDef       s_txDesc[STM32F4_NUM_TX_DESCS];
+static struct stm32f4_rx_buf    s_rxBufs[STM32F4_NUM_RX_BUFS];
+static struct stm32f4_emac_ring s_ring;
+
+static uint32_t s_rxBufsFreed;
+static uint32_t s_bounced;
+static uint32_t s_headersCopied;
+
+static uint64_t s_seed = 0x2545F4914F6CDD1Dull;
+
+static uint32_t NextRandom(void)
+{
+    s_seed ^= s_seed << 13;
+    s_seed ^= s_seed >> 7;
+    s_seed ^= s_seed << 17;
+
+    return (uint32_t)(s_seed >> 16);
+}
+
+//--//
+
+//
+// Simulated DMA engine. Like the MAC it keeps its own position in each ring, starting at the table
+// base, and follows Buffer2NextDescAddr from there.
+//
+
+typedef struct Frame
+{
+    uint16_t Length;
+    uint8_t  Data[FRAME_MAX];
+} Frame;
+
+static ETH_DMADescTypeDef* s_dmaTx;
+static ETH_DMADescTypeDef* s_dmaRx;
+static Frame               s_dmaFrame;         // Frame being gathered from TX descriptors
+static int                 s_dmaInFrame;
+static Frame               s_sent[SENT_MAX];
+static uint32_t            s_sentCount;
+
+static ETH_DMADescTypeDef* Dma_Next(ETH_DMADescTypeDef* desc)
+{
+    return (ETH_DMADescTypeDef*)(uintptr_t)desc->Buffer2NextDescAddr;
+}
+
+static void Dma_Reset(void)
+{
+    s_dmaTx      = s_txDesc;
+    s_dmaRx      = s_rxDesc;
+    s_dmaInFrame = 0;
+    s_sentCount  = 0;
+}
+
+// Processes up to 'budget' TX descriptors, stopping at the first one it does not own. Returns how many.
+static uint32_t Dma_Transmit(uint32_t budget)
+{
+    uint32_t done = 0;
+
+    while (done < budget && (s_dmaTx->Status & ETH_DMATXDESC_OWN) != 0)
+    {
+        uint32_t status = s_dmaTx->Status;
+        uint32_t len    = s_dmaTx->ControlBufferSize & ETH_DMATXDESC_TBS1;
+
+        HOST_CHECK((status & ETH_DMATXDESC_TCH) != 0);
+        HOST_CHECK(((status & ETH_DMATXDESC_FS) != 0) == !s_dmaInFrame);
+        HOST_CHECK(len > 0 && s_dmaFrame.Length * (uint32_t)s_dmaInFrame + len <= FRAME_MAX);
+
+        if (!s_dmaInFrame)
+        {
+            s_dmaFrame.Length = 0;
+            s_dmaInFrame      = 1;
+        }
+
+        memcpy(&s_dmaFrame.Data[s_dmaFrame.Length], (const void*)(uintptr_t)s_dmaTx->Buffer1Addr, len);
+        s_dmaFrame.Length += (uint16_t)len;
+
+        if ((status & ETH_DMATXDESC_LS) != 0)
+        {
+            HOST_CHECK((status & ETH_DMATXDESC_IC) != 0);
+            HOST_CHECK(s_sentCount < SENT_MAX);
+
+            s_sent[s_sentCount++] = s_dmaFrame;
+            s_dmaInFrame          = 0;
+        }
+
+        s_dmaTx->Status = status & ~ETH_DMATXDESC_OWN;
+        s_dmaTx         = Dma_Next(s_dmaTx);
+        done++;
+    }
+
+    return done;
+}
+
+// Receives one frame into the next RX descriptor. Returns 0 if the DMA had no buffer for it.
+static int Dma_Receive(const uint8_t* data, uint32_t len, uint32_t errors)
+{
+    uint32_t size;
+
+    if ((s_dmaRx->Status & ETH_DMARXDESC_OWN) == 0)
+    {
+        return 0;
+    }
+
+    size = s_dmaRx->ControlBufferSize & ETH_DMARXDESC_RBS1;
+
+    HOST_CHECK((s_dmaRx->ControlBufferSize & ETH_DMARXDESC_RCH) != 0);
+    HOST_CHECK(s_dmaRx->Buffer1Addr != 0 && size >= len + 4);
+
+    memcpy((void*)(uintptr_t)s_dmaRx->Buffer1Addr, data, len);
+
+    // The length reported includes the CRC.
+    s_dmaRx->Status = ETH_DMARXDESC_FS | ETH_DMARXDESC_LS | errors | ((len + 4) << ETH_DMARXDESC_FRAMELENGTHSHIFT);
+    s_dmaRx         = Dma_Next(s_dmaRx);
+
+    return 1;
+}
+
+//--//
+
+static void OnRxBufFreed(void)
+{
+    // Called from pbuf_free, after the buffer went back on the free list.
+    HOST_CHECK(MockProtect_Depth() == 0);
+
+    s_rxBufsFreed++;
+}
+
+static void ResetRing(void)
+{
+    HOST_CHECK(MockPbuf_Live() == 0);
+
+    memset(s_rxBufs, 0, sizeof(s_rxBufs));
+
+    stm32f4_ring_init(&s_ring, s_rxDesc, s_txDesc, s_rxBufs, STM32F4_NUM_RX_BUFS);
+    s_ring.rx_buf_freed = OnRxBufFreed;
+
+    Dma_Reset();
+
+    s_rxBufsFreed   = 0;
+    s_bounced       = 0;
+    s_headersCopied = 0;
+}
+
+// Same decisions as stm32f4_low_level_output, without the waiting.
+static err_t Transmit(struct pbuf* p)
+{
+    struct pbuf* bounce = NULL;
+    struct pbuf* header = NULL;
+    u32_t        skip;
+    u32_t        segments;
+    err_t        err    = ERR_OK;
+
+    skip     = stm32f4_ring_tx_copy_len(p);
+    segments = (skip < p->tot_len) ? stm32f4_ring_tx_segments(p, skip) : 0;
+
+    if (segments > 0 && skip > 0)
+    {
+        header = pbuf_alloc(PBUF_RAW, (u16_t)skip, PBUF_RAM);
+        HOST_CHECK(header != NULL);
+        HOST_CHECK(stm32f4_ring_tx_dma_safe(header->payload));
+
+        memcpy(header->payload, p->payload, skip);
+
+        s_headersCopied++;
+    }
+
+    if (segments == 0)
+    {
+        bounce = pbuf_alloc(PBUF_RAW, p->tot_len, PBUF_RAM);
+        HOST_CHECK(bounce != NULL);
+        HOST_CHECK(pbuf_copy(bounce, p) == ERR_OK);
+
+        p        = bounce;
+        skip     = 0;
+        segments = stm32f4_ring_tx_segments(p, 0);
+
+        HOST_CHECK(segments == 1);
+
+        s_bounced++;
+    }
+
+    if (stm32f4_ring_tx_reclaim(&s_ring) < segments)
+    {
+        err = ERR_MEM;
+    }
+    else
+    {
+        stm32f4_ring_tx_queue(&s_ring, header, p, skip, segments, 0);
+    }
+
+    if (bounce != NULL)
+    {
+        pbuf_free(bounce);
+    }
+
+    if (header != NULL)
+    {
+        pbuf_free(header);
+    }
+
+    return err;
+}
+
+//--//
+
+#define FRAME_ARP      0
+#define FRAME_UDP      1
+#define FRAME_TCP      2
+
+#define IP_OFFSET      SIZEOF_ETH_HDR
+#define TCP_OFFSET     (IP_OFFSET + IP_HLEN)
+#define TCP_SEQ_OFFSET (TCP_OFFSET + 4)
+#define HEADERS_LEN    (TCP_OFFSET + TCP_HLEN)
+
+static void BuildFrame(uint8_t* frame, uint32_t len, int kind)
+{
+    uint32_t i;
+
+    HOST_CHECK(len > HEADERS_LEN && len <= FRAME_MAX);
+
+    for (i = 0; i < len; i++)
+    {
+        frame[i] = (uint8_t)NextRandom();
+    }
+
+    if (kind == FRAME_ARP)
+    {
+        frame[12] = 0x08;
+        frame[13] = 0x06;
+    }
+    else
+    {
+        frame[12] = 0x08;
+        frame[13] = 0x00;
+        frame[IP_OFFSET]      = 0x45;
+        frame[IP_OFFSET + 9]  = (kind == FRAME_TCP) ? IP_PROTO_TCP : IP_PROTO_UDP;
+        frame[TCP_OFFSET + 12] = (uint8_t)((TCP_HLEN / 4) << 4);
+    }
+}
+
+// Copies the frame into a chain of pbufs, split at the given offsets.
+static struct pbuf* MakeChain(const uint8_t* frame, uint32_t len, const uint32_t* splits, uint32_t count)
+{
+    struct pbuf* head = NULL;
+    uint32_t     start = 0;
+    uint32_t     i;
+
+    for (i = 0; i <= count; i++)
+    {
+        uint32_t     end = (i < count) ? splits[i] : len;
+        struct pbuf* q   = pbuf_alloc(PBUF_RAW, (u16_t)(end - start), PBUF_RAM);
+
+        HOST_CHECK(q != NULL);
+
+        memcpy(q->payload, frame + start, end - start);
+
+        if (head == NULL)
+        {
+            head = q;
+        }
+        else
+        {
+            pbuf_cat(head, q);
+        }
+
+        start = end;
+    }
+
+    return head;
+}
+
+static void CheckSent(uint32_t index, const uint8_t* frame, uint32_t len)
+{
+    HOST_CHECK(index < s_sentCount);
+    HOST_CHECK(s_sent[index].Length == len);
+    HOST_CHECK(memcmp(s_sent[index].Data, frame, len) == 0);
+}
+
+static void DrainTx(void)
+{
+    while (Dma_Transmit(STM32F4_NUM_TX_DESCS) > 0)
+    {
+    }
+
+    HOST_CHECK(stm32f4_ring_tx_reclaim(&s_ring) == STM32F4_NUM_TX_DESCS);
+}
+
+//--//
+
+static void TestTxZeroCopy(void)
+{
+    static uint8_t frame[FRAME_MAX];
+    uint32_t       split = IP_OFFSET + IP_HLEN + 8;
+    u32_t          first;
+    struct pbuf*   p;
+
+    ResetRing();
+
+    BuildFrame(frame, 300, FRAME_UDP);
+
+    p = MakeChain(frame, 300, &split, 1);
+
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == 0);
+    HOST_CHECK(stm32f4_ring_tx_segments(p, 0) == 2);
+
+    first = s_ring.tx_fill_idx;
+
+    HOST_CHECK(Transmit(p) == ERR_OK);
+    HOST_CHECK(s_bounced == 0);
+
+    // Both descriptors point straight at the payloads, and the ring holds the chain.
+    HOST_CHECK(s_txDesc[first].Buffer1Addr == (uint32_t)(uintptr_t)p->payload);
+    HOST_CHECK(s_txDesc[(first + 1) % STM32F4_NUM_TX_DESCS].Buffer1Addr == (uint32_t)(uintptr_t)p->next->payload);
+    HOST_CHECK(p->ref == 2);
+
+    pbuf_free(p);
+
+    HOST_CHECK(MockPbuf_Live() == 2);
+
+    // Nothing is released until the DMA is done with the last segment.
+    HOST_CHECK(Dma_Transmit(1) == 1);
+    HOST_CHECK(stm32f4_ring_tx_reclaim(&s_ring) == STM32F4_NUM_TX_DESCS - 1);
+    HOST_CHECK(MockPbuf_Live() == 2);
+
+    DrainTx();
+
+    CheckSent(0, frame, 300);
+    HOST_CHECK(MockPbuf_Live() == 0);
+}
+
+// Scribbles over the Ethernet, IP and TCP headers, as a retransmission rewrites them in place.
+static void RewriteHeaders(struct pbuf* p)
+{
+    uint32_t i = 0;
+
+    for (; p != NULL && i < HEADERS_LEN; p = p->next)
+    {
+        uint32_t n;
+
+        for (n = 0; n < p->len && i < HEADERS_LEN; n++, i++)
+        {
+            ((uint8_t*)p->payload)[n] ^= 0xFF;
+        }
+    }
+}
+
+static void TestTxTcpHeaderCopied(void)
+{
+    static uint8_t frame[FRAME_MAX];
+    uint32_t       split = HEADERS_LEN;
+    u32_t          first;
+    u32_t          skip;
+    struct pbuf*   p;
+
+    ResetRing();
+
+    BuildFrame(frame, 600, FRAME_TCP);
+
+    // Headers in a pbuf of their own, as tcp_write without TCP_WRITE_FLAG_COPY builds them: only the
+    // headers are copied, the data goes in place.
+    p = MakeChain(frame, 600, &split, 1);
+
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == HEADERS_LEN);
+    HOST_CHECK(stm32f4_ring_tx_segments(p, HEADERS_LEN) == 2);
+
+    first = s_ring.tx_fill_idx;
+
+    HOST_CHECK(Transmit(p) == ERR_OK);
+    HOST_CHECK(s_bounced == 0 && s_headersCopied == 1);
+    HOST_CHECK(s_txDesc[first].Buffer1Addr != (uint32_t)(uintptr_t)p->payload);
+    HOST_CHECK((s_txDesc[first].ControlBufferSize & ETH_DMATXDESC_TBS1) == HEADERS_LEN);
+    HOST_CHECK(s_txDesc[(first + 1) % STM32F4_NUM_TX_DESCS].Buffer1Addr == (uint32_t)(uintptr_t)p->next->payload);
+    HOST_CHECK(p->ref == 2);
+
+    // The segment is still on the unacked queue: a retransmission rewrites its headers in place.
+    RewriteHeaders(p);
+
+    // The header pbuf goes as soon as the DMA is past it, the frame stays until the last segment.
+    HOST_CHECK(MockPbuf_Live() == 3);
+    HOST_CHECK(Dma_Transmit(1) == 1);
+    HOST_CHECK(stm32f4_ring_tx_reclaim(&s_ring) == STM32F4_NUM_TX_DESCS - 1);
+    HOST_CHECK(MockPbuf_Live() == 2);
+
+    DrainTx();
+
+    CheckSent(0, frame, 600);
+
+    pbuf_free(p);
+
+    // Headers and data in the same pbuf, as with TCP_WRITE_FLAG_COPY: the copy runs up to the next
+    // aligned byte, the rest of the pbuf goes in place.
+    p = MakeChain(frame, 600, NULL, 0);
+
+    skip = (HEADERS_LEN + STM32F4_TX_BUF_ALIGNMENT - 1) & ~(STM32F4_TX_BUF_ALIGNMENT - 1);
+
+    HOST_CHECK(((uintptr_t)p->payload & (STM32F4_TX_BUF_ALIGNMENT - 1)) == 0);
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == skip);
+
+    first = s_ring.tx_fill_idx;
+
+    HOST_CHECK(Transmit(p) == ERR_OK);
+    HOST_CHECK(s_bounced == 0 && s_headersCopied == 2);
+    HOST_CHECK((s_txDesc[first].ControlBufferSize & ETH_DMATXDESC_TBS1) == skip);
+    HOST_CHECK(s_txDesc[(first + 1) % STM32F4_NUM_TX_DESCS].Buffer1Addr == (uint32_t)(uintptr_t)p->payload + skip);
+
+    RewriteHeaders(p);
+
+    DrainTx();
+
+    CheckSent(1, frame, 600);
+
+    pbuf_free(p);
+
+    HOST_CHECK(MockPbuf_Live() == 0);
+}
+
+static void TestTxCopyLen(void)
+{
+    static uint8_t frame[FRAME_MAX];
+    static uint8_t udp[FRAME_MAX];
+    uint32_t       split;
+    struct pbuf*   p;
+    struct pbuf*   q;
+
+    ResetRing();
+
+    // Non-IP and non-TCP frames go in place.
+    BuildFrame(frame, 60, FRAME_ARP);
+    p = MakeChain(frame, 60, NULL, 0);
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == 0);
+
+    // ...unless someone else holds a reference.
+    pbuf_ref(p);
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == 60);
+    pbuf_free(p);
+    pbuf_free(p);
+
+    // A netbuf chained behind a UDP header: the application may reuse it as soon as the send returns.
+    BuildFrame(udp, 200, FRAME_UDP);
+    split = IP_OFFSET + IP_HLEN + 8;
+    p = MakeChain(udp, split, NULL, 0);
+    q = MakeChain(udp + split, 200 - split, NULL, 0);
+    pbuf_chain(p, q);
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == 200);
+
+    HOST_CHECK(Transmit(p) == ERR_OK);
+    HOST_CHECK(s_bounced == 1);
+
+    pbuf_free(p);
+    memset(q->payload, 0, q->len);
+    pbuf_free(q);
+
+    // TCP options are part of the headers.
+    BuildFrame(frame, 100, FRAME_TCP);
+    frame[TCP_OFFSET + 12] = (uint8_t)(((TCP_HLEN + 12) / 4) << 4);
+    p = MakeChain(frame, 100, NULL, 0);
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == ((HEADERS_LEN + 12 + STM32F4_TX_BUF_ALIGNMENT - 1) & ~(STM32F4_TX_BUF_ALIGNMENT - 1)));
+    pbuf_free(p);
+
+    // A segment without data is all headers.
+    BuildFrame(frame, HEADERS_LEN + 1, FRAME_TCP);
+    p = MakeChain(frame, HEADERS_LEN, NULL, 0);
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == HEADERS_LEN);
+    pbuf_free(p);
+
+    // Invalid header lengths, and headers split across pbufs, cannot be checked.
+    BuildFrame(frame, 100, FRAME_TCP);
+    frame[TCP_OFFSET + 12] = 0x40;
+    p = MakeChain(frame, 100, NULL, 0);
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == 100);
+    pbuf_free(p);
+
+    BuildFrame(frame, 100, FRAME_TCP);
+    split = HEADERS_LEN - 1;
+    p = MakeChain(frame, 100, &split, 1);
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == 100);
+    pbuf_free(p);
+
+    split = IP_OFFSET;
+    p = MakeChain(frame, 100, &split, 1);
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == 100);
+    pbuf_free(p);
+
+    BuildFrame(frame, 100, FRAME_ARP);
+    split = 10;
+    p = MakeChain(frame, 100, &split, 1);
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == 100);
+    pbuf_free(p);
+
+    DrainTx();
+
+    HOST_CHECK(s_sentCount == 1);
+    CheckSent(0, udp, 200);
+    HOST_CHECK(MockPbuf_Live() == 0);
+}
+
+static void TestTxUnreachable(void)
+{
+    static uint8_t frame[FRAME_MAX];
+    uint32_t       splits[STM32F4_NUM_TX_DESCS];
+    uint32_t       i;
+    struct pbuf*   p;
+
+    ResetRing();
+
+    // Unaligned payload.
+    BuildFrame(frame, 100, FRAME_UDP);
+    p = pbuf_alloc(PBUF_RAW, 102, PBUF_RAM);
+    HOST_CHECK(p != NULL);
+    p->payload = (uint8_t*)p->payload + 2;
+    p->len     = 100;
+    p->tot_len = 100;
+    memcpy(p->payload, frame, 100);
+
+    HOST_CHECK(stm32f4_ring_tx_copy_len(p) == 0);
+    HOST_CHECK(stm32f4_ring_tx_segments(p, 0) == 0);
+    HOST_CHECK(Transmit(p) == ERR_OK);
+    HOST_CHECK(s_bounced == 1);
+    pbuf_free(p);
+
+    // More segments than the ring can ever hold, empty pbufs do not count.
+    for (i = 0; i < STM32F4_NUM_TX_DESCS; i++)
+    {
+        splits[i] = IP_OFFSET + IP_HLEN + 8 + 4 * i;
+    }
+
+    p = MakeChain(frame, 100, splits, STM32F4_NUM_TX_DESCS - 1);
+    HOST_CHECK(stm32f4_ring_tx_segments(p, 0) == 0);
+    pbuf_free(p);
+
+    splits[1] = splits[0];
+    p = MakeChain(frame, 100, splits, STM32F4_NUM_TX_DESCS - 1);
+    HOST_CHECK(stm32f4_ring_tx_segments(p, 0) == STM32F4_NUM_TX_DESCS - 1);
+    HOST_CHECK(Transmit(p) == ERR_OK);
+    HOST_CHECK(s_bounced == 1);
+    pbuf_free(p);
+
+    DrainTx();
+
+    HOST_CHECK(s_sentCount == 2);
+    CheckSent(0, frame, 100);
+    CheckSent(1, frame, 100);
+    HOST_CHECK(MockPbuf_Live() == 0);
+}
+
+static void TestTxRingFull(void)
+{
+    static uint8_t frame[FRAME_MAX];
+    uint32_t       split = IP_OFFSET + IP_HLEN + 8;
+    uint32_t       queued = 0;
+    uint32_t       i;
+
+    ResetRing();
+
+    BuildFrame(frame, 400, FRAME_UDP);
+
+    for (;;)
+    {
+        struct pbuf* p   = MakeChain(frame, 400, &split, 1);
+        err_t        err = Transmit(p);
+
+        pbuf_free(p);
+
+        if (err != ERR_OK)
+        {
+            HOST_CHECK(err == ERR_MEM);
+            break;
+        }
+
+        queued++;
+    }
+
+    HOST_CHECK(queued == STM32F4_NUM_TX_DESCS / 2);
+
+    DrainTx();
+
+    HOST_CHECK(s_sentCount == queued);
+
+    for (i = 0; i < queued; i++)
+    {
+        CheckSent(i, frame, 400);
+    }
+
+    HOST_CHECK(MockPbuf_Live() == 0);
+}
+
+//
+// Random frames, chains and DMA progress, with the ring wrapping many times. Every frame must come
+// out of the DMA in order and as it was when queued, and every pbuf must be released eventually.
+//
+static void TestTxRandomized(void)
+{
+    static Frame expected[SENT_MAX];
+    uint32_t     head  = 0;         // Next expected frame to check
+    uint32_t     tail  = 0;         // Next expected frame to queue
+    uint32_t     total = 0;
+    int          step;
+
+    ResetRing();
+
+    for (step = 0; step < 20000; step++)
+    {
+        Frame*       frame = &expected[tail % SENT_MAX];
+        int          kind  = (int)(NextRandom() % 3);
+        uint32_t     splits[3];
+        uint32_t     count = NextRandom() % 4;
+        uint32_t     i;
+        struct pbuf* p;
+        err_t        err;
+
+        frame->Length = (uint16_t)(60 + NextRandom() % (FRAME_MAX - 60 + 1));
+
+        BuildFrame(frame->Data, frame->Length, kind);
+
+        for (i = 0; i < count; i++)
+        {
+            splits[i] = (i == 0 ? 0 : splits[i - 1]) + NextRandom() % (frame->Length / 4);
+        }
+
+        p = MakeChain(frame->Data, frame->Length, splits, count);
+
+        while ((err = Transmit(p)) == ERR_MEM)
+        {
+            HOST_CHECK(Dma_Transmit(1 + NextRandom() % STM32F4_NUM_TX_DESCS) > 0);
+        }
+
+        HOST_CHECK(err == ERR_OK);
+
+        tail++;
+
+        // The stack rewrites the headers of TCP segments it still holds, and may reuse whatever the ring
+        // did not reference.
+        if (kind == FRAME_TCP)
+        {
+            RewriteHeaders(p);
+        }
+
+        if (p->ref == 1)
+        {
+            struct pbuf* q;
+
+            for (q = p; q != NULL; q = q->next)
+            {
+                memset(q->payload, 0xA5, q->len);
+            }
+        }
+
+        pbuf_free(p);
+
+        Dma_Transmit(NextRandom() % (STM32F4_NUM_TX_DESCS + 1));
+
+        for (i = 0; i < s_sentCount; i++)
+        {
+            HOST_CHECK(head < tail);
+
+            CheckSent(i, expected[head % SENT_MAX].Data, expected[head % SENT_MAX].Length);
+            head++;
+        }
+
+        total      += s_sentCount;
+        s_sentCount = 0;
+
+        HOST_CHECK(tail - head < SENT_MAX);
+    }
+
+    DrainTx();
+
+    for (uint32_t i = 0; i < s_sentCount; i++)
+    {
+        CheckSent(i, expected[head % SENT_MAX].Data, expected[head % SENT_MAX].Length);
+        head++;
+    }
+
+    total += s_sentCount;
+
+    HOST_CHECK(head == tail && total == 20000);
+    HOST_CHECK(s_bounced > 0 && s_bounced < 20000);
+    HOST_CHECK(s_headersCopied > 0);
+    HOST_CHECK(MockPbuf_Live() == 0);
+}
+
+//--//
+
+static uint32_t CountFreeRxBufs(void)
+{
+    struct stm32f4_rx_buf* buf;
+    uint32_t               count = 0;
+
+    for (buf = s_ring.rx_free; buf != NULL; buf = buf->next)
+    {
+        count++;
+    }
+
+    return count;
+}
+
+static void CheckRxBufs(uint32_t onLoan)
+{
+    uint32_t attached = STM32F4_NUM_RX_DESCS - s_ring.rx_free_descs;
+
+    HOST_CHECK(attached + CountFreeRxBufs() + onLoan == STM32F4_NUM_RX_BUFS);
+}
+
+static void TestRx(void)
+{
+    static uint8_t frames[STM32F4_NUM_RX_BUFS][FRAME_MAX];
+    struct pbuf*   loaned[STM32F4_NUM_RX_BUFS];
+    uint32_t       onLoan = 0;
+    uint32_t       i;
+    struct pbuf*   p;
+
+    ResetRing();
+
+    HOST_CHECK(stm32f4_ring_rx_fill(&s_ring) == STM32F4_NUM_RX_DESCS);
+    HOST_CHECK(stm32f4_ring_rx_take(&s_ring) == NULL);
+    CheckRxBufs(0);
+
+    //
+    // Frames are lent to the stack in place, and the ring keeps receiving into the spare buffers
+    // until there are none left.
+    //
+    while (onLoan < STM32F4_NUM_RX_BUFS)
+    {
+        uint32_t len = 60 + NextRandom() % (FRAME_MAX - 60 + 1);
+
+        BuildFrame(frames[onLoan], len, FRAME_UDP);
+
+        HOST_CHECK(Dma_Receive(frames[onLoan], len, 0));
+
+        p = stm32f4_ring_rx_take(&s_ring);
+
+        HOST_CHECK(p != NULL && p->len == len && p->tot_len == len);
+        HOST_CHECK(memcmp(p->payload, frames[onLoan], len) == 0);
+        HOST_CHECK((uint8_t*)p->payload >= (uint8_t*)s_rxBufs && (uint8_t*)p->payload < (uint8_t*)(s_rxBufs + STM32F4_NUM_RX_BUFS));
+
+        loaned[onLoan++] = p;
+
+        stm32f4_ring_rx_fill(&s_ring);
+        CheckRxBufs(onLoan);
+    }
+
+    // Every buffer is on loan: the DMA has nowhere to put the next frame.
+    HOST_CHECK(s_ring.rx_free_descs == STM32F4_NUM_RX_DESCS);
+    HOST_CHECK(!Dma_Receive(frames[0], 60, 0));
+    HOST_CHECK(stm32f4_ring_rx_take(&s_ring) == NULL);
+
+    // Freeing the frames gives the buffers back, and the ring re-arms.
+    for (i = 0; i < onLoan; i++)
+    {
+        HOST_CHECK(memcmp(loaned[i]->payload, frames[i], loaned[i]->len) == 0);
+
+        pbuf_free(loaned[i]);
+    }
+
+    HOST_CHECK(s_rxBufsFreed == STM32F4_NUM_RX_BUFS);
+    HOST_CHECK(stm32f4_ring_rx_fill(&s_ring) == STM32F4_NUM_RX_DESCS);
+    CheckRxBufs(0);
+
+    //
+    // Errored, runt and oversized frames are dropped and their buffer recycled.
+    //
+    HOST_CHECK(Dma_Receive(frames[0], 100, ETH_DMARXDESC_ES));
+    HOST_CHECK(Dma_Receive(frames[1], 0, 0));
+    HOST_CHECK(Dma_Receive(frames[2], 100, 0));
+
+    s_rxDesc[(s_ring.rx_next_idx + 2) % STM32F4_NUM_RX_DESCS].Status |= ETH_DMARXDESC_FL;
+
+    HOST_CHECK(Dma_Receive(frames[3], 200, 0));
+
+    p = stm32f4_ring_rx_take(&s_ring);
+
+    HOST_CHECK(p != NULL && p->len == 200 && memcmp(p->payload, frames[3], 200) == 0);
+    HOST_CHECK(stm32f4_ring_rx_take(&s_ring) == NULL);
+    CheckRxBufs(1);
+
+    HOST_CHECK(stm32f4_ring_rx_fill(&s_ring) == STM32F4_NUM_RX_DESCS);
+
+    pbuf_free(p);
+
+    CheckRxBufs(0);
+    HOST_CHECK(s_rxBufsFreed == STM32F4_NUM_RX_BUFS + 1);
+}
+
+int main(void)
+{
+    TestTxZeroCopy();
+    TestTxTcpHeaderCopied();
+    TestTxCopyLen();
+    TestTxUnreachable();
+    TestTxRingFull();
+    TestTxRandomized();
+    TestRx();
+
+    printf("EmacRingTest: PASS\n");
+
+    return 0;
+}
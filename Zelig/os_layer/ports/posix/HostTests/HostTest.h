@@ -0,0 +1,19 @@
+//
+// Minimal checking for the native host tests, each test is a plain executable registered
+// with CTest that exits with a non-zero code on the first failed check.
+//
+
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HOST_CHECK(cond)                                                                   \
+    do                                                                                     \
+    {                                                                                      \
+        if (!(cond))                                                                       \
+        {                                                                                  \
+            fprintf(stderr, "%s(%d): check failed: %s\n", __FILE__, __LINE__, #cond);      \
+            exit(1);                                                                       \
+        }                                                                                  \
+    } while (0)
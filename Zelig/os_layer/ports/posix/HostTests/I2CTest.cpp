@@ -0,0 +1,168 @@
+//
+// Host test of the mbed I2C port (os_layer/ports/mbed/mbed_i2c.cpp) against the simulated
+// bus in mbed_mock/MockI2C.cpp.
+//
+
+#include "MockMbed.h"
+#include "HostTest.h"
+
+#include <string.h>
+
+#define LLOS_MEMSET memset
+#include <llos_i2c.h>
+
+static const uint8_t c_SlaveAddress = 0x90;
+
+static LLOS_I2C_Segment MakeSegment(uint8_t* buffer, int32_t length, uint32_t flags)
+{
+    LLOS_I2C_Segment segment;
+
+    segment.Buffer = buffer;
+    segment.Offset = 0;
+    segment.Length = length;
+    segment.Flags  = flags;
+
+    return segment;
+}
+
+static void TestWriteRead(LLOS_Context channel)
+{
+    uint8_t          reg[1] = { 0x10 };
+    uint8_t          data[3];
+    LLOS_I2C_Segment segments[2];
+    int32_t          transferred = -1;
+
+    MockI2C_Reset();
+    MockI2C_SetSlave(c_SlaveAddress, -1, { 0xA0, 0xA1, 0xA2 });
+
+    // Register write followed by a read: the read starts with a repeated start, the last segment stops.
+    segments[0] = MakeSegment(reg, sizeof(reg), LLOS_I2C_SegmentWrite);
+    segments[1] = MakeSegment(data, sizeof(data), LLOS_I2C_SegmentRead);
+
+    HOST_CHECK(SUCCEEDED(LLOS_I2C_Transaction(channel, c_SlaveAddress, segments, 2, &transferred)));
+    HOST_CHECK(transferred == 4);
+    HOST_CHECK(segments[0].Length == 1);
+    HOST_CHECK(segments[1].Length == 3);
+    HOST_CHECK(data[0] == 0xA0 && data[1] == 0xA1 && data[2] == 0xA2);
+    HOST_CHECK(MockI2C_Trace() == "S @90 10 Sr @91 <A0 <A1 <A2 P");
+    HOST_CHECK(!MockI2C_BusClaimed());
+}
+
+static void TestNack(LLOS_Context channel)
+{
+    uint8_t          data[4] = { 0x01, 0x02, 0x03, 0x04 };
+    uint8_t          readBack[2];
+    LLOS_I2C_Segment segments[3];
+    int32_t          transferred = -1;
+
+    // The slave does not acknowledge the third byte: the port stops the bus and skips the rest.
+    MockI2C_Reset();
+    MockI2C_SetSlave(c_SlaveAddress, 2, { 0x55 });
+
+    segments[0] = MakeSegment(data, sizeof(data), LLOS_I2C_SegmentWrite);
+    segments[1] = MakeSegment(data, sizeof(data), LLOS_I2C_SegmentWrite);
+    segments[2] = MakeSegment(readBack, sizeof(readBack), LLOS_I2C_SegmentRead);
+
+    HOST_CHECK(SUCCEEDED(LLOS_I2C_Transaction(channel, c_SlaveAddress, segments, 3, &transferred)));
+    HOST_CHECK(transferred == 2);
+    HOST_CHECK(segments[0].Length == 2);
+    HOST_CHECK(segments[1].Length == 0);
+    HOST_CHECK(segments[2].Length == 0);
+    HOST_CHECK(MockI2C_Trace() == "S @90 01 02 03 N P");
+    HOST_CHECK(!MockI2C_BusClaimed());
+
+    // No slave at the address: nothing is counted and the bus is released as well.
+    MockI2C_Reset();
+    MockI2C_SetSlave(c_SlaveAddress, -1, { 0x55 });
+
+    segments[0] = MakeSegment(data, sizeof(data), LLOS_I2C_SegmentWrite);
+    segments[1] = MakeSegment(readBack, sizeof(readBack), LLOS_I2C_SegmentRead);
+
+    HOST_CHECK(SUCCEEDED(LLOS_I2C_Transaction(channel, 0x42, segments, 2, &transferred)));
+    HOST_CHECK(transferred == 0);
+    HOST_CHECK(segments[0].Length == I2C_ERROR_NO_SLAVE);
+    HOST_CHECK(segments[1].Length == 0);
+    HOST_CHECK(MockI2C_Trace() == "S @42 N P");
+    HOST_CHECK(!MockI2C_BusClaimed());
+}
+
+static void TestRepeatedStart(LLOS_Context channel)
+{
+    uint8_t          first[1]  = { 0x01 };
+    uint8_t          second[2] = { 0x02, 0x03 };
+    uint8_t          data[2];
+    LLOS_I2C_Segment segments[3];
+    int32_t          transferred = -1;
+
+    MockI2C_Reset();
+    MockI2C_SetSlave(c_SlaveAddress, -1, { 0xB0, 0xB1 });
+
+    // An explicit stop ends the first transfer, the next segment opens a new one with a start,
+    // and segments without the flag chain with repeated starts.
+    segments[0] = MakeSegment(first, sizeof(first), LLOS_I2C_SegmentWrite | LLOS_I2C_SegmentStop);
+    segments[1] = MakeSegment(second, sizeof(second), LLOS_I2C_SegmentWrite);
+    segments[2] = MakeSegment(data, sizeof(data), LLOS_I2C_SegmentRead);
+
+    HOST_CHECK(SUCCEEDED(LLOS_I2C_Transaction(channel, c_SlaveAddress, segments, 3, &transferred)));
+    HOST_CHECK(transferred == 5);
+    HOST_CHECK(MockI2C_Trace() == "S @90 01 P S @90 02 03 Sr @91 <B0 <B1 P");
+    HOST_CHECK(!MockI2C_BusClaimed());
+
+    // Offsets select the part of the buffer that goes on the bus.
+    MockI2C_Reset();
+    MockI2C_SetSlave(c_SlaveAddress, -1, { 0xB0 });
+
+    segments[0]        = MakeSegment(second, 1, LLOS_I2C_SegmentWrite);
+    segments[0].Offset = 1;
+
+    HOST_CHECK(SUCCEEDED(LLOS_I2C_Transaction(channel, c_SlaveAddress, segments, 1, &transferred)));
+    HOST_CHECK(transferred == 1);
+    HOST_CHECK(MockI2C_Trace() == "S @90 03 P");
+}
+
+static void TestInvalidSegments(LLOS_Context channel)
+{
+    uint8_t          data[2] = { 0x01, 0x02 };
+    LLOS_I2C_Segment segments[2];
+    int32_t          transferred = -1;
+
+    MockI2C_Reset();
+    MockI2C_SetSlave(c_SlaveAddress, -1, { 0x55 });
+
+    // A bad segment anywhere in the list is rejected before anything goes on the bus.
+    segments[0] = MakeSegment(data, sizeof(data), LLOS_I2C_SegmentWrite);
+    segments[1] = MakeSegment(nullptr, 1, LLOS_I2C_SegmentRead);
+
+    HOST_CHECK(LLOS_I2C_Transaction(channel, c_SlaveAddress, segments, 2, &transferred) == LLOS_E_INVALID_PARAMETER);
+
+    segments[1] = MakeSegment(data, -1, LLOS_I2C_SegmentRead);
+
+    HOST_CHECK(LLOS_I2C_Transaction(channel, c_SlaveAddress, segments, 2, &transferred) == LLOS_E_INVALID_PARAMETER);
+    HOST_CHECK(LLOS_I2C_Transaction(channel, c_SlaveAddress, segments, 0, &transferred) == LLOS_E_INVALID_PARAMETER);
+    HOST_CHECK(LLOS_I2C_Transaction(channel, c_SlaveAddress, segments, 1, nullptr) == LLOS_E_INVALID_PARAMETER);
+    HOST_CHECK(MockI2C_Trace().empty());
+}
+
+int main()
+{
+    LLOS_Context channel = nullptr;
+
+    MockHeap_Reset();
+
+    HOST_CHECK(SUCCEEDED(LLOS_I2C_Initialize(1, 2, &channel)));
+    HOST_CHECK(channel != nullptr);
+    HOST_CHECK(SUCCEEDED(LLOS_I2C_SetFrequency(channel, 100000)));
+
+    TestWriteRead(channel);
+    TestNack(channel);
+    TestRepeatedStart(channel);
+    TestInvalidSegments(channel);
+
+    LLOS_I2C_Uninitialize(channel);
+
+    HOST_CHECK(MockHeap_LiveBlocks() == 0);
+
+    printf("I2CTest passed\n");
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+//
+// Host test of the idle time accounting (os_layer/inc/llos_idle_window.h): directed cases, plus a
+// randomized run against a reference model that keeps one idle counter per window.
+//
+
+#include "HostTest.h"
+
+#include <string.h>
+#include <map>
+
+#define LLOS_MEMSET memset
+#include <llos_idle_window.h>
+
+static const uint64_t W = LLOS_IDLE_WINDOW_US;
+
+static uint64_t s_seed = 0x2545F4914F6CDD1Dull;
+
+static uint64_t NextRandom()
+{
+    s_seed ^= s_seed << 13;
+    s_seed ^= s_seed >> 7;
+    s_seed ^= s_seed << 17;
+
+    return s_seed;
+}
+
+static void CheckLast(const LLOS_IdleWindow* window, uint32_t idle)
+{
+    HOST_CHECK(window->LastIdle   == idle);
+    HOST_CHECK(window->LastActive == W - idle);
+}
+
+static void TestWithinWindow()
+{
+    LLOS_IdleWindow window;
+
+    LLOS_IdleWindow_Initialize(&window, 0);
+
+    LLOS_IdleWindow_Account(&window, 100, 300);
+    LLOS_IdleWindow_Account(&window, 500, 1500);
+
+    HOST_CHECK(window.WindowIdle == 1200);
+
+    // Nothing to report before the first window closes.
+    HOST_CHECK(window.LastIdle   == 0);
+    HOST_CHECK(window.LastActive == 0);
+
+    // A busy system closes the window without charging anything.
+    LLOS_IdleWindow_Account(&window, W + 10, W + 10);
+
+    HOST_CHECK(window.WindowStart == W);
+    HOST_CHECK(window.WindowIdle  == 0);
+    CheckLast(&window, 1200);
+}
+
+static void TestAcrossOneBoundary()
+{
+    LLOS_IdleWindow window;
+
+    LLOS_IdleWindow_Initialize(&window, 0);
+
+    LLOS_IdleWindow_Account(&window, W - 300, W + 200);
+
+    HOST_CHECK(window.WindowStart == W);
+    HOST_CHECK(window.WindowIdle  == 200);
+    CheckLast(&window, 300);
+}
+
+static void TestSkippedWindows()
+{
+    LLOS_IdleWindow window;
+
+    //
+    // Idle from the middle of the first window to the middle of the fourth: the third window,
+    // the last complete one, was idle throughout.
+    //
+    LLOS_IdleWindow_Initialize(&window, 0);
+
+    LLOS_IdleWindow_Account(&window, W / 2, 3 * W + 100);
+
+    HOST_CHECK(window.WindowStart == 3 * W);
+    HOST_CHECK(window.WindowIdle  == 100);
+    CheckLast(&window, W);
+
+    //
+    // Busy for more than a whole window, then idle from the middle of the last complete one.
+    //
+    LLOS_IdleWindow_Initialize(&window, 0);
+
+    LLOS_IdleWindow_Account(&window, 0, 1000);
+    LLOS_IdleWindow_Account(&window, 2 * W + 250000, 3 * W + 100);
+
+    HOST_CHECK(window.WindowStart == 3 * W);
+    HOST_CHECK(window.WindowIdle  == 100);
+    CheckLast(&window, W - 250000);
+
+    //
+    // Busy for several windows, idle only in the new one.
+    //
+    LLOS_IdleWindow_Initialize(&window, 0);
+
+    LLOS_IdleWindow_Account(&window, 5 * W + 10, 5 * W + 20);
+
+    HOST_CHECK(window.WindowStart == 5 * W);
+    HOST_CHECK(window.WindowIdle  == 10);
+    CheckLast(&window, 0);
+
+    //
+    // Busy for several windows, with nothing charged at all.
+    //
+    LLOS_IdleWindow_Initialize(&window, 0);
+
+    LLOS_IdleWindow_Account(&window, 7 * W + 3, 7 * W + 3);
+
+    HOST_CHECK(window.WindowStart == 7 * W);
+    HOST_CHECK(window.WindowIdle  == 0);
+    CheckLast(&window, 0);
+}
+
+//
+// Random idle and busy periods, with the odd poll from a busy system. After each step, the window
+// just before the open one must report exactly the idle time the reference model charged to it.
+//
+static void TestRandomized()
+{
+    LLOS_IdleWindow              window;
+    std::map<uint64_t, uint64_t> reference;
+    uint64_t                     now = 0;
+    uint32_t                     checked = 0;
+
+    LLOS_IdleWindow_Initialize(&window, 0);
+
+    for (int step = 0; step < 200000; step++)
+    {
+        uint64_t start;
+        uint64_t end;
+
+        //
+        // Mostly short periods, with the occasional one spanning several windows.
+        //
+        now += ((NextRandom() % 64) == 0) ? NextRandom() % (4 * W) : NextRandom() % 20000;
+
+        start = now;
+
+        if ((NextRandom() % 8) == 0)
+        {
+            end = start;
+        }
+        else
+        {
+            end = start + (((NextRandom() % 64) == 0) ? NextRandom() % (4 * W) : NextRandom() % 20000);
+        }
+
+        for (uint64_t t = start; t < end; )
+        {
+            uint64_t boundary = (t / W + 1) * W;
+            uint64_t stop     = (boundary < end) ? boundary : end;
+
+            reference[t / W] += stop - t;
+            t = stop;
+        }
+
+        LLOS_IdleWindow_Account(&window, start, end);
+
+        now = end;
+
+        HOST_CHECK(window.WindowStart == (end / W) * W);
+        HOST_CHECK(window.WindowIdle  == reference[end / W]);
+
+        if (window.WindowStart >= W)
+        {
+            CheckLast(&window, (uint32_t)reference[end / W - 1]);
+            checked++;
+        }
+    }
+
+    HOST_CHECK(checked > 0);
+}
+
+int main()
+{
+    TestWithinWindow();
+    TestAcrossOneBoundary();
+    TestSkippedWindows();
+    TestRandomized();
+
+    printf("IdleWindowTest: PASS\n");
+
+    return 0;
+}
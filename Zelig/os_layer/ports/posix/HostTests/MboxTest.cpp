@@ -0,0 +1,348 @@
+//
+// Host test of the native lwIP mailboxes (lwip/lwip-sys/arch/sys_arch_mbox.c): directed cases for the
+// blocking paths, then producers and consumers hammering one mailbox with a mix of blocking, try and
+// timed calls. Every message must be delivered exactly once, in order per producer as seen by each
+// consumer, and no waiter registration or semaphore token may be left behind.
+//
+//   MboxTest [messages per producer]
+//
+
+#include "HostTest.h"
+#include "MockSysArch.h"
+
+#include <stdint.h>
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+static const uint32_t c_Producers = 4;
+static const uint32_t c_Consumers = 2;
+static void* const    c_Stop      = (void*)(uintptr_t)0xFFFFFFFF;
+
+static void* Message(uint32_t producer, uint32_t seq)
+{
+    return (void*)(uintptr_t)(((producer << 24) | seq) + 1);
+}
+
+static void SleepMs(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static void CheckIdle(sys_mbox_t* mbox)
+{
+    HOST_CHECK(mbox->head == mbox->tail);
+    HOST_CHECK(mbox->fetch_waiters == 0);
+    HOST_CHECK(mbox->post_waiters  == 0);
+    HOST_CHECK(MockSem_Count(&mbox->not_empty) == 0);
+    HOST_CHECK(MockSem_Count(&mbox->not_full)  == 0);
+}
+
+//--//
+
+static void TestTryAndTimeout()
+{
+    sys_mbox_t mbox;
+    void*      msg;
+
+    HOST_CHECK(sys_mbox_new(&mbox, 4) == ERR_OK);
+    HOST_CHECK(sys_mbox_valid(&mbox));
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        HOST_CHECK(sys_mbox_trypost(&mbox, Message(0, i)) == ERR_OK);
+    }
+
+    HOST_CHECK(sys_mbox_trypost(&mbox, Message(0, 4)) == ERR_MEM);
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        HOST_CHECK(sys_arch_mbox_tryfetch(&mbox, &msg) == ERR_OK);
+        HOST_CHECK(msg == Message(0, i));
+    }
+
+    HOST_CHECK(sys_arch_mbox_tryfetch(&mbox, &msg) == SYS_MBOX_EMPTY);
+
+    // A timed fetch gives up, and withdraws its registration.
+    HOST_CHECK(sys_arch_mbox_fetch(&mbox, &msg, 5) == SYS_ARCH_TIMEOUT);
+
+    CheckIdle(&mbox);
+
+    // Dropping the message is allowed.
+    HOST_CHECK(sys_mbox_trypost(&mbox, Message(0, 5)) == ERR_OK);
+    HOST_CHECK(sys_arch_mbox_fetch(&mbox, NULL, 5) != SYS_ARCH_TIMEOUT);
+
+    CheckIdle(&mbox);
+
+    sys_mbox_free(&mbox);
+
+    HOST_CHECK(!sys_mbox_valid(&mbox));
+    HOST_CHECK(MockSem_Live() == 0);
+}
+
+static void TestBlocking()
+{
+    sys_mbox_t mbox;
+    void*      msg = NULL;
+
+    HOST_CHECK(sys_mbox_new(&mbox, 2) == ERR_OK);
+
+    //
+    // A fetch on an empty mailbox sleeps until a post wakes it up.
+    //
+    std::thread fetcher([&] { HOST_CHECK(sys_arch_mbox_fetch(&mbox, &msg, 0) != SYS_ARCH_TIMEOUT); });
+
+    while (mbox.fetch_waiters == 0)
+    {
+        SleepMs(1);
+    }
+
+    sys_mbox_post(&mbox, Message(1, 1));
+    fetcher.join();
+
+    HOST_CHECK(msg == Message(1, 1));
+    CheckIdle(&mbox);
+
+    //
+    // A post to a full mailbox sleeps until a fetch makes room.
+    //
+    sys_mbox_post(&mbox, Message(1, 2));
+    sys_mbox_post(&mbox, Message(1, 3));
+
+    std::thread poster([&] { sys_mbox_post(&mbox, Message(1, 4)); });
+
+    while (mbox.post_waiters == 0)
+    {
+        SleepMs(1);
+    }
+
+    for (uint32_t i = 2; i <= 4; i++)
+    {
+        HOST_CHECK(sys_arch_mbox_fetch(&mbox, &msg, 0) != SYS_ARCH_TIMEOUT);
+        HOST_CHECK(msg == Message(1, i));
+    }
+
+    poster.join();
+
+    CheckIdle(&mbox);
+
+    sys_mbox_free(&mbox);
+
+    HOST_CHECK(MockSem_Live() == 0);
+}
+
+//
+// A timed fetch expires just as a post picks it as the waiter to wake: the fetch must take the
+// message and absorb the token that is on its way, rather than report a timeout and leave it behind.
+//
+static sys_mbox_t* s_raceMbox;
+
+static void PostOnTimeout(sys_sem_t* sem)
+{
+    HOST_CHECK(sem == &s_raceMbox->not_empty && s_raceMbox->fetch_waiters == 1);
+
+    MockSem_SetTimeoutHook(NULL);
+
+    HOST_CHECK(sys_mbox_trypost(s_raceMbox, Message(2, 1)) == ERR_OK);
+    HOST_CHECK(s_raceMbox->fetch_waiters == 0);
+}
+
+static void TestTimeoutRace()
+{
+    sys_mbox_t mbox;
+    void*      msg = NULL;
+
+    HOST_CHECK(sys_mbox_new(&mbox, 2) == ERR_OK);
+
+    s_raceMbox = &mbox;
+    MockSem_SetTimeoutHook(PostOnTimeout);
+
+    HOST_CHECK(sys_arch_mbox_fetch(&mbox, &msg, 2) != SYS_ARCH_TIMEOUT);
+    HOST_CHECK(msg == Message(2, 1));
+
+    CheckIdle(&mbox);
+
+    sys_mbox_free(&mbox);
+
+    HOST_CHECK(MockSem_Live() == 0);
+}
+
+//--//
+
+struct Stress
+{
+    sys_mbox_t                         Mbox;
+    uint32_t                           PerProducer;
+    std::vector< std::atomic<uint8_t> > Seen;
+    std::atomic<uint32_t>              Received;
+    std::atomic<uint32_t>              Timeouts;
+
+    Stress(uint32_t perProducer) : PerProducer(perProducer), Seen(c_Producers * perProducer), Received(0), Timeouts(0)
+    {
+    }
+};
+
+static uint32_t NextRandom(uint64_t& seed)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+
+    return (uint32_t)(seed >> 16);
+}
+
+static void Producer(Stress* stress, uint32_t producer)
+{
+    uint64_t seed = 0x2545F4914F6CDD1Dull + producer;
+
+    for (uint32_t seq = 0; seq < stress->PerProducer; seq++)
+    {
+        void*    msg    = Message(producer, seq);
+        uint32_t random = NextRandom(seed);
+
+        // The odd pause lets the timed fetches expire, racing with the posts that follow.
+        if ((random % 2048) == 0)
+        {
+            SleepMs(1 + random % 3);
+        }
+
+        if ((random % 4) == 1)
+        {
+            while (sys_mbox_trypost(&stress->Mbox, msg) != ERR_OK)
+            {
+                std::this_thread::yield();
+            }
+        }
+        else
+        {
+            sys_mbox_post(&stress->Mbox, msg);
+        }
+    }
+}
+
+static void Consumer(Stress* stress, uint32_t consumer)
+{
+    uint64_t seed = 0x9E3779B97F4A7C15ull + consumer;
+    int64_t  last[c_Producers];
+
+    for (uint32_t i = 0; i < c_Producers; i++)
+    {
+        last[i] = -1;
+    }
+
+    for (;;)
+    {
+        void*    msg  = NULL;
+        uint32_t mode = NextRandom(seed) % 4;
+
+        if (mode == 0)
+        {
+            if (sys_arch_mbox_tryfetch(&stress->Mbox, &msg) != ERR_OK)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+        }
+        else if (mode == 1)
+        {
+            if (sys_arch_mbox_fetch(&stress->Mbox, &msg, 1) == SYS_ARCH_TIMEOUT)
+            {
+                stress->Timeouts++;
+                continue;
+            }
+        }
+        else
+        {
+            HOST_CHECK(sys_arch_mbox_fetch(&stress->Mbox, &msg, 0) != SYS_ARCH_TIMEOUT);
+        }
+
+        if (msg == c_Stop)
+        {
+            break;
+        }
+
+        uint32_t value    = (uint32_t)(uintptr_t)msg - 1;
+        uint32_t producer = value >> 24;
+        uint32_t seq      = value & 0xFFFFFF;
+
+        HOST_CHECK(producer < c_Producers && seq < stress->PerProducer);
+        HOST_CHECK((int64_t)seq > last[producer]);
+        HOST_CHECK(stress->Seen[producer * stress->PerProducer + seq].exchange(1) == 0);
+
+        last[producer] = seq;
+        stress->Received++;
+    }
+}
+
+static void TestStress(uint32_t perProducer)
+{
+    Stress                   stress(perProducer);
+    std::vector<std::thread> producers;
+    std::vector<std::thread> consumers;
+
+    HOST_CHECK(sys_mbox_new(&stress.Mbox, MB_SIZE) == ERR_OK);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < c_Consumers; i++)
+    {
+        consumers.emplace_back(Consumer, &stress, i);
+    }
+
+    for (uint32_t i = 0; i < c_Producers; i++)
+    {
+        producers.emplace_back(Producer, &stress, i);
+    }
+
+    for (auto& t : producers)
+    {
+        t.join();
+    }
+
+    for (uint32_t i = 0; i < c_Consumers; i++)
+    {
+        sys_mbox_post(&stress.Mbox, c_Stop);
+    }
+
+    for (auto& t : consumers)
+    {
+        t.join();
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    HOST_CHECK(stress.Received == c_Producers * perProducer);
+
+    for (auto& seen : stress.Seen)
+    {
+        HOST_CHECK(seen == 1);
+    }
+
+    CheckIdle(&stress.Mbox);
+
+    sys_mbox_free(&stress.Mbox);
+
+    HOST_CHECK(MockSem_Live() == 0);
+
+    printf("%u producers, %u consumers: %u messages, %.0f msgs/sec, %u timed fetches expired\n",
+           c_Producers, c_Consumers, (uint32_t)stress.Received, stress.Received / elapsed, (uint32_t)stress.Timeouts);
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t perProducer = argc > 1 ? (uint32_t)atoi(argv[1]) : 200000;
+
+    HOST_CHECK(perProducer > 0 && perProducer < (1u << 24));
+
+    TestTryAndTimeout();
+    TestBlocking();
+    TestTimeoutRace();
+    TestStress(perProducer);
+
+    printf("MboxTest: PASS\n");
+
+    return 0;
+}
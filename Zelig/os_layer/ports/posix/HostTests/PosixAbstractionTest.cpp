@@ -0,0 +1,93 @@
+//
+// Runs through LlilumPosix's entry point with a stand-in for the compiled image, and
+// checks the memory, clock and thread functions the managed runtime relies on.
+//
+
+#include "HostTest.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+
+// Same as the port itself, use the libc memset rather than llos_platform.h's declaration.
+#define LLOS_MEMSET memset
+
+#include <llos_clock.h>
+#include <llos_memory.h>
+#include <llos_thread.h>
+
+static LLOS_Handle  s_worker;
+static volatile int s_timedOut;
+static volatile int s_signaled;
+
+static void Worker(LLOS_Context param)
+{
+    (void)param;
+
+    s_timedOut = LLOS_THREAD_Wait(s_worker, 10) == LLOS_E_TIMEOUT;
+    s_signaled = LLOS_THREAD_Wait(s_worker, 5000) == S_OK;
+}
+
+static void TestMemory()
+{
+    LLOS_Opaque p = nullptr;
+
+    HOST_CHECK(LLOS_MEMORY_Allocate(64, 0x5A, &p) == S_OK);
+    HOST_CHECK(((uint8_t*)p)[63] == 0x5A);
+
+    // Growing and shrinking keep the payload, and keep the block below 4GB as the
+    // managed heap bookkeeping needs.
+    for (uint32_t size = 128; size <= 8 * 1024 * 1024; size *= 4)
+    {
+        HOST_CHECK(LLOS_MEMORY_Reallocate(&p, size) == S_OK);
+        HOST_CHECK(((uint8_t*)p)[0] == 0x5A && ((uint8_t*)p)[63] == 0x5A);
+#if defined(__x86_64__) && defined(MAP_32BIT)
+        HOST_CHECK((uintptr_t)p + size <= 0x100000000ull);
+#endif
+    }
+
+    HOST_CHECK(LLOS_MEMORY_Reallocate(&p, 16) == S_OK);
+    HOST_CHECK(((uint8_t*)p)[15] == 0x5A);
+
+    LLOS_MEMORY_Free(p);
+}
+
+static void TestDelay()
+{
+    uint64_t start = LLOS_CLOCK_GetClockTicks();
+
+    HOST_CHECK(LLOS_CLOCK_Delay(20000) == 20000);
+    HOST_CHECK(LLOS_CLOCK_GetClockTicks() - start >= 20000);
+
+    // Idling only yields on the host, there is nothing to account.
+    uint32_t idle;
+    uint32_t active;
+    uint64_t total;
+
+    LLOS_CLOCK_Idle();
+
+    HOST_CHECK(LLOS_CLOCK_GetIdleStatistics(&idle, &active, &total) == LLOS_E_NOT_SUPPORTED);
+}
+
+static void TestThreads()
+{
+    HOST_CHECK(LLOS_THREAD_CreateThread(Worker, nullptr, nullptr, 0, &s_worker) == S_OK);
+    HOST_CHECK(LLOS_THREAD_Start(s_worker) == S_OK);
+
+    LLOS_THREAD_Sleep(50);
+    HOST_CHECK(LLOS_THREAD_Signal(s_worker) == S_OK);
+
+    // Joins the worker.
+    HOST_CHECK(LLOS_THREAD_DeleteThread(s_worker) == S_OK);
+    HOST_CHECK(s_timedOut);
+    HOST_CHECK(s_signaled);
+}
+
+extern "C" void LLILUM_main(void)
+{
+    TestMemory();
+    TestDelay();
+    TestThreads();
+
+    printf("PosixAbstractionTest passed\n");
+}
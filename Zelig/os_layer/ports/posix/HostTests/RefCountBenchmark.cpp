@@ -0,0 +1,149 @@
+//
+// Multi-threaded reference counting benchmark for PosixAbstraction/LlosGarbageCollection.cpp. Every thread hammers
+// both a shared object and a private one, so the result shows contention on the same header as well as how well
+// independent updates scale, and every few iterations loads the shared object through a slot like a field read.
+// Built twice, as RefCountBenchmark and as RefCountBenchmarkGlobalLock with LLOS_REFCOUNT_USE_GLOBAL_LOCK, so the
+// atomic scheme and the global kernel mutex compare directly. The counts must come back to where they started.
+//
+//   RefCountBenchmark [threads] [iterations per thread]
+//
+
+#include "HostTest.h"
+
+#include <string.h>
+#include <time.h>
+
+#include <thread>
+#include <vector>
+
+#include "LlosPosix.h"
+#include <llos_mutex.h>
+
+extern "C"
+{
+    struct Object;
+
+    void    AddReference(Object* target);
+    int     ReleaseReferenceNative(Object* target);
+    Object* LoadAndAddReferenceNative(Object** target);
+}
+
+extern int LlosPosix_Main(void);
+
+// Must match ObjectHeader.cs and LlosGarbageCollection.cpp
+#define REFERENCE_COUNT_MASK  0xFF000000
+#define REFERENCE_COUNT_SHIFT 24
+#define LOAD_INTERVAL         16
+
+struct TestObject
+{
+    int32_t MultiUseWord;
+    void*   VTable;
+    int32_t Payload;
+};
+
+static uint32_t s_threads    = 4;
+static uint32_t s_iterations = 1 << 18;
+
+static Object* ToObject(TestObject* pObject)
+{
+    // Canonical object pointers point past the header.
+    return (Object*)&pObject->Payload;
+}
+
+static uint32_t GetCount(TestObject* pObject)
+{
+    return ((uint32_t)__atomic_load_n(&pObject->MultiUseWord, __ATOMIC_RELAXED) & REFERENCE_COUNT_MASK) >> REFERENCE_COUNT_SHIFT;
+}
+
+static double NowSeconds()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+extern "C" void LLILUM_main(void)
+{
+    LLOS_Handle              globalLock;
+    TestObject               shared;
+    Object*                  slot;
+    std::vector<TestObject>  mine(s_threads);
+    std::vector<std::thread> threads;
+    double                   start;
+    double                   elapsed;
+    uint64_t                 ops;
+
+    HOST_CHECK(LLOS_MUTEX_CreateGlobalLock(&globalLock) == S_OK);
+
+    memset(&shared, 0, sizeof(shared));
+    shared.MultiUseWord = 1 << REFERENCE_COUNT_SHIFT;
+    slot                = ToObject(&shared);
+
+    for (uint32_t t = 0; t < s_threads; t++)
+    {
+        memset(&mine[t], 0, sizeof(mine[t]));
+        mine[t].MultiUseWord = 1 << REFERENCE_COUNT_SHIFT;
+    }
+
+    start = NowSeconds();
+
+    for (uint32_t t = 0; t < s_threads; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            Object* pShared = ToObject(&shared);
+            Object* pMine   = ToObject(&mine[t]);
+
+            for (uint32_t i = 0; i < s_iterations; i++)
+            {
+                AddReference(pShared);
+                HOST_CHECK(ReleaseReferenceNative(pShared) != 0);
+                AddReference(pMine);
+                HOST_CHECK(ReleaseReferenceNative(pMine) != 0);
+
+                if (i % LOAD_INTERVAL == 0)
+                {
+                    HOST_CHECK(LoadAndAddReferenceNative(&slot) == pShared);
+                    HOST_CHECK(ReleaseReferenceNative(pShared) != 0);
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    elapsed = NowSeconds() - start;
+    ops     = (uint64_t)s_threads * s_iterations * 4 + (uint64_t)s_threads * ((s_iterations + LOAD_INTERVAL - 1) / LOAD_INTERVAL) * 2;
+
+    HOST_CHECK(GetCount(&shared) == 1);
+
+    for (uint32_t t = 0; t < s_threads; t++)
+    {
+        HOST_CHECK(GetCount(&mine[t]) == 1);
+    }
+
+#ifdef LLOS_REFCOUNT_USE_GLOBAL_LOCK
+    printf("reference counting (global lock): ");
+#else
+    printf("reference counting (atomic)     : ");
+#endif
+    printf("%u threads, %.1f ms, %.0f ops/sec\n", s_threads, elapsed * 1e3, ops / elapsed);
+
+    HOST_CHECK(LLOS_MUTEX_Delete(globalLock) == S_OK);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1) s_threads    = (uint32_t)atoi(argv[1]);
+    if (argc > 2) s_iterations = (uint32_t)atoi(argv[2]);
+
+    HOST_CHECK(s_threads > 0 && s_iterations > 0);
+
+    return LlosPosix_Main();
+}
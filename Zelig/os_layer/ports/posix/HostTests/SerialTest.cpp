@@ -0,0 +1,202 @@
+//
+// Host test of the mbed serial port (os_layer/ports/mbed/mbed_serial.cpp) against the
+// simulated UART in mbed_mock/MockSerial.cpp.
+//
+
+#include "MockMbed.h"
+#include "HostTest.h"
+
+#include <string.h>
+
+#define LLOS_MEMSET memset
+#include <llos_serial.h>
+
+static uint32_t s_rxNotifications;
+static uint32_t s_txNotifications;
+
+static void SerialCallback(LLOS_Context channel, LLOS_Context callbackContext, LLOS_SERIAL_Event serialEvent)
+{
+    (void)channel;
+    (void)callbackContext;
+
+    if (serialEvent == LLOS_SERIAL_EventRx)
+    {
+        s_rxNotifications++;
+    }
+    else
+    {
+        s_txNotifications++;
+    }
+}
+
+static void RunUntilTxIdle()
+{
+    for (int i = 0; i < 10000 && !MockSerial_TxIdle(); i++)
+    {
+        MockSerial_Tick();
+    }
+
+    HOST_CHECK(MockSerial_TxIdle());
+}
+
+static void TestReceive(LLOS_Context channel)
+{
+    uint8_t  data[100];
+    uint8_t  buffer[128];
+    int32_t  length;
+    BOOL     canRead;
+
+    for (int i = 0; i < (int)sizeof(data); i++)
+    {
+        data[i] = (uint8_t)(i + 1);
+    }
+
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_CanRead(channel, &canRead)));
+    HOST_CHECK(!canRead);
+
+    // The RX interrupt moves everything into the ring, a single read returns all of it.
+    s_rxNotifications = 0;
+
+    MockSerial_Receive(data, 10);
+
+    HOST_CHECK(s_rxNotifications == 1);
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_CanRead(channel, &canRead)));
+    HOST_CHECK(canRead);
+
+    length = sizeof(buffer);
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Read(channel, buffer, 0, &length)));
+    HOST_CHECK(length == 10);
+    HOST_CHECK(memcmp(buffer, data, 10) == 0);
+
+    // More than the ring holds: the excess is dropped, the hardware FIFO is still emptied.
+    MockSerial_Receive(data, sizeof(data));
+
+    length = sizeof(buffer);
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Read(channel, buffer, 0, &length)));
+    HOST_CHECK(length == LLOS_SERIAL_DEFAULT_BUFFER_SIZE);
+    HOST_CHECK(memcmp(buffer, data, length) == 0);
+
+    // Partial reads leave the rest in order.
+    MockSerial_Receive(data, 20);
+
+    length = 8;
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Read(channel, buffer, 0, &length)));
+    HOST_CHECK(length == 8);
+    length = sizeof(buffer);
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Read(channel, buffer, 8, &length)));
+    HOST_CHECK(length == 12);
+    HOST_CHECK(memcmp(buffer, data, 20) == 0);
+}
+
+static void TestConfigure(LLOS_Context channel, LLOS_SERIAL_Config* pConfig)
+{
+    uint32_t allocations = MockHeap_Allocations();
+
+    // Same sizes, nothing is reallocated.
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Configure(channel, pConfig)));
+    HOST_CHECK(MockHeap_Allocations() == allocations);
+
+    // New sizes are rounded up to a power of two, the old storage is released. The heap mock
+    // fails the test if any of this happens with interrupts disabled.
+    pConfig->RxBufferSize = 16;
+    pConfig->TxBufferSize = 200;
+
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Configure(channel, pConfig)));
+    HOST_CHECK(pConfig->RxBufferSize == 16);
+    HOST_CHECK(pConfig->TxBufferSize == 256);
+    HOST_CHECK(MockHeap_Allocations() == allocations + 2);
+    HOST_CHECK(MockHeap_LiveBlocks() == 3);
+
+    // Only the ring that changes is reallocated.
+    pConfig->RxBufferSize = 32;
+
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Configure(channel, pConfig)));
+    HOST_CHECK(pConfig->RxBufferSize == 32);
+    HOST_CHECK(MockHeap_Allocations() == allocations + 3);
+    HOST_CHECK(MockHeap_LiveBlocks() == 3);
+    HOST_CHECK(g_MockPrimask == 0);
+}
+
+static void TestTransmit(LLOS_Context channel, uint32_t txCapacity)
+{
+    uint8_t data[300];
+    int32_t length;
+
+    for (int i = 0; i < (int)sizeof(data); i++)
+    {
+        data[i] = (uint8_t)(i * 7);
+    }
+
+    // Only what fits in the ring is queued.
+    s_txNotifications = 0;
+
+    length = sizeof(data);
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Write(channel, data, 0, &length)));
+    HOST_CHECK((uint32_t)length == txCapacity);
+    HOST_CHECK(MockSerial_TxIrqEnabled());
+
+    // Flush sleeps on WFI, where the simulated UART makes progress.
+    g_MockWfiHook = MockSerial_Tick;
+
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Flush(channel)));
+    HOST_CHECK(MockSerial_HoldingEmpty());
+    HOST_CHECK(!MockSerial_TxIrqEnabled());
+    HOST_CHECK(s_txNotifications == 1);
+
+    g_MockWfiHook = nullptr;
+
+    // The rest, flushed with interrupts disabled: the ring is drained by polling.
+    int32_t remaining = sizeof(data) - length;
+
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Write(channel, data, length, &remaining)));
+    HOST_CHECK(remaining == (int32_t)sizeof(data) - length);
+
+    __disable_irq();
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Flush(channel)));
+    __enable_irq();
+
+    HOST_CHECK(MockSerial_HoldingEmpty());
+    HOST_CHECK(!MockSerial_TxIrqEnabled());
+
+    RunUntilTxIdle();
+
+    HOST_CHECK(MockSerial_Line().size() == sizeof(data));
+    HOST_CHECK(memcmp(MockSerial_Line().data(), data, sizeof(data)) == 0);
+}
+
+int main()
+{
+    LLOS_SERIAL_Config* pConfig = nullptr;
+    LLOS_Context        channel = nullptr;
+
+    MockHeap_Reset();
+    MockSerial_Reset();
+
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Open(1, 2, &pConfig, &channel)));
+    HOST_CHECK(channel != nullptr && pConfig != nullptr);
+    HOST_CHECK(MockHeap_LiveBlocks() == 3);
+
+    pConfig->BaudRate = 115200;
+    pConfig->DataBits = 8;
+    pConfig->Parity   = LLOS_SERIAL_ParityNone;
+    pConfig->StopBits = LLOS_SERIAL_StopBitsOne;
+
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Configure(channel, pConfig)));
+    HOST_CHECK(pConfig->RxBufferSize == LLOS_SERIAL_DEFAULT_BUFFER_SIZE);
+    HOST_CHECK(pConfig->TxBufferSize == LLOS_SERIAL_DEFAULT_BUFFER_SIZE);
+
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_SetCallback(channel, SerialCallback, nullptr)));
+    HOST_CHECK(SUCCEEDED(LLOS_SERIAL_Enable(channel, LLOS_SERIAL_IrqBoth)));
+
+    TestReceive(channel);
+    TestConfigure(channel, pConfig);
+    TestTransmit(channel, pConfig->TxBufferSize);
+
+    LLOS_SERIAL_Close(channel);
+
+    HOST_CHECK(MockHeap_LiveBlocks() == 0);
+
+    printf("SerialTest passed\n");
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+//
+// Scheduler benchmarks of os_layer/inc/llos_thread_benchmark.h against the POSIX port. The mbed port runs the
+// same code on the device (Test/mbed/simple, THREAD_PERF), so the numbers compare directly.
+//
+//   ThreadBenchmark [round trips] [threads] [yields per thread]
+//
+
+#include "HostTest.h"
+
+#include <string.h>
+
+#define LLOS_MEMSET memset
+#include <llos_thread_benchmark.h>
+
+extern int LlosPosix_Main(void);
+
+static uint32_t s_roundTrips = 100000;
+static uint32_t s_threads    = 4;
+static uint32_t s_yields     = 100000;
+
+//
+// Runs on the port's main thread, which has a thread handle of its own like the managed runtime's.
+//
+extern "C" void LLILUM_main(void)
+{
+    uint32_t roundTrips = s_roundTrips;
+    uint32_t threads    = s_threads;
+    uint32_t yields     = s_yields;
+    uint64_t elapsedUs  = 0;
+
+    HOST_CHECK(LLOS_THREAD_BenchmarkSignalWait(roundTrips, &elapsedUs) == S_OK);
+
+    printf("signal/wait: %u round trips in %.1f ms, %.2f us per round trip\n", roundTrips, elapsedUs / 1e3, (double)elapsedUs / roundTrips);
+
+    HOST_CHECK(LLOS_THREAD_BenchmarkYield(threads, yields, &elapsedUs) == S_OK);
+
+    printf("yield      : %u threads x %u yields in %.1f ms, %.2f us per yield\n", threads, yields, elapsedUs / 1e3, (double)elapsedUs / ((uint64_t)threads * yields));
+
+    //
+    // Out of range arguments are rejected, not run.
+    //
+    HOST_CHECK(LLOS_THREAD_BenchmarkYield(0, yields, &elapsedUs) == LLOS_E_INVALID_PARAMETER);
+    HOST_CHECK(LLOS_THREAD_BenchmarkYield(LLOS_THREAD_BENCHMARK_MAX_THREADS + 1, yields, &elapsedUs) == LLOS_E_INVALID_PARAMETER);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1) s_roundTrips = (uint32_t)atoi(argv[1]);
+    if (argc > 2) s_threads    = (uint32_t)atoi(argv[2]);
+    if (argc > 3) s_yields     = (uint32_t)atoi(argv[3]);
+
+    HOST_CHECK(s_roundTrips > 0 && s_yields > 0);
+
+    return LlosPosix_Main();
+}
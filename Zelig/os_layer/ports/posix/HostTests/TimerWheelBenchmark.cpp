@@ -0,0 +1,123 @@
+//
+// Host benchmark of the hierarchical timer wheel (os_layer/inc/llos_timer_wheel.h), for the costs
+// that matter to the mbed port: arming/cancelling a timer with many others armed, and advancing
+// through a steady stream of expirations.
+//
+//   TimerWheelBenchmark [timers] [operations]
+//
+
+#include "HostTest.h"
+
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#define LLOS_MEMSET memset
+#include <llos_timer_wheel.h>
+
+static uint64_t s_seed = 0x2545F4914F6CDD1Dull;
+
+static uint64_t NextRandom()
+{
+    s_seed ^= s_seed << 13;
+    s_seed ^= s_seed >> 7;
+    s_seed ^= s_seed << 17;
+
+    return s_seed;
+}
+
+static double NowSeconds()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint32_t s_fired;
+
+static void OnExpired(LLOS_TimerWheelEntry* entry, uint64_t now, void* context)
+{
+    LLOS_TimerWheel* wheel = (LLOS_TimerWheel*)context;
+
+    s_fired++;
+
+    // Keep the population steady, like periodic timers would.
+    LLOS_TimerWheel_Schedule(wheel, entry, now + 1 + NextRandom() % 100000);
+}
+
+int main(int argc, char** argv)
+{
+    static LLOS_TimerWheel              wheel;
+    uint32_t                            count      = argc > 1 ? (uint32_t)atoi(argv[1]) : 1000;
+    uint32_t                            operations = argc > 2 ? (uint32_t)atoi(argv[2]) : 1000000;
+    std::vector< LLOS_TimerWheelEntry > entries(count);
+    uint64_t                            now = 0;
+    double                              start;
+    double                              elapsed;
+
+    HOST_CHECK(count > 0 && operations > 0);
+
+    LLOS_TimerWheel_Initialize(&wheel, now);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        LLOS_TimerWheel_InitializeEntry(&entries[i]);
+        LLOS_TimerWheel_Schedule(&wheel, &entries[i], now + 1 + NextRandom() % 100000);
+    }
+
+    //
+    // Reschedule (cancel + insert) of random timers.
+    //
+    start = NowSeconds();
+
+    for (uint32_t i = 0; i < operations; i++)
+    {
+        LLOS_TimerWheel_Schedule(&wheel, &entries[NextRandom() % count], now + 1 + NextRandom() % 100000);
+    }
+
+    elapsed = NowSeconds() - start;
+
+    printf("schedule: %u timers armed, %.1f ns per reschedule\n", count, elapsed * 1e9 / operations);
+
+    //
+    // Advance through expirations, 1us at a time over a window that fires every timer several times.
+    //
+    const uint32_t steps = 1000000;
+    uint64_t       end   = now + steps;
+
+    s_fired = 0;
+    start   = NowSeconds();
+
+    while (now < end)
+    {
+        now += 1;
+
+        LLOS_TimerWheel_Advance(&wheel, now, OnExpired, &wheel);
+    }
+
+    elapsed = NowSeconds() - start;
+
+    HOST_CHECK(s_fired > 0);
+
+    printf("advance : %u expirations in %.1f ms, %.1f ns per 1us step\n", s_fired, elapsed * 1e3, elapsed * 1e9 / steps);
+
+    //
+    // NextEvent, called after every change to program the hardware ticker.
+    //
+    volatile uint64_t sink = 0;
+
+    start = NowSeconds();
+
+    for (uint32_t i = 0; i < operations; i++)
+    {
+        sink += LLOS_TimerWheel_NextEvent(&wheel);
+    }
+
+    elapsed = NowSeconds() - start;
+
+    printf("next    : %.1f ns per call\n", elapsed * 1e9 / operations);
+
+    return 0;
+}
@@ -0,0 +1,251 @@
+//
+// Host test of the hierarchical timer wheel (os_layer/inc/llos_timer_wheel.h): directed cases, plus a
+// randomized run against a trivial reference model that keeps every timer's absolute expiry.
+//
+
+#include "HostTest.h"
+
+#include <string.h>
+#include <vector>
+
+#define LLOS_MEMSET memset
+#include <llos_timer_wheel.h>
+
+struct TestTimer
+{
+    LLOS_TimerWheelEntry Entry;     // Must be first
+    uint32_t             Id;
+    bool                 Armed;     // Reference model
+    uint64_t             Expiry;    // Reference model
+    int                  Fired;
+    uint64_t             FiredAt;
+    uint64_t             Reschedule; // Non-zero: reschedule this far out from the callback...
+    int                  Repeats;    // ...this many times
+    TestTimer*           CancelFromCallback;
+};
+
+struct FireLog
+{
+    LLOS_TimerWheel* Wheel;
+    uint64_t         LastFire;
+    uint32_t         Count;
+};
+
+static uint64_t s_seed = 0x9E3779B97F4A7C15ull;
+
+static uint64_t NextRandom()
+{
+    s_seed ^= s_seed << 13;
+    s_seed ^= s_seed >> 7;
+    s_seed ^= s_seed << 17;
+
+    return s_seed;
+}
+
+static void OnExpired(LLOS_TimerWheelEntry* entry, uint64_t now, void* context)
+{
+    TestTimer* timer = (TestTimer*)entry;
+    FireLog*   log   = (FireLog*)context;
+
+    HOST_CHECK(!LLOS_TimerWheel_IsScheduled(entry));
+    HOST_CHECK(timer->Armed);
+    HOST_CHECK(now == timer->Expiry);
+    HOST_CHECK(now >= log->LastFire);
+
+    timer->Armed   = false;
+    timer->Fired  += 1;
+    timer->FiredAt = now;
+    log->LastFire  = now;
+    log->Count    += 1;
+
+    if (timer->CancelFromCallback != nullptr)
+    {
+        LLOS_TimerWheel_Cancel(log->Wheel, &timer->CancelFromCallback->Entry);
+
+        timer->CancelFromCallback->Armed = false;
+        timer->CancelFromCallback        = nullptr;
+    }
+
+    if (timer->Reschedule != 0 && timer->Repeats-- > 0)
+    {
+        timer->Expiry = now + timer->Reschedule;
+        timer->Armed  = true;
+
+        LLOS_TimerWheel_Schedule(log->Wheel, &timer->Entry, timer->Expiry);
+    }
+}
+
+static void Arm(LLOS_TimerWheel* wheel, TestTimer* timer, uint64_t expiry)
+{
+    timer->Expiry = expiry;
+    timer->Armed  = true;
+
+    LLOS_TimerWheel_Schedule(wheel, &timer->Entry, expiry);
+}
+
+static void InitializeTimers(std::vector< TestTimer >& timers)
+{
+    for (size_t i = 0; i < timers.size(); i++)
+    {
+        memset(&timers[i], 0, sizeof(TestTimer));
+
+        LLOS_TimerWheel_InitializeEntry(&timers[i].Entry);
+
+        timers[i].Id = (uint32_t)i;
+    }
+}
+
+//--//
+
+static void TestDirected()
+{
+    static LLOS_TimerWheel   wheel;
+    std::vector< TestTimer > timers(4);
+    FireLog                  log = { &wheel, 0, 0 };
+
+    InitializeTimers(timers);
+    LLOS_TimerWheel_Initialize(&wheel, 1000);
+
+    HOST_CHECK(LLOS_TimerWheel_NextEvent(&wheel) == LLOS_TIMER_WHEEL_NEVER);
+
+    // Exact expiry across levels and beyond the top level.
+    Arm(&wheel, &timers[0], 1000 + 5);
+    Arm(&wheel, &timers[1], 1000 + 100000);
+    Arm(&wheel, &timers[2], 1000 + (1ull << 40));
+
+    LLOS_TimerWheel_Advance(&wheel, 1004, OnExpired, &log);
+    HOST_CHECK(timers[0].Fired == 0);
+
+    LLOS_TimerWheel_Advance(&wheel, 1005, OnExpired, &log);
+    HOST_CHECK(timers[0].Fired == 1 && timers[0].FiredAt == 1005);
+
+    LLOS_TimerWheel_Advance(&wheel, 1000 + (1ull << 41), OnExpired, &log);
+    HOST_CHECK(timers[1].Fired == 1 && timers[1].FiredAt == 1000 + 100000);
+    HOST_CHECK(timers[2].Fired == 1 && timers[2].FiredAt == 1000 + (1ull << 40));
+    HOST_CHECK(LLOS_TimerWheel_NextEvent(&wheel) == LLOS_TIMER_WHEEL_NEVER);
+
+    // A callback cancelling another entry of the same slot.
+    uint64_t now = wheel.Now;
+
+    Arm(&wheel, &timers[0], now + 10);
+    Arm(&wheel, &timers[1], now + 10);
+
+    timers[0].Fired = timers[1].Fired = 0;
+
+    TestTimer* first  = (TestTimer*)wheel.Slots[0][(now + 10) & (LLOS_TIMER_WHEEL_SLOTS - 1)];
+    TestTimer* second = (first == &timers[0]) ? &timers[1] : &timers[0];
+
+    first->CancelFromCallback = second;
+
+    LLOS_TimerWheel_Advance(&wheel, now + 10, OnExpired, &log);
+    HOST_CHECK(first->Fired == 1);
+    HOST_CHECK(second->Fired == 0);
+    HOST_CHECK(!LLOS_TimerWheel_IsScheduled(&second->Entry));
+
+    // Periodic rescheduling from the callback.
+    now = wheel.Now;
+
+    timers[3].Reschedule = 7;
+    timers[3].Repeats    = 100;
+    Arm(&wheel, &timers[3], now + 7);
+
+    LLOS_TimerWheel_Advance(&wheel, now + 70, OnExpired, &log);
+    HOST_CHECK(timers[3].Fired == 10);
+    HOST_CHECK(timers[3].FiredAt == now + 70);
+
+    timers[3].Reschedule = 0;
+    LLOS_TimerWheel_Cancel(&wheel, &timers[3].Entry);
+    HOST_CHECK(LLOS_TimerWheel_NextEvent(&wheel) == LLOS_TIMER_WHEEL_NEVER);
+}
+
+static uint64_t RandomDelay()
+{
+    switch (NextRandom() % 8)
+    {
+    case 0:  return 0;
+    case 1:  return NextRandom() % 64;
+    case 2:  return NextRandom() % 4096;
+    case 3:  return NextRandom() % (1u << 18);
+    case 4:  return NextRandom() % (1u << 24);
+    case 5:  return NextRandom() % (1ull << 30);
+    case 6:  return NextRandom() % (1ull << 34);
+    default: return NextRandom() % 1000;
+    }
+}
+
+static void TestRandomized()
+{
+    static LLOS_TimerWheel   wheel;
+    std::vector< TestTimer > timers(512);
+    FireLog                  log = { &wheel, 0, 0 };
+    uint64_t                 now = 123456789;
+
+    InitializeTimers(timers);
+    LLOS_TimerWheel_Initialize(&wheel, now);
+
+    for (int iteration = 0; iteration < 200000; iteration++)
+    {
+        TestTimer* timer = &timers[NextRandom() % timers.size()];
+        uint32_t   op    = (uint32_t)(NextRandom() % 16);
+
+        if (op < 8)
+        {
+            timer->Reschedule = (NextRandom() % 8 == 0) ? 1 + NextRandom() % 5000 : 0;
+            timer->Repeats    = (int)(NextRandom() % 16);
+
+            Arm(&wheel, timer, now + RandomDelay());
+        }
+        else if (op < 11)
+        {
+            LLOS_TimerWheel_Cancel(&wheel, &timer->Entry);
+
+            timer->Armed = false;
+        }
+        else
+        {
+            uint64_t target = now + RandomDelay();
+
+            log.LastFire = 0;
+
+            LLOS_TimerWheel_Advance(&wheel, target, OnExpired, &log);
+
+            now = target;
+
+            for (size_t i = 0; i < timers.size(); i++)
+            {
+                HOST_CHECK(timers[i].Armed == LLOS_TimerWheel_IsScheduled(&timers[i].Entry));
+                HOST_CHECK(!timers[i].Armed || timers[i].Expiry > now);
+            }
+        }
+
+        //
+        // The wheel may ask to be advanced early to cascade, but never after the earliest expiry.
+        //
+        uint64_t earliest = LLOS_TIMER_WHEEL_NEVER;
+
+        for (size_t i = 0; i < timers.size(); i++)
+        {
+            if (timers[i].Armed && timers[i].Expiry < earliest)
+            {
+                earliest = timers[i].Expiry;
+            }
+        }
+
+        uint64_t next = LLOS_TimerWheel_NextEvent(&wheel);
+
+        HOST_CHECK(next <= earliest);
+        HOST_CHECK((earliest == LLOS_TIMER_WHEEL_NEVER) == (next == LLOS_TIMER_WHEEL_NEVER));
+    }
+
+    HOST_CHECK(log.Count > 10000);
+}
+
+int main()
+{
+    TestDirected();
+    TestRandomized();
+
+    printf("TimerWheelTest passed\n");
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+//
+// pbuf and sys_arch_protect mocks, see MockPbuf.h.
+//
+
+#include "MockPbuf.h"
+#include "HostTest.h"
+
+#include "lwip/mem.h"
+
+#include <string.h>
+
+#define MOCK_PBUF_COUNT      64
+
+struct mock_pbuf {
+    struct pbuf p;
+    u8_t        used;
+    u32_t       data[(MOCK_PBUF_MAX_SIZE + PBUF_LINK_HLEN + PBUF_IP_HLEN + PBUF_TRANSPORT_HLEN + 3) / 4];
+};
+
+static struct mock_pbuf s_pbufs[MOCK_PBUF_COUNT];
+static u32_t            s_live;
+static u32_t            s_protect;
+
+//--//
+
+static u16_t layer_offset(pbuf_layer l)
+{
+    switch (l) {
+    case PBUF_TRANSPORT: return PBUF_LINK_HLEN + PBUF_IP_HLEN + PBUF_TRANSPORT_HLEN;
+    case PBUF_IP:        return PBUF_LINK_HLEN + PBUF_IP_HLEN;
+    case PBUF_LINK:      return PBUF_LINK_HLEN;
+    default:             return 0;
+    }
+}
+
+u32_t MockPbuf_Live(void)
+{
+    return s_live;
+}
+
+u32_t MockProtect_Depth(void)
+{
+    return s_protect;
+}
+
+/** Single pbuf of any type; PBUF_REF and PBUF_ROM get no payload, the caller points it somewhere. */
+struct pbuf *pbuf_alloc(pbuf_layer l, u16_t length, pbuf_type type)
+{
+    u32_t i;
+
+    HOST_CHECK(length <= MOCK_PBUF_MAX_SIZE);
+
+    for (i = 0; i < MOCK_PBUF_COUNT; i++) {
+        struct mock_pbuf *m = &s_pbufs[i];
+
+        if (!m->used) {
+            m->used      = 1;
+            m->p.next    = NULL;
+            m->p.payload = (type == PBUF_RAM || type == PBUF_POOL) ? (u8_t *)m->data + layer_offset(l) : NULL;
+            m->p.tot_len = length;
+            m->p.len     = length;
+            m->p.type    = (u8_t)type;
+            m->p.flags   = 0;
+            m->p.ref     = 1;
+
+            s_live++;
+
+            return &m->p;
+        }
+    }
+
+    return NULL;
+}
+
+struct pbuf *pbuf_alloced_custom(pbuf_layer l, u16_t length, pbuf_type type, struct pbuf_custom *p,
+                                 void *payload_mem, u16_t payload_mem_len)
+{
+    u16_t offset = layer_offset(l);
+
+    if (LWIP_MEM_ALIGN_SIZE(offset) + length > payload_mem_len) {
+        return NULL;
+    }
+
+    p->pbuf.next    = NULL;
+    p->pbuf.payload = (payload_mem != NULL) ? (u8_t *)payload_mem + LWIP_MEM_ALIGN_SIZE(offset) : NULL;
+    p->pbuf.tot_len = length;
+    p->pbuf.len     = length;
+    p->pbuf.type    = (u8_t)type;
+    p->pbuf.flags   = PBUF_FLAG_IS_CUSTOM;
+    p->pbuf.ref     = 1;
+
+    return &p->pbuf;
+}
+
+void pbuf_ref(struct pbuf *p)
+{
+    if (p != NULL) {
+        HOST_CHECK(p->ref > 0);
+        p->ref++;
+    }
+}
+
+/** Dereferences the chain from its head, deallocating pbufs up to the first one still referenced. */
+u8_t pbuf_free(struct pbuf *p)
+{
+    u8_t count = 0;
+
+    while (p != NULL) {
+        struct pbuf *next = p->next;
+
+        HOST_CHECK(p->ref > 0);
+
+        if (--p->ref > 0) {
+            break;
+        }
+
+        if ((p->flags & PBUF_FLAG_IS_CUSTOM) != 0) {
+            ((struct pbuf_custom *)p)->custom_free_function(p);
+        } else {
+            struct mock_pbuf *m = (struct mock_pbuf *)p;
+
+            HOST_CHECK(m >= s_pbufs && m < s_pbufs + MOCK_PBUF_COUNT && m->used);
+
+            m->used = 0;
+            s_live--;
+        }
+
+        count++;
+        p = next;
+    }
+
+    return count;
+}
+
+void pbuf_cat(struct pbuf *head, struct pbuf *tail)
+{
+    struct pbuf *p;
+
+    for (p = head; p->next != NULL; p = p->next) {
+        p->tot_len += tail->tot_len;
+    }
+
+    p->tot_len += tail->tot_len;
+    p->next = tail;
+}
+
+void pbuf_chain(struct pbuf *head, struct pbuf *tail)
+{
+    pbuf_cat(head, tail);
+    pbuf_ref(tail);
+}
+
+err_t pbuf_copy(struct pbuf *p_to, struct pbuf *p_from)
+{
+    u16_t to_offset = 0;
+    u16_t from_offset = 0;
+
+    if (p_to == NULL || p_from == NULL || p_to->tot_len < p_from->tot_len) {
+        return ERR_ARG;
+    }
+
+    while (p_from != NULL) {
+        u16_t len = p_to->len - to_offset;
+
+        if (len > p_from->len - from_offset) {
+            len = p_from->len - from_offset;
+        }
+
+        memcpy((u8_t *)p_to->payload + to_offset, (u8_t *)p_from->payload + from_offset, len);
+
+        to_offset += len;
+        from_offset += len;
+
+        if (to_offset == p_to->len) {
+            p_to = p_to->next;
+            to_offset = 0;
+        }
+
+        if (from_offset == p_from->len) {
+            p_from = p_from->next;
+            from_offset = 0;
+        }
+
+        if (p_from != NULL && p_to == NULL) {
+            return ERR_VAL;
+        }
+    }
+
+    return ERR_OK;
+}
+
+sys_prot_t sys_arch_protect(void)
+{
+    return (sys_prot_t)s_protect++;
+}
+
+void sys_arch_unprotect(sys_prot_t pval)
+{
+    HOST_CHECK(s_protect > 0 && (u32_t)pval == s_protect - 1);
+
+    s_protect = (u32_t)pval;
+}
@@ -0,0 +1,30 @@
+//
+// Host mocks for the part of the lwIP core the zero-copy EMAC rings depend on: a reference
+// counted pbuf implementation with lwIP 1.4 semantics, and sys_arch_protect. The lwIP core
+// sources are not part of the tree, only its headers.
+//
+// Pbufs come from a static arena, so that they stay below 4GB like on the device, where the
+// rings hand payload addresses to the DMA as uint32_t.
+//
+
+#pragma once
+
+#include "lwip/pbuf.h"
+#include "lwip/sys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Largest pbuf_alloc'ed payload. */
+#define MOCK_PBUF_MAX_SIZE   1536
+
+/** Number of pbufs allocated with pbuf_alloc and not freed yet. */
+u32_t MockPbuf_Live(void);
+
+/** Current sys_arch_protect nesting. */
+u32_t MockProtect_Depth(void);
+
+#ifdef __cplusplus
+}
+#endif
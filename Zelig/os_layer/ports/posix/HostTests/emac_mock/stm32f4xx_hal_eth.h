@@ -0,0 +1,41 @@
+//
+// Stand-in for the STM32F4 HAL Ethernet header: just the DMA descriptor layout, the descriptor
+// bits and the buffer counts the zero-copy ring uses, with the values of the real HAL
+// (mbed/TARGET_NUCLEO_F411RE/stm32f4xx_hal_eth.h and stm32f4xx_hal_conf.h).
+//
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct
+{
+    volatile uint32_t Status;
+    uint32_t          ControlBufferSize;
+    uint32_t          Buffer1Addr;
+    uint32_t          Buffer2NextDescAddr;
+    uint32_t          ExtendedStatus;
+    uint32_t          Reserved1;
+    uint32_t          TimeStampLow;
+    uint32_t          TimeStampHigh;
+} ETH_DMADescTypeDef;
+
+#define ETH_RXBUFNB                             ((uint32_t)4)
+#define ETH_MAX_PACKET_SIZE                     ((uint32_t)1524)
+
+#define ETH_DMATXDESC_OWN                       ((uint32_t)0x80000000)
+#define ETH_DMATXDESC_IC                        ((uint32_t)0x40000000)
+#define ETH_DMATXDESC_LS                        ((uint32_t)0x20000000)
+#define ETH_DMATXDESC_FS                        ((uint32_t)0x10000000)
+#define ETH_DMATXDESC_TCH                       ((uint32_t)0x00100000)
+#define ETH_DMATXDESC_TBS1                      ((uint32_t)0x00001FFF)
+#define ETH_DMATXDESC_CHECKSUMTCPUDPICMPFULL    ((uint32_t)0x00C00000)
+
+#define ETH_DMARXDESC_OWN                       ((uint32_t)0x80000000)
+#define ETH_DMARXDESC_FL                        ((uint32_t)0x3FFF0000)
+#define ETH_DMARXDESC_ES                        ((uint32_t)0x00008000)
+#define ETH_DMARXDESC_FS                        ((uint32_t)0x00000200)
+#define ETH_DMARXDESC_LS                        ((uint32_t)0x00000100)
+#define ETH_DMARXDESC_RCH                       ((uint32_t)0x00004000)
+#define ETH_DMARXDESC_RBS1                      ((uint32_t)0x00001FFF)
+#define ETH_DMARXDESC_FRAMELENGTHSHIFT          ((uint32_t)16)
@@ -0,0 +1,12 @@
+//
+// Host stand-in for the LPC17xx device header, only what the mbed port needs from CMSIS.
+//
+
+#ifndef __LPC17xx_H__
+#define __LPC17xx_H__
+
+#define __CORTEX_M 0x03
+
+#include "core_cmFunc.h"
+
+#endif // __LPC17xx_H__
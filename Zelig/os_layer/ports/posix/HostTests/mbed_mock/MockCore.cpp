@@ -0,0 +1,78 @@
+//
+// CMSIS and managed heap mocks, see MockMbed.h.
+//
+
+#include "MockMbed.h"
+#include "HostTest.h"
+
+#include <string.h>
+
+#define LLOS_MEMSET memset
+#include <llos_memory.h>
+
+volatile uint32_t g_MockPrimask = 0;
+void (*g_MockWfiHook)(void)     = nullptr;
+
+//--//
+
+static const uint32_t c_HeapSize = 1024 * 1024;
+
+static uint8_t  s_heap[c_HeapSize] __attribute__((aligned(8)));
+static uint32_t s_heapTop;
+static uint32_t s_liveBlocks;
+static uint32_t s_allocations;
+
+void MockHeap_Reset()
+{
+    s_heapTop     = 0;
+    s_liveBlocks  = 0;
+    s_allocations = 0;
+}
+
+uint32_t MockHeap_LiveBlocks()
+{
+    return s_liveBlocks;
+}
+
+uint32_t MockHeap_Allocations()
+{
+    return s_allocations;
+}
+
+LLOS_Opaque AllocateFromManagedHeap(uint32_t size)
+{
+    uint8_t* pBlock;
+
+    HOST_CHECK(g_MockPrimask == 0);
+
+    size = (size + 7) & ~7u;
+
+    if (s_heapTop + size > c_HeapSize)
+    {
+        return nullptr;
+    }
+
+    // Freed blocks are never reused, so that a stale pointer never aliases a newer block.
+    pBlock     = &s_heap[s_heapTop];
+    s_heapTop += size;
+
+    s_liveBlocks++;
+    s_allocations++;
+
+    memset(pBlock, 0, size);
+
+    return pBlock;
+}
+
+VOID FreeFromManagedHeap(LLOS_Opaque address)
+{
+    HOST_CHECK(g_MockPrimask == 0);
+
+    if (address != nullptr)
+    {
+        HOST_CHECK((uint8_t*)address >= s_heap && (uint8_t*)address < &s_heap[s_heapTop]);
+        HOST_CHECK(s_liveBlocks > 0);
+
+        s_liveBlocks--;
+    }
+}
@@ -0,0 +1,50 @@
+//
+// Host mocks for the mbed HAL and the runtime services the mbed port depends on. The port
+// sources are compiled unchanged against the real HAL headers, with device.h, LPC17xx.h and
+// core_cmFunc.h from this directory standing in for the target specific ones.
+//
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "core_cmFunc.h"
+#include "serial_api.h"
+#include "i2c_api.h"
+
+//
+// Managed heap. Blocks come from a static arena and are never reused. Allocating or freeing
+// with interrupts disabled fails the test.
+//
+void     MockHeap_Reset      ();
+uint32_t MockHeap_LiveBlocks ();
+uint32_t MockHeap_Allocations();
+
+//
+// UART with an unbounded receive FIFO filled by MockSerial_Receive, a transmit holding
+// register and a transmit shift register. Every call to MockSerial_Tick is one character
+// time on the line, after which the enabled interrupts that are pending are delivered.
+// Polling serial_writable on a busy transmitter lets one character time go by as well.
+//
+void                          MockSerial_Reset       ();
+void                          MockSerial_Receive     (const uint8_t* data, uint32_t length);
+void                          MockSerial_Tick        ();
+bool                          MockSerial_HoldingEmpty();
+bool                          MockSerial_TxIdle      ();
+bool                          MockSerial_TxIrqEnabled();
+const std::vector< uint8_t >& MockSerial_Line        ();
+
+//
+// I2C bus with a single slave. Every bus condition and byte is appended to a trace:
+// "S" start, "Sr" repeated start, "P" stop, "@xx" address byte, "xx" byte written by the
+// master, "<xx" byte read by the master, "N" the slave did not acknowledge the previous byte.
+// The slave acknowledges its address and the first nackAfter data bytes written to it, does
+// not acknowledge the next one (never if nackAfter is -1), and returns readData, repeated as
+// needed, to reads.
+//
+void               MockI2C_Reset     ();
+void               MockI2C_SetSlave  (uint8_t address, int32_t nackAfter, const std::vector< uint8_t >& readData);
+bool               MockI2C_BusClaimed();
+const std::string& MockI2C_Trace     ();
@@ -0,0 +1,217 @@
+//
+// Simulated UART behind the mbed serial HAL, see MockMbed.h.
+//
+
+#include "MockMbed.h"
+#include "HostTest.h"
+
+#include <deque>
+
+struct MockUart
+{
+    std::deque< uint8_t >  RxFifo;
+    bool                   HoldingFull;
+    uint8_t                Holding;
+    bool                   ShiftBusy;
+    uint8_t                Shift;
+    std::vector< uint8_t > Line;
+
+    bool                   RxIrq;
+    bool                   TxIrq;
+    uart_irq_handler       Handler;
+    uint32_t               Id;
+};
+
+static MockUart s_uart;
+
+static void ElapseCharacterTime()
+{
+    if (s_uart.ShiftBusy)
+    {
+        s_uart.Line.push_back(s_uart.Shift);
+        s_uart.ShiftBusy = false;
+    }
+
+    if (s_uart.HoldingFull)
+    {
+        s_uart.Shift       = s_uart.Holding;
+        s_uart.ShiftBusy   = true;
+        s_uart.HoldingFull = false;
+    }
+}
+
+static void DeliverInterrupts()
+{
+    if (s_uart.Handler == nullptr)
+    {
+        return;
+    }
+
+    if (s_uart.RxIrq && !s_uart.RxFifo.empty())
+    {
+        s_uart.Handler(s_uart.Id, RxIrq);
+    }
+
+    if (s_uart.TxIrq && !s_uart.HoldingFull)
+    {
+        s_uart.Handler(s_uart.Id, TxIrq);
+    }
+}
+
+//--//
+
+void MockSerial_Reset()
+{
+    s_uart = MockUart();
+}
+
+void MockSerial_Receive(const uint8_t* data, uint32_t length)
+{
+    s_uart.RxFifo.insert(s_uart.RxFifo.end(), data, data + length);
+
+    DeliverInterrupts();
+}
+
+void MockSerial_Tick()
+{
+    ElapseCharacterTime();
+
+    DeliverInterrupts();
+}
+
+bool MockSerial_HoldingEmpty()
+{
+    return !s_uart.HoldingFull;
+}
+
+bool MockSerial_TxIdle()
+{
+    return !s_uart.HoldingFull && !s_uart.ShiftBusy;
+}
+
+bool MockSerial_TxIrqEnabled()
+{
+    return s_uart.TxIrq;
+}
+
+const std::vector< uint8_t >& MockSerial_Line()
+{
+    return s_uart.Line;
+}
+
+//--//
+
+void serial_init(serial_t *obj, PinName tx, PinName rx)
+{
+    (void)tx;
+    (void)rx;
+
+    obj->index = 0;
+}
+
+void serial_free(serial_t *obj)
+{
+    (void)obj;
+
+    s_uart.Handler = nullptr;
+}
+
+void serial_baud(serial_t *obj, int baudrate)
+{
+    (void)obj;
+
+    HOST_CHECK(baudrate > 0);
+}
+
+void serial_format(serial_t *obj, int data_bits, SerialParity parity, int stop_bits)
+{
+    (void)obj;
+    (void)parity;
+    (void)stop_bits;
+
+    HOST_CHECK(data_bits >= 5 && data_bits <= 9);
+}
+
+void serial_irq_handler(serial_t *obj, uart_irq_handler handler, uint32_t id)
+{
+    (void)obj;
+
+    s_uart.Handler = handler;
+    s_uart.Id      = id;
+}
+
+void serial_irq_set(serial_t *obj, SerialIrq irq, uint32_t enable)
+{
+    (void)obj;
+
+    if (irq == RxIrq)
+    {
+        s_uart.RxIrq = enable != 0;
+    }
+    else
+    {
+        s_uart.TxIrq = enable != 0;
+    }
+}
+
+int serial_getc(serial_t *obj)
+{
+    uint8_t c;
+
+    (void)obj;
+
+    HOST_CHECK(!s_uart.RxFifo.empty());
+
+    c = s_uart.RxFifo.front();
+    s_uart.RxFifo.pop_front();
+
+    return c;
+}
+
+void serial_putc(serial_t *obj, int c)
+{
+    // Like the real HAL, blocks until the holding register is free.
+    while (!serial_writable(obj))
+    {
+    }
+
+    s_uart.Holding     = (uint8_t)c;
+    s_uart.HoldingFull = true;
+}
+
+int serial_readable(serial_t *obj)
+{
+    (void)obj;
+
+    return !s_uart.RxFifo.empty();
+}
+
+int serial_writable(serial_t *obj)
+{
+    (void)obj;
+
+    if (s_uart.HoldingFull)
+    {
+        ElapseCharacterTime();
+
+        return 0;
+    }
+
+    return 1;
+}
+
+void serial_clear(serial_t *obj)
+{
+    (void)obj;
+
+    s_uart.RxFifo.clear();
+    s_uart.HoldingFull = false;
+}
+
+void serial_set_flow_control(serial_t *obj, FlowControl type, PinName rxflow, PinName txflow)
+{
+    (void)obj;
+    (void)type;
+    (void)rxflow;
+    (void)txflow;
+}
@@ -0,0 +1,40 @@
+//
+// Host stand-in for the CMSIS core intrinsics. PRIMASK is a plain variable, and WFI calls
+// the hook installed by the test, which is where the test delivers simulated interrupts.
+//
+
+#ifndef __CORE_CMFUNC_H
+#define __CORE_CMFUNC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern volatile uint32_t g_MockPrimask;
+extern void (*g_MockWfiHook)(void);
+
+static inline uint32_t __get_PRIMASK(void)            { return g_MockPrimask; }
+static inline void     __set_PRIMASK(uint32_t primask) { g_MockPrimask = primask; }
+static inline void     __disable_irq(void)            { g_MockPrimask = 1; }
+static inline void     __enable_irq(void)             { g_MockPrimask = 0; }
+
+static inline void __WFI(void)
+{
+    if (g_MockWfiHook != 0)
+    {
+        g_MockWfiHook();
+    }
+}
+
+static inline void __NOP(void) { }
+static inline void __DSB(void) { __sync_synchronize(); }
+static inline void __DMB(void) { __sync_synchronize(); }
+static inline void __ISB(void) { __sync_synchronize(); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CORE_CMFUNC_H
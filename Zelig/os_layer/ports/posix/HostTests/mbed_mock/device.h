@@ -0,0 +1,55 @@
+//
+// Host stand-in for the per target device.h of the mbed SDK: enables the HAL APIs used by
+// the mbed port and gives each HAL object type a minimal definition, so that the port
+// sources can be compiled against the real mbed HAL headers and the mocks in MockMbed.h.
+//
+
+#ifndef MBED_DEVICE_H
+#define MBED_DEVICE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define DEVICE_ANALOGIN     1
+#define DEVICE_ANALOGOUT    1
+#define DEVICE_INTERRUPTIN  1
+#define DEVICE_PWMOUT       1
+#define DEVICE_SERIAL       1
+#define DEVICE_SERIAL_FC    1
+#define DEVICE_SPI          1
+#define DEVICE_I2C          1
+
+typedef enum
+{
+    NC = (int)0xFFFFFFFF,
+} PinName;
+
+typedef enum
+{
+    PIN_INPUT,
+    PIN_OUTPUT,
+} PinDirection;
+
+typedef enum
+{
+    PullNone,
+    PullUp,
+    PullDown,
+    PullDefault = PullNone,
+} PinMode;
+
+typedef struct
+{
+    PinName  pin;
+    uint32_t value;
+} gpio_t;
+
+struct gpio_irq_s { uint32_t id; };
+struct analogin_s { PinName pin; };
+struct dac_s      { PinName pin; };
+struct pwmout_s   { PinName pin; };
+struct serial_s   { uint32_t index; };
+struct spi_s      { uint32_t index; };
+struct i2c_s      { uint32_t index; };
+
+#endif // MBED_DEVICE_H
@@ -0,0 +1,136 @@
+//
+// sys_arch mocks for the native mailboxes, see MockSysArch.h.
+//
+
+#include "MockSysArch.h"
+#include "HostTest.h"
+
+#include <stdarg.h>
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+struct os_semaphore_cb
+{
+    std::mutex              lock;
+    std::condition_variable signaled;
+    u32_t                   count;
+};
+
+static std::recursive_mutex s_protect;
+static std::atomic<u32_t>   s_liveSems;
+static void               (*s_timeoutHook)(sys_sem_t *sem);
+
+//--//
+
+extern "C" u32_t MockSem_Count(sys_sem_t *sem)
+{
+    std::lock_guard<std::mutex> guard(sem->id->lock);
+
+    return sem->id->count;
+}
+
+extern "C" u32_t MockSem_Live(void)
+{
+    return s_liveSems;
+}
+
+extern "C" void MockSem_SetTimeoutHook(void (*hook)(sys_sem_t *sem))
+{
+    s_timeoutHook = hook;
+}
+
+extern "C" err_t sys_sem_new(sys_sem_t *sem, u8_t count)
+{
+    sem->id        = new os_semaphore_cb();
+    sem->id->count = count;
+
+    s_liveSems++;
+
+    return ERR_OK;
+}
+
+extern "C" void sys_sem_free(sys_sem_t *sem)
+{
+    HOST_CHECK(sem->id != NULL);
+
+    delete sem->id;
+    sem->id = NULL;
+
+    s_liveSems--;
+}
+
+extern "C" void sys_sem_signal(sys_sem_t *sem)
+{
+    {
+        std::lock_guard<std::mutex> guard(sem->id->lock);
+
+        sem->id->count++;
+    }
+
+    sem->id->signaled.notify_one();
+}
+
+// Like the device: 0 waits forever, otherwise the milliseconds spent waiting or SYS_ARCH_TIMEOUT.
+extern "C" u32_t sys_arch_sem_wait(sys_sem_t *sem, u32_t timeout)
+{
+    std::unique_lock<std::mutex> guard(sem->id->lock);
+    auto                         start = std::chrono::steady_clock::now();
+
+    if (timeout == 0)
+    {
+        sem->id->signaled.wait(guard, [sem] { return sem->id->count > 0; });
+    }
+    else if (!sem->id->signaled.wait_for(guard, std::chrono::milliseconds(timeout), [sem] { return sem->id->count > 0; }))
+    {
+        guard.unlock();
+
+        if (s_timeoutHook != NULL)
+        {
+            s_timeoutHook(sem);
+        }
+
+        return SYS_ARCH_TIMEOUT;
+    }
+
+    sem->id->count--;
+
+    return (u32_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+extern "C" sys_prot_t sys_arch_protect(void)
+{
+    s_protect.lock();
+
+    return 0;
+}
+
+extern "C" void sys_arch_unprotect(sys_prot_t pval)
+{
+    (void)pval;
+
+    s_protect.unlock();
+}
+
+extern "C" uint32_t sys_uSeconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+extern "C" void error(const char* format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+
+    exit(1);
+}
@@ -0,0 +1,29 @@
+//
+// Host mocks for what the native lwIP mailboxes (lwip-sys/arch/sys_arch_mbox.c) take from the rest of
+// the device sys_arch: the semaphores, sys_arch_protect and the microsecond clock. The mailbox code is
+// compiled unchanged against the device arch/sys_arch.h and cmsis_os.h; sys_sem_t keeps its device
+// layout, with 'id' pointing at a host semaphore.
+//
+// sys_arch_protect stands for masking interrupts: one lock shared by every thread, which may nest.
+//
+
+#pragma once
+
+#include "lwip/sys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Tokens currently held by a semaphore. */
+u32_t MockSem_Count(sys_sem_t *sem);
+
+/** Number of semaphores created and not freed yet. */
+u32_t MockSem_Live(void);
+
+/** Called by a timed sys_arch_sem_wait that expired, just before it returns SYS_ARCH_TIMEOUT. */
+void MockSem_SetTimeoutHook(void (*hook)(sys_sem_t *sem));
+
+#ifdef __cplusplus
+}
+#endif
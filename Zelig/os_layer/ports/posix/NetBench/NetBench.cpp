@@ -0,0 +1,445 @@
+//
+// Copyright (c) Microsoft Corporation.    All rights reserved.
+//
+
+//
+// iperf-style TCP/UDP throughput benchmark for the lwIP stack and the LLOS_lwip_* interop layer
+// (os_layer/ports/mbed/mbed_socket.cpp), running on the host netif in lwip/lwip-eth/arch/TARGET_HOST.
+//
+// Build with TARGET_HOST defined, lwip/lwip-sys/TARGET_HOST ahead of lwip/lwip-sys on the include path, and link
+// this file, mbed_socket.cpp, the host netif and sys_arch, and the lwIP core sources. Then, without privileges:
+//
+//   NetBench -d pair:/tmp/nb0,/tmp/nb1 -a 10.0.0.1 -s &
+//   NetBench -d pair:/tmp/nb1,/tmp/nb0 -a 10.0.0.2 -c 10.0.0.1 -t 10 -b 50
+//
+// Add -u for UDP. With -b, the exit code is 2 when the measured throughput is below the given Mbit/s, so that a CI
+// job catches regressions. A TAP device (-d tap:tap0) lets a host iperf or netcat be the other end instead.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "lwip/tcpip.h"
+#include "lwip/netif.h"
+#include "lwip/inet.h"
+#include "lwip/sockets.h"
+#include "eth_arch.h"
+#include "host_emac_config.h"
+
+extern "C"
+{
+    // Exported by mbed_socket.cpp, with the same signatures the managed SocketNative imports.
+    int32_t LLOS_lwip_socket(int32_t family, int32_t type, int32_t protocol);
+    int32_t LLOS_lwip_bind(int32_t socket, void* address);
+    int32_t LLOS_lwip_connect(int32_t socket, void* address, bool fThrowOnWouldBlock);
+    int32_t LLOS_lwip_listen(int32_t socket, int32_t backlog);
+    int32_t LLOS_lwip_accept(int32_t socket, void* address, uint32_t* addrlen);
+    int32_t LLOS_lwip_send(int32_t socket, char* buf, int32_t count, int32_t flags, int32_t time_ms);
+    int32_t LLOS_lwip_recv(int32_t socket, char* buf, int32_t count, int32_t flags, int32_t time_ms);
+    int32_t LLOS_lwip_sendto(int32_t socket, char* buf, int32_t count, int32_t flags, int32_t time_ms, void* address, uint32_t tolen);
+    int32_t LLOS_lwip_recvfrom(int32_t socket, char* buf, int32_t count, int32_t flags, int32_t time_ms, void* address, uint32_t* fromlen);
+    int32_t LLOS_lwip_close(int32_t socket);
+}
+
+#define NETBENCH_DEFAULT_PORT       5001
+#define NETBENCH_DEFAULT_SECONDS    10
+#define NETBENCH_DEFAULT_LENGTH     1460
+#define NETBENCH_MAX_LENGTH         (64 * 1024)
+#define NETBENCH_LINK_TIMEOUT_MS    5000
+#define NETBENCH_UDP_IDLE_MS        2000
+#define NETBENCH_UDP_END_MARKER     0xFFFFFFFF
+#define NETBENCH_UDP_END_COUNT      10
+
+typedef struct NetBenchOptions
+{
+    const char* Device;
+    const char* Address;
+    const char* Netmask;
+    const char* Server;
+    bool        Udp;
+    uint16_t    Port;
+    int32_t     Seconds;
+    int32_t     Length;
+    double      MinimumMbps;
+} NetBenchOptions;
+
+// mbed_socket.cpp borrows this from mbed_ethernet.cpp, which is not part of the host build.
+int32_t WStringToCharBuffer(char* output, uint32_t outputBufferLength, const uint16_t* input, const uint32_t length)
+{
+    if (length > outputBufferLength)
+    {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        output[i] = (input[i] > 0xFF) ? '?' : (char)input[i];
+    }
+
+    return (int32_t)length;
+}
+
+static struct netif g_netif;
+static sys_sem_t    g_ready;
+static char         g_buffer[NETBENCH_MAX_LENGTH];
+
+static uint64_t NowMicroseconds()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+
+//
+// Fills 'address' with the managed SocketAddress layout that LLOS_lwip_bind/connect/sendto expect: family (little
+// endian), port (big endian), IPv4 address (network order).
+//
+static void MakeSocketAddress(uint8_t* address, uint32_t ip, uint16_t port)
+{
+    memset(address, 0, 16);
+
+    address[0] = AF_INET;
+    address[2] = (uint8_t)(port >> 8);
+    address[3] = (uint8_t)port;
+    memcpy(&address[4], &ip, 4);
+}
+
+static void TcpipInitDone(void* arg)
+{
+    sys_sem_signal((sys_sem_t*)arg);
+}
+
+static void LinkCallback(struct netif* netif)
+{
+    if (netif_is_link_up(netif))
+    {
+        sys_sem_signal(&g_ready);
+    }
+}
+
+// Same sequence as EthernetInterface::init/connect with a static address.
+static bool StartNetwork(const NetBenchOptions* pOptions)
+{
+    ip_addr_t ip;
+    ip_addr_t mask;
+    ip_addr_t gateway;
+
+    if (pOptions->Device != nullptr && host_emac_set_device(pOptions->Device) != 0)
+    {
+        fprintf(stderr, "Bad device '%s'\n", pOptions->Device);
+        return false;
+    }
+
+    if (!inet_aton(pOptions->Address, &ip) || !inet_aton(pOptions->Netmask, &mask))
+    {
+        fprintf(stderr, "Bad address or netmask\n");
+        return false;
+    }
+
+    ip_addr_set_zero(&gateway);
+
+    sys_sem_new(&g_ready, 0);
+
+    tcpip_init(TcpipInitDone, &g_ready);
+    sys_arch_sem_wait(&g_ready, 0);
+
+    if (netif_add(&g_netif, &ip, &mask, &gateway, nullptr, eth_arch_enetif_init, tcpip_input) == nullptr)
+    {
+        return false;
+    }
+
+    netif_set_default(&g_netif);
+    netif_set_link_callback(&g_netif, LinkCallback);
+
+    eth_arch_enable_interrupts();
+    netif_set_up(&g_netif);
+
+    if (!netif_is_link_up(&g_netif) && sys_arch_sem_wait(&g_ready, NETBENCH_LINK_TIMEOUT_MS) == SYS_ARCH_TIMEOUT)
+    {
+        fprintf(stderr, "Link did not come up\n");
+        return false;
+    }
+
+    return true;
+}
+
+static double Report(const char* what, uint64_t bytes, uint64_t elapsedUs)
+{
+    double mbps = (elapsedUs == 0) ? 0.0 : (double)bytes * 8.0 / (double)elapsedUs;
+
+    printf("%s: %llu bytes in %.3f s, %.2f Mbit/s\n", what, (unsigned long long)bytes, elapsedUs / 1000000.0, mbps);
+
+    return mbps;
+}
+
+static double TcpServer(const NetBenchOptions* pOptions)
+{
+    uint8_t  address[16];
+    uint8_t  peer[16];
+    uint32_t peerLength = sizeof(peer);
+    int32_t  listener   = LLOS_lwip_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    int32_t  connection;
+    uint64_t bytes = 0;
+    uint64_t start;
+    int32_t  received;
+
+    MakeSocketAddress(address, INADDR_ANY, pOptions->Port);
+
+    if (listener < 0 || LLOS_lwip_bind(listener, address) != 0 || LLOS_lwip_listen(listener, 1) != 0)
+    {
+        fprintf(stderr, "Cannot listen on port %u\n", pOptions->Port);
+        return -1.0;
+    }
+
+    connection = LLOS_lwip_accept(listener, peer, &peerLength);
+    LLOS_lwip_close(listener);
+
+    if (connection < 0)
+    {
+        return -1.0;
+    }
+
+    start = NowMicroseconds();
+
+    while ((received = LLOS_lwip_recv(connection, g_buffer, pOptions->Length, 0, 0)) > 0)
+    {
+        bytes += received;
+    }
+
+    LLOS_lwip_close(connection);
+
+    return Report("TCP receive", bytes, NowMicroseconds() - start);
+}
+
+static double TcpClient(const NetBenchOptions* pOptions, uint32_t server)
+{
+    uint8_t  address[16];
+    int32_t  socket = LLOS_lwip_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    uint64_t bytes  = 0;
+    uint64_t start;
+    uint64_t end;
+    int32_t  sent;
+
+    MakeSocketAddress(address, server, pOptions->Port);
+
+    if (socket < 0 || LLOS_lwip_connect(socket, address, false) != 0)
+    {
+        fprintf(stderr, "Cannot connect to %s:%u\n", pOptions->Server, pOptions->Port);
+        return -1.0;
+    }
+
+    start = NowMicroseconds();
+    end   = start + (uint64_t)pOptions->Seconds * 1000000;
+
+    while (NowMicroseconds() < end)
+    {
+        sent = LLOS_lwip_send(socket, g_buffer, pOptions->Length, 0, 0);
+        if (sent <= 0)
+        {
+            break;
+        }
+        bytes += sent;
+    }
+
+    LLOS_lwip_close(socket);
+
+    return Report("TCP send", bytes, NowMicroseconds() - start);
+}
+
+//
+// UDP datagrams carry a sequence number in their first four bytes, the receiver reports the loss from the gaps. The
+// sender finishes with a burst of end markers; the receiver also gives up after NETBENCH_UDP_IDLE_MS of silence.
+//
+static double UdpServer(const NetBenchOptions* pOptions)
+{
+    uint8_t  address[16];
+    uint8_t  peer[16];
+    uint32_t peerLength;
+    int32_t  socket   = LLOS_lwip_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    uint64_t bytes    = 0;
+    uint32_t datagrams = 0;
+    uint32_t highest  = 0;
+    uint64_t start    = 0;
+    uint64_t last     = 0;
+    int32_t  received;
+    uint32_t sequence;
+    double   mbps;
+
+    MakeSocketAddress(address, INADDR_ANY, pOptions->Port);
+
+    if (socket < 0 || LLOS_lwip_bind(socket, address) != 0)
+    {
+        fprintf(stderr, "Cannot bind port %u\n", pOptions->Port);
+        return -1.0;
+    }
+
+    while (true)
+    {
+        peerLength = sizeof(peer);
+        received   = LLOS_lwip_recvfrom(socket, g_buffer, pOptions->Length, 0, (start == 0) ? 0 : NETBENCH_UDP_IDLE_MS, peer, &peerLength);
+
+        if (received < 4)
+        {
+            break;
+        }
+
+        memcpy(&sequence, g_buffer, 4);
+        if (sequence == NETBENCH_UDP_END_MARKER)
+        {
+            break;
+        }
+
+        last = NowMicroseconds();
+        if (start == 0)
+        {
+            start = last;
+            continue;
+        }
+
+        bytes += received;
+        datagrams++;
+        if (sequence > highest)
+        {
+            highest = sequence;
+        }
+    }
+
+    LLOS_lwip_close(socket);
+
+    mbps = Report("UDP receive", bytes, last - start);
+    printf("UDP loss: %u of %u datagrams\n", (highest > datagrams) ? highest - datagrams : 0, highest);
+
+    return mbps;
+}
+
+static double UdpClient(const NetBenchOptions* pOptions, uint32_t server)
+{
+    uint8_t  address[16];
+    int32_t  socket   = LLOS_lwip_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    uint64_t bytes    = 0;
+    uint32_t sequence = 0;
+    uint32_t marker   = NETBENCH_UDP_END_MARKER;
+    uint64_t start;
+    uint64_t end;
+    int32_t  sent;
+
+    MakeSocketAddress(address, server, pOptions->Port);
+
+    if (socket < 0)
+    {
+        return -1.0;
+    }
+
+    start = NowMicroseconds();
+    end   = start + (uint64_t)pOptions->Seconds * 1000000;
+
+    // Datagram 0 only starts the receiver's clock, it is not counted on either side.
+    while (NowMicroseconds() < end)
+    {
+        memcpy(g_buffer, &sequence, 4);
+
+        sent = LLOS_lwip_sendto(socket, g_buffer, pOptions->Length, 0, 0, address, sizeof(address));
+        if (sent > 0 && sequence++ != 0)
+        {
+            bytes += sent;
+        }
+    }
+
+    memcpy(g_buffer, &marker, 4);
+    for (int i = 0; i < NETBENCH_UDP_END_COUNT; i++)
+    {
+        LLOS_lwip_sendto(socket, g_buffer, 4, 0, 0, address, sizeof(address));
+    }
+
+    LLOS_lwip_close(socket);
+
+    return Report("UDP send", bytes, NowMicroseconds() - start);
+}
+
+static void Usage()
+{
+    fprintf(stderr,
+        "NetBench -a <address> [-n <netmask>] [-d tap:<name> | -d pair:<local>,<peer>]\n"
+        "         (-s | -c <server>) [-u] [-p <port>] [-t <seconds>] [-l <length>] [-b <minimum Mbit/s>]\n");
+}
+
+int main(int argc, char** argv)
+{
+    NetBenchOptions options;
+    uint32_t        server = 0;
+    bool            isServer = false;
+    double          mbps;
+    int             opt;
+
+    memset(&options, 0, sizeof(options));
+    options.Netmask = "255.255.255.0";
+    options.Port    = NETBENCH_DEFAULT_PORT;
+    options.Seconds = NETBENCH_DEFAULT_SECONDS;
+    options.Length  = NETBENCH_DEFAULT_LENGTH;
+
+    while ((opt = getopt(argc, argv, "a:n:d:sc:up:t:l:b:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'a': options.Address     = optarg;                         break;
+        case 'n': options.Netmask     = optarg;                         break;
+        case 'd': options.Device      = optarg;                         break;
+        case 's': isServer            = true;                           break;
+        case 'c': options.Server      = optarg;                         break;
+        case 'u': options.Udp         = true;                           break;
+        case 'p': options.Port        = (uint16_t)atoi(optarg);         break;
+        case 't': options.Seconds     = atoi(optarg);                   break;
+        case 'l': options.Length      = atoi(optarg);                   break;
+        case 'b': options.MinimumMbps = atof(optarg);                   break;
+        default:  Usage();                                              return 1;
+        }
+    }
+
+    if (options.Address == nullptr || isServer == (options.Server != nullptr) ||
+        options.Length < 4 || options.Length > NETBENCH_MAX_LENGTH || options.Seconds <= 0)
+    {
+        Usage();
+        return 1;
+    }
+
+    if (options.Server != nullptr && (server = inet_addr(options.Server)) == INADDR_NONE)
+    {
+        Usage();
+        return 1;
+    }
+
+    if (!StartNetwork(&options))
+    {
+        return 1;
+    }
+
+    memset(g_buffer, 0x5A, sizeof(g_buffer));
+
+    if (isServer)
+    {
+        mbps = options.Udp ? UdpServer(&options) : TcpServer(&options);
+    }
+    else
+    {
+        mbps = options.Udp ? UdpClient(&options, server) : TcpClient(&options, server);
+    }
+
+    if (mbps < 0.0)
+    {
+        return 1;
+    }
+
+    if (mbps < options.MinimumMbps)
+    {
+        fprintf(stderr, "Below the %.2f Mbit/s threshold\n", options.MinimumMbps);
+        return 2;
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "LlosPosix.h"
+#include <llos_clock.h>
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+
+uint64_t GetMonotonicMicroseconds()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000ull + (uint64_t)ts.tv_nsec / 1000ull;
+}
+
+uint64_t LLOS_CLOCK_GetClockTicks()
+{
+    return GetMonotonicMicroseconds();
+}
+
+uint64_t LLOS_CLOCK_GetClockFrequency()
+{
+    return 1000000; // 1us tick clock = 1MHz
+}
+
+uint64_t LLOS_CLOCK_GetPerformanceCounter()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t LLOS_CLOCK_GetPerformanceCounterFrequency()
+{
+    return 1000000000; // 1ns resolution
+}
+
+uint32_t LLOS_CLOCK_DelayCycles(uint32_t cycles)
+{
+    // There is no cycle counter we can rely on in user mode, so treat cycles as
+    // nanoseconds of the performance counter and spin.
+    uint64_t end = LLOS_CLOCK_GetPerformanceCounter() + cycles;
+
+    while (LLOS_CLOCK_GetPerformanceCounter() < end)
+    {
+    }
+
+    return cycles;
+}
+
+uint32_t LLOS_CLOCK_Delay(uint32_t microSeconds)
+{
+    struct timespec ts;
+
+    ts.tv_sec  = microSeconds / 1000000;
+    ts.tv_nsec = (microSeconds % 1000000) * 1000;
+
+    // clock_nanosleep returns the error rather than setting errno, only an interrupted
+    // sleep is worth resuming.
+    while (clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, &ts) == EINTR)
+    {
+    }
+
+    return microSeconds;
+}
+
+VOID LLOS_CLOCK_Idle()
+{
+    // The host scheduler owns the processor, idling is just giving up the rest of the time slice.
+    sched_yield();
+}
+
+HRESULT LLOS_CLOCK_GetIdleStatistics(uint32_t* pIdleMicroseconds, uint32_t* pActiveMicroseconds, uint64_t* pTotalIdleMicroseconds)
+{
+    LLOS__UNREFERENCED_PARAMETER(pIdleMicroseconds);
+    LLOS__UNREFERENCED_PARAMETER(pActiveMicroseconds);
+    LLOS__UNREFERENCED_PARAMETER(pTotalIdleMicroseconds);
+
+    return LLOS_E_NOT_SUPPORTED;
+}
@@ -0,0 +1,24 @@
+#include "LlosPosix.h"
+#include <llos_debug.h>
+#include <signal.h>
+
+VOID LLOS_DEBUG_Break(uint32_t code)
+{
+    LLOS__UNREFERENCED_PARAMETER(code);
+
+    raise(SIGTRAP);
+}
+
+VOID LLOS_DEBUG_LogText(wchar_t* text, int32_t textLength)
+{
+    // Managed strings are UTF-16, while wchar_t is 32 bits wide on Linux.
+    const uint16_t* chars = (const uint16_t*)text;
+
+    for (int32_t i = 0; i < textLength; i++)
+    {
+        uint16_t ch = chars[i];
+        putchar((ch > 0xFF) ? '?' : (char)ch);
+    }
+
+    printf("\r\n");
+}
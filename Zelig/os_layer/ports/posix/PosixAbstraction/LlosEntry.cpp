@@ -0,0 +1,31 @@
+#include "LlosPosix.h"
+#include <llos_mutex.h>
+
+pthread_key_t g_tlsKey;
+
+int LlosPosix_Main()
+{
+    pthread_key_create(&g_tlsKey, nullptr);
+
+    // The main thread has no LLOS_THREAD_CreateThread handle, give it an empty one so
+    // that waits, signals and lock ownership behave the same as on created threads.
+    LlosThread* pMainThread = (LlosThread*)calloc(1, sizeof(LlosThread));
+
+    if (pMainThread == nullptr)
+    {
+        return 1;
+    }
+
+    pMainThread->hndThread = pthread_self();
+    pMainThread->fStarted  = TRUE;
+    pthread_setspecific(g_tlsKey, pMainThread);
+
+    LLILUM_main();
+
+    pthread_setspecific(g_tlsKey, nullptr);
+    free(pMainThread);
+
+    pthread_key_delete(g_tlsKey);
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include "LlosPosix.h"
+#include <llos_mutex.h>
+
+extern "C"
+{
+    // Enable this macro to shift object pointers from the beginning of the header to the beginning of the payload.
+#define CANONICAL_OBJECT_POINTERS
+
+    struct Object;
+
+    struct ObjectHeader
+    {
+        int32_t MultiUseWord;
+        void* VTable;
+
+        inline Object* get_Object()
+        {
+#ifdef CANONICAL_OBJECT_POINTERS
+            return reinterpret_cast<Object*>(this + 1);
+#else // CANONICAL_OBJECT_POINTERS
+            return reinterpret_cast<Object*>(this);
+#endif // CANONICAL_OBJECT_POINTERS
+        }
+    };
+
+    struct Object
+    {
+        inline ObjectHeader* get_Header()
+        {
+#ifdef CANONICAL_OBJECT_POINTERS
+            return reinterpret_cast<ObjectHeader*>(this) - 1;
+#else // CANONICAL_OBJECT_POINTERS
+            return reinterpret_cast<ObjectHeader*>(this);
+#endif // CANONICAL_OBJECT_POINTERS
+        }
+    };
+
+    extern "C"
+    {
+
+        // Must match consts defined in ObjectHeader.cs
+#define REFERENCE_COUNT_MASK  0xFF000000
+#define REFERENCE_COUNT_SHIFT 24
+
+        // Define LLOS_REFCOUNT_USE_GLOBAL_LOCK to go back to serializing every reference count update on
+        // the global kernel mutex. HostTests builds RefCountBenchmark both ways to compare the two.
+
+#ifdef LLOS_REFCOUNT_USE_GLOBAL_LOCK
+
+        // Helpers for starting / ending section of code that needs to be atomic
+        __inline void StartAtomicOperations(Object** target)
+        {
+            LLOS__UNREFERENCED_PARAMETER(target);
+
+            LLOS_MUTEX_Acquire(g_globalMutex, -1);
+        }
+
+        __inline void EndAtomicOperations(Object** target)
+        {
+            LLOS__UNREFERENCED_PARAMETER(target);
+
+            LLOS_MUTEX_Release(g_globalMutex);
+        }
+
+#else // LLOS_REFCOUNT_USE_GLOBAL_LOCK
+
+        //
+        // Operations that read a slot and then touch the object it points to (load + addref,
+        // exchange, compare exchange) must not interleave with each other on the same slot,
+        // otherwise the object can be released between the load and the add ref. They take
+        // one of a small set of spin locks picked by slot address; plain add ref / release
+        // only use interlocked operations on the header.
+        //
+
+#define SLOT_LOCK_COUNT 64
+
+        struct __attribute__((aligned(64))) SlotLock
+        {
+            int32_t Taken;
+        };
+
+        static SlotLock s_slotLocks[SLOT_LOCK_COUNT];
+
+        __inline int32_t* GetSlotLock(Object** target)
+        {
+            return &s_slotLocks[((uintptr_t)target / sizeof(Object*)) % SLOT_LOCK_COUNT].Taken;
+        }
+
+        __inline void StartAtomicOperations(Object** target)
+        {
+            int32_t* lock = GetSlotLock(target);
+
+            while (__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE) != 0)
+            {
+                while (__atomic_load_n(lock, __ATOMIC_RELAXED) != 0)
+                {
+#if defined(__i386__) || defined(__x86_64__)
+                    __builtin_ia32_pause();
+#endif
+                }
+            }
+        }
+
+        __inline void EndAtomicOperations(Object** target)
+        {
+            __atomic_store_n(GetSlotLock(target), 0, __ATOMIC_RELEASE);
+        }
+
+#endif // LLOS_REFCOUNT_USE_GLOBAL_LOCK
+
+        __inline void AddReferenceFast(Object* target)
+        {
+            if (target != NULL)
+            {
+                int32_t* word = &target->get_Header()->MultiUseWord;
+                int32_t value = __atomic_load_n(word, __ATOMIC_RELAXED);
+
+                // On failure the compare exchange reloads value, so just retry.
+                while (value & REFERENCE_COUNT_MASK)
+                {
+                    if (__atomic_compare_exchange_n(word, &value, value + (1 << REFERENCE_COUNT_SHIFT), true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        void AddReference(Object* target)
+        {
+#ifdef LLOS_REFCOUNT_USE_GLOBAL_LOCK
+            StartAtomicOperations(nullptr);
+            AddReferenceFast(target);
+            EndAtomicOperations(nullptr);
+#else // LLOS_REFCOUNT_USE_GLOBAL_LOCK
+            AddReferenceFast(target);
+#endif // LLOS_REFCOUNT_USE_GLOBAL_LOCK
+        }
+
+        // Return zero when target is dead after the call
+        int ReleaseReferenceNative(Object* target)
+        {
+            int ret = 1;
+            if (target != NULL)
+            {
+                int32_t* word = &target->get_Header()->MultiUseWord;
+
+#ifdef LLOS_REFCOUNT_USE_GLOBAL_LOCK
+                StartAtomicOperations(nullptr);
+#endif // LLOS_REFCOUNT_USE_GLOBAL_LOCK
+
+                int32_t value = __atomic_load_n(word, __ATOMIC_RELAXED);
+
+                // Release ordering makes every write to the object visible to the thread that frees it.
+                while (value & REFERENCE_COUNT_MASK)
+                {
+                    int32_t newValue = value - (1 << REFERENCE_COUNT_SHIFT);
+
+                    if (__atomic_compare_exchange_n(word, &value, newValue, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+                    {
+                        ret = newValue & REFERENCE_COUNT_MASK;
+                        break;
+                    }
+                }
+
+#ifdef LLOS_REFCOUNT_USE_GLOBAL_LOCK
+                EndAtomicOperations(nullptr);
+#endif // LLOS_REFCOUNT_USE_GLOBAL_LOCK
+            }
+
+            return ret;
+        }
+
+        Object* LoadAndAddReferenceNative(Object** target)
+        {
+            StartAtomicOperations(target);
+
+            Object* value = __atomic_load_n(target, __ATOMIC_ACQUIRE);
+            AddReferenceFast(value);
+
+            EndAtomicOperations(target);
+
+            return value;
+        }
+
+        Object* ReferenceCountingExchange(Object** target, Object* value)
+        {
+            StartAtomicOperations(target);
+
+            Object* oldValue = __atomic_exchange_n(target, value, __ATOMIC_ACQ_REL);
+            AddReferenceFast(value);
+
+            EndAtomicOperations(target);
+
+            return oldValue;
+        }
+
+        Object* ReferenceCountingCompareExchange(Object** target, Object* value, Object* comparand)
+        {
+            StartAtomicOperations(target);
+
+            Object* oldValue = comparand;
+            __atomic_compare_exchange_n(target, &oldValue, value, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+            Object* addRefTarget;
+            if (oldValue == comparand)
+            {
+                // Compare exchange succeeded, we need to add ref the new value
+                // The old value's ref count will be passed back to the caller on return.
+                addRefTarget = value;
+            }
+            else
+            {
+                // Target is not changed, we need to add ref the old value so it has
+                // a ref count to pass back to caller on return
+                addRefTarget = oldValue;
+            }
+
+            AddReferenceFast(addRefTarget);
+
+            EndAtomicOperations(target);
+
+            return oldValue;
+        }
+    }
+}
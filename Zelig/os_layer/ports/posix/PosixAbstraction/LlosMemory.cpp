@@ -0,0 +1,115 @@
+#include "LlosPosix.h"
+#include <llos_memory.h>
+#include <sys/mman.h>
+
+// Every allocation is a private anonymous mapping prefixed by its length so that
+// LLOS_MEMORY_Free and LLOS_MEMORY_Reallocate can recover the mapping size.
+typedef struct LlosAllocationHeader
+{
+    size_t length;
+    size_t padding;
+} LlosAllocationHeader;
+
+// The managed memory manager keeps heap addresses in 32 bit fields, so ask for
+// mappings in the low 4GB where the kernel supports it.
+#if defined(MAP_32BIT)
+#define LLOS_MMAP_FLAGS (MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT)
+#else
+#define LLOS_MMAP_FLAGS (MAP_PRIVATE | MAP_ANONYMOUS)
+#endif
+
+static LlosAllocationHeader* GetAllocationHeader(LLOS_Opaque address)
+{
+    return ((LlosAllocationHeader*)address) - 1;
+}
+
+HRESULT LLOS_MEMORY_GetMaxHeapSize(uint32_t* pMaxHeapSize)
+{
+    if (pMaxHeapSize == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    *pMaxHeapSize = 2 * 1024 * 1024;
+
+    return S_OK;
+}
+
+HRESULT LLOS_MEMORY_Allocate(uint32_t size, uint8_t fill, LLOS_Opaque* pAllocation)
+{
+    LlosAllocationHeader* header;
+    size_t length = sizeof(LlosAllocationHeader) + size;
+
+    if (pAllocation == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    *pAllocation = nullptr;
+
+    header = (LlosAllocationHeader*)mmap(nullptr, length, PROT_READ | PROT_WRITE, LLOS_MMAP_FLAGS, -1, 0);
+
+    if (header == MAP_FAILED)
+    {
+        return LLOS_E_OUT_OF_MEMORY;
+    }
+
+    header->length = length;
+
+    // Anonymous mappings are already zero filled.
+    if (fill != 0)
+    {
+        memset(&header[1], fill, size);
+    }
+
+    *pAllocation = &header[1];
+
+    return S_OK;
+}
+
+HRESULT LLOS_MEMORY_Reallocate(LLOS_Opaque* pAllocation, uint32_t newSize)
+{
+    LlosAllocationHeader* header;
+    size_t length = sizeof(LlosAllocationHeader) + newSize;
+
+    if (pAllocation == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    if (*pAllocation == nullptr)
+    {
+        return LLOS_MEMORY_Allocate(newSize, 0, pAllocation);
+    }
+
+    // Not mremap: a moved mapping is not guaranteed to stay below 4GB, so map the new
+    // block with the same flags as any other allocation and copy the payload over.
+    LlosAllocationHeader* oldHeader = GetAllocationHeader(*pAllocation);
+
+    header = (LlosAllocationHeader*)mmap(nullptr, length, PROT_READ | PROT_WRITE, LLOS_MMAP_FLAGS, -1, 0);
+
+    if (header == MAP_FAILED)
+    {
+        return LLOS_E_OUT_OF_MEMORY;
+    }
+
+    header->length = length;
+
+    memcpy(&header[1], &oldHeader[1], (oldHeader->length < length ? oldHeader->length : length) - sizeof(LlosAllocationHeader));
+
+    munmap(oldHeader, oldHeader->length);
+
+    *pAllocation = &header[1];
+
+    return S_OK;
+}
+
+VOID LLOS_MEMORY_Free(LLOS_Opaque address)
+{
+    if (address != nullptr)
+    {
+        LlosAllocationHeader* header = GetAllocationHeader(address);
+
+        munmap(header, header->length);
+    }
+}
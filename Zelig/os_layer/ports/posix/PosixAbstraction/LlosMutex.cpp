@@ -0,0 +1,162 @@
+#include "LlosPosix.h"
+#include <llos_mutex.h>
+#include <errno.h>
+#include <time.h>
+
+LlosMutex* g_globalMutex = nullptr;
+
+HRESULT LLOS_MUTEX_CreateGlobalLock(LLOS_Handle* mutexHandle)
+{
+    HRESULT hr = LLOS_MUTEX_Create(nullptr, nullptr, mutexHandle);
+
+    // The first mutex created will be the global mutex for handling thread synchronization.
+    // It is saved to g_globalMutex so that the native POSIX code can use the global lock.
+    if (SUCCEEDED(hr))
+    {
+        g_globalMutex = (LlosMutex*)*mutexHandle;
+    }
+
+    return hr;
+}
+
+HRESULT LLOS_MUTEX_Create(LLOS_Context attributes, LLOS_Context name, LLOS_Handle* mutexHandle)
+{
+    LLOS__UNREFERENCED_PARAMETER(attributes);
+    LLOS__UNREFERENCED_PARAMETER(name);
+
+    pthread_mutexattr_t attr;
+    LlosMutex *pMutex;
+
+    if (mutexHandle == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    pMutex = (LlosMutex*)calloc(1, sizeof(LlosMutex));
+
+    if (pMutex == nullptr)
+    {
+        return LLOS_E_OUT_OF_MEMORY;
+    }
+
+    // Managed code re-enters the global lock, match the Win32 mutex semantics.
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+
+    if (pthread_mutex_init(&pMutex->mutex, &attr) != 0)
+    {
+        free(pMutex);
+        pMutex = nullptr;
+    }
+
+    pthread_mutexattr_destroy(&attr);
+
+    *mutexHandle = pMutex;
+
+    return pMutex != nullptr ? S_OK : LLOS_E_FAIL;
+}
+
+HRESULT LLOS_MUTEX_Acquire(LLOS_Handle mutexHandle, int32_t timeout)
+{
+    LlosMutex *pMutex = (LlosMutex*)mutexHandle;
+    int ret;
+
+    if (pMutex == nullptr)
+    {
+        return S_OK;
+    }
+
+    if (timeout < 0)
+    {
+        ret = pthread_mutex_lock(&pMutex->mutex);
+    }
+    else
+    {
+        struct timespec deadline;
+
+        clock_gettime(CLOCK_REALTIME, &deadline);
+
+        deadline.tv_sec  += timeout / 1000;
+        deadline.tv_nsec += (timeout % 1000) * 1000000;
+
+        if (deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_sec  += 1;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        ret = pthread_mutex_timedlock(&pMutex->mutex, &deadline);
+    }
+
+    if (ret == ETIMEDOUT)
+    {
+        return LLOS_E_TIMEOUT;
+    }
+
+    if (ret != 0)
+    {
+        return LLOS_E_FAIL;
+    }
+
+    pMutex->owner = pthread_self();
+    pMutex->recursionCount++;
+
+    return S_OK;
+}
+
+HRESULT LLOS_MUTEX_Release(LLOS_Handle mutexHandle)
+{
+    LlosMutex *pMutex = (LlosMutex*)mutexHandle;
+
+    if (pMutex == nullptr)
+    {
+        return S_OK;
+    }
+
+    if (pMutex->recursionCount <= 0 || !pthread_equal(pMutex->owner, pthread_self()))
+    {
+        return LLOS_E_LOCK_SYNCHRONIZATION_EXCEPTION;
+    }
+
+    pMutex->recursionCount--;
+
+    return pthread_mutex_unlock(&pMutex->mutex) == 0 ? S_OK : LLOS_E_FAIL;
+}
+
+BOOL LLOS_MUTEX_CurrentThreadHasLock(LLOS_Handle mutexHandle)
+{
+    LlosMutex *pMutex = (LlosMutex*)mutexHandle;
+
+    if (pMutex == nullptr)
+    {
+        return FALSE;
+    }
+
+    // Only the owning thread can observe a non-zero recursion count together
+    // with its own id, so no lock is needed for this check.
+    return (pMutex->recursionCount > 0 && pthread_equal(pMutex->owner, pthread_self())) ? TRUE : FALSE;
+}
+
+HRESULT LLOS_MUTEX_Delete(LLOS_Handle mutexHandle)
+{
+    LlosMutex *pMutex = (LlosMutex*)mutexHandle;
+
+    if (pMutex == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    if (pMutex == g_globalMutex)
+    {
+        g_globalMutex = nullptr;
+    }
+
+    if (pthread_mutex_destroy(&pMutex->mutex) != 0)
+    {
+        return LLOS_E_BUSY;
+    }
+
+    free(pMutex);
+
+    return S_OK;
+}
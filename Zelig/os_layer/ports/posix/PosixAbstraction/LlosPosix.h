@@ -0,0 +1,49 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Make sure llos_platform.h picks up the libc memset rather than declaring its own.
+#define LLOS_MEMSET memset
+
+#include <llos_types.h>
+
+#pragma once
+
+#ifndef TRUE
+#define TRUE  1
+#endif
+
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+#define LLOS__UNREFERENCED_PARAMETER(P) ((void)P)
+
+typedef struct LlosThread
+{
+    LLOS_ThreadEntry entry;
+    LLOS_Context     param;
+    LLOS_Context     managedThread;
+    pthread_t        hndThread;
+    uint32_t         stackSize;
+    int32_t          priority;
+    BOOL             fStarted;
+    int32_t          waitAddress;
+} LlosThread;
+
+typedef struct LlosMutex
+{
+    pthread_mutex_t  mutex;
+    pthread_t        owner;
+    int32_t          recursionCount;
+} LlosMutex;
+
+extern "C" void LLILUM_main(void);
+extern LlosThread* GetThreadLocalStorage(void);
+extern uint64_t    GetMonotonicMicroseconds(void);
+extern int32_t     FutexWait(int32_t* address, int32_t expected, int32_t timeoutMs);
+extern int32_t     FutexWake(int32_t* address);
+
+extern LlosMutex*    g_globalMutex;
+extern pthread_key_t g_tlsKey;
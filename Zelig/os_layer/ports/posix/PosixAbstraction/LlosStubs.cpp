@@ -0,0 +1,139 @@
+#include "LlosPosix.h"
+#include <signal.h>
+
+extern "C"
+{
+    uint32_t CMSIS_STUB_SCB__get_CONTROL()
+    {
+        return 0;
+    }
+
+    uint32_t CMSIS_STUB_SCB__get_BASEPRI()
+    {
+        return 0;
+    }
+
+    uint32_t CMSIS_STUB_SCB__set_BASEPRI(uint32_t basePri)
+    {
+        LLOS__UNREFERENCED_PARAMETER(basePri);
+
+        return 0;
+    }
+
+    void CUSTOM_STUB_SCB_SCR_SetSystemControlRegister(uint32_t scr)
+    {
+        LLOS__UNREFERENCED_PARAMETER(scr);
+    }
+
+    void CUSTOM_STUB_SCB_set_CCR(uint32_t value)
+    {
+        LLOS__UNREFERENCED_PARAMETER(value);
+    }
+
+    void CUSTOM_STUB_SCB_SHCRS_EnableSystemHandler(uint32_t ex)
+    {
+        LLOS__UNREFERENCED_PARAMETER(ex);
+    }
+
+    void CUSTOM_STUB_RaiseSupervisorCallForLongJump()
+    {
+    }
+
+    uint32_t CUSTOM_STUB_SCB__get_FPCCR()
+    {
+        return 0;
+    }
+
+    void CUSTOM_STUB_SCB__set_FPCCR(uint32_t fpscr)
+    {
+        LLOS__UNREFERENCED_PARAMETER(fpscr);
+    }
+
+    void Breakpoint()
+    {
+    }
+
+    uint32_t CUSTOM_STUB_DebuggerConnected()
+    {
+        return 0;
+    }
+
+    uint32_t CUSTOM_STUB_SCB__get_CFSR()
+    {
+        return 0;
+    }
+
+    uint32_t CUSTOM_STUB_SCB__get_HFSR()
+    {
+        return 0;
+    }
+
+    uint32_t CUSTOM_STUB_SCB__get_MMFAR()
+    {
+        return 0;
+    }
+
+    uint32_t CUSTOM_STUB_SCB__get_BFAR()
+    {
+        return 0;
+    }
+
+    uint32_t* CUSTOM_STUB_FetchSoftwareFrameSnapshot()
+    {
+        return nullptr;
+    }
+
+    void CMSIS_STUB_SCB__set_PSP(uint32_t topOfProcStack)
+    {
+        LLOS__UNREFERENCED_PARAMETER(topOfProcStack);
+    }
+
+    void CUSTOM_STUB_SetExcReturn(uint32_t ret)
+    {
+        LLOS__UNREFERENCED_PARAMETER(ret);
+    }
+
+    void CUSTOM_STUB_RaiseSupervisorCallForStartThreads()
+    {
+    }
+
+    void CUSTOM_STUB_RaiseSupervisorCallForRetireThread()
+    {
+    }
+
+    void CUSTOM_STUB_RaiseSupervisorCallForSnapshotProcessModeRegisters()
+    {
+    }
+
+    uint32_t CMSIS_STUB_SCB__get_FAULTMASK()
+    {
+        return 0;
+    }
+
+    uint32_t CMSIS_STUB_SCB__get_PRIMASK()
+    {
+        return 0;
+    }
+
+    uint32_t CMSIS_STUB_SCB__set_PRIMASK(uint32_t priMask)
+    {
+        LLOS__UNREFERENCED_PARAMETER(priMask);
+
+        return 0;
+    }
+    
+    uint32_t CUSTOM_STUB_SCB_IPSR_GetCurrentISRNumber()
+    {
+        return 0;
+    }
+
+    uint32_t us_ticker_read()
+    {
+        // This function will only be included and called if the test application was
+        // compiled for a board other than the host. You should verify that program.cs in
+        // the directory: zelig\zelig\test\mbed\simple\ defines WIN32 at the top of the
+        // file.
+        raise(SIGTRAP);
+        return 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,350 @@
+#include "LlosPosix.h"
+#include <llos_thread.h>
+#include <errno.h>
+#include <limits.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+//
+// LLOS_THREAD_Wait/Signal are built on a private futex word per thread, which is the
+// POSIX equivalent of the WaitOnAddress/WakeByAddressAll pair used by the Win32 port.
+//
+
+int32_t FutexWait(int32_t* address, int32_t expected, int32_t timeoutMs)
+{
+    struct timespec timeout;
+    struct timespec* pTimeout = nullptr;
+
+    if (timeoutMs >= 0)
+    {
+        timeout.tv_sec  = timeoutMs / 1000;
+        timeout.tv_nsec = (timeoutMs % 1000) * 1000000;
+        pTimeout = &timeout;
+    }
+
+    if (syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, expected, pTimeout, nullptr, 0) == 0)
+    {
+        return 0;
+    }
+
+    return errno;
+}
+
+int32_t FutexWake(int32_t* address)
+{
+    return (int32_t)syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+static void* LlosThreadEntryWrapper(void* lpThreadParameter)
+{
+    LlosThread *pThread = (LlosThread*)lpThreadParameter;
+
+    if (pThread == nullptr)
+    {
+        return nullptr;
+    }
+
+    pthread_setspecific(g_tlsKey, pThread);
+
+    // Apply any priority that was set before the thread was started.
+    setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), pThread->priority);
+
+    pThread->entry(pThread->param);
+
+    pthread_setspecific(g_tlsKey, nullptr);
+
+    return nullptr;
+}
+
+LlosThread* GetThreadLocalStorage()
+{
+    return (LlosThread*)pthread_getspecific(g_tlsKey);
+}
+
+HRESULT LLOS_THREAD_GetCurrentThread(LLOS_Context* threadHandle)
+{
+    LlosThread *pThread;
+
+    if (threadHandle == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    pThread = GetThreadLocalStorage();
+
+    if (pThread != nullptr)
+    {
+        *threadHandle = pThread->managedThread;
+    }
+    else
+    {
+        *threadHandle = nullptr;
+    }
+
+    return *threadHandle != nullptr ? S_OK : LLOS_E_FAIL;
+}
+
+HRESULT LLOS_THREAD_CreateThread(LLOS_ThreadEntry threadEntry, LLOS_Context threadParameter, LLOS_Context managedThread, uint32_t stackSize, LLOS_Handle* threadHandle)
+{
+    LlosThread *pThread;
+
+    if (threadHandle == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    pThread = (LlosThread*)calloc(1, sizeof(LlosThread));
+
+    if (pThread == nullptr)
+    {
+        return LLOS_E_OUT_OF_MEMORY;
+    }
+
+    // pthreads cannot be created suspended, so the OS thread is only created in LLOS_THREAD_Start.
+    pThread->entry         = threadEntry;
+    pThread->param         = threadParameter;
+    pThread->managedThread = managedThread;
+    pThread->stackSize     = stackSize;
+    pThread->priority      = 0;
+    pThread->fStarted      = FALSE;
+    pThread->waitAddress   = 0;
+
+    *threadHandle = pThread;
+
+    return S_OK;
+}
+
+HRESULT LLOS_THREAD_Start(LLOS_Handle threadHandle)
+{
+    pthread_attr_t attr;
+    LlosThread *pThread = (LlosThread*)threadHandle;
+    int ret;
+
+    if (pThread == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    if (pThread->fStarted)
+    {
+        return LLOS_E_INVALID_OPERATION;
+    }
+
+    pthread_attr_init(&attr);
+
+    if (pThread->stackSize >= PTHREAD_STACK_MIN)
+    {
+        pthread_attr_setstacksize(&attr, pThread->stackSize);
+    }
+
+    ret = pthread_create(&pThread->hndThread, &attr, LlosThreadEntryWrapper, pThread);
+
+    pthread_attr_destroy(&attr);
+
+    if (ret != 0)
+    {
+        return ret == EAGAIN ? LLOS_E_OUT_OF_MEMORY : LLOS_E_FAIL;
+    }
+
+    pThread->fStarted = TRUE;
+
+    return S_OK;
+}
+
+HRESULT LLOS_THREAD_Yield(VOID)
+{
+    sched_yield();
+
+    return S_OK;
+}
+
+HRESULT LLOS_THREAD_Wait(LLOS_Handle threadHandle, int32_t timeoutMs)
+{
+    HRESULT hr = S_OK;
+    LlosThread *pThread = (LlosThread*)threadHandle;
+    uint64_t deadline = 0;
+
+    if (pThread == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    if (timeoutMs >= 0)
+    {
+        deadline = GetMonotonicMicroseconds() + (uint64_t)timeoutMs * 1000;
+    }
+
+    while (__atomic_load_n(&pThread->waitAddress, __ATOMIC_ACQUIRE) == 0)
+    {
+        int32_t remainingMs = -1;
+
+        if (timeoutMs >= 0)
+        {
+            uint64_t now = GetMonotonicMicroseconds();
+
+            if (now >= deadline)
+            {
+                hr = LLOS_E_TIMEOUT;
+                break;
+            }
+
+            remainingMs = (int32_t)((deadline - now + 999) / 1000);
+        }
+
+        // EAGAIN means we were signaled between the load and the wait, EINTR is a spurious
+        // wake up, ETIMEDOUT is handled by the deadline check; all of them just loop.
+        FutexWait(&pThread->waitAddress, 0, remainingMs);
+    }
+
+    __atomic_store_n(&pThread->waitAddress, 0, __ATOMIC_RELEASE);
+
+    return hr;
+}
+
+HRESULT LLOS_THREAD_Signal(LLOS_Handle threadHandle)
+{
+    LlosThread *pThread = (LlosThread*)threadHandle;
+
+    if (pThread == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    __atomic_store_n(&pThread->waitAddress, 1, __ATOMIC_RELEASE);
+    FutexWake(&pThread->waitAddress);
+
+    return S_OK;
+}
+
+//
+// Priorities map onto nice values, the only per-thread knob available to unprivileged
+// processes under the default SCHED_OTHER policy. Raising priority above normal
+// requires CAP_SYS_NICE and silently stays at normal otherwise.
+//
+
+static int32_t ConvertToNiceValue(LLOS_ThreadPriority threadPriority)
+{
+    switch (threadPriority)
+    {
+    case ThreadPriority_Lowest:
+        return 10;
+    case ThreadPriority_BelowNormal:
+        return 5;
+    case ThreadPriority_AboveNormal:
+        return -5;
+    case ThreadPriority_Highest:
+        return -10;
+
+    case ThreadPriority_Normal:
+    default:
+        return 0;
+    }
+}
+
+HRESULT LLOS_THREAD_SetPriority(LLOS_Handle threadHandle, LLOS_ThreadPriority threadPriority)
+{
+    LlosThread *pThread = (LlosThread*)threadHandle;
+
+    if (pThread == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    pThread->priority = ConvertToNiceValue(threadPriority);
+
+    // Nice values are per kernel task and can only be applied from the thread itself, so
+    // for other threads the value is picked up on start.
+    if (pThread == GetThreadLocalStorage())
+    {
+        if (setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), pThread->priority) != 0 && errno != EACCES && errno != EPERM)
+        {
+            return LLOS_E_FAIL;
+        }
+    }
+
+    return S_OK;
+}
+
+HRESULT LLOS_THREAD_GetPriority(LLOS_Handle threadHandle, LLOS_ThreadPriority* threadPriority)
+{
+    LLOS_ThreadPriority llosPri = ThreadPriority_Normal;
+    LlosThread *pThread = (LlosThread*)threadHandle;
+
+    if (pThread == nullptr || threadPriority == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    if (pThread->priority >= 10)
+    {
+        llosPri = ThreadPriority_Lowest;
+    }
+    else if (pThread->priority > 0)
+    {
+        llosPri = ThreadPriority_BelowNormal;
+    }
+    else if (pThread->priority <= -10)
+    {
+        llosPri = ThreadPriority_Highest;
+    }
+    else if (pThread->priority < 0)
+    {
+        llosPri = ThreadPriority_AboveNormal;
+    }
+
+    *threadPriority = llosPri;
+
+    return S_OK;
+}
+
+HRESULT LLOS_THREAD_DeleteThread(LLOS_Handle threadHandle)
+{
+    LlosThread *pThread = (LlosThread*)threadHandle;
+
+    if (pThread != nullptr)
+    {
+        if (pThread->fStarted)
+        {
+            pthread_join(pThread->hndThread, nullptr);
+        }
+
+        free(pThread);
+    }
+
+    return S_OK;
+}
+
+VOID LLOS_THREAD_Sleep(int32_t timeoutMilliseconds)
+{
+    struct timespec ts;
+
+    // A negative timeout is INFINITE on Win32, where Sleep never returns.
+    if (timeoutMilliseconds < 0)
+    {
+        while (true)
+        {
+            pause();
+        }
+    }
+
+    ts.tv_sec  = timeoutMilliseconds / 1000;
+    ts.tv_nsec = (timeoutMilliseconds % 1000) * 1000000;
+
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+    {
+    }
+}
+
+uint32_t LLOS_THREAD_GetMainStackAddress()
+{
+    return 0;
+}
+
+uint32_t LLOS_THREAD_GetMainStackSize()
+{
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include "LlosPosix.h"
+#include <llos_mutex.h>
+#include <llos_system_timer.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+//
+// Each timer owns a timerfd and a dispatch thread, mirroring the thread-per-timer
+// model of the Win32 port. The thread blocks in epoll on the timerfd and on an
+// eventfd that is used to ask it to exit.
+//
+
+typedef struct LlosTimerEntry
+{
+    pthread_t hndThread;
+    int       timerFd;
+    int       exitFd;
+    int       epollFd;
+    BOOL      fExit;
+    LLOS_SYSTEM_TIMER_Callback callback;
+    LLOS_Context callbackContext;
+
+} LlosTimerEntry;
+
+static void* LlosTimerThreadProc(void* lpThreadParameter)
+{
+    LlosTimerEntry *pTimer = (LlosTimerEntry*)lpThreadParameter;
+    LlosThread timerThread;
+
+    if (pTimer == nullptr)
+    {
+        return nullptr;
+    }
+
+    // Timer callbacks take the global lock, so give this thread a storage slot as well.
+    memset(&timerThread, 0, sizeof(timerThread));
+    timerThread.hndThread = pthread_self();
+    timerThread.fStarted  = TRUE;
+    pthread_setspecific(g_tlsKey, &timerThread);
+
+    while (!__atomic_load_n(&pTimer->fExit, __ATOMIC_ACQUIRE))
+    {
+        struct epoll_event events[2];
+        BOOL fTimerExpired = FALSE;
+        int count;
+
+        count = epoll_wait(pTimer->epollFd, events, 2, -1);
+
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            if (events[i].data.fd == pTimer->timerFd)
+            {
+                uint64_t expirations;
+
+                if (read(pTimer->timerFd, &expirations, sizeof(expirations)) == sizeof(expirations) && expirations > 0)
+                {
+                    fTimerExpired = TRUE;
+                }
+            }
+        }
+
+        if (fTimerExpired && !__atomic_load_n(&pTimer->fExit, __ATOMIC_ACQUIRE))
+        {
+            LLOS_MUTEX_Acquire((LLOS_Context)g_globalMutex, -1);
+
+            pTimer->callback(pTimer->callbackContext, LLOS_SYSTEM_TIMER_GetTicks(pTimer));
+
+            LLOS_MUTEX_Release((LLOS_Context)g_globalMutex);
+        }
+    }
+
+    pthread_setspecific(g_tlsKey, nullptr);
+
+    return nullptr;
+}
+
+static void FreeTimerEntry(LlosTimerEntry *pEntry)
+{
+    if (pEntry->epollFd >= 0)
+    {
+        close(pEntry->epollFd);
+    }
+
+    if (pEntry->exitFd >= 0)
+    {
+        close(pEntry->exitFd);
+    }
+
+    if (pEntry->timerFd >= 0)
+    {
+        close(pEntry->timerFd);
+    }
+
+    free(pEntry);
+}
+
+HRESULT LLOS_SYSTEM_TIMER_AllocateTimer(LLOS_SYSTEM_TIMER_Callback callback, LLOS_Context callbackContext, uint64_t microsecondsFromNow, LLOS_Context *pTimer)
+{
+    LlosTimerEntry *pEntry = nullptr;
+    struct epoll_event event;
+
+    if (pTimer == nullptr || callback == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    pEntry = (LlosTimerEntry*)calloc(1, sizeof(LlosTimerEntry));
+
+    if (pEntry == nullptr)
+    {
+        return LLOS_E_OUT_OF_MEMORY;
+    }
+
+    pEntry->callback        = callback;
+    pEntry->callbackContext = callbackContext;
+    pEntry->fExit           = FALSE;
+    pEntry->timerFd         = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    pEntry->exitFd          = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    pEntry->epollFd         = epoll_create1(EPOLL_CLOEXEC);
+
+    if (pEntry->timerFd < 0 || pEntry->exitFd < 0 || pEntry->epollFd < 0)
+    {
+        FreeTimerEntry(pEntry);
+        return LLOS_E_FAIL;
+    }
+
+    event.events  = EPOLLIN;
+    event.data.fd = pEntry->timerFd;
+    epoll_ctl(pEntry->epollFd, EPOLL_CTL_ADD, pEntry->timerFd, &event);
+
+    event.events  = EPOLLIN;
+    event.data.fd = pEntry->exitFd;
+    epoll_ctl(pEntry->epollFd, EPOLL_CTL_ADD, pEntry->exitFd, &event);
+
+    if (pthread_create(&pEntry->hndThread, nullptr, LlosTimerThreadProc, pEntry) != 0)
+    {
+        FreeTimerEntry(pEntry);
+        return LLOS_E_FAIL;
+    }
+
+    *pTimer = pEntry;
+
+    if (microsecondsFromNow != 0)
+    {
+        LLOS_SYSTEM_TIMER_ScheduleTimer(pEntry, microsecondsFromNow);
+    }
+
+    return S_OK;
+}
+
+VOID LLOS_SYSTEM_TIMER_FreeTimer(LLOS_Context pTimer)
+{
+    if (pTimer != nullptr)
+    {
+        LlosTimerEntry *pEntry = (LlosTimerEntry*)pTimer;
+        uint64_t value = 1;
+
+        __atomic_store_n(&pEntry->fExit, TRUE, __ATOMIC_RELEASE);
+
+        if (write(pEntry->exitFd, &value, sizeof(value)) == sizeof(value))
+        {
+            pthread_join(pEntry->hndThread, nullptr);
+        }
+        else
+        {
+            pthread_detach(pEntry->hndThread);
+        }
+
+        FreeTimerEntry(pEntry);
+    }
+}
+
+HRESULT LLOS_SYSTEM_TIMER_ScheduleTimer(LLOS_Context pTimer, uint64_t microsecondsFromNow)
+{
+    LlosTimerEntry *pEntry = (LlosTimerEntry*)pTimer;
+    struct itimerspec spec;
+
+    if (pTimer == nullptr)
+    {
+        return LLOS_E_INVALID_PARAMETER;
+    }
+
+    // A zero it_value disarms the timer, so fire as soon as possible instead.
+    if (microsecondsFromNow == 0)
+    {
+        microsecondsFromNow = 1;
+    }
+
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec  = (time_t)(microsecondsFromNow / 1000000);
+    spec.it_value.tv_nsec = (long)((microsecondsFromNow % 1000000) * 1000);
+
+    if (timerfd_settime(pEntry->timerFd, 0, &spec, nullptr) != 0)
+    {
+        return LLOS_E_FAIL;
+    }
+
+    return S_OK;
+}
+
+uint64_t LLOS_SYSTEM_TIMER_GetTicks(LLOS_Context pTimer)
+{
+    LLOS__UNREFERENCED_PARAMETER(pTimer);
+
+    return GetMonotonicMicroseconds();
+}
+
+uint64_t LLOS_SYSTEM_TIMER_GetTimerFrequency(LLOS_Context pTimer)
+{
+    LLOS__UNREFERENCED_PARAMETER(pTimer);
+
+    return 1000000; // 1us tick timer = 1MHz
+}
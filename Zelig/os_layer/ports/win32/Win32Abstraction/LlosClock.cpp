@@ -16,3 +16,13 @@ uint64_t LLOS_CLOCK_GetPerformanceCounterFrequency()
 {
     return 1000;
 }
+
+VOID LLOS_CLOCK_Idle()
+{
+    SwitchToThread();
+}
+
+HRESULT LLOS_CLOCK_GetIdleStatistics(uint32_t* pIdleMicroseconds, uint32_t* pActiveMicroseconds, uint64_t* pTotalIdleMicroseconds)
+{
+    return LLOS_E_NOT_SUPPORTED;
+}
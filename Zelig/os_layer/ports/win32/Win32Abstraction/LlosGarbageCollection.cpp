@@ -42,65 +42,130 @@ extern "C"
 #define REFERENCE_COUNT_MASK  0xFF000000
 #define REFERENCE_COUNT_SHIFT 24
 
+        // Enable this macro to go back to serializing every reference count update on the
+        // global kernel mutex, e.g. to compare against the atomic implementation below.
+//#define LLOS_REFCOUNT_USE_GLOBAL_LOCK
+
+#ifdef LLOS_REFCOUNT_USE_GLOBAL_LOCK
+
         // Helpers for starting / ending section of code that needs to be atomic
-        __inline void StartAtomicOperations(void)
+        __inline void StartAtomicOperations(Object** target)
         {
             LLOS_MUTEX_Acquire(g_globalMutex, -1);
         }
 
-        __inline void EndAtomicOperations(void)
+        __inline void EndAtomicOperations(Object** target)
         {
             LLOS_MUTEX_Release(g_globalMutex);
         }
 
-        __inline void AddReferenceFast(Object* target)
+#else // LLOS_REFCOUNT_USE_GLOBAL_LOCK
+
+        //
+        // Operations that read a slot and then touch the object it points to (load + addref,
+        // exchange, compare exchange) must not interleave with each other on the same slot,
+        // otherwise the object can be released between the load and the add ref. They take
+        // one of a small set of spin locks picked by slot address; plain add ref / release
+        // only use interlocked operations on the header.
+        //
+
+#define SLOT_LOCK_COUNT 64
+
+        struct __declspec(align(64)) SlotLock
         {
-            if (target != NULL)
+            volatile LONG Taken;
+        };
+
+        static SlotLock s_slotLocks[SLOT_LOCK_COUNT];
+
+        __inline volatile LONG* GetSlotLock(Object** target)
+        {
+            return &s_slotLocks[((uintptr_t)target / sizeof(Object*)) % SLOT_LOCK_COUNT].Taken;
+        }
+
+        __inline void StartAtomicOperations(Object** target)
+        {
+            volatile LONG* lock = GetSlotLock(target);
+
+            while (InterlockedExchange(lock, 1) != 0)
             {
-                ObjectHeader* header = target->get_Header();
-                if (header->MultiUseWord & REFERENCE_COUNT_MASK)
+                while (*lock != 0)
                 {
-                    header->MultiUseWord += (1 << REFERENCE_COUNT_SHIFT);
+                    YieldProcessor();
                 }
             }
         }
 
-        void AddReference(Object* target)
+        __inline void EndAtomicOperations(Object** target)
+        {
+            InterlockedExchange(GetSlotLock(target), 0);
+        }
+
+#endif // LLOS_REFCOUNT_USE_GLOBAL_LOCK
+
+        __inline void AddReferenceFast(Object* target)
         {
             if (target != NULL)
             {
-                ObjectHeader* header = target->get_Header();
+                volatile LONG* word = (volatile LONG*)&target->get_Header()->MultiUseWord;
+                LONG value = *word;
 
-                StartAtomicOperations();
-
-                if (header->MultiUseWord & REFERENCE_COUNT_MASK)
+                while (value & REFERENCE_COUNT_MASK)
                 {
-                    header->MultiUseWord += (1 << REFERENCE_COUNT_SHIFT);
-                }
+                    LONG oldValue = InterlockedCompareExchange(word, value + (1 << REFERENCE_COUNT_SHIFT), value);
 
-                EndAtomicOperations();
+                    if (oldValue == value)
+                    {
+                        break;
+                    }
+
+                    value = oldValue;
+                }
             }
         }
 
+        void AddReference(Object* target)
+        {
+#ifdef LLOS_REFCOUNT_USE_GLOBAL_LOCK
+            StartAtomicOperations(nullptr);
+            AddReferenceFast(target);
+            EndAtomicOperations(nullptr);
+#else // LLOS_REFCOUNT_USE_GLOBAL_LOCK
+            AddReferenceFast(target);
+#endif // LLOS_REFCOUNT_USE_GLOBAL_LOCK
+        }
+
         // Return zero when target is dead after the call
         int ReleaseReferenceNative(Object* target)
         {
             int ret = 1;
             if (target != NULL)
             {
-                ObjectHeader* header = target->get_Header();
+                volatile LONG* word = (volatile LONG*)&target->get_Header()->MultiUseWord;
 
-                StartAtomicOperations();
+#ifdef LLOS_REFCOUNT_USE_GLOBAL_LOCK
+                StartAtomicOperations(nullptr);
+#endif // LLOS_REFCOUNT_USE_GLOBAL_LOCK
 
-                int32_t value = header->MultiUseWord;
-                if (value & REFERENCE_COUNT_MASK)
+                LONG value = *word;
+
+                while (value & REFERENCE_COUNT_MASK)
                 {
-                    value -= (1 << REFERENCE_COUNT_SHIFT);
-                    header->MultiUseWord = value;
-                    ret = value & REFERENCE_COUNT_MASK;
+                    LONG newValue = value - (1 << REFERENCE_COUNT_SHIFT);
+                    LONG oldValue = InterlockedCompareExchange(word, newValue, value);
+
+                    if (oldValue == value)
+                    {
+                        ret = newValue & REFERENCE_COUNT_MASK;
+                        break;
+                    }
+
+                    value = oldValue;
                 }
 
-                EndAtomicOperations();
+#ifdef LLOS_REFCOUNT_USE_GLOBAL_LOCK
+                EndAtomicOperations(nullptr);
+#endif // LLOS_REFCOUNT_USE_GLOBAL_LOCK
             }
 
             return ret;
@@ -108,39 +173,36 @@ extern "C"
 
         Object* LoadAndAddReferenceNative(Object** target)
         {
-            StartAtomicOperations();
+            StartAtomicOperations(target);
 
             Object* value = *target;
             AddReferenceFast(value);
 
-            EndAtomicOperations();
+            EndAtomicOperations(target);
 
             return value;
         }
 
         Object* ReferenceCountingExchange(Object** target, Object* value)
         {
-            StartAtomicOperations();
+            StartAtomicOperations(target);
 
-            Object* oldValue = *target;
-            *target = value;
+            Object* oldValue = (Object*)InterlockedExchangePointer((PVOID volatile*)target, value);
             AddReferenceFast(value);
 
-            EndAtomicOperations();
+            EndAtomicOperations(target);
 
             return oldValue;
         }
 
         Object* ReferenceCountingCompareExchange(Object** target, Object* value, Object* comparand)
         {
-            StartAtomicOperations();
+            StartAtomicOperations(target);
 
-            Object* oldValue = *target;
+            Object* oldValue = (Object*)InterlockedCompareExchangePointer((PVOID volatile*)target, value, comparand);
             Object* addRefTarget;
             if (oldValue == comparand)
             {
-                *target = value;
-
                 // Compare exchange succeeded, we need to add ref the new value
                 // The old value's ref count will be passed back to the caller on return.
                 addRefTarget = value;
@@ -154,7 +216,7 @@ extern "C"
 
             AddReferenceFast(addRefTarget);
 
-            EndAtomicOperations();
+            EndAtomicOperations(target);
 
             return oldValue;
         }